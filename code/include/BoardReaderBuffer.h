@@ -0,0 +1,106 @@
+#ifndef _BoardReaderBuffer_included_
+#define _BoardReaderBuffer_included_
+
+// --------------------------------------------------------------------------------------
+//
+// Block-buffered input for the board readers parsing raw files word by word.
+//
+// The files are read by large blocks (kDefaultBlockSize bytes) into an aligned buffer,
+//  the readers then copy their words from memory (Read), or parse directly
+//  in the buffer (Peek + Skip), seeking inside the current block costs nothing.
+//
+// A list of files can be given (AddFile), Read and ReadSome continue
+//  with the next file of the list when the current one is exhausted,
+//  so that the readers do not handle the file rollover.
+// Tell, Seek and GetFileSize refer to the current file.
+//
+// As for std::istream, a failed Read or Seek sets a flag (Good() false)
+//  and Tell() then returns -1, until the next Open or Clear.
+//
+// No ROOT dependency.
+//
+// --------------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class BoardReaderBuffer {
+
+ public:
+
+  enum { kBegin = 0, kCurrent = 1, kEnd = 2 };
+  enum { kDefaultBlockSize = 4*1024*1024, kAlignment = 4096 };
+
+  BoardReaderBuffer( size_t blockSize=kDefaultBlockSize);
+  ~BoardReaderBuffer();
+
+  void        SetLabel( const char *aLabel)          { fLabel = aLabel; } // prefix of the messages
+  void        SetVerbose( bool verbose)              { fVerbose = verbose; }
+
+  // list of files
+  bool        Open( const char *fileName); // forget the list and open this file
+  void        AddFile( const char *fileName); // appended to the list, opened if no file is open
+  bool        OpenNextFile();
+  void        Close();
+  bool        IsOpen() const                         { return fFile!=0; }
+  const char* GetFileName() const                    { return fFileIndex>=0 && fFileIndex<(int)fFileNames.size() ? fFileNames[fFileIndex].c_str() : ""; }
+  int         GetFileIndex() const                   { return fFileIndex; }
+  int         GetFilesN() const                      { return (int)fFileNames.size(); }
+
+  // reading
+  bool        Read( void *destination, size_t nBytes) {
+    // fast path, the bytes are already in memory
+    if( fGood && fPosition>=fBlockStart && fPosition+(long long)nBytes<=fBlockStart+(long long)fBlockBytes ) {
+      memcpy( destination, fBlock+(fPosition-fBlockStart), nBytes);
+      fPosition += nBytes;
+      return true;
+    }
+    return ReadSlow( destination, nBytes);
+  }
+  size_t      ReadSome( void *destination, size_t maxBytes); // returns the number of bytes read, 0 at the end of the last file
+  const char* Peek( size_t nBytes); // the next nBytes of the current file in memory, 0 if not available
+  bool        Skip( long long nBytes)                { return Seek( nBytes, kCurrent); }
+  bool        Seek( long long offset, int whence=kBegin);
+  long long   Tell() const                           { return fGood ? fPosition : -1; }
+  long long   GetFileSize() const                    { return fFileSize; }
+  bool        Good() const                           { return fGood; }
+  bool        Eof() const                            { return fPosition>=fFileSize && fFileIndex>=(int)fFileNames.size()-1; }
+  void        Clear()                                { fGood = true; }
+
+  long long   GetBytesRead() const                   { return fBytesRead; } // from the disk, all files
+  int         GetBlocksRead() const                  { return fBlocksRead; }
+
+ private:
+
+  BoardReaderBuffer( const BoardReaderBuffer&);
+  BoardReaderBuffer& operator=( const BoardReaderBuffer&);
+
+  bool        ReadSlow( void *destination, size_t nBytes);
+  bool        OpenFile( int index);
+  bool        FillBlock( long long position, size_t minBytes);
+
+  std::string fLabel;
+  bool        fVerbose;
+
+  std::vector<std::string> fFileNames;
+  int         fFileIndex;
+  FILE       *fFile;
+  long long   fFileSize;
+  long long   fFilePosition;  // position of the FILE pointer
+
+  char       *fAllocated;
+  char       *fBlock;         // aligned in fAllocated
+  size_t      fBlockSize;     // capacity
+  long long   fBlockStart;    // position in the file of the first byte in fBlock
+  size_t      fBlockBytes;    // bytes available in fBlock
+  long long   fPosition;      // reading position in the current file
+  bool        fGood;
+
+  long long   fBytesRead;
+  int         fBlocksRead;
+
+};
+
+#endif
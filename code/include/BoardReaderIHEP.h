@@ -20,6 +20,7 @@
 #include "Riostream.h"
 #include "TObject.h"
 #include "DGlobalTools.h" // to have fTool has a data member
+#include "BoardReaderBuffer.h"
 //using namespace std;
 
 //##############################################################################
@@ -58,7 +59,7 @@ private:
   int vi_Verbose; /* Recommend-4; Little-6; Less-10 */
 
   /* Stream to input Raw Data file */
-  fstream ifs_DataRaw;
+  BoardReaderBuffer ifs_DataRaw; //! block-buffered input file
   unsigned long int vi_Pointer_FileBegin;
   unsigned long int vi_Pointer_FileEnd;
   unsigned long int vi_N_FileSize;
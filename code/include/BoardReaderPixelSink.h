@@ -0,0 +1,27 @@
+#ifndef _BoardReaderPixelSink_included_
+#define _BoardReaderPixelSink_included_
+
+// --------------------------------------------------------------------------------------
+//
+// Receiver of the pixels decoded by a board reader.
+//
+// When a sink is attached to a reader, each decoded pixel is handed
+//  to AddPixel instead of being stored in the reader own list of pixels,
+//  so that the pixel can go straight to its final container
+//  (for TAF, the list of pixels of the matching plane, see DAcqPixelSink).
+// Input and index start at 0, as for the pixel classes of the readers.
+//
+// No ROOT dependency, so that readers compiled STANDALONE can use it.
+//
+// --------------------------------------------------------------------------------------
+
+class BoardReaderPixelSink {
+
+ public:
+  virtual ~BoardReaderPixelSink() {}
+
+  virtual void AddPixel( int input, int value, int index, int timestamp) = 0;
+
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include "DGlobalTools.h"
 #include "DSetup.h"
 #include "DPixel.h"
+#include "DHotPixelMask.h"
 //#include "DMonteCarlo.h"
 #include "TNTBoardReader.h"
 #include "PXIBoardReader.h"
@@ -45,6 +46,27 @@
 #include "BoardReaderIHEP.h"
 #include "BoardReaderMIMOSIS.h"
 #include "sup_exp.typ" // for time reference information
+#include "BoardReaderPixelSink.h"
+#include "DAcqEventAssembly.h"
+
+class DAcq;
+
+// Receives the pixels decoded by one module (type mdt, number mdl)
+//  and adds them directly to the pixel list of the matching plane,
+//  see DAcq::AddIndexedPixel.
+class DAcqPixelSink : public BoardReaderPixelSink {
+
+ public:
+  DAcqPixelSink( DAcq *anAcq, Int_t mdt, Int_t mdl) : fAcq(anAcq), fModuleType(mdt), fModuleNumber(mdl) {}
+  virtual ~DAcqPixelSink() {}
+  virtual void AddPixel( int input, int value, int index, int timestamp);
+
+ private:
+  DAcq  *fAcq;
+  Int_t  fModuleType;
+  Int_t  fModuleNumber;
+
+};
 
 class DAcq : public TObject {
 
@@ -70,6 +92,8 @@ class DAcq : public TObject {
       BoardReaderMIMOSIS **fMSIS;          // pointer to MIMOSIS boards, JB 2021/05/01
       Int_t          ***fRawData;          // pointer to Raw Values
       std::vector<DPixel*>  *fListOfPixels;     // pointer to list of hit pixel
+      std::vector<DHotPixelMask*> fHotPixelMask; //! hot pixel mask per plane, 0 if no hot pixel
+      Int_t            *fHotPixelsMaskedN; //! number of hot pixels dropped per plane
       //std::vector<DMonteCarlo*> *fListOfMonteCarlo; // pointer to list of hit montecarlo
       //std::vector<Int_t>   *fListOfPixels;    // list of hit pixel index
       Int_t             fTriggersN;        // number of triggers in the event, JB 2009/05/22
@@ -79,11 +103,26 @@ class DAcq : public TObject {
       std::vector<int>      *ListOfTriggers;    // list of triggers JB 2010/06/16
       std::vector<int>      *ListOfFrames;      // list of frames JB 2010/06/16
       std::vector<int>      *ListOfTimestamps;  // list of timestamps JB 2010/06/16
+      DAcqEventAssembly      fEventAssembly;    //! board lists of the event, merged into the three lists above
       std::vector<int>      *ListOfLineOverflow; // line overflow vector per sensor, MG 2012/02/15
       Int_t         ****fMatchingPlane;   // plane matching the input
       Int_t         ****fIndexShift;      // index shift to add
       std::vector<int>    ***fInputSegments;    // limits of segments for this input, JB 2013/08/14
       Int_t             fMaxSegments;      // max nb of segements allowed for an input
+
+      // Plane and index shift of each input, precomputed from the segments
+      //  so that no search is needed per pixel, see BuildChannelMap
+      struct ChannelMap_t {
+        Int_t              plane;        // plane of the input when it has one segment
+        Int_t              shift;        // index shift of the input when it has one segment
+        std::vector<Int_t> channelPlane; // plane of each channel (from 1) when several segments
+        std::vector<Int_t> channelShift; // shift of each channel (from 1) when several segments
+      };
+      ChannelMap_t   ***fChannelMap;      //! per module type, module and input
+      std::vector<DAcqPixelSink*> fPixelSinks; //! sinks attached to the board readers
+
+      void              BuildChannelMap();
+      void              SearchPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t channel, Int_t &aPlane, Int_t &aShift);
       Bool_t          **fUseTimestamp;     // flag for timestamp usage, JB 2015/05/26
 
       Int_t             fEventNumber;      //  Number of the event according to DSession, JB 2009/05/26
@@ -91,6 +130,8 @@ class DAcq : public TObject {
       Int_t             fEventsMissed;     // Number of events missed for synchronization
       Int_t             fEventsDataNotOK;  // Number of events with wrong data
       Int_t             fEventsModuleNotOK;// Number of events with pb in module
+      Int_t             fEventsSkipped;    // Number of events passed over by GoToEvent, neither read nor checked
+      Int_t             fNextEventNumber;  // Number of the event the readers are positioned on
       Int_t             fRunNumber;        //  Run Number the event is in
 
       // Data to synchronize two PXIe boards, JB 2012/07/19
@@ -116,19 +157,38 @@ class DAcq : public TObject {
       Bool_t            fIsMCBoardReader;  // AP 2016/07/27   bool to specify if reading data with MCBoardReader
       DEventMC*         MCInfoHolder;      // AP 2016/04/21   Object with all the MC information. i.e. the full list of particles, hits and pixels (both from physics and noise)
 
+      void              AssembleLists();   // trigger, frame and timestamp lists from fEventAssembly
+
   public:
       DAcq();
       DAcq(DSetup& c);
       ~DAcq();
       TBits*           NextEvent( Int_t eventNumber, Int_t aTrigger=-1); // actually read the data from raw file!, JB 2009/05/26, 2012/07/10
       void             Reset();                                          // Restart event reading at 0, JB 2015/03/02
+      Bool_t           IsAbleToGoToEvent();                              // all modules keep an event index
+      Bool_t           GoToEvent( Int_t anEvent);                        // next NextEvent reads event anEvent
+      Int_t            FindEventWithTrigger( Int_t aTrigger);            // event number from the event index
       Int_t*           GetRawData( Int_t mdt, Int_t mdl, Int_t input);   // get the raw data buffer
       void             GetMatchingPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t channel, Int_t &aPlane, Int_t &aShift);  // get the plane and shift matching the input and channel
+      void             LookUpPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t channel, Int_t &aPlane, Int_t &aShift) {
+        const ChannelMap_t &map = fChannelMap[mdt-1][mdl-1][input-1];
+        if( map.channelPlane.empty() ) { aPlane = map.plane; aShift = map.shift; }
+        else if( 0<channel && channel<(Int_t)map.channelPlane.size() ) { aPlane = map.channelPlane[channel]; aShift = map.channelShift[channel]; }
+        else SearchPlaneAndShift( mdt, mdl, input, channel, aPlane, aShift);
+      }
+      void             AddIndexedPixel( Int_t mdt, Int_t mdl, Int_t input, Int_t index, Double_t value, Int_t timestamp=0); // input and index from 0
       std::vector<DPixel*> *GetListOfPixels( Int_t aPlaneNumber) { return &fListOfPixels[aPlaneNumber-1]; }// get the hit pixel list for a given plane
       //std::vector<Int_t>   *GetListOfPixels( Int_t aPlaneNumber) { return &fListOfPixels[aPlaneNumber]; }// get the hit pixel index list for a given plane
       //std::vector<DMonteCarlo*> *GetListOfMonteCarlo( Int_t aPlaneNumber) { return &fListOfMonteCarlo[aPlaneNumber-1]; }// get the hit monte carlo list for a given plane
       Bool_t           GetUsageTimestamp( Int_t mdt, Int_t mdl) { return fUseTimestamp[mdt-1][mdl-1];} // JB 2015/05/26
 
+      // Hot pixels are dropped while decoding, before any DPixel is created
+      void             InitHotPixelMasks();
+      DHotPixelMask*   GetHotPixelMask( Int_t aPlaneNumber) { return fHotPixelMask[aPlaneNumber-1]; }
+      Bool_t           IsHotPixel( Int_t aPlaneNumber, Int_t aLine, Int_t aColumn) { DHotPixelMask *mask = fHotPixelMask[aPlaneNumber-1]; if( mask && mask->IsHot( aLine, aColumn) ) { fHotPixelsMaskedN[aPlaneNumber-1]++; return kTRUE; } return kFALSE; }
+      Bool_t           IsHotPixelIndex( Int_t aPlaneNumber, Int_t anIndex) { DHotPixelMask *mask = fHotPixelMask[aPlaneNumber-1]; if( mask && mask->IsHotIndex( anIndex) ) { fHotPixelsMaskedN[aPlaneNumber-1]++; return kTRUE; } return kFALSE; }
+      Bool_t           SaveHotPixelMasks( const char *filePrefix);
+
       Bool_t           DumpHexToTerm();     // performs a hexadecimal dump of data
                                           // without any interpretation of data
       Int_t            GetEventNumber()     const { return fEventNumber; } // Number of the event according to Dsession, JB 2009/05/26
@@ -160,6 +220,11 @@ class DAcq : public TObject {
       Int_t            GetDebug()                            { return fDebugAcq;}
 
       void             PrintStatistics(ostream &stream=cout); // JB 2009/09/09 //SS 2011/12/14
+      Int_t            GetEventsMissed()            { return fEventsMissed; }
+      Int_t            GetEventsSkipped()           { return fEventsSkipped; }
+      Int_t            GetEventsDataNotOK()         { return fEventsDataNotOK; }
+      Int_t            GetEventsModuleNotOK()       { return fEventsModuleNotOK; }
+      void             ResetStatistics()            { fEventsMissed = 0; fEventsDataNotOK = 0; fEventsModuleNotOK = 0; fEventsSkipped = 0; }
       void             DumpSynchroInfo( Int_t nEvents=-1); // JB 2013/08/20
 
       Bool_t           IfMonteCarlo()               { return fIfMonteCarlo; }  // LC 2014/12/15 : Test to include MonteCarlo Infos
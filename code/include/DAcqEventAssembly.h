@@ -0,0 +1,62 @@
+#ifndef _DAcqEventAssembly_included_
+#define _DAcqEventAssembly_included_
+
+// --------------------------------------------------------------------------------------
+//
+// Assembly of the trigger, frame and timestamp lists of an event
+//  from the lists of the synchronised boards, used by DAcq::NextEvent.
+//
+// Each board hands its own vectors (Add, AddBoard), which are only referenced:
+//  nothing is copied nor modified in the board readers.
+// Get returns the list of the event:
+//  - the board vector itself when only one board provided the list,
+//  - otherwise a vector owned by the assembly, merged once in O(total size)
+//    and reused from event to event (no reallocation once large enough).
+//
+// The order is the one DAcq always used: the values of a board added with kAppend
+//  follow the first board, those added with kPrepend come before it,
+//  the last board added first.
+//
+// The references are valid until the boards read the next event, Clear forgets them.
+//
+// No ROOT dependency.
+//
+// --------------------------------------------------------------------------------------
+
+#include <vector>
+#include <cstddef>
+
+class DAcqEventAssembly {
+
+ public:
+
+  enum { kTriggers = 0, kFrames = 1, kTimestamps = 2, kLists = 3 };
+  enum { kAppend = 0, kPrepend = 1 };
+
+  DAcqEventAssembly();
+
+  void              Clear(); // new event
+  void              Add( int list, std::vector<int> *values, int where=kAppend);
+  void              AddBoard( std::vector<int> *triggers, std::vector<int> *frames, std::vector<int> *timestamps=0); // triggers appended, frames and timestamps prepended
+
+  int               GetBoardsN( int list) const        { return (int)fSpans[list].size(); } // boards which provided the list
+  size_t            GetSize( int list) const           { return fSizes[list]; }
+  std::vector<int>* Get( int list);
+
+ private:
+
+  struct Span_t {
+    std::vector<int> *values;
+    int               where;
+  };
+
+  void              Merge( int list);
+
+  std::vector<Span_t> fSpans[kLists];
+  size_t              fSizes[kLists];
+  std::vector<int>    fMerged[kLists];
+  bool                fMergedValid[kLists]; // fMerged up to date with fSpans
+
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef _DEtaTable_included_
+#define _DEtaTable_included_
+
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DEtaTable                                       //
+  //                                                                      //
+  // Eta correction of one direction (U or V) and one cluster position    //
+  //  (3x3, 2x2 or 5x5 CoG), computed from the list of CoG stored in the  //
+  //  TreeEta of the CorPar file.                                         //
+  // The correction is tabulated on a regular grid and evaluated by a     //
+  //  clamped linear interpolation, without branch nor list scan.         //
+  // The table matches the correction of the list within a tolerance      //
+  //  (um), otherwise the exact correction is used.                       //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+// ROOT classes
+#include "TObject.h"
+
+class DEtaTable : public TObject {
+
+ public:
+  DEtaTable();
+  virtual ~DEtaTable();
+
+  enum { kMinCells = 256, kMaxCells = 1<<15 };
+
+  void     SetList( const Float_t *aList, Int_t aListN, Float_t aPitch);
+  Bool_t   Tabulate( Double_t aTolerance, Int_t maxCells=kMaxCells);
+  Bool_t   UseCellsOf( const DEtaTable &aTable, Double_t aTolerance);
+  void     Clear( Option_t *opt="");
+
+  // correction (um) for the CoG x relative to the seed pixel
+  Double_t Exact( Float_t x) const {
+    Int_t count = (Int_t)(std::upper_bound( fThresholds.begin(), fThresholds.end(), x) - fThresholds.begin());
+    return fPitch*(Float_t(count)/Float_t(fListN)) - fPitch/2.;
+  }
+  Double_t Eval( Float_t x) const {
+    if( fCellsN==0 ) return Exact( x);
+    return Interpolate( x);
+  }
+
+  Bool_t   IsTabulated() const             { return fCellsN>0; }
+  Int_t    GetListN() const                { return fListN; }
+  Float_t  GetPitch() const                { return fPitch; }
+  Int_t    GetCellsN() const               { return fCellsN; }
+  Double_t GetStep() const                 { return fStep; }
+  Double_t GetTolerance() const            { return fTolerance; }
+  Double_t GetMaxDeviation() const         { return fMaxDeviation; }
+
+ private:
+  Double_t Interpolate( Float_t x) const {
+    Double_t t = (x-fAnchor)*fInvStep; // exact for x close to the anchor
+    t = t<fTmax ? t : fTmax; // NaN goes to the last cell, as in the list scan
+    t = t>fTmin ? t : fTmin;
+    Double_t edge = floor( t);
+    const Float_t *cell = &fCells[2*((Int_t)edge-fFirstCell)];
+    return cell[0] + (t-edge)*(cell[1]-cell[0]);
+  }
+  Double_t ExactAt( Double_t x, Bool_t leftLimit) const;
+  void     Fill( Int_t nCells);
+  Double_t ComputeMaxDeviation() const;
+  void     SetCellsN( Int_t nCells);
+
+  Int_t                 fListN;         // number of CoG in the list
+  Float_t               fPitch;         // pixel pitch (um)
+  Double_t              fTolerance;     // requested maximal deviation (um)
+  Double_t              fMaxDeviation;  // measured maximal deviation (um)
+  Int_t                 fCellsN;        // number of cells, 0 if not tabulated
+  Float_t               fAnchor;        // list value with the largest step, on a cell edge
+  Int_t                 fFirstCell;     // index of the first cell, from the anchor
+  Double_t              fStep;          // cell width, a power of 2
+  std::vector<Float_t>  fCells;         // correction at the lower and upper edge of each cell
+  Double_t              fInvStep;       //! 1/fStep
+  Double_t              fTmin;          //! index of the first cell
+  Double_t              fTmax;          //! index of the last cell
+  std::vector<Float_t>  fThresholds;    //! running maximum of the list
+
+  ClassDef(DEtaTable,1)                 // Tabulated eta correction
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _DEventIndex_included_
+#define _DEventIndex_included_
+
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DEventIndex                                     //
+  //                                                                      //
+  // Position of each event of a raw data run: file number, byte offset   //
+  //  in this file, acquisition and frame ids, trigger number.            //
+  // The index is filled by a board reader during a first sequential      //
+  //  pass and saved in a small binary sidecar file, next runs read it    //
+  //  back to seek directly to any event or trigger.                      //
+  // The sizes of the raw files are stored with the index so that an      //
+  //  index built on other (or modified) files is never used.             //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+// ROOT classes
+#include "TObject.h"
+
+class DEventIndex : public TObject {
+
+ public:
+
+  // One record per event, the event number is the rank of the record
+  struct Entry_t {
+    Int_t    fileNumber;   // rank of the raw file in the reader list
+    Long64_t offset;       // byte offset of the event in this file
+    Int_t    acqId;        // acquisition (or event) id written by the DAQ, -1 if unknown
+    Int_t    frameId;      // frame id written by the DAQ, -1 if unknown
+    Int_t    trigger;      // trigger number written by the DAQ, -1 if unknown
+  };
+
+  DEventIndex();
+  virtual ~DEventIndex();
+
+  void    Reset();
+  void    SetFileSizes( const std::vector<Long64_t> &fileSizes) { fFileSizes = fileSizes; }
+  void    Add( Int_t fileNumber, Long64_t offset, Int_t acqId=-1, Int_t frameId=-1, Int_t trigger=-1);
+  void    SetComplete( Bool_t complete=kTRUE) { fComplete = complete; }
+
+  Int_t          GetEntriesN() const                 { return (Int_t)fEntries.size(); }
+  const Entry_t* GetEntry( Int_t anEvent) const      { return (anEvent>=0 && anEvent<(Int_t)fEntries.size()) ? &fEntries[anEvent] : 0; }
+  Bool_t         IsComplete() const                  { return fComplete; }
+  Int_t          FindTrigger( Int_t aTrigger) const;
+  Bool_t         GetChunk( Int_t iChunk, Int_t nChunks, Int_t &firstEvent, Int_t &lastEvent) const;
+
+  Bool_t  WriteToFile( const char *fileName) const;
+  Bool_t  ReadFromFile( const char *fileName);
+
+ private:
+  std::vector<Entry_t>   fEntries;        //! one entry per event
+  std::vector<Long64_t>  fFileSizes;      //! size of each raw file, -1 if missing
+  Bool_t                 fComplete;       // kTRUE once the whole run was indexed
+  Bool_t                 fTriggersSorted; // kTRUE while triggers are increasing, allows a binary search
+
+  ClassDef(DEventIndex,1)                 // Index of the events in raw files
+};
+
+#endif
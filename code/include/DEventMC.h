@@ -121,6 +121,12 @@ private:
   std::vector<NonSensitiveSimParticle_t>    ListOfNonSensitiveSimParticles;
   std::vector<NonSensitiveSimHit_t>         ListOfNonSensitiveSimHits;
   
+  //Work buffers for the truth matching, reused from one hit/track to the next
+  std::vector<int>            fMatchIdxList;   //!
+  std::vector<int>            fSortedIdxList;  //!
+  
+  void                    GetMostFrequentIdx(std::vector<int> &IdxList, int &BestIdx, int &BestCount);
+  
 public:
   
   DEventMC();
@@ -162,6 +168,10 @@ public:
   
   void                    DoTrackTruthMatching(DTrack* aTrack, int &MCPartID, int &NHitsMCPartID); //Truth matching of a reconstructed track
   
+  void                    DoHitsTruthMatching(int NHits, DHit** HitList);         //Truth matching of all the hits of a plane
+  
+  void                    DoTracksTruthMatching(int NTracks, DTrack** TrackList); //Truth matching of all the tracks
+  
   
 
   ClassDef(DEventMC,3)              // Describes EventMC
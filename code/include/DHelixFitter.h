@@ -36,6 +36,27 @@ class DHelixFitter: public TObject {
 private:
 static DHelixFitter* fgInstance;
 public:
+  // Fit methods available in GetHelixParameter
+  enum { kHelixFitAnalytic = 0, kHelixFitMinuit = 1 };
+  // Maximum number of points handled by the analytic fit (fixed-size buffers)
+  static const int kMaxFitPoints = 32;
+
+  struct HelixFitResult {
+    double Rho;        // signed curvature in the transverse plane [1/mm]
+    double Phi;        // direction at the point of closest approach to the origin [rad]
+    double D0;         // signed transverse distance of closest approach [mm]
+    double Z0;         // z at the point of closest approach [mm]
+    double TanLambda;  // dz/ds
+    double Xc;         // circle centre [mm]
+    double Yc;
+    double Radius;     // [mm]
+    double Pt;         // transverse momentum [GeV/c], positive for a clockwise track seen from +z with B>0
+    double Chi2Circle;
+    double Chi2Z;
+    int    NDF;
+    bool   IsValid;
+  };
+
   DHelixFitter (DTracker *Tracker);
   DLadder          *aLadder;
   DPlane           *aPlane;
@@ -79,8 +100,34 @@ public:
   TMinuit *ptMinuit;
   int iNum;
 
+  int              fFitMethod;     // kHelixFitAnalytic (default) or kHelixFitMinuit (validation)
+  bool             fRefineFit;     // apply one Gauss-Newton step on the analytic circle
+  int              fDebug;
+  double           fBField;        // [T], along z
+  double           fSigmaIP_RPhi;  // [mm], beam spot constraint
+  double           fSigmaIP_Z;
+  double           fSigmaHit_RPhi; // [mm], hit resolution
+  double           fSigmaHit_Z;
+  HelixFitResult   fLastFit;
+  // Work buffers of the analytic fit, no allocation per call
+  double           fFitX[kMaxFitPoints];
+  double           fFitY[kMaxFitPoints];
+  double           fFitZ[kMaxFitPoints];
+  double           fFitSigRPhi[kMaxFitPoints];
+  double           fFitSigZ[kMaxFitPoints];
+  double           fFitS[kMaxFitPoints];
+
   virtual  ~DHelixFitter ();
-  virtual TVector3 GetHelixParameter(vector<TVector3> ListOfHits);
+  virtual TVector3 GetHelixParameter(const vector<TVector3> &ListOfHits, int nPositions); // nPositions hits, then optionally the sensor indexes
+  virtual TVector3 GetHelixParameterMinuit(const vector<TVector3> &ListOfHits, int nPositions);
+  virtual TVector3 GetHelixParameterAnalytic(const vector<TVector3> &ListOfHits, int nPositions);
+  virtual bool     FitHelixAnalytic(int nPoints, const double *x, const double *y, const double *z, const double *sigRPhi, const double *sigZ, HelixFitResult &result);
+  void             SetFitMethod(int method)   { fFitMethod = method; }
+  int              GetFitMethod()             { return fFitMethod; }
+  void             SetRefineFit(bool refine)  { fRefineFit = refine; }
+  void             SetDebug(int level)        { fDebug = level; }
+  void             SetMagneticField(double b) { fBField = b; }
+  HelixFitResult  &GetLastFit()               { return fLastFit; }
   virtual TVector3 GetCircleParameters(TVector3 r1, TVector3 r2);
   virtual void     Helix_ChiSquare(Int_t &npar, Double_t *gin, Double_t &f, Double_t *par, Int_t iflag);
   virtual TMatrixD GetResidual(Double_t *par,int MeasurmentIndex );
@@ -0,0 +1,66 @@
+#ifndef _DHotPixelMask_included_
+#define _DHotPixelMask_included_
+
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DHotPixelMask                                   //
+  //                                                                      //
+  // Packed bit mask of the hot pixels of one plane.                      //
+  // Pixels are identified either by (line, column) or by their 1D        //
+  //  (DAQ) index, each identification has its own mask.                  //
+  // Testing a pixel costs one word access, whatever the number of        //
+  //  hot pixels.                                                         //
+  // The mask can be saved to and read back from a small binary file.     //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+// ROOT classes
+#include "TObject.h"
+
+class DHotPixelMask : public TObject {
+
+ public:
+  DHotPixelMask();
+  DHotPixelMask( Int_t nLines, Int_t nColumns);
+  virtual ~DHotPixelMask();
+
+  void    SetSize( Int_t nLines, Int_t nColumns);
+  void    Reset();
+  void    Fill( const std::vector<Int_t> &lines, const std::vector<Int_t> &columns, const std::vector<Int_t> &indexes);
+  void    SetHot( Int_t aLine, Int_t aColumn);
+  void    SetHotIndex( Int_t anIndex);
+
+  // O(1) tests
+  Bool_t  IsHot( Int_t aLine, Int_t aColumn) const {
+    if( aLine<0 || aLine>=fNLines || aColumn<0 || aColumn>=fNColumns ) return kFALSE;
+    UInt_t bit = (UInt_t)(aLine*fNColumns+aColumn);
+    return (fMask2D[bit>>5]>>(bit&31))&1;
+  }
+  Bool_t  IsHotIndex( Int_t anIndex) const {
+    if( anIndex<0 || (UInt_t)anIndex>=32*fMask1D.size() ) return kFALSE;
+    return (fMask1D[(UInt_t)anIndex>>5]>>(anIndex&31))&1;
+  }
+
+  Bool_t  IsEmpty() const                 { return fNHot2D==0 && fNHotIndex==0; }
+  Int_t   GetNHot() const                 { return fNHot2D; }
+  Int_t   GetNHotIndex() const            { return fNHotIndex; }
+  Int_t   GetNLines() const               { return fNLines; }
+  Int_t   GetNColumns() const             { return fNColumns; }
+
+  Bool_t  WriteToFile( const char *fileName) const;
+  Bool_t  ReadFromFile( const char *fileName);
+
+ private:
+  Int_t                fNLines;       // size of the (line, column) mask
+  Int_t                fNColumns;
+  std::vector<UInt_t>  fMask2D;       // bit line*fNColumns+column set for hot pixels
+  std::vector<UInt_t>  fMask1D;       // bit index set for hot pixels, extended when needed
+  Int_t                fNHot2D;       // number of hot pixels in fMask2D
+  Int_t                fNHotIndex;    // number of hot pixels in fMask1D
+
+  ClassDef(DHotPixelMask,1)           // Bit mask of hot pixels
+};
+
+#endif
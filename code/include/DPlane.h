@@ -49,6 +49,7 @@ class DCut;
 class DR3;
 class DSession;
 class DEventMC;
+class TMimosa24_25Map;
 // class DCMOSReader
 class DPlane : public TObject {
 
@@ -88,7 +89,8 @@ class DPlane : public TObject {
   Int_t        fChannelsN;                // number of channels in this plane
 
   DHit       **fHit;                      //! list of pointers to hits
-  DHit       **fHitUnTrackedLastEvent;    //Explicit   // VR 2014.08.28
+  Int_t       *fHitUnTrackedLastEvent;    //! slots in fHit of the untracked hits kept from the last event
+  Bool_t       fHitsUnTrackedParked;      //! kTRUE once the kept hits are moved to the carry area of fHit
   //DHit       **fHitMonteCarlo;        // list of pointer to Monte Carlo Hits. LC 2014/01/08
   Int_t        fHitsN;                    // number of hits found in plane (total)
   Int_t        fHitsUnTrackedLastEventN;  // number of hits not associated to a track in last event // VR 2014.08.28
@@ -96,11 +98,14 @@ class DPlane : public TObject {
   Int_t        fHitsOld;                  // number of untracked hits from previous event added to the list // VR 2014.08.28
 
   Int_t        fHitMax;                   // maximum number of hits allowed in plane
+  Double_t    *fAlignHitsInPlaneFrame;    //! hit positions (u,v,w) for AlignData, as many as slots in fHit
+  Double_t    *fAlignHitsInTrackerFrame;  //! same in the tracker frame
   Float_t      fCDSvariance;              // variance of signal distributon in the plane after CDS
   Float_t      fThreshold;                // a threshold for measuring occupancy
   Long_t        fOverThresholdN;           // the number of channels which exceed threshold
   Float_t      fOverThresholdC;           // the pulseheight sum on strips over threshold
   Int_t        fKeepUnTrackedHitsBetw2evts; //explicit // VR 2014.08.28
+  Int_t        fTruthMatching;              // 0 no MC truth matching, 1 done in Update, 2 deferred to DTracker::DoTruthMatching
 
   DCut        *fCut;
   TBRIK       *fGeometry;
@@ -109,6 +114,9 @@ class DPlane : public TObject {
   Int_t        fStatus;                   // 1=Primary, 2=Secondary Reference, or 3=Test Plane
   Int_t        fAnalysisMode;             // 0, 1=Strips, 2=Pixels
   Int_t        fReadout;                  // 1=normal (look Update() method)
+  Bool_t       (DPlane::*fUpdateReadout)(); //! pixel processing of the readout, chosen by SelectReadoutProcessor
+  TMimosa24_25Map *fMimosaMap;            //! channel map for readouts 24, 25, 124, 125
+  Int_t       *fMimosaLineOffset;         //! first line of each submatrix for readouts 25, 125, -1 if none
   Int_t        fTimeLimit;                // JB 2015/05/26
   Bool_t       fUseTimestamp;             // JB 2015/05/26
   Int_t        fMimosaType;               // RDM210509
@@ -196,6 +204,31 @@ class DPlane : public TObject {
   void         UpdatePedestalAndNoise();
   Bool_t       CheckSaturation();         // Checks if the event is saturated (both frames are at maximum -> CDS==0)
   void         FindNeighbours();           // finds neighbour pixels/strips for cluster building
+  void         ParkUnTrackedHits();        // moves the kept hits out of the slots of the new hits
+  void         SwapHits(Int_t aSlot1, Int_t aSlot2);
+
+  // pixel processing of Update, one per readout
+  void         SelectReadoutProcessor();
+  void         BuildMimosa25Map(const char *aChip);
+  Bool_t       UpdateReadout1();
+  Bool_t       UpdateReadout2();
+  Bool_t       UpdateReadout3();
+  Bool_t       UpdateReadout5();
+  Bool_t       UpdateReadout18();
+  Bool_t       UpdateReadout20();
+  Bool_t       UpdateReadout22();
+  Bool_t       UpdateReadout24();
+  Bool_t       UpdateReadout25();
+  Bool_t       UpdateReadout32();
+  Bool_t       UpdateReadout102();
+  Bool_t       UpdateReadout105();
+  Bool_t       UpdateReadout118();
+  Bool_t       UpdateReadout120();
+  Bool_t       UpdateReadout124();
+  Bool_t       UpdateReadout125();
+  Bool_t       UpdateReadout126();
+  Bool_t       UpdateReadout132();
+  Bool_t       UpdateReadout232();
 
   TRandom      fRandomGenerator;          // random generator (seed is set at initialization)
 
@@ -286,7 +319,8 @@ class DPlane : public TObject {
   DHit        *GetPrincipalHit();
 
   DHit        *GetHit(Int_t aHk)                   const { return  fHit[aHk-1];  }
-  DHit        *GetHitUnTrackedLastEvent(Int_t aHk) const { return  fHitUnTrackedLastEvent[aHk-1];  }// VR 2014.08.28
+  void         KeepUnTrackedHits();         // end of event, records the untracked new hits
+  void         AddUnTrackedHitsOfLastEvent(); // after the hit finding, appends the kept hits to the list
   //DHit        *GetHitMonteCarlo(Int_t aHk)  const {return fHitMonteCarlo[aHk-1]; }  // LC 2014/12/15
   Char_t      *GetPlaneName()               const { return  fPlaneName;   }
   Char_t      *GetPlanePurpose()            const { return  fPlanePurpose;}
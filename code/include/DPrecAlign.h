@@ -91,6 +91,17 @@ class DPrecAlign : public TObject  {
 
   Int_t DPrecAlignMethod;
 
+  // Transform cached from the matrices and angles by ComputeTransform,
+  //  in the orientation of the current method: uvw = fToPlane.(xyz-T), xyz = fToTracker.uvw+T
+  Double_t fToPlane[3][3];   //!
+  Double_t fToTracker[3][3]; //!
+  Double_t fTanTiltY;        //! tan(_fTh[1]), for the deformation
+  Bool_t   fFlippedTiltX;    //! _fTh[2] within 175 and 180 degrees, for the deformation
+
+  void     ComputeTransform();
+  void     HitToTracker( const Double_t *uvw, Double_t *xyz);
+  void     TrackToPlane( const Double_t *xyz, const Double_t *slope, Double_t *uvw);
+
 public:
   DPrecAlign();
   DPrecAlign(Int_t method);
@@ -136,6 +147,8 @@ public:
   DR3      TransformHitToPlane(DR3 xxx); // JB 2010/11/25
   DR3      TransformTrackToPlane();
   DR3      TransformTrackToPlane( Double_t tx, Double_t ty, Double_t tz, Double_t tdx, Double_t tdy);
+  void     TransformHitsToTracker( Int_t nHits, const Double_t *uvw, Double_t *xyz); // (u,v,w) and (x,y,z) triplets
+  void     TransformTracksToPlane( Int_t nTracks, const Double_t *origins, const Double_t *slopes, Double_t *uvw); // (x,y,z) origins, (dx/dz,dy/dz) slopes
   void     SetTrackPosition( DR3 xxx); // JB 2010/11/25
   DR3      GetTrackPosition();
   DR3      GetTrackSlope();
@@ -167,7 +180,7 @@ public:
   void  SetDebug(Int_t aDebug){fDebugDPrecAlign = aDebug;}
   Int_t GetDebug()    { return fDebugDPrecAlign;}
 
-  void        SetDPrecAlignMethod(Int_t method) { DPrecAlignMethod=method; } // LC 2015/01/31
+  void        SetDPrecAlignMethod(Int_t method) { DPrecAlignMethod=method; ComputeTransform(); } // LC 2015/01/31
   Int_t       GetDPrecAlignMethod() { return DPrecAlignMethod; }             // LC 2015/01/31
 
   ClassDef(DPrecAlign,2) // DPrecAlign
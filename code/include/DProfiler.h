@@ -0,0 +1,107 @@
+#ifndef _DProfiler_included_
+#define _DProfiler_included_
+
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DProfiler                                       //
+  //                                                                      //
+  // Lightweight instrumentation of the reconstruction chain.             //
+  // For each stage and each slot (plane number, or module type for the   //
+  //  decoding), the number of calls, the time spent (ns) and a free      //
+  //  counter (pixels, hits, tracks...) are accumulated.                  //
+  // Times are inclusive: track finding includes the track fitting.       //
+  // A scope nested in a scope of the same stage (a fit calling another   //
+  //  fit) is not counted again, nor are its counters.                    //
+  // The accumulators are atomic, planes may be updated by several        //
+  //  threads (DTracker::SetPlaneThreads).                                //
+  // The number of slots is set at initialisation by SetSlotsN (planes,   //
+  //  module types), values for other slots are counted as lost.         //
+  //                                                                      //
+  // Use the macros in the code:                                          //
+  //   TAF_PROFILE_SCOPE( DProfiler::kFindHits, fPlaneNumber);            //
+  //     times from this line to the end of the enclosing block,          //
+  //   TAF_PROFILE_COUNT( DProfiler::kFindHits, fPlaneNumber, fHitsN);    //
+  //     adds to the counter.                                             //
+  //                                                                      //
+  // Compiling with -DNOPROFILING (USEPROFILING=FALSE for make) removes   //
+  //  all the instrumentation.                                            //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <atomic>
+
+#include "Rtypes.h"
+#include "Riostream.h"
+
+class DProfiler {
+
+ public:
+  enum Stage_t { kDecode=0, kPlaneUpdate, kFindHits, kClustering, kTrackFinding, kTrackFitting, kVertexing, kFillTree, kStagesN };
+  // slot 0 is used for stages not related to a plane
+
+  // Times a stage from construction to destruction
+  class Scope {
+   public:
+    Scope( Int_t aStage, Int_t aSlot) : fStage(aStage), fSlot(aSlot), fOutermost( DProfiler::Enter( aStage)), fStart( std::chrono::steady_clock::now()) {}
+    ~Scope() {
+      if( fOutermost ) DProfiler::Add( fStage, fSlot, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now()-fStart).count());
+      DProfiler::Leave( fStage);
+    }
+   private:
+    Int_t  fStage;
+    Int_t  fSlot;
+    Bool_t fOutermost;
+    std::chrono::steady_clock::time_point fStart;
+  };
+
+  static void   Add( Int_t aStage, Int_t aSlot, Long64_t nanoseconds) {
+    if( aSlot<0 || aSlot>=fgSlotsN ) { fgLost.fetch_add( 1, std::memory_order_relaxed); return; }
+    fgNanoseconds[aStage*fgSlotsN+aSlot].fetch_add( nanoseconds, std::memory_order_relaxed);
+    fgCalls[aStage*fgSlotsN+aSlot].fetch_add( 1, std::memory_order_relaxed);
+  }
+  static void   Count( Int_t aStage, Int_t aSlot, Long64_t aCount) {
+    if( IsNested( aStage) ) return;
+    if( aSlot<0 || aSlot>=fgSlotsN ) { fgLost.fetch_add( 1, std::memory_order_relaxed); return; }
+    fgCounts[aStage*fgSlotsN+aSlot].fetch_add( aCount, std::memory_order_relaxed);
+  }
+
+  static void   SetSlotsN( Int_t nSlots); // at initialisation only, never shrinks
+  static Int_t  GetSlotsN()                                  { return fgSlotsN; }
+  static void   Reset();
+  static Bool_t IsEmpty();
+  static const char* GetStageName( Int_t aStage);
+  static Long64_t GetNanoseconds( Int_t aStage, Int_t aSlot) { return fgNanoseconds[aStage*fgSlotsN+aSlot].load( std::memory_order_relaxed); }
+  static Long64_t GetCalls( Int_t aStage, Int_t aSlot)       { return fgCalls[aStage*fgSlotsN+aSlot].load( std::memory_order_relaxed); }
+  static Long64_t GetCounts( Int_t aStage, Int_t aSlot)      { return fgCounts[aStage*fgSlotsN+aSlot].load( std::memory_order_relaxed); }
+  static Long64_t GetLost()                                  { return fgLost.load( std::memory_order_relaxed); }
+
+  static void   Print( ostream &stream=cout);
+  static Bool_t WriteJSON( const char *fileName);
+  static void   WriteHistograms(); // in the current ROOT directory
+
+ private:
+  // nesting depth of each stage in the calling thread
+  static Bool_t Enter( Int_t aStage);
+  static void   Leave( Int_t aStage);
+  static Bool_t IsNested( Int_t aStage);
+
+  static Int_t                  fgSlotsN;
+  static std::atomic<Long64_t> *fgNanoseconds; // [kStagesN*fgSlotsN]
+  static std::atomic<Long64_t> *fgCalls;
+  static std::atomic<Long64_t> *fgCounts;
+  static std::atomic<Long64_t>  fgLost;        // values for a slot out of range
+
+};
+
+#ifndef NOPROFILING
+#define TAF_PROFILE_CONCAT_(a,b) a##b
+#define TAF_PROFILE_CONCAT(a,b) TAF_PROFILE_CONCAT_(a,b)
+#define TAF_PROFILE_SCOPE(stage,slot) DProfiler::Scope TAF_PROFILE_CONCAT(tafProfileScope_,__LINE__)( stage, slot)
+#define TAF_PROFILE_COUNT(stage,slot,n) DProfiler::Count( stage, slot, n)
+#else
+#define TAF_PROFILE_SCOPE(stage,slot)
+#define TAF_PROFILE_COUNT(stage,slot,n)
+#endif
+
+#endif
@@ -42,6 +42,12 @@ class DSession : public TObject {
   Int_t          fStatus;                      // Status, 0 = initalizing, >= 1 aligning, running
   Int_t          fEventsToDo;                  // number of events to read from tape/file
   Int_t          fCurrentEventNumber;	       // actual event number // VR 2014/07/13 renamed
+  Int_t          fFirstEvent;                  // first event written in the DSF, see SetEventRange
+  Int_t          fWarmUpEvents;                // events reconstructed before fFirstEvent but not written
+  Int_t          fChunkId;                     // rank of this production among fChunksN
+  Int_t          fChunksN;                     // number of productions sharing the run
+  Int_t          fEventsLooped;                // events reconstructed by Loop in the range
+  Int_t          fLastEvent;                   // last event reconstructed by Loop
   Int_t          fRunNumber;                   // the run number
   TString        fConfigPath;                  // the path to the directory that contains telescope configuration files
   TString        fConfigFileName;              // name of the configuration file
@@ -66,6 +72,12 @@ class DSession : public TObject {
   TTree         *fEventTree;                   // pointer to the Tree
   Int_t          fFillLevel;                   // controls amount of info stored in Tree, JB 2011/07/21
   Int_t          fEventBuildingMode;           // To switch externally EventBuildingMode. SS 2011.11.14
+  TString        fDSFCompression;              // DSF compression algorithm, "" to use the config file
+  Int_t          fDSFCompressionLevel;         // DSF compression level, -1 to use the config file
+  Int_t          fDSFBasketSize;               // DSF basket size, -1 to use the config file
+  Int_t          fDSFAutoFlush;                // DSF tree auto-flush, 0 to use the config file
+  Int_t          fDSFThreads;                  // DSF compression threads, -1 to use the config file
+  Bool_t         fImplicitMTStarted;           // implicit MT enabled by MakeTree, stopped by Finish
 
   Double_t    fTrackLimitsForAlignX[2];        // min-max in X for tracks used in alignment procedure, JB 2013/06/10
   Double_t    fTrackLimitsForAlignY[2];        // min-max in Y for tracks used in alignment procedure, JB 2013/06/10
@@ -88,6 +100,8 @@ class DSession : public TObject {
   Bool_t         NextRawEvent( Int_t aTrigger=-1); // get next event from run
   Int_t          GoToEvent(Int_t anEvent);      // Specific method to ask the DAQ for a given event // VR 2014/07/13
   Int_t          GoToNextEvent(void);           // Specific method to ask the DAQ for a given event // VR 2014/07/13
+  Int_t          GoToTrigger(Int_t aTrigger);   // go to the event carrying this trigger, needs an event index
+  Bool_t         SkipRawEvents(Int_t nEvents);  // skip events without decoding them when possible
   void           ResetDaq();                    // Restart event reading from the beginning, JB 2015/03/02
   void           Loop();                 // loop over events and fill .root
   void           SetPlaneToScan(Int_t aPlnb) {fPlaneToScan = aPlnb ;}
@@ -95,6 +109,7 @@ class DSession : public TObject {
   void           Finish();
   void           InitSession();
   void           FillTree();
+  void           WriteProductionInfo();   // event range and statistics in the DSF
 
   Int_t          GetDebug()                        { return fDebugSession;}
   DEvent        *GetEvent()                        { return  fEvent;      }
@@ -124,9 +139,16 @@ class DSession : public TObject {
   void           SetRunNumber(Int_t aRunNumber)    { fRunNumber  = aRunNumber;             }
   void           SetEvents(Int_t aNumberOfEvents)  { fEventsToDo += aNumberOfEvents;       }
   void 		       SetEventsToDo(Int_t aNumberOfEventsToDo) { fEventsToDo = aNumberOfEventsToDo;};//VR 2014/06/29
+  void           SetEventRange(Int_t firstEvent, Int_t lastEvent, Int_t warmUpEvents=0); // chunked production
+  void           SetChunk(Int_t chunkId, Int_t nChunks) { fChunkId = chunkId; fChunksN = nChunks; }
+  Int_t          GetFirstEvent()                   { return  fFirstEvent;                  }
+  Int_t          GetWarmUpEvents()                 { return  fWarmUpEvents;                }
+  Int_t          GetDefaultWarmUpEvents();
   void           SetStatus(Int_t aStatus)          { fStatus = aStatus;     cout << endl << "The Session status just changed to " << aStatus << endl;
 } // JB 2009/07/17
   void           SetFillLevel( Int_t aLevel)       { fFillLevel = aLevel; } // JB 2011/07/21
+  void           SetDSFCompression( const char *algorithm, Int_t level=-1, Int_t basketSize=-1, Int_t autoFlush=0, Int_t threads=-1);
+  static Int_t   GetCompressionAlgorithm( TString aName);
   void           SetEventBuildingMode (Int_t aEventBuildingMode) {fEventBuildingMode = aEventBuildingMode; } //SS 2011.11.14
 
   void           SetConfigPath(TString aConfigPath){ fConfigPath = aConfigPath; }
@@ -24,6 +24,7 @@
 #include "DSession.h"
 #include "DR3.h"
 #include "TSystem.h"
+#include <string>
 
 using namespace std;
 
@@ -70,7 +71,28 @@ class DSetup : public TObject {
   void         read_TStrings(TString &TheString, Int_t aLength);
   void         getRidOfLine();
   void         read_list(std::vector<Int_t>& arg);
-  ifstream     fConfigFileStream;
+
+  // The config file is read in one go and parsed from memory
+  Bool_t       loadConfigFile();
+  Bool_t       getChar(Char_t &c);
+  Bool_t       getNumberToken(Char_t *token, Int_t maxLength, Bool_t isFloat);
+  Bool_t       configEof()                        { return fConfigEof; }
+  std::string  fConfigBuffer;               //! content of the config file
+  size_t       fConfigPos;                  //! parsing position in fConfigBuffer
+  Bool_t       fConfigEof;                  //! parsing went past the end of fConfigBuffer
+  ULong64_t    fConfigHash;                 // hash of the config file content
+
+  // Optional cache of the results derived from external files (hot pixel lists),
+  // enabled when the TAF_CONFIG_CACHE environment variable gives a directory
+  TString      fCacheDir;
+  TString      hotPixelCacheFileName(int aPlaneNumber, TString HotPixelMapFile);
+  Bool_t       readHotPixelCache(int aPlaneNumber, TString HotPixelMapFile);
+  void         writeHotPixelCache(int aPlaneNumber, TString HotPixelMapFile);
+
+  // Time spent in the start-up phases [s]
+  Double_t     fTimeReadConfiguration;
+  Double_t     fTimePerformancesParams;
+  Double_t     fTimeHotPixels;
 
   TString      fConfigPath;                 // name of the configuration path
   TString      fConfigFileName;             // name of the configuration file
@@ -130,6 +152,10 @@ class DSetup : public TObject {
   TString      GetConfigPath()                    { return fConfigPath; }
 
   void         ReadConfiguration();
+  ULong64_t    GetConfigHash()                    { return fConfigHash; }
+  Double_t     GetTimeReadConfiguration()         { return fTimeReadConfiguration; }  // total, including the two below
+  Double_t     GetTimePerformancesParams()        { return fTimePerformancesParams; }
+  Double_t     GetTimeHotPixels()                 { return fTimeHotPixels; }
 
 
   struct AnalysisParameter_t {
@@ -210,6 +236,8 @@ class DSetup : public TObject {
     Int_t      HitMonteCarlo;          // Enable/Disable Hit Monte Carlo (Default = 0)
     Int_t      KeepUnTrackedHitsBetw2evts; // explicit // VR 2014.08.28
     Int_t      DPrecAlignMethod;        // Default : (0) Old method | (1) New method
+    Int_t      TruthMatching;           // MC truth matching: (0) none | (1) during reconstruction | (2) deferred
+    Int_t      PlaneThreads;            // threads updating the planes in parallel (ROOT implicit MT), 0 = sequential
     // For TracksFinder=2 :
     Int_t      TrackingPass;            // nb of pass in the tracking loop
     Int_t*     PreTrackHitsNbMinimum;   // explicit
@@ -376,6 +404,7 @@ class DSetup : public TObject {
     std::vector<Int_t> HotPixelList_lin;     //List of hot pixels: line
     std::vector<Int_t> HotPixelList_col;     //List of hot pixels: column
     std::vector<Int_t> HotPixelList_index;   //List of hot pixels: index
+    TString    HotPixelMaskFile;      // binary hot pixel mask (DHotPixelMask) applied during decoding
   };
 
   PlaneParameter_t  *pPlaneParameter;
@@ -423,6 +452,9 @@ class DSetup : public TObject {
     Float_t    AmpFactor; // JB,CB,PLR 2015/03/24
     UInt_t     Trailer; // JB,CB,PLR 2015/03/24
     TString    MCTreeName; //AP 2016/05/18
+    Int_t      MCCacheSize;           // TTreeCache size in MB for the MC trees, 0 = from the cluster size, <0 = no cache
+    Int_t      MCThreads;             // threads decompressing the MC tree baskets (ROOT implicit MT), 0 = none
+    Int_t      MCReadAheadFiles;      // files of the MC list read ahead of the current one
     Int_t      IfZeroSuppress;        // >0 if to suppress rawdata values below a threshold
     Int_t      ThresholdZero;         // threshold for zero suppression
   };
@@ -447,6 +479,11 @@ class DSetup : public TObject {
     Int_t      EndIndex;             // end index
     Int_t      NoiseRun;             // Run number of noise run YV 27/11/09
     Int_t      PixelGainRun;         // Run number of gain calibration JB 2018/07/04
+    Char_t     DSFCompression[tpsz]; // compression algorithm of the DSF: ZLIB, LZ4, ZSTD, LZMA, "" for ROOT default
+    Int_t      DSFCompressionLevel;  // compression level of the DSF (0 = no compression)
+    Int_t      DSFBasketSize;        // basket size (bytes) of the DSF tree branches
+    Int_t      DSFAutoFlush;         // auto-flush of the DSF tree (see TTree::SetAutoFlush), 0 for ROOT default
+    Int_t      DSFThreads;           // threads compressing the DSF baskets (ROOT implicit MT), 0 = none
     //    Int_t      FileCountOut;         // maximum number of files possible
   } RunParameter;
 
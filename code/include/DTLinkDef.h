@@ -30,6 +30,8 @@
 #pragma link C++ class    AliMIMOSA22RawStreamVASingle+;
 #pragma link C++ class    DecoderM18+;
 #pragma link C++ class    DecoderGeant+;
+#pragma link C++ class    DecoderMi26; // no streamer, for the interpreter only
+#pragma link C++ class    DecoderMi26::Hit_t;
 #pragma link C++ class    DSetup+;
 #pragma link C++ class    DAcq+;
 #pragma link C++ class    DTracker+;
@@ -52,12 +54,16 @@
 #pragma link C++ class    DataPoints+;
 #pragma link C++ class    DPrecAlign-; // custom streamer
 #pragma link C++ class    DPixel+;
+#pragma link C++ class    DHotPixelMask+;
+#pragma link C++ class    DEventIndex+;
 //#pragma link C++ class    DMonteCarlo+; // LC : 2014/12/15 : Removed
 #pragma link C++ class    DLadder+;
 //#pragma link C++ class    DHitMonteCarlo+; // LC : 2014/12/15 : Removed
 #pragma link C++ class    MiniVector+; // LC : 2014/12/19
 #pragma link C++ class    DBeaster+; // DC : 2017/03/08
 #pragma link C++ class    DHelixFitter+; // DC : 2017/07
+#pragma link C++ class    DVertexFitter+;
+#pragma link C++ class    DEtaTable+;
 #pragma link C++ class    DHelix+; // DC : 2017/09
 //#pragma link C++ class    BoardReaderIHEP+; // JB, 2018/06/20
 
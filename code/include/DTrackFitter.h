@@ -29,6 +29,7 @@ class DTrackFitter : public TObject {
   private:
 
   Bool_t    _multipleScatteringFit;
+  Int_t     _fitMethod;
 
   Int_t     _hitNumber;
   Int_t     _localAxisNumber;
@@ -38,11 +39,15 @@ class DTrackFitter : public TObject {
 
   TMatrixD* _derivativeTrackMatrix;
   
-  TMatrixD* _covarianceMatrix;
+  TMatrixD* _covarianceMatrix;           // dense covariances, allocated by the kFitDense fit only
   TMatrixD* _covarianceMatrixMS;
   
   TMatrixD*  _inverseCovarianceMatrix;
 
+  std::vector<Double_t> _hitVariances;   // resolution^2 of the U and V measurements
+  std::vector<Double_t> _pathLengths;    // along the track, from the first hit
+  Double_t  _pathSign;                   // +1 (-1) if the path lengths increase (decrease) with the hit index
+
   TMatrixD* _finalMatrix;
   TMatrixD* _inverseFinalMatrix;
 
@@ -65,6 +70,11 @@ class DTrackFitter : public TObject {
 
   public:
 
+  // Fit methods, both give the same parameters and covariance
+  //  kFitDense     : inversion of the covariance matrix of all the hits
+  //  kFitRecursive : filter along the hits, cost linear with their number
+  enum { kFitDense = 0, kFitRecursive = 1 };
+
   Double_t ComputeResidualDerivative_U_AboutTrackDirectionX(Int_t planeIndex, Double_t trackDirectionX, Double_t trackDirectionY, DR3 trackPoint);
   Double_t ComputeResidualDerivative_U_AboutTrackDirectionY(Int_t planeIndex, Double_t trackDirectionX, Double_t trackDirectionY, DR3 trackPoint);
 
@@ -89,12 +99,19 @@ class DTrackFitter : public TObject {
 
   void SetCovarianceMatrixToIdentity();
 
+  void  SetFitMethod(Int_t aMethod) { _fitMethod = aMethod; }
+  Int_t GetFitMethod() const        { return _fitMethod; }
+
+  void AllocateCovarianceMatrices();
   void SetCovarianceMatrixMS();
   void ComputeResidualsMS();
+  Bool_t ComputePathLengths();           // kFALSE if the hits are not ordered along the track
+  void ComputeResidualsMSRecursive();
 
   void ProcessHits();             // Fill Vectors and Matrices.
 
   void ComputeTrackParameters();  // Matrix Inversion included.
+  Bool_t ComputeTrackParametersRecursive();
   
   void RedefineTrackParameters();
 
@@ -104,6 +121,7 @@ class DTrackFitter : public TObject {
 
   DR3 GetTrackDirections();
   DR3 GetTrackOrigin();
+  const TMatrixD& GetTrackParametersCovariance() const { return *_inverseFinalMatrix; }
 
 };
 
@@ -23,6 +23,10 @@
 #include "DEventMC.h"
 
 #include "DBeaster.h"
+#include "DVertexFitter.h"
+#include <vector>
+
+namespace ROOT { class TThreadExecutor; }
 
 
 using namespace std;
@@ -35,7 +39,6 @@ class DAcq;
 class DLadder;
 class DEventMC;
 class DBeaster; //DC 2017/03/08
-void FCNAlignVertex(Int_t &n, Double_t *gin, Double_t &f, Double_t *par , Int_t iflag); //LC. 2012/12/13.
 
 class DTracker : public TObject {
 
@@ -50,6 +53,7 @@ class DTracker : public TObject {
   DTrack          *fTrackVoid;         // this is an "empty" track
 
   Int_t            fVertexMaximum;     // maximum number of vertex allowed, JB 2013/06/11
+  DVertexFitter    fVertexFitter;      //! vertex fit of the tracks of the event, reused from event to event
 
   DTrack         **fSubTrack;          // pointer to subtrack list, JB 2014/12/15
   Int_t            fSubTrackPlanesN;   // number of planes in subtrack, JB 2014/12/15
@@ -99,6 +103,9 @@ class DTracker : public TObject {
   Int_t**          fTrackingOrderExtTrack;
 
   Int_t            fKeepUnTrackedHitsBetw2evts; //explicit // VR 2014.08.28
+  Int_t            fPlaneThreads;      // threads updating the planes in parallel, 0 = sequential
+  ROOT::TThreadExecutor *fPlanePool;   //! pool of fPlaneThreads threads, created by SetPlaneThreads
+  std::vector<Int_t> fPlaneUpdateStatus; //! return of DPlane::Update for each plane of the event
   Double_t         fSearchMoreHitDistance;   // Max distance to associate a hit to a pre-track, VR 2014/06/29
 
   void             find_tracks_withStrips(); // finds the track in the strip-tracker
@@ -140,6 +147,9 @@ class DTracker : public TObject {
   enum             {kSimpleChi2, kKalman, kChi2MS}; // QL 2016/06/06
   Int_t            Update();
   Int_t            UpdateMC();
+  Int_t            UpdatePlanes( Int_t nPlanes=-1);            // DPlane::Update of the first planes, all by default
+  void             SetPlaneThreads( Int_t nThreads);
+  Int_t            GetPlaneThreads() const                    { return fPlaneThreads; }
   Int_t            GetAlignmentStatus()                       { return fAlignmentStatus; }
   void             SetAlignmentStatus(Int_t aStatusValue);
   void             SetRequiredHits(Int_t aNumber);
@@ -148,6 +158,7 @@ class DTracker : public TObject {
 
   DAcq            *GetAcq()                                   { return  fAcq;          }
   DBeaster        *GetBeaster()                               { return fBeaster;       }
+  DVertexFitter   *GetVertexFitter()                          { return &fVertexFitter; } // vertex of the last event, fit settings
   DSetup          *GetSetup()                                 { return  fc;            }
   DTrack          *GetTrack(Int_t aTN);
   DTrack          *GetSubTrack(Int_t aTN); // JB 2014/12/15
@@ -170,7 +181,7 @@ class DTracker : public TObject {
   Int_t            GetNDUT()                                  { return  fTestDevs; }
   Int_t           *GetListDUT()                               { return  fListTestDevs; }
   Int_t            GetTrackCount( Int_t i)                    { return  fTrackCount[i]; }
-  Int_t            GetTrackCountPerPlane( Int_t iPlane)       { if( iPlane<fPlanesN ) return  fTrackCountPerPlane[iPlane]; else return -1; }
+  Int_t            GetTrackCountPerPlane( Int_t iPlane)       { if( iPlane<=fPlanesN ) return  fTrackCountPerPlane[iPlane]; else return -1; }
 
   TNode           *GetNode()                                  { return  fTrackerNode;  }
 
@@ -190,8 +201,10 @@ class DTracker : public TObject {
   DEventMC*        GetMCInfoHolder()            { return MCInfoHolder;  }     // AP 2016/04/21 : Function to get the MCInfoHolder
 
   void             PrintStatistics(ostream &stream=cout); // JB 2009/09/09 // SS 2011/12/14
+  void             ResetStatistics();
 
   void             MCTracksTruthMatching(void);           //AP 2016/08/08: Function to perform the truth matching of the reconstructed tracks
+  void             DoTruthMatching(void);                 // Truth matching of hits and tracks, required when it is deferred (TruthMatching=2)
 
 /*
   static DTracker*& Instance() {
@@ -203,7 +216,6 @@ class DTracker : public TObject {
     return fgInstance;
   }
 */
-  void             fcn(Int_t &npar, Double_t *gin, Double_t &fValue, Double_t *x, Int_t iflag);
   static DTracker*& Instance()  { return fgInstance; }
 
   ClassDef(DTracker,1)                 // Describes DTracker
@@ -0,0 +1,91 @@
+#ifndef _DVertexFitter_included_
+#define _DVertexFitter_included_
+
+  ////////////////////////////////////////////////////////////
+  // Class Description of DVertexFitter                     //
+  //                                                        //
+  // Common vertex of straight tracks, used by              //
+  //  DTracker::find_vertex                                 //
+  //                                                        //
+  ////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "TObject.h"
+
+class TMinuit;
+
+class DVertexFitter : public TObject {
+
+ public:
+
+  // Fit methods available in Fit
+  enum { kVertexFitAnalytic = 0, kVertexFitMinuit = 1 };
+
+  DVertexFitter();
+  virtual ~DVertexFitter();
+
+  // tracks, given by a point and the slopes dx/dz, dy/dz
+  void             Clear( Option_t *opt="");
+  void             AddTrack( Double_t x0, Double_t y0, Double_t z0, Double_t slopeX, Double_t slopeY);
+  Int_t            GetTracksN() const                        { return (Int_t)fTracks.size(); }
+
+  // settings
+  void             SetFitMethod( Int_t aMethod)              { fFitMethod = aMethod; }
+  Int_t            GetFitMethod() const                      { return fFitMethod; }
+  void             SetResolution( Double_t position, Double_t slope=0.) { fPositionResolution = position; fSlopeResolution = slope; }
+  void             SetOutlierCut( Double_t aCut)             { fOutlierCut = aCut; }     // in sigma, <=0 no down-weighting
+  void             SetMaxIterations( Int_t anIterations)     { fMaxIterations = anIterations; }
+
+  // fit
+  Bool_t           Fit();
+  Bool_t           FitAnalytic();
+  Bool_t           FitMinuit();
+
+  // results
+  Bool_t           IsValid() const                           { return fValid; }
+  Double_t         GetX() const                              { return fVertex[0]; }
+  Double_t         GetY() const                              { return fVertex[1]; }
+  Double_t         GetZ() const                              { return fVertex[2]; }
+  Double_t         GetVertex( Int_t i) const                 { return fVertex[i]; }
+  Double_t         GetCovariance( Int_t i, Int_t j) const    { return fCovariance[i][j]; }
+  Double_t         GetChi2() const                           { return fChi2; }
+  Int_t            GetIterations() const                     { return fIterations; }
+  Double_t         GetTrackWeight( Int_t iTrack) const       { return fTracks[iTrack].weight; } // outlier down-weighting factor, 1 if none
+  Double_t         GetTrackDistance( Int_t iTrack) const;   // from the vertex
+
+  static DVertexFitter*& Instance()                          { return fgInstance; }
+  void             MinuitFcn( Int_t &npar, Double_t *gin, Double_t &fValue, Double_t *x, Int_t iflag);
+
+ private:
+
+  struct Track_t {
+    Double_t origin[3];
+    Double_t direction[3];  // unit vector
+    Double_t slope[3];      // (dx/dz, dy/dz, 1)
+    Double_t weight;
+  };
+
+  Double_t         Distance2( const Track_t &aTrack, const Double_t *aPoint, Double_t &along) const;
+
+  static DVertexFitter *fgInstance;
+
+  std::vector<Track_t> fTracks;          //!
+  Int_t            fFitMethod;
+  Double_t         fPositionResolution;  // track resolution at the vertex
+  Double_t         fSlopeResolution;     // increase of the resolution with the distance to the track origin
+  Double_t         fOutlierCut;          // normalized distance beyond which a track is down-weighted
+  Int_t            fMaxIterations;
+
+  Bool_t           fValid;
+  Double_t         fVertex[3];
+  Double_t         fCovariance[3][3];
+  Double_t         fChi2;
+  Int_t            fIterations;
+
+  TMinuit         *fMinuit;              //! created on the first Minuit fit
+
+  ClassDef(DVertexFitter,1)              // Vertex of straight tracks
+
+};
+
+#endif
@@ -45,6 +45,9 @@ public:
 
   inline virtual ~DXRay2DPdf();
 
+  // pdf values at n points (x,y), the geometry being computed once
+  void EvaluateBatch(Int_t n, const Double_t *xValues, const Double_t *yValues, Double_t *values) const;
+
 
 protected:
 
@@ -69,6 +72,22 @@ protected:
 
 private:
 
+  enum { kNpeak = 5, kCacheParametersN = 16 };
+
+  Bool_t   UpdateGeometry() const;
+  Double_t EvaluatePoint(Double_t xVal, Double_t yVal) const;
+
+  // quantities depending only on the parameters, see UpdateGeometry
+  mutable Bool_t   fGeometryValid;                          //!
+  mutable Double_t fGeometryParameters[kCacheParametersN];  //! parameter values of the geometry
+  mutable Double_t fCosPhi, fSinPhi;                        //!
+  mutable Double_t fCosAlpha, fSinAlpha;                    //!
+  mutable Double_t fX0t, fAveYt, fGamma;                    //!
+  mutable Double_t fBetaOverRadius, fFactor2;               //!
+  mutable Double_t fSqrt2Sigma, fNormalisation;             //!
+  mutable Int_t    fBandsN;                                 //! number of bands of non zero width
+  mutable Double_t fXhigh[kNpeak], fXlow[kNpeak];           //! their edges, rotated frame
+
   ClassDef(DXRay2DPdf,1) // 2D pdf for X-ray data
 };
  
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include "BoardReaderBuffer.h"
 
 using namespace std;
 
@@ -24,8 +25,7 @@ class DecoderM18: public TObject {
     ~DecoderM18() {};
 
     void    SetInputFile(const char *filename="data.txt"){
-      fFileInput = fopen(filename,"rb");
-      if( fFileInput) {
+      if( fFileInput.Open(filename) ) {
         printf("your file %s is ok!! .... pay attention--> read option: rb \n", filename); 
       }
       else {
@@ -79,7 +79,7 @@ class DecoderM18: public TObject {
     Bool_t ReadCDH();
 
     Int_t fNEvent;
-    FILE *fFileInput;
+    BoardReaderBuffer fFileInput; //! block-buffered input file
     UInt_t fDataChar;
     Int_t fcountEv; //counter incremented when reading CDH
     Int_t fEvCounterCDH; // counter read in CDH
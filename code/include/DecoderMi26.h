@@ -0,0 +1,85 @@
+#ifndef _DecoderMi26_included_
+#define _DecoderMi26_included_
+
+// --------------------------------------------------------------------------------------
+//
+// Decoder of the zero-suppressed data of one Mimosa26 (or Mimosa28) frame.
+//
+// The data of one sensor in a frame is a list of 16 bits words:
+//  - a StatesLine word: number of states (4 bits), line (11 bits), overflow (1 bit),
+//  - followed by as many State words: number of hits-1 (2 bits), column (11 bits).
+// A state codes HitNb+1 consecutive fired pixels starting at the column.
+// The last word of the data is a dummy one.
+//
+// Decode() appends the fired pixels, as (line, column) pairs,
+//  to a vector reused from one frame to the next,
+//  the overflowed lines are listed apart.
+// Only the lines inside a window are kept (event building on a trigger line),
+//  and the pixels set in the veto bit mask are dropped.
+//
+// The statistics on the number of states per line and per block
+//  (used for the occupancy histograms of the readers) are optional.
+//
+// No ROOT dependency, so that it can be used and benchmarked standalone,
+//  see macros/DecoderMi26Benchmark.C.
+//
+// --------------------------------------------------------------------------------------
+
+#include <vector>
+
+class DecoderMi26 {
+
+ public:
+
+  struct Hit_t {
+    unsigned short line;
+    unsigned short column;
+  };
+
+  enum { kMaxStatesPerLine = 15, kStatBlocks = 18, kAllLines = 0xFFFF };
+
+  DecoderMi26( int nLines=576, int nColumns=1152);
+  ~DecoderMi26() {}
+
+  // Keep the lines from firstLine to lastLine,
+  //  if firstLine>lastLine keep the lines >=firstLine OR <=lastLine,
+  //  firstLine=lastLine=kAllLines keeps no line (overflows and statistics only).
+  // Returns the number of hits added, -1 if the data are truncated.
+  int     Decode( const unsigned short *words, int nWords, int firstLine=0, int lastLine=kAllLines);
+
+  std::vector<Hit_t>& GetHits()                        { return fHits; }
+  std::vector<int>&   GetOverflowLines()               { return fOverflowLines; }
+  void    ClearHits()                                  { fHits.clear(); fOverflowLines.clear(); }
+
+  void    SetVeto( int aLine, int aColumn);
+  void    ClearVeto();
+  bool    IsVetoed( int aLine, int aColumn) const;
+  int     GetVetoedPixelsN() const                     { return fVetoedN; }
+
+  void    SetStatistics( bool statistics)              { fStatistics = statistics; }
+  bool    GetStatistics() const                        { return fStatistics; }
+  void    ResetStatistics();
+  // number of lines with n states, n=0 to kMaxStatesPerLine
+  long long GetLinesWithStates( int n) const           { return (n>=0 && n<=kMaxStatesPerLine) ? fLineOccupancy[n] : 0; }
+  // number of (line, block) pairs with n states, n=0 to kMaxStatesPerLine
+  long long GetBlocksWithStates( int n) const          { return (n>=0 && n<=kMaxStatesPerLine) ? fBlockOccupancy[n] : 0; }
+
+ private:
+
+  int                        fLines;
+  int                        fColumns;
+  int                        fWordsPerLine;   // 64 bits words of the veto mask per line
+  std::vector<unsigned long long> fVetoMask;  // one bit per pixel, padded by one word per line
+  std::vector<unsigned char> fLineVetoed;     // 1 if at least one pixel of the line is vetoed
+  int                        fVetoedN;
+
+  bool                       fStatistics;
+  long long                  fLineOccupancy[kMaxStatesPerLine+1];
+  long long                  fBlockOccupancy[kMaxStatesPerLine+1];
+
+  std::vector<Hit_t>         fHits;
+  std::vector<int>           fOverflowLines;
+
+};
+
+#endif
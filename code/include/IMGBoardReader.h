@@ -16,6 +16,8 @@
 #else
   #include "event_header.typ"
 #endif
+#include "DEventIndex.h"
+#include "BoardReaderPixelSink.h"
 
 using namespace std;
 
@@ -119,6 +121,7 @@ class IMGBoardReader : public TObject {
   int               maxNumberOfTriggersPerEvent;
  std::vector<int>       ListOfFrames;
  std::vector<IMGPixel>  ListOfPixels;
+  BoardReaderPixelSink *PixelSink; //! receives the pixels instead of ListOfPixels if set
 
   // management of input files
   ifstream          RawFileStream;
@@ -132,10 +135,19 @@ class IMGBoardReader : public TObject {
   bool              NoMoreFile;
   int               EventsInFile; // JB 2012/08/18
 
+  // index of the events in the files, see InitEventIndex
+  DEventIndex       EventIndex; //!
+  char             *IndexFileName;
+  bool              IndexLoaded; // true if the index was read from the sidecar file
+  int               NextEventPosition; // rank in the run of the next buffer to read
+
   // management of data buffer
   size_t            SizeOfEvent; // nb of bytes in an event
   char             *Data;
   int               Endianness;       // 0= do not swap bytes, 1= swap bytes
+  bool              BulkUnpack;       //! unpack whole blocks of values when the layout allows, see GetInputData
+  bool              BulkUnpackChecked; //! bulk unpacking compared to BuildValue on the first event
+ std::vector<unsigned int> UnpackedValues; //! values of one input
 
   int      EventTrailer;
   TEventHeader     *EventHeader;
@@ -178,13 +190,21 @@ class IMGBoardReader : public TObject {
   bool         OpenRawFile(const char *fileName);
   bool         LookUpRawFile();
   bool         GetNextBuffer();
+  void         InitEventIndex();
+  bool         SeekPosition( int fileNumber, Long64_t offset, int eventPosition);
   bool         SetBufferPointers();
   void         GetInputData( int mode=0);
   void         GetTriggerData();
   int          DecodeTriggerFromData( int input, int rowNumber, unsigned int *rawdatas, int nFrames); // 2013/06/19
   unsigned int BuildValue( int anAddress, int wordSize );
+  bool         IsBulkUnpackInput( int input, int mode);
+  bool         GetInputDataBulk( int input);
   void         AddPixel( int input, unsigned int rawdata, int index);
   void         AddPixel( int input, unsigned int *rawdatas, int nFrames, int index); // JB 2013/06/19
+  void         StorePixel( int input, int value, int index, int timestamp=0) {
+    if( PixelSink ) PixelSink->AddPixel( input, value, index, timestamp);
+    else ListOfPixels.push_back( IMGPixel( input, value, index, timestamp));
+  }
 
   int          NumberOfColumns;             //AP, 2016/08/22
   int          IfZeroSupress; // JB 2017/11/20
@@ -192,7 +212,7 @@ class IMGBoardReader : public TObject {
 
   public:
 
-  IMGBoardReader() {;}
+  IMGBoardReader() { PixelSink = 0; BulkUnpack = true; BulkUnpackChecked = false; }
   IMGBoardReader( int boardNumber, int nInputs, int *nChannels, int sizeOfEvent, int eventsInFile, int headerSize, int trailerSize, int *numberOfBits, int *sigBits, int endian=0, int triggermode=0, int daqmode=0, int Ncolumns=64, int Nframes=5);
   ~IMGBoardReader();
   void         SetDebugLevel( int level)              { DebugLevel = level; cout << "IMGBoardReader " << BoardNumber << " debug updated to " << DebugLevel << endl;}
@@ -201,6 +221,9 @@ class IMGBoardReader : public TObject {
   bool         AddFileList(const char *prefixFileName, int startIndex, int endIndex,const char *suffixFileName);
   bool         HasData();
   void         SkipNextEvent();
+  bool         GoToEvent( int anEvent);
+  int          FindEventWithTrigger( int aTrigger)    { return EventIndex.FindTrigger( aTrigger); }
+  DEventIndex* GetEventIndex()                        { return &EventIndex; }
   int          GetBoardNumber()                       { return BoardNumber; }
   IMGEvent*    GetEvent()                             { return CurrentEvent; }
   int          GetEventNumber()                       { return CurrentEventNumber;}
@@ -215,6 +238,10 @@ class IMGBoardReader : public TObject {
   void         SetNumberOfColumns(int ColumnNum)      { NumberOfColumns = ColumnNum; return;}    //AP, 2016/08/22
   void         SetZeroSuppression(int aThreshold); // JB 2017/11/20
   int          GetZeroSuppression()                   { return ZeroThreshold; } // JB 2017/11/20
+  void         SetPixelSink( BoardReaderPixelSink *aSink) { PixelSink = aSink; } // 0 to store pixels in the event again
+  void         SetBulkUnpack( bool bulk)              { BulkUnpack = bulk; BulkUnpackChecked = false; }
+  void         UnpackValues( int anAddress, int secondAddress, int wordSize, int nValues, unsigned int mask, unsigned int *values);
+  bool         CheckUnpackValues( int anAddress, int secondAddress, int wordSize, int nValues, unsigned int mask);
 
   ClassDef(IMGBoardReader,1);
 };
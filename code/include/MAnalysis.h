@@ -51,6 +51,8 @@
 #endif
 #include "DTracker.h"
 #include "DPlane.h"
+#include "DHotPixelMask.h"
+#include "DEtaTable.h"
 #include "DAlign.h"
 #include "DHit.h"
 #include "DR3.h"
@@ -202,6 +204,29 @@ class MimosaAnalysis : public MHist {
   TH2F *h2HotPixelMap; // pointer to the histogram containing pixel hit rate
   Char_t HotPixelFileName[40];
   TFile *HotPixelFile; // pointer to file containing the previous histogram
+  DHotPixelMask fHotPixelMask; //! pixels out of the rate cuts, built from h2HotPixelMap
+
+  // ------------------------
+  // Parallel event loops
+  // ------------------------
+  static const Int_t kMaxParallelCounters = 20;
+  static const Int_t kMaxParallelStreams = 5;
+  static const Int_t kMaxParallelCarried = 5;
+  static const Int_t kMaxWorkers = 64;
+  Int_t fNWorkers; // number of processes sharing the event loops, 1 = sequential
+  Int_t fWorkerIndex; //! 0 for the main process
+  Int_t fWorkersN; //! number of workers actually running
+  Int_t fWorkerPid[kMaxWorkers]; //!
+  Int_t fWorkerFirstEvent[kMaxWorkers]; //!
+  Int_t fWorkerLastEvent[kMaxWorkers]; //!
+  TString fWorkerFilePrefix; //! temporary files exchanged with the main process
+  Int_t fParallelCountersN; //!
+  Int_t *fParallelCounter[kMaxParallelCounters]; //! counters local to the analysis method, summed over workers
+  Int_t fParallelCounterSize[kMaxParallelCounters]; //!
+  Int_t fParallelStreamsN; //!
+  ofstream *fParallelStream[kMaxParallelStreams]; //! text outputs, concatenated in event order
+  Int_t fParallelCarriedN; //!
+  Int_t *fParallelCarried[kMaxParallelCarried]; //! values carried from event to event, resolved between ranges
 
   // ------------------------
   // cuts
@@ -582,6 +607,15 @@ class MimosaAnalysis : public MHist {
   Int_t HotPixel_test( Int_t aPixelIndex);
   void HotPixel_end( Int_t eventsRead);
 
+  // Parallel event loops
+  // the event range is shared between fNWorkers processes
+  void ParallelLoop_addCounter( Int_t *aCounter, Int_t aSize=1);
+  void ParallelLoop_addStream( ofstream *aStream);
+  void ParallelLoop_addCarried( Int_t *aValue);
+  static Int_t ParallelLoop_carriedTag( Int_t iCarried) { return -1000000000-iCarried; }
+  Int_t ParallelLoop_init( Int_t &firstEvent, Int_t &lastEvent);
+  void ParallelLoop_end();
+
   // Check what crown the pixel belongs to //clm 2013/01/23
   Bool_t IsPixelIn1stCrown(Int_t lin, Int_t col);
   Bool_t IsPixelIn2ndCrown(Int_t lin, Int_t col);
@@ -614,6 +648,7 @@ class MimosaAnalysis : public MHist {
   // Internal tool methods
 
   void       GetMiEta();
+  void       BuildEtaTables( DEtaTable *tables, const Float_t **lists, Int_t listN, Bool_t readCorPar); // see fEtaTables
   // void       StoreEta() ;  // replaced by CreateNewEta, JB 2011/06/19
   void       GetAlignment(); // JB 2011/06/19
   Int_t      GetHitMapReadOpt()                  { return Option_read_Pixel_map;}
@@ -631,12 +666,16 @@ class MimosaAnalysis : public MHist {
   void       SetMimosaType(Int_t aMimosaType)    { MimosaType  = aMimosaType;}
   Int_t      GetAlignStatus()                    { return fSession->GetTracker()->GetAlignmentStatus(); }
   void       SetDebug(Int_t aMimoDebug);
+  Int_t      GetNWorkers()                       { return fNWorkers;}
+  void       SetNWorkers(Int_t aNumber)          { fNWorkers = (aNumber<1) ? 1 : ((aNumber>kMaxWorkers) ? kMaxWorkers : aNumber);}
   void       SetAlignStatus(Int_t aStatus)       { fSession->GetTracker()->SetAlignmentStatus( aStatus); } // See DTracker
 
   Double_t   GetCUT_MaxHitRatePerPixel()               { return CUT_MaxHitRatePerPixel;}
   Double_t   GetCUT_MinHitRatePerPixel()               { return CUT_MinHitRatePerPixel;}
   void       SetCUT_MaxHitRatePerPixel(Double_t aRate) { CUT_MaxHitRatePerPixel = aRate;}
   void       SetCUT_MinHitRatePerPixel(Double_t aRate) { CUT_MinHitRatePerPixel = aRate;}
+  Double_t   GetEtaTableTolerance()                    { return fEtaTableTolerance;}
+  void       SetEtaTableTolerance(Double_t aTolerance) { fEtaTableTolerance = aTolerance;} // um, 0 for the exact eta corrections, before GetMiEta
 
   void       InitMimosaType()                    {  MimosaType = (Int_t)(RunNumber/1000.); if(RunNumber==2110)  MimosaType=4; else if(RunNumber<1000) MimosaType = 99;} // JB 2012/05/04 deal with RunNumber<1000 case
 
@@ -730,6 +769,11 @@ class MimosaAnalysis : public MHist {
   TArrayF READListe_CoGV_eta5x5;
   Int_t READnListe_CoG_eta5x5;
 
+  // Tabulated eta corrections of the READListe above, used by ClusterPosition_eta
+  enum { kEta3x3U, kEta3x3V, kEta2x2U, kEta2x2V, kEta5x5U, kEta5x5V, kEtaTablesN };
+  DEtaTable fEtaTables[kEtaTablesN]; //!
+  Double_t fEtaTableTolerance; // maximal deviation (um) of the tables from the lists
+
   //  Int_t GetREADnListe_CoG()                    { return READnListe_CoG;                  }
   //  void  SetREADnListe_CoG(Int_t aREADnListe_CoG)    { READnListe_CoG  = aREADnListe_CoG;           }
 
@@ -776,7 +820,13 @@ class MimosaAnalysis : public MHist {
   void       AlignTrackerMillepede(Int_t nAlignEvents=4000);  // LC 2012/12/24.
 //  void        Gener(Double_t* xp, Double_t* yp, Double_t& aX, Double_t& bX, Double_t& aY, Double_t& bY, Double_t* sigX, Double_t* disX, Double_t* sigY, Double_t* disY, Double_t* z, Double_t* phi); // LC 2012/01/07
 
-  void       DSFProduction(Int_t NEvt = 500000, Int_t fillLevel=1);
+  void       DSFProduction(Int_t NEvt = 500000, Int_t fillLevel=1, const char *compression=0, Int_t compressionLevel=-1);
+  void       DSFProductionRange(Int_t firstEvent, Int_t lastEvent, Int_t fillLevel=1, Int_t warmUpEvents=-1);
+  void       DSFProductionChunk(Int_t chunkId, Int_t nChunks, Int_t NEvt = 500000, Int_t fillLevel=1, Int_t warmUpEvents=-1);
+  Bool_t     MergeDSFChunks(Int_t nChunks);
+  Bool_t     CompareDSF(const char *fileName1, const char *fileName2);
+  TString    GetDSFChunkFileName(Int_t chunkId, Int_t nChunks);
+  void       RunDSFProduction(Int_t fillLevel, const char *newFileName);
   void       StudyDeformation(const Float_t tiniBound = 480., Int_t nEvents=2000, Bool_t fitAuto=0); // BB 2014/05/20
 
 
@@ -112,6 +112,10 @@ public:
   
   void SetMCInforHolder(DEventMC* AnMCInfoHolder) {MCInfoHolder = AnMCInfoHolder;};
   
+  // Prefetching of the input trees: TTreeCache size in MB (0 = from the cluster size, <0 = no cache),
+  //  threads decompressing the baskets, files of the list read ahead of the current one
+  void SetPrefetch(int cacheSizeMB, int nThreads, int readAheadFiles);
+  
   void FillUpMCParticlesFromFrame(int TheFrame);  //AP, 2016/04/21. Fill up the particle list for frame TheFrame
   void FillUpMCInfoHolderForThisEvent(void);      //AP, 2016/04/21. Fill up the MCInfoHolder for the current event
   
@@ -141,6 +145,16 @@ private:
   TChain* fChain;
   Int_t   fCurrent; //!current Tree number in a TChain
   
+  //Prefetching
+  Long64_t fClusterBytes;      //! largest cluster (compressed bytes) of the input trees
+  Long64_t fCacheSize;         //! TTreeCache size in bytes, 0 for no cache
+  int      fReadAheadFiles;    //! files of the list read ahead of the current one
+  int      fReadAheadDone;     //! files of the list already read ahead
+  bool     fImplicitMTStarted; //! implicit MT enabled by SetPrefetch, stopped by the destructor
+  
+  void      PrepareTree();
+  void      ReadAheadFiles(int firstFile);
+  
   //The MC tree structure
   //Particles Branch
   Int_t    ParticleNb;
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <vector>
 #include "DGlobalTools.h" // to have fTool has a data member
+#include "DecoderMi26.h"
 using namespace std;
 
 
@@ -110,8 +111,7 @@ class PXIBoardReader : public TObject {
   int               EventsOverflow; // JB 2009/09/09
   int               EventsAborted; // JB 2009/09/16
   int               FramesReadTwice; // JB 2009/10/14
-  int               NStatesInBlock[100]; // up to 100 blocks
-  int               NStatesInLine; // up to 100 blocks
+  DecoderMi26       Mi26Decoder; //! decodes the frames and counts the states per line and block
   TH1S             *h1BlockOccupancy; // JB 2009/09/10
   TH1S             *h1LineOccupancy; // JB 2009/09/10
 
@@ -161,7 +161,7 @@ class PXIBoardReader : public TObject {
 
   unsigned int SwapEndian( unsigned int data);
 
-  ClassDef(PXIBoardReader,2);  
+  ClassDef(PXIBoardReader,3);  
 };
 
 # endif
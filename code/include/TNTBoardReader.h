@@ -9,6 +9,7 @@
 #include <vector>
 #include <math.h>
 #include "DGlobalTools.h" // to have fTool has a data member
+#include "BoardReaderBuffer.h"
 
 
 using namespace std;
@@ -101,7 +102,7 @@ class TNTBoardReader : public TObject {
  std::vector<int>       ListOfFrames;
  std::vector<TNTPixel>  ListOfPixels;
 
-  ifstream          RawFileStream;
+  BoardReaderBuffer RawFileStream; //! block-buffered input, handles the list of files
   char             *InputFileName;
   char*             PrefixFileName;
   char*             SuffixFileName;
@@ -152,7 +153,7 @@ class TNTBoardReader : public TObject {
   int          GetBoardNumber()                       { return BoardNumber; }
   TNTEvent*    GetEvent()                             { return CurrentEvent; }
   int          GetEventNumber()                       { return CurrentEventNumber;}
-  char*        GetInputFileName()                     { return InputFileName;}  //RDM300509
+  char*        GetInputFileName()                     { return (char*)RawFileStream.GetFileName();}  //RDM300509
   char*        GetSuffixFileName()                    { return SuffixFileName;} //RDM300509
   char*        GetPrefixFileName()                    { return PrefixFileName;} //RDM300509
   void         Close();
@@ -0,0 +1,263 @@
+// --------------------------------------------------------------------------------------
+//
+// Block-buffered input for the board readers, see BoardReaderBuffer.h
+//
+// The FILE is unbuffered (the block is the buffer) and read by blocks of fBlockSize bytes.
+// When the requested bytes straddle the end of the block,
+//  the remaining bytes are moved to the beginning of the block
+//  and the block is completed from the file, nothing is read twice.
+//
+// --------------------------------------------------------------------------------------
+
+#include "BoardReaderBuffer.h"
+#include <stdint.h>
+
+// --------------------------------------------------------------------------------------
+
+BoardReaderBuffer::BoardReaderBuffer( size_t blockSize) {
+
+  fLabel        = "BoardReaderBuffer";
+  fVerbose      = true;
+  fFileIndex    = -1;
+  fFile         = 0;
+  fFileSize     = 0;
+  fFilePosition = 0;
+
+  fBlockSize    = blockSize>kAlignment ? blockSize : (size_t)kAlignment;
+  fAllocated    = new char[fBlockSize+kAlignment];
+  fBlock        = fAllocated + (kAlignment - (uintptr_t)fAllocated%kAlignment)%kAlignment;
+  fBlockStart   = 0;
+  fBlockBytes   = 0;
+  fPosition     = 0;
+  fGood         = true;
+
+  fBytesRead    = 0;
+  fBlocksRead   = 0;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+BoardReaderBuffer::~BoardReaderBuffer() {
+
+  Close();
+  delete[] fAllocated;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::Open( const char *fileName) {
+
+  Close();
+  fFileNames.clear();
+  fFileNames.push_back( fileName);
+  return OpenFile( 0);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void BoardReaderBuffer::AddFile( const char *fileName) {
+
+  fFileNames.push_back( fileName);
+  if( !fFile && fFileIndex<0 ) OpenFile( 0);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::OpenNextFile() {
+
+  if( fFileIndex+1>=(int)fFileNames.size() ) return false;
+  return OpenFile( fFileIndex+1);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void BoardReaderBuffer::Close() {
+
+  if( fFile ) fclose( fFile);
+  fFile         = 0;
+  fFileSize     = 0;
+  fFilePosition = 0;
+  fBlockStart   = 0;
+  fBlockBytes   = 0;
+  fPosition     = 0;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::OpenFile( int index) {
+
+  Close();
+  fFileIndex = index;
+  fGood = true;
+
+  fFile = fopen( fFileNames[index].c_str(), "rb");
+  if( !fFile ) {
+    printf( "ERROR %s: file %s does not exist!\n", fLabel.c_str(), fFileNames[index].c_str());
+    fGood = false;
+    return false;
+  }
+  setvbuf( fFile, 0, _IONBF, 0);
+
+  fseeko( fFile, 0, SEEK_END);
+  fFileSize = ftello( fFile);
+  fseeko( fFile, 0, SEEK_SET);
+
+  if( fVerbose ) printf( "  --> %s New file %s (%lld bytes)\n", fLabel.c_str(), fFileNames[index].c_str(), fFileSize);
+
+  return true;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::FillBlock( long long position, size_t minBytes) {
+
+  // Load the block with the bytes of the current file from position,
+  //  return true if at least minBytes are available.
+
+  if( !fFile ) return false;
+
+  // keep the bytes already in memory
+  size_t kept = 0;
+  if( position>=fBlockStart && position<fBlockStart+(long long)fBlockBytes ) {
+    kept = fBlockBytes - (size_t)(position-fBlockStart);
+  }
+
+  if( minBytes>fBlockSize ) { // larger block needed
+    size_t newSize = ((minBytes+kAlignment-1)/kAlignment)*kAlignment;
+    char *allocated = new char[newSize+kAlignment];
+    char *block = allocated + (kAlignment - (uintptr_t)allocated%kAlignment)%kAlignment;
+    if( kept ) memcpy( block, fBlock+(position-fBlockStart), kept);
+    delete[] fAllocated;
+    fAllocated = allocated;
+    fBlock     = block;
+    fBlockSize = newSize;
+  }
+  else if( kept ) {
+    memmove( fBlock, fBlock+(position-fBlockStart), kept);
+  }
+
+  long long readFrom = position + kept;
+  if( fFilePosition!=readFrom ) {
+    fseeko( fFile, readFrom, SEEK_SET);
+    fFilePosition = readFrom;
+  }
+  size_t nRead = fread( fBlock+kept, 1, fBlockSize-kept, fFile);
+  fFilePosition += nRead;
+  fBytesRead += nRead;
+  fBlocksRead++;
+
+  fBlockStart = position;
+  fBlockBytes = kept + nRead;
+
+  return fBlockBytes>=minBytes;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::ReadSlow( void *destination, size_t nBytes) {
+
+  // Copy nBytes to destination, loading new blocks
+  //  and going to the next file of the list if needed.
+
+  if( !fGood ) return false;
+
+  char *out = (char*)destination;
+  while( nBytes>0 ) {
+    if( fPosition>=fBlockStart && fPosition<fBlockStart+(long long)fBlockBytes ) {
+      size_t available = (size_t)(fBlockStart+(long long)fBlockBytes-fPosition);
+      size_t n = nBytes<available ? nBytes : available;
+      memcpy( out, fBlock+(fPosition-fBlockStart), n);
+      out       += n;
+      nBytes    -= n;
+      fPosition += n;
+    }
+    else if( fFile && fPosition<fFileSize ) {
+      if( !FillBlock( fPosition, 1) ) { fGood = false; return false; }
+    }
+    else if( !OpenNextFile() ) {
+      fGood = false;
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+size_t BoardReaderBuffer::ReadSome( void *destination, size_t maxBytes) {
+
+  // Copy up to maxBytes to destination, going to the next file of the list if needed,
+  //  return the number of bytes copied, smaller than maxBytes only at the end of the last file.
+
+  if( !fGood ) return 0;
+
+  char *out = (char*)destination;
+  size_t done = 0;
+  while( done<maxBytes ) {
+    if( fPosition>=fBlockStart && fPosition<fBlockStart+(long long)fBlockBytes ) {
+      size_t available = (size_t)(fBlockStart+(long long)fBlockBytes-fPosition);
+      size_t n = maxBytes-done<available ? maxBytes-done : available;
+      memcpy( out+done, fBlock+(fPosition-fBlockStart), n);
+      done      += n;
+      fPosition += n;
+    }
+    else if( fFile && fPosition<fFileSize ) {
+      if( !FillBlock( fPosition, 1) ) break;
+    }
+    else if( !OpenNextFile() ) {
+      break;
+    }
+  }
+
+  return done;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+const char* BoardReaderBuffer::Peek( size_t nBytes) {
+
+  // Pointer to the next nBytes of the current file, loaded in memory,
+  //  valid until the next call to a reading method.
+  // The reading position is not moved, see Skip.
+
+  if( !fGood || !fFile ) return 0;
+  if( fPosition+(long long)nBytes>fFileSize ) return 0;
+  if( fPosition<fBlockStart || fPosition+(long long)nBytes>fBlockStart+(long long)fBlockBytes ) {
+    if( !FillBlock( fPosition, nBytes) ) return 0;
+  }
+  return fBlock + (fPosition-fBlockStart);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool BoardReaderBuffer::Seek( long long offset, int whence) {
+
+  // Move the reading position in the current file,
+  //  nothing is read before the next reading method.
+
+  if( !fGood ) return false;
+
+  long long target = offset;
+  if( whence==kCurrent ) target += fPosition;
+  else if( whence==kEnd ) target += fFileSize;
+
+  if( target<0 || target>fFileSize ) {
+    fGood = false;
+    return false;
+  }
+  fPosition = target;
+  return true;
+
+}
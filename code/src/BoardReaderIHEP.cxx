@@ -141,10 +141,10 @@ bool BoardReaderIHEP::AddFile(const char *fileName) {
   // Adapted from method sent on 2018/08/14
 
   /* Open the input Raw Data file, Data getting from FPGA, default txt in 18 32bit-words */
-  ifs_DataRaw.close();
-  ifs_DataRaw.clear();
-  ifs_DataRaw.open( fileName, ios::in|ios::binary);
-  if (!ifs_DataRaw.good())
+  // the file is read by large blocks, the decoding then works in memory
+  ifs_DataRaw.SetLabel( "BoardReaderIHEP");
+  ifs_DataRaw.SetVerbose( false);
+  if (!ifs_DataRaw.Open( fileName))
   {
     cout << "ERROR : Mi28DecodeLadderDataToRoot(), Failed to open input file: " << fileName << endl;
     return false;
@@ -154,12 +154,9 @@ bool BoardReaderIHEP::AddFile(const char *fileName) {
     cout << "INFO : BoardReaderIHEP::AddFile, Successfully open input file: " << fileName << endl;
   }
   /* Get the size of the binary file */
-  ifs_DataRaw.seekg(0, ios::beg);
-  vi_Pointer_FileBegin = ifs_DataRaw.tellg();
-  ifs_DataRaw.seekg(0, ios::end);
-  vi_Pointer_FileEnd = ifs_DataRaw.tellg();
+  vi_Pointer_FileBegin = 0;
+  vi_Pointer_FileEnd = ifs_DataRaw.GetFileSize();
   vi_N_FileSize = vi_Pointer_FileEnd - vi_Pointer_FileBegin;
-  ifs_DataRaw.seekg(0, ios::beg);
   cout << "INFO : Mi28DecodeLadderDataToRoot(), The input file size is : " << vi_N_FileSize << endl;
   cout << "------------------------------------------------------"   << endl;
 
@@ -247,14 +244,14 @@ bool BoardReaderIHEP::DecodeNextEvent()
   /* Hex in stream                 : 3412 7856 */
   /* Hex after SwitchDWordBytes2() : 1234 5678 */
   //while (!ifs_DataRaw.eof())
-  while (ifs_DataRaw.tellg() != vi_Pointer_FileEnd && !ready)
+  while (ifs_DataRaw.Tell() != vi_Pointer_FileEnd && !ready)
   {
     /* Input raw binary data */
-    if (ifs_DataRaw.good())
+    if (ifs_DataRaw.Good())
     {
         /* Check file size */
         /* The minimum case : Ladder_Header/Ladder_FrameCounter/Ladder_DataLength/Ladder_Trailer */
-        vi_Pointer_Data = ifs_DataRaw.tellg();
+        vi_Pointer_Data = ifs_DataRaw.Tell();
         if ((vi_Pointer_Data + 4*DWORD) > vi_Pointer_FileEnd)
         {
           cout << "  ERROR : Mi28DecodeLadderDataToRoot(), file is incomplete at !! Ladder_Header !!, STOP DECODING!" << endl;
@@ -263,8 +260,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
         /* ------------------------------------------------------ */
         /* Trigger_Header*/
-        ifs_DataRaw.read((char *)&vi_Trigger_Header, DWORD);
-        vi_Pointer_Data         = ifs_DataRaw.tellg();
+        ifs_DataRaw.Read(&vi_Trigger_Header, DWORD);
+        vi_Pointer_Data         = ifs_DataRaw.Tell();
         vi_Trigger_Header = SwitchDWordWords(vi_Trigger_Header);
         if (vi_Trigger_Header != M_LADDER_TriggerHeader)
         {
@@ -275,7 +272,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
                  << std::setw(11) << std::setbase(16) << M_LADDER_TriggerHeader  << "\t@\t"
                  << std::setw(15) << std::setbase(10) << vi_Pointer_Data   << endl;
           }
-          ifs_DataRaw.seekg(BYTE -DWORD, ios::cur); /* Return the Pointer */
+          ifs_DataRaw.Seek(BYTE -DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
          continue; /* Continue to Check Trigger_Header */
          }
          else
@@ -290,8 +287,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
         }
         /*-------------------------------------------------------*/
         /* Trigger ID */
-        ifs_DataRaw.read((char *)&vi_Trigger_ID, DWORD);
-        vi_Pointer_Data        = ifs_DataRaw.tellg();
+        ifs_DataRaw.Read(&vi_Trigger_ID, DWORD);
+        vi_Pointer_Data        = ifs_DataRaw.Tell();
         vi_Trigger_ID = SwitchDWordWords(vi_Trigger_ID);
         if (vi_Verbose < 6)
         {
@@ -302,8 +299,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
         }
         /*--------------------------------------------------------*/
         /*PackLength*/
-        ifs_DataRaw.read((char *)&vi_Pack_Length, DWORD);
-        vi_Pointer_Data      = ifs_DataRaw.tellg();
+        ifs_DataRaw.Read(&vi_Pack_Length, DWORD);
+        vi_Pointer_Data      = ifs_DataRaw.Tell();
         vi_Pack_Length = SwitchDWordWords(vi_Pack_Length);
         vi_Pointer_Pack_DataLength = vi_Pointer_Data;
         if (vi_Verbose < 6)
@@ -324,15 +321,15 @@ bool BoardReaderIHEP::DecodeNextEvent()
         }
         /*-----------------------------------------------------------*/
         /* Pack State*/
-          ifs_DataRaw.seekg(WORD, ios::cur);
+          ifs_DataRaw.Seek(WORD, BoardReaderBuffer::kCurrent);
         /*------------------------------------------------------------*/
          /* ------------------------------------------------------ */
         /*-------------------------------------------------------*/
         /* Trigger Trailer*/
-        ifs_DataRaw.seekg(vi_Pack_Length*BYTE, ios::cur);
-        ifs_DataRaw.read((char *)&vi_Trigger_Trailer, DWORD);
-        vi_Pointer_Data = ifs_DataRaw.tellg();
-        ifs_DataRaw.seekg(-vi_Pack_Length*BYTE - DWORD, ios::cur); /* Return the Pointer */
+        ifs_DataRaw.Seek(vi_Pack_Length*BYTE, BoardReaderBuffer::kCurrent);
+        ifs_DataRaw.Read(&vi_Trigger_Trailer, DWORD);
+        vi_Pointer_Data = ifs_DataRaw.Tell();
+        ifs_DataRaw.Seek(-vi_Pack_Length*BYTE - DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
         vi_Trigger_Trailer = SwitchDWordWords(vi_Trigger_Trailer);
         if (vi_Trigger_Trailer != M_LADDER_TriggerTRAILER)
         {
@@ -345,7 +342,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
           }
 
           /* Return to Pointer Ladder_DataLength, Continue a new Ladder_Frame */
-          ifs_DataRaw.seekg(BYTE - 3*DWORD, ios::cur); /* Return the Pointer */
+          ifs_DataRaw.Seek(BYTE - 3*DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
           continue; /* Continue to Check Trigger_Header */
         }
         else
@@ -363,7 +360,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
         /*-----------------------------------------------------------*/
         int  vi_N_Ladder      = 0;
         int vi_N_Ladder_Chip = 0;
-        while (ifs_DataRaw.tellg() < (vi_Pointer_Pack_DataLength + vi_Pack_Length*BYTE))
+        while (ifs_DataRaw.Tell() < (vi_Pointer_Pack_DataLength + vi_Pack_Length*BYTE))
         {
           /*-----------------------------------------------------------*/
           /* Pack State*/
@@ -371,8 +368,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
           /*------------------------------------------------------------*/
           /* ------------------------------------------------------ */
           /* Ladder_Header */
-          ifs_DataRaw.read((char *)&vi_Ladder_Header, DWORD);
-          vi_Pointer_Data    = ifs_DataRaw.tellg();
+          ifs_DataRaw.Read(&vi_Ladder_Header, DWORD);
+          vi_Pointer_Data    = ifs_DataRaw.Tell();
           vi_Ladder_Header_1 = SwitchDWordWords(vi_Ladder_Header);
           vi_ID_Ladder       = vi_Ladder_Header_1 & 0xFF;
           vi_Ladder_Header   = vi_Ladder_Header_1 >> 8;
@@ -387,7 +384,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
             }
 
             /* Pass the first BYTE, and Continue to Check Ladder_Header */
-            ifs_DataRaw.seekg(BYTE - DWORD, ios::cur); /* Return the Pointer */
+            ifs_DataRaw.Seek(BYTE - DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
             continue; /* Continue to Check Ladder_Header */
           }
           else
@@ -402,8 +399,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
           }
           /* ------------------------------------------------------ */
           /* Ladder_Trigger */
-          ifs_DataRaw.read((char *)&vi_Ladder_Trigger, DWORD);
-          vi_Pointer_Data        = ifs_DataRaw.tellg();
+          ifs_DataRaw.Read(&vi_Ladder_Trigger, DWORD);
+          vi_Pointer_Data        = ifs_DataRaw.Tell();
           vi_Ladder_Trigger = SwitchDWordWords(vi_Ladder_Trigger);
           if (vi_Verbose < 6)
           {
@@ -417,8 +414,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
           /* ------------------------------------------------------ */
           /* Ladder_FrameCounter */
-          ifs_DataRaw.read((char *)&vi_Ladder_FrameCounter, DWORD);
-          vi_Pointer_Data        = ifs_DataRaw.tellg();
+          ifs_DataRaw.Read(&vi_Ladder_FrameCounter, DWORD);
+          vi_Pointer_Data        = ifs_DataRaw.Tell();
           vi_Ladder_FrameCounter = SwitchDWordWords(vi_Ladder_FrameCounter);
           if (vi_Verbose < 6)
           {
@@ -454,8 +451,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
           /* ------------------------------------------------------ */
           /* Ladder_DataLength */
-          ifs_DataRaw.read((char *)&vi_Ladder_DataLength, DWORD);
-          vi_Pointer_Data      = ifs_DataRaw.tellg();
+          ifs_DataRaw.Read(&vi_Ladder_DataLength, DWORD);
+          vi_Pointer_Data      = ifs_DataRaw.Tell();
           vi_Ladder_DataLength = SwitchDWordWords(vi_Ladder_DataLength);
           vi_Pointer_Ladder_DataLength = vi_Pointer_Data;
           if (vi_Verbose < 6)
@@ -476,10 +473,10 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
           /* ------------------------------------------------------ */
           /* Ladder_Trailer */
-          ifs_DataRaw.seekg(vi_Ladder_DataLength*WORD, ios::cur);
-          ifs_DataRaw.read((char *)&vi_Ladder_Trailer, DWORD);
-          vi_Pointer_Data = ifs_DataRaw.tellg();
-          ifs_DataRaw.seekg(-vi_Ladder_DataLength*WORD - DWORD, ios::cur); /* Return the Pointer */
+          ifs_DataRaw.Seek(vi_Ladder_DataLength*WORD, BoardReaderBuffer::kCurrent);
+          ifs_DataRaw.Read(&vi_Ladder_Trailer, DWORD);
+          vi_Pointer_Data = ifs_DataRaw.Tell();
+          ifs_DataRaw.Seek(-vi_Ladder_DataLength*WORD - DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
           vi_Ladder_Trailer = SwitchDWordWords(vi_Ladder_Trailer);
           if (vi_Ladder_Trailer != M_LADDER_TRAILER)
           {
@@ -492,7 +489,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
             }
 
             /* Return to Pointer Ladder_DataLength, Continue a new Ladder_Frame */
-            ifs_DataRaw.seekg(BYTE - 4*DWORD, ios::cur); /* Return the Pointer */
+            ifs_DataRaw.Seek(BYTE - 4*DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
             continue; /* Continue to Check Ladder_Header */
           }
           else
@@ -510,12 +507,12 @@ bool BoardReaderIHEP::DecodeNextEvent()
           /* Recycling decode the data for less than 10 chips */
           /* ------------------------------------------------------ */
 
-          while (ifs_DataRaw.tellg() < (vi_Pointer_Ladder_DataLength + vi_Ladder_DataLength*WORD))
+          while (ifs_DataRaw.Tell() < (vi_Pointer_Ladder_DataLength + vi_Ladder_DataLength*WORD))
           {
             /* ------------------------------------------------------ */
             /* Ladder_Chip */
-            ifs_DataRaw.read((char *)&vi_Ladder_Chip, DWORD);
-            vi_Pointer_Data   = ifs_DataRaw.tellg();
+            ifs_DataRaw.Read(&vi_Ladder_Chip, DWORD);
+            vi_Pointer_Data   = ifs_DataRaw.Tell();
             vi_Ladder_Chip_1  = SwitchDWordWords(vi_Ladder_Chip);
             vi_ID_Ladder_Chip = vi_Ladder_Chip_1 & 0xF;
             vi_Ladder_Chip    = vi_Ladder_Chip_1 >> 4;
@@ -530,7 +527,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
               }
 
               /* Return to Pointer Ladder_Chip, Continue a new Ladder_Chip */
-              ifs_DataRaw.seekg(BYTE - DWORD, ios::cur); /* Return the Pointer */
+              ifs_DataRaw.Seek(BYTE - DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
               continue; /* Continue to Check Ladder_Chip */
             }
             else
@@ -546,8 +543,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
             /* ------------------------------------------------------ */
             /* Chip_Header */
-            ifs_DataRaw.read((char *)&vi_Chip_Header, DWORD);
-            vi_Pointer_Data = ifs_DataRaw.tellg();
+            ifs_DataRaw.Read(&vi_Chip_Header, DWORD);
+            vi_Pointer_Data = ifs_DataRaw.Tell();
             vi_Chip_Header  = SwitchDWordWords(vi_Chip_Header);
             if (vi_Chip_Header != M_CHIP_HEADER)
             {
@@ -560,7 +557,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
               }
 
               /* Return to Pointer Ladder_Chip, Continue a new Ladder_Chip */
-              ifs_DataRaw.seekg(BYTE - 2*DWORD, ios::cur); /* Return the Pointer */
+              ifs_DataRaw.Seek(BYTE - 2*DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
               continue; /* Continue to Check Ladder_Chip */
             }
             else
@@ -576,8 +573,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
             /* ------------------------------------------------------ */
             /* Chip_FrameCounter */
-            ifs_DataRaw.read((char *)&vi_Chip_FrameCounter, DWORD);
-            vi_Pointer_Data      = ifs_DataRaw.tellg();
+            ifs_DataRaw.Read(&vi_Chip_FrameCounter, DWORD);
+            vi_Pointer_Data      = ifs_DataRaw.Tell();
             vi_Chip_FrameCounter = SwitchDWordWords(vi_Chip_FrameCounter);
             if (vi_Verbose < 6)
             {
@@ -589,12 +586,12 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
             /* ------------------------------------------------------ */
             /* Chip_DataLength */
-            ifs_DataRaw.read((char *)&vi_Chip_DataLength_1, WORD);
-            ifs_DataRaw.read((char *)&vi_Chip_DataLength_2, WORD);
+            ifs_DataRaw.Read(&vi_Chip_DataLength_1, WORD);
+            ifs_DataRaw.Read(&vi_Chip_DataLength_2, WORD);
             vi_Chip_DataLength_1       = SwitchWordBytes(vi_Chip_DataLength_1);
             vi_Chip_DataLength_2       = SwitchWordBytes(vi_Chip_DataLength_2);
             vi_Chip_DataLength         = vi_Chip_DataLength_1 + vi_Chip_DataLength_2;
-            vi_Pointer_Data = ifs_DataRaw.tellg();
+            vi_Pointer_Data = ifs_DataRaw.Tell();
             vi_Pointer_Chip_DataLength = vi_Pointer_Data;
             if (vi_Verbose < 6)
             {
@@ -614,10 +611,10 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
             /* ------------------------------------------------------ */
             /* Chip_Trailer */
-            ifs_DataRaw.seekg(vi_Chip_DataLength*WORD, ios::cur);
-            ifs_DataRaw.read((char *)&vi_Chip_Trailer, DWORD);
-            vi_Pointer_Data = ifs_DataRaw.tellg();
-            ifs_DataRaw.seekg(-vi_Chip_DataLength*WORD - DWORD, ios::cur); /* Return the Pointer */
+            ifs_DataRaw.Seek(vi_Chip_DataLength*WORD, BoardReaderBuffer::kCurrent);
+            ifs_DataRaw.Read(&vi_Chip_Trailer, DWORD);
+            vi_Pointer_Data = ifs_DataRaw.Tell();
+            ifs_DataRaw.Seek(-vi_Chip_DataLength*WORD - DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
             vi_Chip_Trailer = SwitchDWordWords(vi_Chip_Trailer);
             if (vi_Chip_Trailer != M_CHIP_TRAILER)
             {
@@ -630,7 +627,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
               }
 
               /* Return to Pointer Ladder_Chip, Continue a new Ladder_Chip */
-              ifs_DataRaw.seekg(BYTE - 4*DWORD, ios::cur); /* Return the Pointer */
+              ifs_DataRaw.Seek(BYTE - 4*DWORD, BoardReaderBuffer::kCurrent); /* Return the Pointer */
               continue; /* Continue to Check Ladder_Chip */
             }
             else
@@ -647,11 +644,11 @@ bool BoardReaderIHEP::DecodeNextEvent()
             /* ------------------------------------------------------ */
             /*                   Deal with useful data                */
             /* ------------------------------------------------------ */
-            while (ifs_DataRaw.tellg() < (vi_Pointer_Chip_DataLength + vi_Chip_DataLength*WORD))
+            while (ifs_DataRaw.Tell() < (vi_Pointer_Chip_DataLength + vi_Chip_DataLength*WORD))
             {
               /* Chip_Status */
-              ifs_DataRaw.read((char *)&vi_DataRaw, WORD);
-              vi_Pointer_Data = ifs_DataRaw.tellg();
+              ifs_DataRaw.Read(&vi_DataRaw, WORD);
+              vi_Pointer_Data = ifs_DataRaw.Tell();
 
               vi_Chip_Status          = SwitchWordBytes(vi_DataRaw);
               vi_Chip_N_State         = vi_Chip_Status  & M_CHIP_N_STATE;
@@ -661,7 +658,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
 
               if (vi_Verbose < 3)
               {
-                vi_Pointer_Data = ifs_DataRaw.tellp();
+                vi_Pointer_Data = ifs_DataRaw.Tell();
                 cout << "  SSSSS" << endl;
                 cout << "  INFO : Status / Pointer_Status / N_State / Address_Line   is : "
                 << std::setw(12) << std::setbase(16) << vi_Chip_Status
@@ -707,7 +704,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
                 unsigned long int M_AAAA=0xAAAA;
                 for(int i_word=0;i_word<100;i_word++)
                 {
-                  ifs_DataRaw.read((char *)&Checking_Stata, WORD);
+                  ifs_DataRaw.Read(&Checking_Stata, WORD);
                   Checking_Stata=SwitchWordBytes(Checking_Stata);
                   if(Checking_Stata == M_AAAA)
                   {
@@ -716,7 +713,7 @@ bool BoardReaderIHEP::DecodeNextEvent()
                       // << std::setbase(10) << vi_Chip_N_State    << " + "<< std::setbase(10) <<i_word<<" VS "
                       // << std::setbase(10) << (vi_Pointer_Chip_DataLength + vi_Chip_DataLength*WORD)
                       // << endl;
-                    ifs_DataRaw.seekg( - WORD, ios::cur);
+                    ifs_DataRaw.Seek( - WORD, BoardReaderBuffer::kCurrent);
                     break;
                   }
                 }
@@ -742,8 +739,8 @@ bool BoardReaderIHEP::DecodeNextEvent()
               for (unsigned long int iState=0; iState<vi_Chip_N_State; iState++)
               {
                 /* Chip_State */
-                ifs_DataRaw.read((char *)&vi_DataRaw, WORD);
-                vi_Pointer_Data = ifs_DataRaw.tellp();
+                ifs_DataRaw.Read(&vi_DataRaw, WORD);
+                vi_Pointer_Data = ifs_DataRaw.Tell();
 
                 vi_Chip_State           = SwitchWordBytes(vi_DataRaw);
                 vi_Chip_N_Pixel         = vi_Chip_State  & M_CHIP_N_PIXEL;
@@ -828,12 +825,12 @@ bool BoardReaderIHEP::DecodeNextEvent()
                 } // End of 'for (unsigned long int iPixel=0; iPixel<vi_Chip_N_Pixel+1; iPixel++)'
 
               } /* End of 'for (int iState=0; iState<vi_Chip_N_State; iState++)' */
-            } /* End of 'while ((ifs_DataRaw.tellg() - vi_Pointer_Chip_DataLength) < vi_Chip_DataLength)' */
+            } /* End of 'while ((ifs_DataRaw.Tell() - vi_Pointer_Chip_DataLength) < vi_Chip_DataLength)' */
 
             /* ------------------------------------------------------ */
             /* Chip_Trailer */
-            ifs_DataRaw.read((char *)&vi_Chip_Trailer, DWORD);
-            vi_Pointer_Data = ifs_DataRaw.tellg();
+            ifs_DataRaw.Read(&vi_Chip_Trailer, DWORD);
+            vi_Pointer_Data = ifs_DataRaw.Tell();
             vi_Chip_Trailer = SwitchDWordWords(vi_Chip_Trailer);
             if (vi_Chip_Trailer != M_CHIP_TRAILER)
             {
@@ -857,12 +854,12 @@ bool BoardReaderIHEP::DecodeNextEvent()
               }
             }
             vi_N_Ladder_Chip++;
-          } /* End of 'while ((ifs_DataRaw.tellg() - vi_Pointer_Ladder_DataLength) < vi_Ladder_DataLength)' */
+          } /* End of 'while ((ifs_DataRaw.Tell() - vi_Pointer_Ladder_DataLength) < vi_Ladder_DataLength)' */
 
           /* ------------------------------------------------------ */
           /* Ladder_Trailer */
-          ifs_DataRaw.read((char *)&vi_Ladder_Trailer, DWORD);
-          vi_Pointer_Data = ifs_DataRaw.tellg();
+          ifs_DataRaw.Read(&vi_Ladder_Trailer, DWORD);
+          vi_Pointer_Data = ifs_DataRaw.Tell();
           vi_Ladder_Trailer = SwitchDWordWords(vi_Ladder_Trailer);
           if (vi_Ladder_Trailer != M_LADDER_TRAILER)
           {
@@ -888,18 +885,18 @@ bool BoardReaderIHEP::DecodeNextEvent()
           if (vi_Verbose < 11)
           {
             cout << "  SUCCESS : Mi28DecodeLadderDataToRoot(), Finish Good Ladder Frame " << vi_N_Frame_Good << " with Chips = " << vi_N_Ladder_Chip
-            << " @ "  << std::setw(15) << std::setbase(10) << ifs_DataRaw.tellg()
+            << " @ "  << std::setw(15) << std::setbase(10) << ifs_DataRaw.Tell()
             << " VS " << std::setw(15) << std::setbase(10) << vi_Pointer_FileEnd
             << endl;
           }
 
           vi_N_Ladder++;
-        }/* End of 'while (ifs_DataRaw.tellg() < (vi_Pointer_Ladder_PackLength + vi_Ladder_PackLength*WORD))'*/
+        }/* End of 'while (ifs_DataRaw.Tell() < (vi_Pointer_Ladder_PackLength + vi_Ladder_PackLength*WORD))'*/
 
         /* ------------------------------------------------------ */
         /* Trigger_Trailer */
-        ifs_DataRaw.read((char *)&vi_Trigger_Trailer, DWORD);
-        vi_Pointer_Data = ifs_DataRaw.tellg();
+        ifs_DataRaw.Read(&vi_Trigger_Trailer, DWORD);
+        vi_Pointer_Data = ifs_DataRaw.Tell();
         vi_Trigger_Trailer = SwitchDWordWords(vi_Trigger_Trailer);
         if (vi_Trigger_Trailer != M_LADDER_TriggerTRAILER)
         {
@@ -930,12 +927,13 @@ bool BoardReaderIHEP::DecodeNextEvent()
         if (vi_Verbose < 11)
         {
           cout << "  SUCCESS : Mi28DecodeLadderDataToRoot(), Finish Good Ladder Frame " << vi_N_Frame_Good << " with Chips = " << vi_N_Ladder
-               << " @ "  << std::setw(15) << std::setbase(10) << ifs_DataRaw.tellg()
+               << " @ "  << std::setw(15) << std::setbase(10) << ifs_DataRaw.Tell()
                << " VS " << std::setw(15) << std::setbase(10) << vi_Pointer_FileEnd \
                << endl;
         }
 
     } /* End of 'if (ifs_DataRaw.good())' */
+    else break; // a read went past the end of the file, Tell() is -1 from now on
   } /* End of 'while (!ifs_DataRaw.eof())' */
 
 
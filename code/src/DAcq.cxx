@@ -52,6 +52,7 @@
 //*KEND.
 
 #include "DAcq.h"
+#include "DProfiler.h"
 
 #define MIMO_DAQ_LIB_VERSION_1_1 // (MIMOSIS1)
 /*
@@ -94,6 +95,8 @@
   DAcq::DAcq()
 {
   // Default DAcq ctor.
+  fHotPixelsMaskedN = NULL;
+  fChannelMap = NULL;
 }
 
 //______________________________________________________________________________
@@ -138,8 +141,11 @@ DAcq::DAcq(DSetup& c)
   fEventsMissed = 0; // JB 2012/08/17
   fEventsDataNotOK = 0;  // JB 2014/12/16
   fEventsModuleNotOK = 0;// JB 2014/12/16
+  fEventsSkipped = 0;
+  fNextEventNumber = 0;
   Int_t          mdt, mdl;
   fModuleTypes  = fc->GetAcqPar().ModuleTypes;
+  DProfiler::SetSlotsN( fModuleTypes+1); // decoding profiled per module type
   fMaxSegments = 50; // JB 2013/08/14
 
   // Timing information, 0 is the default which could be updated from data
@@ -182,6 +188,7 @@ DAcq::DAcq(DSetup& c)
   //fListOfMonteCarlo = new vector<DMonteCarlo*>[fc->GetTrackerPar().Planes]; // LC 2014/12/15 :: DMonteCarlo included in DPixel
   fLineOverflowN = new Int_t[10]; //MG 2012/02/15 : be carefull if the number of plane is bigger than 10 !
   fUseTimestamp = new Bool_t*[totalNmodules]; // JB 2015/05/26
+  InitHotPixelMasks();
   // ==========================
 
 
@@ -271,6 +278,9 @@ DAcq::DAcq(DSetup& c)
         if( fc->GetModulePar(mdt).IfZeroSuppress > 0) { // JB 2017/11/20
           fIMG[iModule]->SetZeroSuppression( fc->GetModulePar(mdt).ThresholdZero);
         }
+        // decoded pixels go straight to the plane lists
+        fPixelSinks.push_back( new DAcqPixelSink( this, mdt, mdl));
+        fIMG[iModule]->SetPixelSink( fPixelSinks.back());
         fIMG[iModule]->SetDebugLevel( fDebugAcq);
         //cout << "Setting number of columns to " << fc->GetPlanePar(1).Strips(0) << endl;
         if( fc->GetModulePar(mdt).DeviceDataFile[mdl-1]!=NULL ) {
@@ -442,6 +452,7 @@ DAcq::DAcq(DSetup& c)
           TString(fc->GetModulePar(mdt).MCTreeName.Data()),
           fc);
         fMC[iModule]->SetDebugLevel( fDebugAcq);
+        fMC[iModule]->SetPrefetch( fc->GetModulePar(mdt).MCCacheSize, fc->GetModulePar(mdt).MCThreads, fc->GetModulePar(mdt).MCReadAheadFiles);
 
         //Holder for the MC truth information
         //Only initialized when reading MC data
@@ -570,6 +581,8 @@ DAcq::DAcq(DSetup& c)
     } // end loop on inputs
   } // end loop on planes
 
+  BuildChannelMap();
+
 
   // Now, check that each input has some correct plane number associated
   // JB, 2009/05/25; modified JB 2013/08/14
@@ -637,6 +650,72 @@ for (mdl = 1; mdl <= fc->GetModulePar(mdt).Devices; mdl++){ // loop on each modu
 DAcq::~DAcq()
 {
   // Default DAcq destructor.
+
+  for( size_t iPlane=0; iPlane<fHotPixelMask.size(); iPlane++) delete fHotPixelMask[iPlane];
+  fHotPixelMask.clear();
+  delete[] fHotPixelsMaskedN;
+  for( size_t iSink=0; iSink<fPixelSinks.size(); iSink++) delete fPixelSinks[iSink];
+  fPixelSinks.clear();
+  if( fChannelMap ) {
+    for( Int_t mdt=1; mdt<=fModuleTypes; mdt++) {
+      for( Int_t mdl=1; mdl<=fc->GetModulePar(mdt).Devices; mdl++) delete[] fChannelMap[mdt-1][mdl-1];
+      delete[] fChannelMap[mdt-1];
+    }
+    delete[] fChannelMap;
+  }
+}
+
+//______________________________________________________________________________
+//
+void DAcq::InitHotPixelMasks()
+{
+  // Build one bit mask per plane with the hot pixels
+  //  - found by DSetup from the HotPixelMapFile (lists in PlaneParameter),
+  //  - and/or read from the HotPixelMaskFile.
+  // Planes without hot pixel get no mask, so that testing costs nothing.
+  // The masks are used in NextEvent to drop hot pixels before any DPixel is created.
+
+  Int_t nPlanes = fc->GetTrackerPar().Planes;
+  fHotPixelMask.assign( nPlanes, (DHotPixelMask*)NULL);
+  fHotPixelsMaskedN = new Int_t[nPlanes];
+
+  for( Int_t iPlane=0; iPlane<nPlanes; iPlane++) {
+    fHotPixelsMaskedN[iPlane] = 0;
+    DSetup::PlaneParameter_t &planePar = fc->GetPlanePar(iPlane+1);
+
+    DHotPixelMask *mask = new DHotPixelMask();
+    mask->Fill( planePar.HotPixelList_lin, planePar.HotPixelList_col, planePar.HotPixelList_index);
+    if( !planePar.HotPixelMaskFile.IsNull() ) mask->ReadFromFile( planePar.HotPixelMaskFile.Data());
+
+    if( mask->IsEmpty() ) {
+      delete mask;
+      continue;
+    }
+    fHotPixelMask[iPlane] = mask;
+    if (fDebugAcq) cout << "  DAcq: plane " << iPlane+1 << " masks " << mask->GetNHot() << " hot pixels by (line,column) and " << mask->GetNHotIndex() << " by index." << endl;
+  }
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DAcq::SaveHotPixelMasks( const char *filePrefix)
+{
+  // Write the hot pixel mask of each plane in a binary file
+  //  named <filePrefix>_pl<plane>.bin,
+  //  which can be given as HotPixelMaskFile in the config file of other runs.
+  // The masks are those used by this run, built by InitHotPixelMasks from the
+  //  HotPixelMapFile lists and the HotPixelMaskFile, they are not filled from the data.
+  // Return kFALSE if one file could not be written.
+
+  Bool_t allOK = kTRUE;
+  for( Int_t iPlane=0; iPlane<(Int_t)fHotPixelMask.size(); iPlane++) {
+    if( fHotPixelMask[iPlane]==NULL ) continue;
+    TString fileName = TString::Format( "%s_pl%d.bin", filePrefix, iPlane+1);
+    allOK &= fHotPixelMask[iPlane]->WriteToFile( fileName.Data());
+    cout << "DAcq: hot pixel mask of plane " << iPlane+1 << " saved in " << fileName << endl;
+  }
+  return allOK;
 }
 
 //______________________________________________________________________________
@@ -798,12 +877,8 @@ void DAcq::GetMatchingPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t ch
   //  module type, number, input and channel.
   // All indexes expected to start at 1.
   //
-  // The vector fInputSegments provides the lower limits of a segment
-  //  for a given module type and number and input number.
-  // Its minimum size is 1.
-  // This means that if an input has only one segment: fInputSegments[0] = 1,
-  //  and with segments like 1-256 / 257-512:
-  //   fInputSegments[0] = 1 and fInputSegments[1] = 257
+  // The answer is read from the table built by BuildChannelMap,
+  //  see SearchPlaneAndShift for the meaning of the segments.
   //
   // JB 2013/08/14
 
@@ -816,7 +891,36 @@ void DAcq::GetMatchingPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t ch
     printf("\n");
   }
 
+  LookUpPlaneAndShift( mdt, mdl, input, channel, aPlane, aShift);
+
+  if(fDebugAcq>3) printf("DAcq::GetMatchingPlaneAndShift found plane %d and shift %d\n", aPlane, aShift);
+
+}
+
+//______________________________________________________________________________
+//
+void DAcq::SearchPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t channel, Int_t &aPlane, Int_t &aShift)
+{
+  // Search the segment of the input containing the channel,
+  //  and set the matching plane and shift.
+  // All indexes expected to start at 1.
+  //
+  // The vector fInputSegments provides the lower limits of a segment
+  //  for a given module type and number and input number.
+  // Its minimum size is 1.
+  // This means that if an input has only one segment: fInputSegments[0] = 1,
+  //  and with segments like 1-256 / 257-512:
+  //   fInputSegments[0] = 1 and fInputSegments[1] = 257
+  //
+  // Only used to build the table of BuildChannelMap
+  //  and for channels outside this table.
+
   Int_t aSegment = (Int_t)fInputSegments[mdt-1][mdl-1][input-1].size()-1;
+  if( aSegment<0 ) { // input not associated to any plane
+    aPlane = 0;
+    aShift = 0;
+    return;
+  }
 
   while (0<aSegment && channel<fInputSegments[mdt-1][mdl-1][input-1].at(aSegment)) {
     aSegment--;
@@ -826,8 +930,65 @@ void DAcq::GetMatchingPlaneAndShift( Int_t mdt, Int_t mdl, Int_t input, Int_t ch
   aShift = fIndexShift[mdt-1][mdl-1][input-1][aSegment]
           - fInputSegments[mdt-1][mdl-1][input-1].at(aSegment)+1;
 
-  if(fDebugAcq>3) printf("DAcq::GetMatchingPlaneAndShift found plane %d and shift %d from segment %d\n", aPlane, aShift, aSegment);
+}
 
+//______________________________________________________________________________
+//
+void DAcq::BuildChannelMap()
+{
+  // Precompute, for each input of each module, the plane and the index shift
+  //  of every channel, so that decoding a pixel needs no segment search.
+  // An input with a single segment (the usual case) only stores one plane
+  //  and one shift, an input shared by several planes stores them per channel.
+
+  fChannelMap = new ChannelMap_t**[fModuleTypes];
+  for( Int_t mdt=1; mdt<=fModuleTypes; mdt++) {
+    fChannelMap[mdt-1] = new ChannelMap_t*[fc->GetModulePar(mdt).Devices];
+    for( Int_t mdl=1; mdl<=fc->GetModulePar(mdt).Devices; mdl++) {
+      fChannelMap[mdt-1][mdl-1] = new ChannelMap_t[fc->GetModulePar(mdt).Inputs];
+      for( Int_t iInp=1; iInp<=fc->GetModulePar(mdt).Inputs; iInp++) {
+        ChannelMap_t &map = fChannelMap[mdt-1][mdl-1][iInp-1];
+        std::vector<int> &segments = fInputSegments[mdt-1][mdl-1][iInp-1];
+        SearchPlaneAndShift( mdt, mdl, iInp, 1, map.plane, map.shift);
+        if( segments.size()<2 ) continue;
+
+        // channels above the largest segment limit all belong to the last segment
+        Int_t nChannels = fc->GetModulePar(mdt).Channels[iInp-1];
+        for( size_t iSeg=0; iSeg<segments.size(); iSeg++) {
+          if( segments[iSeg]>nChannels ) nChannels = segments[iSeg];
+        }
+        map.channelPlane.resize( nChannels+1);
+        map.channelShift.resize( nChannels+1);
+        for( Int_t iCh=1; iCh<=nChannels; iCh++) {
+          SearchPlaneAndShift( mdt, mdl, iInp, iCh, map.channelPlane[iCh], map.channelShift[iCh]);
+        }
+        if(fDebugAcq) cout << "  DAcq: input " << iInp << " of module type " << mdt << " nb " << mdl << " shared by " << segments.size() << " segments, map of " << nChannels << " channels" << endl;
+      }
+    }
+  }
+}
+
+//______________________________________________________________________________
+//
+void DAcqPixelSink::AddPixel( int input, int value, int index, int timestamp)
+{
+  fAcq->AddIndexedPixel( fModuleType, fModuleNumber, input, index, (Double_t)value, timestamp);
+}
+
+//______________________________________________________________________________
+//
+void DAcq::AddIndexedPixel( Int_t mdt, Int_t mdl, Int_t input, Int_t index, Double_t value, Int_t timestamp)
+{
+  // Add one pixel to the list of its plane, unless it is hot.
+  // Input and index start at 0 (reader convention),
+  //  the index is translated to the plane index with the channel map.
+
+  Int_t aPlaneNumber, aShift;
+  LookUpPlaneAndShift( mdt, mdl, input+1, index+1, aPlaneNumber, aShift);
+  if(fDebugAcq>2) cout << "  pixel index " << index << " from input " << input << " with value " << value << ", associated to plane " << aPlaneNumber << " with an index shift of " << aShift << " Timestamp " << timestamp << endl;
+  if( aPlaneNumber<1 ) return;
+  if( IsHotPixelIndex( aPlaneNumber, index+aShift) ) return;
+  fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, index+aShift, value, timestamp));
 }
 
 //______________________________________________________________________________
@@ -1145,6 +1306,65 @@ void DAcq::Reset()
 
 }
 
+//______________________________________________________________________________
+//
+Bool_t DAcq::IsAbleToGoToEvent()
+{
+  // Return kTRUE if every module can be positioned on any event,
+  //  which is the case for readers maintaining an event index (IMG boards).
+
+  for ( Int_t mdt = 1; mdt <= fModuleTypes; mdt++){ // loop on module types
+    if( (fc->GetModulePar(mdt).Type)/10 != 1 ) return kFALSE;
+  }
+  return fModuleTypes>0;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DAcq::GoToEvent( Int_t anEvent)
+{
+  // Position all the modules so that the next call to NextEvent
+  //  reads the event anEvent (counted from 0 since the start of the run).
+  // Return kFALSE if one module cannot reach this event.
+  //
+  // The events passed over are not decoded, so they do not enter the
+  //  counters of missed synchronisation and data or module problems;
+  //  they are counted apart (GetEventsSkipped) and removed from the
+  //  events read in PrintStatistics.
+
+  if( !IsAbleToGoToEvent() ) {
+    cout << "WARNING: DAcq::GoToEvent, one module type cannot go to a specific event -> nop." << endl;
+    return kFALSE;
+  }
+
+  Bool_t reached = kTRUE;
+  Int_t iModule=0; // module index, from 0 to totalNmodules
+  for ( Int_t mdt = 1; mdt <= fModuleTypes; mdt++){ // loop on module types
+    for (Int_t mdl = 1; mdl <= fc->GetModulePar(mdt).Devices; mdl++){ // loop on each modules of this type
+      reached &= fIMG[iModule]->GoToEvent( anEvent);
+      iModule++;
+    }
+  }
+  if (fDebugAcq)  cout << " DAcq::GoToEvent(), positioned on event " << anEvent << ", OK? " << reached << endl;
+  if( reached ) {
+    if( anEvent>fNextEventNumber ) fEventsSkipped += anEvent-fNextEventNumber;
+    fNextEventNumber = anEvent;
+  }
+
+  return reached;
+}
+
+//______________________________________________________________________________
+//
+Int_t DAcq::FindEventWithTrigger( Int_t aTrigger)
+{
+  // Return the event number (counted from 0) carrying the trigger aTrigger,
+  //  according to the event index of the first module, -1 if unknown.
+
+  if( !IsAbleToGoToEvent() ) return -1;
+  return fIMG[0]->FindEventWithTrigger( aTrigger);
+}
+
 //______________________________________________________________________________
 //
 TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
@@ -1190,6 +1410,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
   BoardReaderPixel *readerPixel;
 
   fEventNumber = eventNumber; // JB 2009/05/26
+  fNextEventNumber = eventNumber+1;
   if (fDebugAcq)  cout << " DAcq::NextEvent(), getting event " << fEventNumber << endl;
 
   // Init added because each module types update those lists
@@ -1197,9 +1418,10 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
   fTriggersN    = 0;
   fFramesN      = 0;
   fTimestampsN  = 0;
-  if (ListOfTriggers!=NULL) ListOfTriggers->clear();
-  if (ListOfFrames!=NULL) ListOfFrames->clear();
-  if (ListOfTimestamps!=NULL) ListOfTimestamps->clear();
+  // The lists are assembled from the board lists at the end of the module loop,
+  //  see DAcqEventAssembly.
+  fEventAssembly.Clear();
+  AssembleLists();
 
   //====================
   // erasing pixel and pixel list for all planes
@@ -1254,6 +1476,12 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
   Int_t iModule=0; // module index, from 0 to totalNmodules
   for ( Int_t mdt = 1; mdt <= fModuleTypes; mdt++){ // loop on module types
 
+    TAF_PROFILE_SCOPE( DProfiler::kDecode, mdt);
+    Long64_t pixelsListed = 0; // to count the pixels decoded by this module type
+#ifndef NOPROFILING
+    for( Int_t iPlane = 0; iPlane<fc->GetTrackerPar().Planes; iPlane++) pixelsListed -= (Long64_t)fListOfPixels[iPlane].size();
+#endif
+
     switch ( (fc->GetModulePar(mdt).Type)/10 ) {
 
         // -+-+- IMG modules (added JB 2012/07/22)
@@ -1278,28 +1506,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fTriggersN      += imgEvent->GetNumberOfTriggers();
             fFramesN        += imgEvent->GetNumberOfFrames();
             fTimestampsN    += imgEvent->GetNumberOfTimestamps();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = imgEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (imgEvent->GetTriggers())->begin(), (imgEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = imgEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (imgEvent->GetFrames())->begin(), (imgEvent->GetFrames())->end());
-              ;
-            }
-            if (ListOfTimestamps==NULL) {
-              ListOfTimestamps     = imgEvent->GetTimestamps();
-            }
-            else {
-              ListOfTimestamps->insert( ListOfTimestamps->begin(), (imgEvent->GetTimestamps())->begin(), (imgEvent->GetTimestamps())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( imgEvent->GetTriggers(), imgEvent->GetFrames(), imgEvent->GetTimestamps());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << imgEvent->GetNumberOfPixels() << " hit pixels with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout << ListOfTriggers->at( iTrig) <<  ", ";
@@ -1315,6 +1524,8 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               cout << " from daq event " << fRealEventNumber << endl << endl;
             }
             // Set values for hit pixels
+            // The pixels are already in the plane lists if the reader has a sink (see DAcqPixelSink),
+            //  then the event contains none.
             for( Int_t iPix=0; iPix<imgEvent->GetNumberOfPixels(); iPix++) { // loop on Pixels
               imgPixel = imgEvent->GetPixelAt( iPix);
               GetMatchingPlaneAndShift( mdt, mdl, imgPixel->GetInput()+1, imgPixel->GetIndex()+1, aPlaneNumber, aShift);
@@ -1323,6 +1534,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               if(fDebugAcq>2) cout << "  pixel " << iPix << " index " << imgPixel->GetIndex() << " from input " << imgPixel->GetInput() << " with value " << imgPixel->GetValue() << ", associated to plane " << aPlaneNumber << " with an index shift of " << aShift << " Timestamp " << imgPixel->GetTimeStamp() << endl;
               //if (imgPixel->GetValue()<0) {cout << " we also have negative pulseheights " << imgPixel->GetValue() << endl; } //YV check 22/07/09
 
+              if( IsHotPixelIndex( aPlaneNumber, imgPixel->GetIndex()+aShift) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, imgPixel->GetIndex()+aShift, (Double_t)imgPixel->GetValue(), imgPixel->GetTimeStamp());
               //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, imgPixel->GetIndex()+aShift, (Double_t)imgPixel->GetValue(), imgPixel->GetTimeStamp()));
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
@@ -1364,28 +1576,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fTriggersN      += tntEvent->GetNumberOfTriggers();
             fFramesN        += tntEvent->GetNumberOfFrames();
             fTimestampsN    += tntEvent->GetNumberOfTimestamps();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = tntEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (tntEvent->GetTriggers())->begin(), (tntEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = tntEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (tntEvent->GetFrames())->begin(), (tntEvent->GetFrames())->end());
-              ;
-            }
-            if (ListOfTimestamps==NULL) {
-              ListOfTimestamps     = tntEvent->GetTimestamps();
-            }
-            else {
-              ListOfTimestamps->insert( ListOfTimestamps->begin(), (tntEvent->GetTimestamps())->begin(), (tntEvent->GetTimestamps())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( tntEvent->GetTriggers(), tntEvent->GetFrames(), tntEvent->GetTimestamps());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << tntEvent->GetNumberOfPixels() << " hit pixels with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout << ListOfTriggers->at( iTrig) <<  ", ";
@@ -1409,7 +1602,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               //aShift = fIndexShift[mdt-1][mdl-1][tntPixel->GetInput()]; // JB 2009/05/06
               if(fDebugAcq>2) cout << "  pixel " << iPix << " index " << tntPixel->GetIndex() << " from input " << tntPixel->GetInput() << " with value " << tntPixel->GetValue() << ", associated to plane " << aPlaneNumber << " with an index shift of " << aShift << endl;
               //if (tntPixel->GetValue()<0) {cout << " we also have negative pulseheights " << tntPixel->GetValue() << endl; } //YV check 22/07/09
-              if( tntPixel->GetValue()>-4000.) {
+              if( tntPixel->GetValue()>-4000. && !IsHotPixelIndex( aPlaneNumber, tntPixel->GetIndex()+aShift) ) {
 
                 DPixel* APixel =  new DPixel( aPlaneNumber, tntPixel->GetIndex()+aShift, tntPixel->GetValue());
                 //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, tntPixel->GetIndex()+aShift, tntPixel->GetValue())); //YV move the cut of the raw value of the pixel from 0 to -4000 22/07/09
@@ -1452,21 +1645,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fRealEventNumber = pxiEvent->GetEventNumber();
             fTriggersN      += pxiEvent->GetNumberOfTriggers();
             fFramesN        += pxiEvent->GetNumberOfFrames();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = pxiEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (pxiEvent->GetTriggers())->begin(), (pxiEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = pxiEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (pxiEvent->GetFrames())->begin(), (pxiEvent->GetFrames())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( pxiEvent->GetTriggers(), pxiEvent->GetFrames());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << pxiEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout <<  ", " << ListOfTriggers->at( iTrig);
@@ -1484,6 +1665,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][pxiPixel->GetInput()-1][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << pxiPixel->GetLineNumber() << " column " << pxiPixel->GetColumnNumber() << " from input " << pxiPixel->GetInput() << " with value " << pxiPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
 
+              if( IsHotPixel( aPlaneNumber, pxiPixel->GetLineNumber(), pxiPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, pxiPixel->GetLineNumber(), pxiPixel->GetColumnNumber(), (Double_t)pxiPixel->GetValue());
               //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, pxiPixel->GetLineNumber(), pxiPixel->GetColumnNumber(), (Double_t)pxiPixel->GetValue()));
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
@@ -1551,34 +1733,21 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               fTriggersN      += pxieEvent->GetNumberOfTriggers();
               fFramesN        += pxieEvent->GetNumberOfFrames();
               fTimestampsN    += pxieEvent->GetNumberOfTimestamps();
-              if (ListOfTriggers==NULL) {
-                ListOfTriggers = pxieEvent->GetTriggers();
-              }
-              else {
-                ListOfTriggers->insert( ListOfTriggers->begin(), (pxieEvent->GetTriggers())->begin(), (pxieEvent->GetTriggers())->end());
-              }
-              if (ListOfFrames==NULL) {
-                ListOfFrames     = pxieEvent->GetFrames();
-              }
-              else {
-                if(fPXIe[iModule]->GetFlag() == 0) {
-                  ListOfFrames->insert( ListOfFrames->begin(), (pxieEvent->GetFrames())->begin(), (pxieEvent->GetFrames())->end());
-                }
-              }
-              if (ListOfTimestamps==NULL) {
-                ListOfTimestamps     = pxieEvent->GetTimestamps();
-              }
-              else {
-                ListOfTimestamps->insert( ListOfTimestamps->begin(), (pxieEvent->GetTimestamps())->begin(), (pxieEvent->GetTimestamps())->end());
+              // the PXIe triggers come first, its frames are added only if no other board gave frames or if the flag is 0
+              fEventAssembly.Add( DAcqEventAssembly::kTriggers, pxieEvent->GetTriggers(), DAcqEventAssembly::kPrepend);
+              if( fEventAssembly.GetBoardsN( DAcqEventAssembly::kFrames)==0 || fPXIe[iModule]->GetFlag() == 0) {
+                fEventAssembly.Add( DAcqEventAssembly::kFrames, pxieEvent->GetFrames(), DAcqEventAssembly::kPrepend);
               }
+              fEventAssembly.Add( DAcqEventAssembly::kTimestamps, pxieEvent->GetTimestamps(), DAcqEventAssembly::kPrepend);
 
-              fEventTime = fEventReferenceTime + ListOfTimestamps->at(0)*115.e-6; // seconds since Epoch JB 2018/02/12
+              fEventTime = fEventReferenceTime + pxieEvent->GetTimestamps()->at(0)*115.e-6; // seconds since Epoch JB 2018/02/12
               ListOfLineOverflow = pxieEvent->GetLineOverflow(); //MG 2012/02/15
               if (fDebugAcq) cout << "    event time " << fEventTime << " sec" << endl;
 
               for(int i=0;i<fc->GetTrackerPar().Planes;i++) fLineOverflowN[i]=ListOfLineOverflow[i].size() ;//MG 2012/02/15
 
               if (fDebugAcq) {
+                AssembleLists();
                 cout << "   module " << mdl << " found " << pxieEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
                 for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                   cout <<  ", " << ListOfTriggers->at( iTrig);
@@ -1605,7 +1774,8 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
                 aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][pxiePixel->GetInput()-1][0];
                 if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << pxiePixel->GetLineNumber() << " column " << pxiePixel->GetColumnNumber() << " from input " << pxiePixel->GetInput() << " with value " << pxiePixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
 
-                DPixel* APixel = new DPixel( aPlaneNumber, pxiePixel->GetLineNumber(), pxiePixel->GetColumnNumber(), (Double_t)pxiePixel->GetValue(), ListOfTimestamps->at(0)); // relative timestamp added JB 2018/02/12
+                if( IsHotPixel( aPlaneNumber, pxiePixel->GetLineNumber(), pxiePixel->GetColumnNumber()) ) continue;
+                DPixel* APixel = new DPixel( aPlaneNumber, pxiePixel->GetLineNumber(), pxiePixel->GetColumnNumber(), (Double_t)pxiePixel->GetValue(), pxieEvent->GetTimestamps()->at(0)); // relative timestamp added JB 2018/02/12
                 //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, pxiePixel->GetLineNumber(), pxiePixel->GetColumnNumber(), (Double_t)pxiePixel->GetValue()));
                 fListOfPixels[aPlaneNumber-1].push_back(APixel);
 
@@ -1653,6 +1823,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << gigPixel->GetLineNumber() << " column " << gigPixel->GetColumnNumber() << " from input " << gigPixel->GetInput() << " with value " << gigPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
 
+              if( IsHotPixel( aPlaneNumber, gigPixel->GetLineNumber(), gigPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, gigPixel->GetLineNumber(), gigPixel->GetColumnNumber(), (Double_t)gigPixel->GetValue());
 
               if( fIfMonteCarlo == 1) {
@@ -1695,21 +1866,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fRealEventNumber = readerEvent->GetEventNumber();
             fTriggersN      += readerEvent->GetNumberOfTriggers();
             //            fFramesN        += readerEvent->GetNumberOfFrames();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = readerEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (readerEvent->GetTriggers())->begin(), (readerEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = readerEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (readerEvent->GetFrames())->begin(), (readerEvent->GetFrames())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( readerEvent->GetTriggers(), readerEvent->GetFrames());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << readerEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout <<  ", " << ListOfTriggers->at( iTrig);
@@ -1727,6 +1886,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][readerPixel->GetInput()-1][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << readerPixel->GetLineNumber() << " column " << readerPixel->GetColumnNumber() << " from input " << readerPixel->GetInput() << " with value " << readerPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
 
+              if( IsHotPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue());
               //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue()));
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
@@ -1768,7 +1928,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               readerPixel = (BoardReaderPixel*)readerEvent->GetPixelAt( iPix);
               aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][readerPixel->GetInput()-1][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << readerPixel->GetLineNumber() << " column " << readerPixel->GetColumnNumber() << " frame " << readerPixel->GetTimeStamp() << " from input " << readerPixel->GetInput() << " with value " << readerPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
-              if(readerPixel->GetValue()>0) fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue(), (Int_t)readerPixel->GetTimeStamp()));
+              if(readerPixel->GetValue()>0 && !IsHotPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber()) ) fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue(), (Int_t)readerPixel->GetTimeStamp()));
 
             } // end loop on Pixels
 
@@ -1813,7 +1973,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               //aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][0][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " index " << fM18[iModule]->GetIndex( iPix) << " line " << fM18[iModule]->GetRow( iPix) << " column " << fM18[iModule]->GetCol( iPix) << " from input " << 0 << " with value " << fM18[iModule]->GetAmp( iPix) << ", associated to plane " << aPlaneNumber << " with an index shift of " << aShift << endl;
 
-              if( (Double_t)fM18[iModule]->GetAmp( iPix)>0 ) { // cut tails //!!!!scommentare
+              if( (Double_t)fM18[iModule]->GetAmp( iPix)>0 && !IsHotPixelIndex( aPlaneNumber, fM18[iModule]->GetIndex(iPix)+aShift+1) ) { // cut tails //!!!!scommentare
 
                 //fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, fM18[iModule]->GetIndex(iPix)+aShift+1, (Double_t)fM18[iModule]->GetAmp( iPix)) );//added +1 in shift 17/6
                 DPixel* APixel =  new DPixel( aPlaneNumber, fM18[iModule]->GetIndex(iPix)+aShift+1, /*(Double_t)fM18[iModule]->GetAmp( iPix)*/TMath::Abs((Double_t)fM18[iModule]->GetAmp( iPix)) ); //added +1 in shift 17/6
@@ -1879,7 +2039,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               GetMatchingPlaneAndShift( mdt, mdl, 1, 1, aPlaneNumber, aShift);
               //aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][0][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " index " << fGeant[iModule]->GetIndex( iPix) << " line " << fGeant[iModule]->GetRow( iPix) << " column " << fGeant[iModule]->GetCol( iPix) << " from input " << 0 << " with value " << fGeant[iModule]->GetAmp( iPix) << ", associated to plane " << aPlaneNumber << endl;
-              if((Double_t)fGeant[iModule]->GetAmp( iPix)>0) { // cut tails
+              if((Double_t)fGeant[iModule]->GetAmp( iPix)>0 && !IsHotPixel( aPlaneNumber, fGeant[iModule]->GetRow( iPix), fGeant[iModule]->GetCol(iPix)) ) { // cut tails
                 //                fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, fGeant[iModule]->GetIndex(iPix), (Double_t)fGeant[iModule]->GetAmp( iPix)) );
                 //		  fListOfPixels[aPlaneNumber-1].push_back( new DPixel( aPlaneNumber, fGeant[iModule]->GetRow( iPix), fGeant[iModule]->GetCol(iPix), (Double_t)fGeant[iModule]->GetAmp( iPix)) );
                 DPixel* APixel =  new DPixel( aPlaneNumber, fGeant[iModule]->GetRow( iPix), fGeant[iModule]->GetCol(iPix), (Double_t)fGeant[iModule]->GetAmp( iPix));
@@ -1912,13 +2072,10 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fTriggersN      += readerEvent->GetNumberOfTriggers();
             //fFramesN        += readerEvent->GetNumberOfFrames();
 
-            if(ListOfTriggers == NULL) ListOfTriggers = readerEvent->GetTriggers();
-            else                       ListOfTriggers->insert( ListOfTriggers->end(), (readerEvent->GetTriggers())->begin(), (readerEvent->GetTriggers())->end());
-
-            if(ListOfFrames == NULL)   ListOfFrames = readerEvent->GetFrames();
-            else                       ListOfFrames->insert( ListOfFrames->begin(), (readerEvent->GetFrames())->begin(), (readerEvent->GetFrames())->end());
+            fEventAssembly.AddBoard( readerEvent->GetTriggers(), readerEvent->GetFrames());
 
             if(fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << readerEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) cout <<  ", " << ListOfTriggers->at( iTrig);
               cout << " and " << fFramesN << " frames: ";
@@ -1960,6 +2117,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 				   << " with value " << Value
 				   << ", associated to plane " << aPlaneNumber
 				   << endl;
+	      if( IsHotPixel( aPlaneNumber, MCInfoHolder->GetASimPixel(iPix).row, MCInfoHolder->GetASimPixel(iPix).col) ) continue;
 	      DPixel* APixel = new DPixel(aPlaneNumber,
 					  MCInfoHolder->GetASimPixel(iPix).row,
 					  MCInfoHolder->GetASimPixel(iPix).col,
@@ -1981,6 +2139,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 				   << ", associated to plane " << aPlaneNumber
 				   << endl;
 
+              if( IsHotPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue());
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
             } // end loop on Pixels
@@ -2010,21 +2169,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fRealEventNumber = readerEvent->GetEventNumber();
             fTriggersN      += readerEvent->GetNumberOfTriggers();
             fFramesN        += readerEvent->GetNumberOfFrames();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = readerEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (readerEvent->GetTriggers())->begin(), (readerEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = readerEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (readerEvent->GetFrames())->begin(), (readerEvent->GetFrames())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( readerEvent->GetTriggers(), readerEvent->GetFrames());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << readerEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout <<  ", " << ListOfTriggers->at( iTrig);
@@ -2042,6 +2189,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
               aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][readerPixel->GetInput()-1][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << readerPixel->GetLineNumber() << " column " << readerPixel->GetColumnNumber() << " at timestamp " << readerPixel->GetTimeStamp() << " from input " << readerPixel->GetInput() << " with value " << readerPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
 
+              if( IsHotPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue(), readerPixel->GetTimeStamp());
               // if(readerPixel->GetInput()!=5 && readerPixel->GetInput()!=6 && readerPixel->GetTimeStamp()==1)
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
@@ -2072,21 +2220,9 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
             fRealEventNumber = readerEvent->GetEventNumber();
             fTriggersN      += readerEvent->GetNumberOfTriggers();
             fFramesN        += readerEvent->GetNumberOfFrames();
-            if (ListOfTriggers==NULL) {
-              ListOfTriggers = readerEvent->GetTriggers();
-            }
-            else {
-              ListOfTriggers->insert( ListOfTriggers->end(), (readerEvent->GetTriggers())->begin(), (readerEvent->GetTriggers())->end());
-              ;
-            }
-            if (ListOfFrames==NULL) {
-              ListOfFrames     = readerEvent->GetFrames();
-            }
-            else {
-              ListOfFrames->insert( ListOfFrames->begin(), (readerEvent->GetFrames())->begin(), (readerEvent->GetFrames())->end());
-              ;
-            }
+            fEventAssembly.AddBoard( readerEvent->GetTriggers(), readerEvent->GetFrames());
             if (fDebugAcq) {
+              AssembleLists();
               cout << "   module " << mdl << " found " << readerEvent->GetNumberOfPixels() << " hit pixels  with " << fTriggersN << " triggers: ";
               for( Int_t iTrig=0; iTrig<fTriggersN; iTrig++) {
                 cout <<  ", " << ListOfTriggers->at( iTrig);
@@ -2103,6 +2239,7 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 	              cout << " Got pixel " << iPix << " for input " << readerPixel->GetInput() << endl;
               aPlaneNumber = fMatchingPlane[mdt-1][mdl-1][readerPixel->GetInput()-1][0];
               if(fDebugAcq>2) cout << "  pixel " << iPix << " line " << readerPixel->GetLineNumber() << " column " << readerPixel->GetColumnNumber() << " at timestamp " << readerPixel->GetTimeStamp() << " from input " << readerPixel->GetInput() << " with value " << readerPixel->GetValue() << ", associated to plane " << aPlaneNumber << endl;
+              if( IsHotPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber()) ) continue;
               DPixel* APixel = new DPixel( aPlaneNumber, readerPixel->GetLineNumber(), readerPixel->GetColumnNumber(), (Double_t)readerPixel->GetValue(), readerPixel->GetTimeStamp());
               // if(readerPixel->GetInput()!=5 && readerPixel->GetInput()!=6 && readerPixel->GetTimeStamp()==1)
               fListOfPixels[aPlaneNumber-1].push_back(APixel);
@@ -2120,6 +2257,11 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 
     }; // end switch on module types
 
+#ifndef NOPROFILING
+    for( Int_t iPlane = 0; iPlane<fc->GetTrackerPar().Planes; iPlane++) pixelsListed += (Long64_t)fListOfPixels[iPlane].size();
+#endif
+    TAF_PROFILE_COUNT( DProfiler::kDecode, mdt, pixelsListed);
+
     // Interrupt the loop on modules if one event data is not OK
     // JB 2012/08/18 -> undesired behavior JB 2015/03/25
     //if( !dataOK ) {
@@ -2128,54 +2270,11 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 
   } // end loop on module types
 
+  // single merge of the board lists
+  AssembleLists();
 
-  //Subtracting hot pixels from hit pixels list
-  for(int iPlane=0;iPlane<fc->GetTrackerPar().Planes;iPlane++) { // Loop on planes
-
-    if(   fc->GetPlanePar(iPlane+1).HotPixelList_lin.size() == 0
-       && fc->GetPlanePar(iPlane+1).HotPixelList_index.size() == 0) {
-      if (fDebugAcq>2) cout << "DAcq: no hot pixel to subtract." << endl;
-      continue;
-    }
-
-    if (fDebugAcq>1) cout << "DAcq: Subtracting hot pixels, from a list of " << int(fc->GetPlanePar(iPlane+1).HotPixelList_lin.size()) << " ordered in 2D, or from a list of " << int(fc->GetPlanePar(iPlane+1).HotPixelList_index.size()) << " ordered in 1D, from plane " << iPlane+1 << " with " << int(fListOfPixels[iPlane].size()) << " fired pixels." << endl;
-
-    //temporal list with hit pixels excluding hot-pixels
-   std::vector<DPixel*> Temp_list;
-    Temp_list.clear();
-    for(int iPix=0;iPix<int(fListOfPixels[iPlane].size());iPix++) { // loop on read pixels
-      //Test if current pixel is in hot-pixel-list:
-      bool IsAHotPixel = false;
-      for(int i_hot = 0; i_hot<int(fc->GetPlanePar(iPlane+1).HotPixelList_lin.size());i_hot++) { // loop on 2D ordered hot pixel list
-        if (fDebugAcq>2) printf("DAcq: 2D-testing pixel[%d] (%d,%d) against known hot pixel[%d] (%d,%d)\n", iPix, fListOfPixels[iPlane][iPix]->GetPixelLine(), fListOfPixels[iPlane][iPix]->GetPixelColumn(), i_hot, fc->GetPlanePar(iPlane+1).HotPixelList_lin[i_hot], fc->GetPlanePar(iPlane+1).HotPixelList_col[i_hot] );
-        if((fListOfPixels[iPlane][iPix]->GetPixelLine()   == fc->GetPlanePar(iPlane+1).HotPixelList_lin[i_hot])
-           &&
-           (fListOfPixels[iPlane][iPix]->GetPixelColumn() == fc->GetPlanePar(iPlane+1).HotPixelList_col[i_hot])) {
-          IsAHotPixel = true;
-          if (fDebugAcq>2) printf( "    hot pixel found at row %d, col %d\n", fListOfPixels[iPlane][iPix]->GetPixelLine(), fListOfPixels[iPlane][iPix]->GetPixelColumn() );
-          break;
-        }
-      }  // end loop on 2D ordered hot pixel list
-
-      for(int i_hot = 0; i_hot<int(fc->GetPlanePar(iPlane+1).HotPixelList_index.size());i_hot++) { // loop on 1D ordered hot pixel list
-        if (fDebugAcq>2) printf("DAcq: 1D-testing pixel[%d] (%d) against known hot pixel[%d] (%d)\n", iPix, fListOfPixels[iPlane][iPix]->GetDAQIndex(), i_hot, fc->GetPlanePar(iPlane+1).HotPixelList_index[i_hot] );
-        if( fListOfPixels[iPlane][iPix]->GetDAQIndex() == fc->GetPlanePar(iPlane+1).HotPixelList_index[i_hot] ) {
-          IsAHotPixel = true;
-          if (fDebugAcq>2) printf( "    hot pixel found at index %d\n", fListOfPixels[iPlane][iPix]->GetDAQIndex() );
-          break;
-        }
-      }  // end loop on 1D ordered hot pixel list
-
-      if(!IsAHotPixel) Temp_list.push_back(fListOfPixels[iPlane][iPix]);
-    } // end loop on read pixels
-
-    fListOfPixels[iPlane].clear();
-    for(int iPix=0;iPix<int(Temp_list.size());iPix++) {
-      fListOfPixels[iPlane].push_back(Temp_list[iPix]);
-    }
-    Temp_list.clear();
-
-  } // end Loop on planes
+  // Hot pixels are not in the lists anymore,
+  //  they have been dropped while decoding thanks to fHotPixelMask.
 
 
   /*
@@ -2221,6 +2320,19 @@ TBits* DAcq::NextEvent( Int_t eventNumber, Int_t aTrigger)
 
 }
 
+//______________________________________________________________________________
+//
+void DAcq::AssembleLists()
+{
+  // Point the trigger, frame and timestamp lists of the event
+  //  to the board lists, merged if several boards provided them.
+
+  ListOfTriggers   = fEventAssembly.Get( DAcqEventAssembly::kTriggers);
+  ListOfFrames     = fEventAssembly.Get( DAcqEventAssembly::kFrames);
+  ListOfTimestamps = fEventAssembly.Get( DAcqEventAssembly::kTimestamps);
+
+}
+
 //______________________________________________________________________________
 //
 Bool_t DAcq::DumpHexToTerm()
@@ -2398,10 +2510,14 @@ void DAcq::PrintStatistics(ostream &stream)
 
   } // end loop on module types
 
-  stream << "DAcq: Number of events read: " << fEventNumber << "." << endl;
+  stream << "DAcq: Number of events read: " << fEventNumber-fEventsSkipped << "." << endl;
+  if( fEventsSkipped>0 ) stream << "DAcq: Number of events skipped without reading (not in the numbers below): " << fEventsSkipped << "." << endl;
   stream << "DAcq: Number of events with synchro missed: " << fEventsMissed << "." << endl;
   stream << "DAcq: Number of events with data pb: " << fEventsDataNotOK << "." << endl;  // JB 2014/12/16
   stream << "DAcq: Number of events with module pb: " << fEventsModuleNotOK << "." << endl;// JB 2014/12/16
+  for( Int_t iPlane=0; iPlane<(Int_t)fHotPixelMask.size(); iPlane++) {
+    if( fHotPixelMask[iPlane] ) stream << "DAcq: Number of hot pixels dropped in plane " << iPlane+1 << ": " << fHotPixelsMaskedN[iPlane] << "." << endl;
+  }
 
 }
 
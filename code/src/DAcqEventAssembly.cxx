@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------------------
+//
+// Assembly of the trigger, frame and timestamp lists of an event, see DAcqEventAssembly.h
+//
+// --------------------------------------------------------------------------------------
+
+#include "DAcqEventAssembly.h"
+
+// --------------------------------------------------------------------------------------
+
+DAcqEventAssembly::DAcqEventAssembly() {
+
+  for( int list=0; list<kLists; list++) {
+    fSizes[list]       = 0;
+    fMergedValid[list] = false;
+  }
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DAcqEventAssembly::Clear() {
+
+  // Forget the board lists of the previous event,
+  //  the capacity of the vectors is kept.
+
+  for( int list=0; list<kLists; list++) {
+    fSpans[list].clear();
+    fSizes[list]       = 0;
+    fMerged[list].clear();
+    fMergedValid[list] = false;
+  }
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DAcqEventAssembly::Add( int list, std::vector<int> *values, int where) {
+
+  if( values==0 ) return;
+
+  Span_t span;
+  span.values = values;
+  span.where  = where;
+  fSpans[list].push_back( span);
+  fSizes[list] += values->size();
+  fMergedValid[list] = false;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DAcqEventAssembly::AddBoard( std::vector<int> *triggers, std::vector<int> *frames, std::vector<int> *timestamps) {
+
+  Add( kTriggers,   triggers,   kAppend);
+  Add( kFrames,     frames,     kPrepend);
+  Add( kTimestamps, timestamps, kPrepend);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+std::vector<int>* DAcqEventAssembly::Get( int list) {
+
+  // The board vector if it is the only one, the merged vector otherwise.
+
+  if( fSpans[list].size()==1 ) return fSpans[list][0].values;
+  if( !fMergedValid[list] ) Merge( list);
+  return &fMerged[list];
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DAcqEventAssembly::Merge( int list) {
+
+  // Single pass over the values: the boards prepended, from the last one,
+  //  then the first board, then the boards appended.
+
+  std::vector<Span_t> &spans = fSpans[list];
+  std::vector<int>    &merged = fMerged[list];
+  merged.clear();
+  merged.reserve( fSizes[list]);
+
+  for( int iSpan=(int)spans.size()-1; iSpan>0; iSpan--) {
+    if( spans[iSpan].where==kPrepend ) merged.insert( merged.end(), spans[iSpan].values->begin(), spans[iSpan].values->end());
+  }
+  if( !spans.empty() ) merged.insert( merged.end(), spans[0].values->begin(), spans[0].values->end());
+  for( int iSpan=1; iSpan<(int)spans.size(); iSpan++) {
+    if( spans[iSpan].where==kAppend ) merged.insert( merged.end(), spans[iSpan].values->begin(), spans[iSpan].values->end());
+  }
+
+  fMergedValid[list] = true;
+
+}
@@ -1408,7 +1408,7 @@ void DBeaster::BuildMcTrueTsFromIpList(int iLadder){
                0.);
       ListOfHitsTsIpCandidat.push_back(r3);
 
-      HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsTsIpCandidat);
+      HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsTsIpCandidat, 2); // r1, r2 then the sensor indexes
       std::cout << "Sensor ID 1 = "<< MCInfoHolder->GetASimHit(FirstHitIdx + 0).sensorID<<" Sensor ID 2 = "<< MCInfoHolder->GetASimHit(FirstHitIdx + 1).sensorID<< '\n';
       std::cout << "Transverse   Momentum = " << pt <<"[MeV]"<< '\n';
       std::cout << "Longitudinal Momentum = " << pz <<"[MeV]"<< '\n';
@@ -1507,7 +1507,7 @@ void DBeaster::BuildMcTrueTsList(int iLadder){
     ListOfHitsTsCandidat.clear();
     ListOfHitsTsCandidat.push_back(r1);
     ListOfHitsTsCandidat.push_back(r2);
-    HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsTsCandidat);
+    HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsTsCandidat, 2); // r1, r2, no sensor indexes: analytic fit only
   }
   return;
 }
@@ -1567,7 +1567,7 @@ void DBeaster::BuildFakeRecoTsList(int iLadder){
      ListOfHitsFakeRecoTs.push_back(r2);
      ListOfHitsFakeRecoTs.push_back(r3);
 
-     HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsFakeRecoTs);
+     HelixParameter = aHelixFitter->GetHelixParameter(ListOfHitsFakeRecoTs, 2); // r1, r2 then the sensor indexes
    }
   return;
 }
@@ -0,0 +1,222 @@
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DEtaTable                                       //
+  //                                                                      //
+  // Eta correction computed from a list of CoG, as done by               //
+  //  MimosaAnalysis::ClusterPosition_eta: for a CoG x, the correction    //
+  //  is pitch*count/N - pitch/2, where count is the index of the first   //
+  //  element of the list greater than x (N if none).                     //
+  //                                                                      //
+  // Exact() finds count by a binary search on the running maximum of     //
+  //  the list, which gives the same index as the scan of the list, also  //
+  //  when the list is not sorted.                                        //
+  //                                                                      //
+  // Tabulate() builds a regular grid of cells, each one storing the      //
+  //  correction at its lower edge and the limit at its upper edge, so    //
+  //  that a step of the correction located on a cell edge is exact.      //
+  //  The grid is aligned on the largest step (the CoG of the single      //
+  //  pixel clusters typically) and refined by factors 2 until the        //
+  //  maximal deviation to Exact() is below the tolerance.                //
+  //  The deviation is computed exactly: between two list values the      //
+  //  correction is constant and the table linear, so the extrema are at  //
+  //  the cell edges, at each list value and at the float just below.     //
+  //                                                                      //
+  // The table (not the list) is streamed, MimosaAnalysis stores it in    //
+  //  the CorPar file next to the TreeEta, see UseCellsOf().              //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include "DEtaTable.h"
+#include "TMath.h"
+#include <math.h>
+
+ClassImp(DEtaTable)
+
+//______________________________________________________________________________
+//
+DEtaTable::DEtaTable()
+{
+  fListN        = 0;
+  fPitch        = 0.;
+  fTolerance    = 0.;
+  fMaxDeviation = 0.;
+  fCellsN       = 0;
+  fAnchor       = 0.;
+  fFirstCell    = 0;
+  fStep         = 1.;
+  fInvStep      = 1.;
+  fTmin         = 0.;
+  fTmax         = 0.;
+}
+
+//______________________________________________________________________________
+//
+DEtaTable::~DEtaTable()
+{
+}
+
+//______________________________________________________________________________
+//
+void DEtaTable::Clear( Option_t *)
+{
+  // Forget the list and the table.
+
+  fListN        = 0;
+  fMaxDeviation = 0.;
+  fThresholds.clear();
+  SetCellsN( 0);
+}
+
+//______________________________________________________________________________
+//
+void DEtaTable::SetList( const Float_t *aList, Int_t aListN, Float_t aPitch)
+{
+  // Define the list of CoG (um) and the pitch, the table is cleared.
+  // The running maximum of the list is kept for the binary search,
+  //  and the value where it has the largest step gives the grid anchor.
+
+  fListN = aListN>0 ? aListN : 0;
+  fPitch = aPitch;
+  fMaxDeviation = 0.;
+  SetCellsN( 0);
+
+  fThresholds.resize( fListN);
+  Int_t run = 0, largestRun = 0;
+  for( Int_t i=0; i<fListN; i++) {
+    fThresholds[i] = (i==0 || aList[i]>fThresholds[i-1]) ? aList[i] : fThresholds[i-1];
+    run = (i>0 && fThresholds[i]==fThresholds[i-1]) ? run+1 : 1;
+    if( run>largestRun ) {
+      largestRun = run;
+      fAnchor = fThresholds[i];
+    }
+  }
+}
+
+//______________________________________________________________________________
+//
+void DEtaTable::SetCellsN( Int_t nCells)
+{
+  fCellsN = nCells;
+  fCells.resize( 2*nCells);
+  fInvStep = 1./fStep;
+  fTmin    = fFirstCell;
+  fTmax    = fFirstCell + (nCells>0 ? nCells-1 : 0);
+}
+
+//______________________________________________________________________________
+//
+Double_t DEtaTable::ExactAt( Double_t x, Bool_t leftLimit) const
+{
+  // Exact correction at x, or its limit when approaching x from below.
+
+  Int_t count = (Int_t)( leftLimit ?
+                         std::lower_bound( fThresholds.begin(), fThresholds.end(), x) - fThresholds.begin()
+                         : std::upper_bound( fThresholds.begin(), fThresholds.end(), x) - fThresholds.begin() );
+  return fPitch*(Float_t(count)/Float_t(fListN)) - fPitch/2.;
+}
+
+//______________________________________________________________________________
+//
+void DEtaTable::Fill( Int_t nCells)
+{
+  // Grid of about nCells cells covering the list, the first and the last
+  //  cells being constant (below and above all the list values).
+
+  Double_t first = fThresholds.front();
+  Double_t last  = fThresholds.back();
+  Double_t range = last - first;
+
+  int exponent = 0;
+  if( range>0. ) frexp( range/(nCells-3), &exponent);
+  fStep = ldexp( 1., exponent);
+
+  fFirstCell = (Int_t)floor( (first-fAnchor)/fStep) - 1;
+  SetCellsN( (Int_t)ceil( (last-fAnchor)/fStep) - fFirstCell + 1);
+
+  for( Int_t i=0; i<fCellsN; i++) {
+    fCells[2*i]   = ExactAt( fAnchor + (fFirstCell+i)*fStep, kFALSE);
+    fCells[2*i+1] = ExactAt( fAnchor + (fFirstCell+i+1)*fStep, kTRUE);
+  }
+  fCells[2*fCellsN-1] = fCells[2*fCellsN-2];
+}
+
+//______________________________________________________________________________
+//
+Double_t DEtaTable::ComputeMaxDeviation() const
+{
+  // Maximal difference between the table and Exact().
+
+  Double_t deviation = 0.;
+
+  // cell edges, the rounding of the stored values only
+  for( Int_t i=0; i<fCellsN; i++) {
+    Double_t edge = fAnchor + (fFirstCell+i)*fStep;
+    deviation = TMath::Max( deviation, fabs( fCells[2*i] - ExactAt( edge, kFALSE)));
+    if( i<fCellsN-1 ) deviation = TMath::Max( deviation, fabs( fCells[2*i+1] - ExactAt( edge+fStep, kTRUE)));
+  }
+
+  // each list value and the float just below
+  for( Int_t i=0; i<fListN; i++) {
+    if( i>0 && fThresholds[i]==fThresholds[i-1] ) continue;
+    Float_t x = fThresholds[i];
+    Float_t below = nextafterf( x, -HUGE_VALF);
+    deviation = TMath::Max( deviation, fabs( Interpolate( x) - ExactAt( x, kFALSE)));
+    deviation = TMath::Max( deviation, fabs( Interpolate( below) - ExactAt( below, kFALSE)));
+  }
+
+  return deviation;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DEtaTable::Tabulate( Double_t aTolerance, Int_t maxCells)
+{
+  // Build the table with the coarsest grid matching Exact() within
+  //  aTolerance (um), starting from kMinCells cells.
+  // Returns kFALSE (and Eval() uses Exact()) if maxCells are not enough,
+  //  if the tolerance is not positive or the list empty.
+
+  fTolerance = aTolerance;
+  fMaxDeviation = 0.;
+  SetCellsN( 0);
+  if( fListN==0 || aTolerance<=0. ) return kFALSE;
+
+  for( Int_t nCells=kMinCells; nCells<=maxCells; nCells*=2) {
+    Fill( nCells);
+    fMaxDeviation = ComputeMaxDeviation();
+    if( fMaxDeviation<=aTolerance ) return kTRUE;
+  }
+
+  SetCellsN( 0);
+  return kFALSE;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DEtaTable::UseCellsOf( const DEtaTable &aTable, Double_t aTolerance)
+{
+  // Take the table of aTable (read from a file) if it was built from a list
+  //  of the same size and pitch, and if it matches Exact() on the current
+  //  list within aTolerance.
+  // Returns kFALSE otherwise, the table is then cleared.
+
+  fTolerance = aTolerance;
+  fMaxDeviation = 0.;
+  SetCellsN( 0);
+  if( fListN==0 || aTolerance<=0. || !aTable.IsTabulated()
+      || aTable.GetListN()!=fListN || aTable.GetPitch()!=fPitch ) return kFALSE;
+
+  Float_t anchor = fAnchor;
+  fAnchor    = aTable.fAnchor;
+  fFirstCell = aTable.fFirstCell;
+  fStep      = aTable.fStep;
+  SetCellsN( aTable.fCellsN);
+  fCells = aTable.fCells;
+
+  fMaxDeviation = ComputeMaxDeviation();
+  if( fMaxDeviation<=aTolerance ) return kTRUE;
+
+  fAnchor = anchor;
+  SetCellsN( 0);
+  return kFALSE;
+}
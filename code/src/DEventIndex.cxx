@@ -0,0 +1,197 @@
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DEventIndex                                     //
+  //                                                                      //
+  // Event index of a raw data run, see DEventIndex.h.                    //
+  //                                                                      //
+  // The board reader calls Add() for each event read sequentially,       //
+  //  SetComplete() when the last file is done, and WriteToFile().        //
+  // At the next start, ReadFromFile() returns kFALSE if the index does   //
+  //  not match the current raw files (their sizes are compared).         //
+  //                                                                      //
+  // Binary file format:                                                  //
+  //  magic, version (32 bits), n files (32 bits), file sizes (64 bits),  //
+  //  n entries (32 bits), entries: file number (32 bits),                //
+  //  offset (64 bits), acq id, frame id, trigger (32 bits)               //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include "DEventIndex.h"
+#include "Riostream.h"
+
+ClassImp(DEventIndex)
+
+static const UInt_t kEventIndexMagic   = 0x58444954; // "TIDX"
+static const UInt_t kEventIndexVersion = 1;
+
+//______________________________________________________________________________
+//
+DEventIndex::DEventIndex()
+{
+  fComplete       = kFALSE;
+  fTriggersSorted = kTRUE;
+}
+
+//______________________________________________________________________________
+//
+DEventIndex::~DEventIndex()
+{
+}
+
+//______________________________________________________________________________
+//
+void DEventIndex::Reset()
+{
+  // Remove all the entries, keep the file sizes.
+
+  fEntries.clear();
+  fComplete       = kFALSE;
+  fTriggersSorted = kTRUE;
+}
+
+//______________________________________________________________________________
+//
+void DEventIndex::Add( Int_t fileNumber, Long64_t offset, Int_t acqId, Int_t frameId, Int_t trigger)
+{
+  // Append the position of the next event.
+
+  Entry_t entry;
+  entry.fileNumber = fileNumber;
+  entry.offset     = offset;
+  entry.acqId      = acqId;
+  entry.frameId    = frameId;
+  entry.trigger    = trigger;
+  if( !fEntries.empty() && trigger<fEntries.back().trigger ) fTriggersSorted = kFALSE;
+  fEntries.push_back( entry);
+}
+
+//______________________________________________________________________________
+//
+Int_t DEventIndex::FindTrigger( Int_t aTrigger) const
+{
+  // Return the number of the event carrying the trigger aTrigger,
+  //  -1 if it is not in the index.
+  // Binary search when the triggers are increasing, linear otherwise.
+
+  if( fEntries.empty() || aTrigger<0 ) return -1;
+
+  if( fTriggersSorted ) {
+    Int_t low = 0, high = (Int_t)fEntries.size()-1;
+    while( low<high ) {
+      Int_t middle = (low+high)/2;
+      if( fEntries[middle].trigger<aTrigger ) low = middle+1;
+      else high = middle;
+    }
+    return fEntries[low].trigger==aTrigger ? low : -1;
+  }
+
+  for( Int_t iEvent=0; iEvent<(Int_t)fEntries.size(); iEvent++) {
+    if( fEntries[iEvent].trigger==aTrigger ) return iEvent;
+  }
+  return -1;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DEventIndex::GetChunk( Int_t iChunk, Int_t nChunks, Int_t &firstEvent, Int_t &lastEvent) const
+{
+  // Split the run into nChunks contiguous ranges of events of similar size
+  //  and return the range [firstEvent, lastEvent] of chunk iChunk (0 to nChunks-1).
+  // The byte position where a chunk starts is given by GetEntry( firstEvent),
+  //  so that each chunk can be read independently.
+  // Return kFALSE if the index is not complete or the chunk is empty.
+
+  firstEvent = 0;
+  lastEvent = -1;
+  if( !fComplete || nChunks<1 || iChunk<0 || iChunk>=nChunks ) return kFALSE;
+
+  Long64_t nEvents = (Long64_t)fEntries.size();
+  firstEvent = (Int_t)( nEvents*iChunk/nChunks );
+  lastEvent  = (Int_t)( nEvents*(iChunk+1)/nChunks ) - 1;
+
+  return lastEvent>=firstEvent;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DEventIndex::WriteToFile( const char *fileName) const
+{
+  // Save the index in a binary file, return kFALSE if it failed.
+  // Only a complete index is worth saving.
+
+  if( !fComplete ) return kFALSE;
+
+  ofstream indexFile( fileName, ios::out | ios::binary);
+  if( indexFile.fail() ) {
+    printf("WARNING DEventIndex: cannot write file %s\n", fileName);
+    return kFALSE;
+  }
+
+  UInt_t header[3] = { kEventIndexMagic, kEventIndexVersion, (UInt_t)fFileSizes.size() };
+  indexFile.write( (const char*)header, sizeof(header));
+  if( !fFileSizes.empty() ) indexFile.write( (const char*)&fFileSizes[0], fFileSizes.size()*sizeof(Long64_t));
+
+  UInt_t nEntries = (UInt_t)fEntries.size();
+  indexFile.write( (const char*)&nEntries, sizeof(UInt_t));
+  for( UInt_t iEntry=0; iEntry<nEntries; iEntry++) {
+    const Entry_t &entry = fEntries[iEntry];
+    indexFile.write( (const char*)&entry.fileNumber, sizeof(Int_t));
+    indexFile.write( (const char*)&entry.offset, sizeof(Long64_t));
+    indexFile.write( (const char*)&entry.acqId, sizeof(Int_t));
+    indexFile.write( (const char*)&entry.frameId, sizeof(Int_t));
+    indexFile.write( (const char*)&entry.trigger, sizeof(Int_t));
+  }
+
+  return indexFile.good();
+}
+
+//______________________________________________________________________________
+//
+Bool_t DEventIndex::ReadFromFile( const char *fileName)
+{
+  // Read an index written by WriteToFile.
+  // The file sizes set with SetFileSizes before the call must be
+  //  identical to the ones stored, otherwise the index is stale.
+  // Return kFALSE if the file does not exist, is not an index file,
+  //  or does not match the raw files; the index is then left empty.
+
+  Reset();
+
+  ifstream indexFile( fileName, ios::in | ios::binary);
+  if( indexFile.fail() ) return kFALSE;
+
+  UInt_t header[3];
+  indexFile.read( (char*)header, sizeof(header));
+  if( !indexFile.good() || header[0]!=kEventIndexMagic || header[1]!=kEventIndexVersion ) {
+    printf("WARNING DEventIndex: %s is not an event index file, ignored.\n", fileName);
+    return kFALSE;
+  }
+
+  std::vector<Long64_t> fileSizes( header[2], 0);
+  if( header[2]>0 ) indexFile.read( (char*)&fileSizes[0], header[2]*sizeof(Long64_t));
+  if( fileSizes!=fFileSizes ) {
+    printf("WARNING DEventIndex: %s was built for other raw files, ignored.\n", fileName);
+    return kFALSE;
+  }
+
+  UInt_t nEntries = 0;
+  indexFile.read( (char*)&nEntries, sizeof(UInt_t));
+  fEntries.reserve( nEntries);
+  Entry_t entry;
+  for( UInt_t iEntry=0; iEntry<nEntries && indexFile.good(); iEntry++) {
+    indexFile.read( (char*)&entry.fileNumber, sizeof(Int_t));
+    indexFile.read( (char*)&entry.offset, sizeof(Long64_t));
+    indexFile.read( (char*)&entry.acqId, sizeof(Int_t));
+    indexFile.read( (char*)&entry.frameId, sizeof(Int_t));
+    indexFile.read( (char*)&entry.trigger, sizeof(Int_t));
+    if( indexFile.good() ) Add( entry.fileNumber, entry.offset, entry.acqId, entry.frameId, entry.trigger);
+  }
+  if( fEntries.size()!=nEntries ) {
+    printf("WARNING DEventIndex: file %s is truncated, ignored.\n", fileName);
+    Reset();
+    return kFALSE;
+  }
+
+  fComplete = kTRUE;
+  return kTRUE;
+}
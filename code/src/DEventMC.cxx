@@ -22,6 +22,7 @@
 #include "DCut.h"
 #include "DAcq.h"
 #include "DGlobalTools.h"
+#include <algorithm>
 
 
 ClassImp(DEvent)
@@ -72,6 +73,68 @@ void DEventMC::ResetLists(void)
   
   return;
   
+}
+//_____________________________________________________________________________
+//
+void  DEventMC::GetMostFrequentIdx(std::vector<int> &IdxList, int &BestIdx, int &BestCount)
+{
+
+  // Returns the index appearing the most often in IdxList (BestIdx)
+  // and the number of times it appears (BestCount).
+  // When several indexes appear as often, the first one in IdxList is taken.
+  // When IdxList has only 2 different entries, the first one different from -1
+  // (i.e. not noise) is taken.
+  //
+  // The counting is done on a sorted copy of the list kept in a member buffer,
+  // so there is no allocation once the buffer has grown to the largest cluster.
+
+  int N = int(IdxList.size());
+  if(N == 0) {
+    BestIdx   = -1;
+    BestCount =  0;
+    return;
+  }
+
+  if(N == 2 && IdxList[0] != IdxList[1]) {
+    BestIdx   = (IdxList[0] != -1)? IdxList[0] : IdxList[1];
+    BestCount = 1;
+    return;
+  }
+
+  fSortedIdxList.assign(IdxList.begin(), IdxList.end());
+  std::sort(fSortedIdxList.begin(), fSortedIdxList.end());
+
+  // largest run length in the sorted list, and number of runs reaching it
+  int maxCount = 0;
+  int nRunsAtMax = 0;
+  int maxIdx = fSortedIdxList[0];
+  for(int i=0; i<N; ) {
+    int j = i+1;
+    while(j < N && fSortedIdxList[j] == fSortedIdxList[i]) j++;
+    if(j-i > maxCount) {
+      maxCount   = j-i;
+      maxIdx     = fSortedIdxList[i];
+      nRunsAtMax = 1;
+    }
+    else if(j-i == maxCount) nRunsAtMax++;
+    i = j;
+  }
+
+  if(nRunsAtMax > 1) { // tie, keep the first one in the original order
+    for(int i=0; i<N; i++) {
+      std::pair<std::vector<int>::iterator, std::vector<int>::iterator> range = std::equal_range(fSortedIdxList.begin(), fSortedIdxList.end(), IdxList[i]);
+      if(int(range.second-range.first) == maxCount) {
+        maxIdx = IdxList[i];
+        break;
+      }
+    }
+  }
+
+  BestIdx   = maxIdx;
+  BestCount = maxCount;
+
+  return;
+
 }
 //_____________________________________________________________________________
 //
@@ -97,83 +160,13 @@ void  DEventMC::DoHitTruthMatching(DHit* aHit, int &MCHitID, int &NpixelsMCHitID
     return;
   }
   
-  std::vector<int> MCHitIdxList;
-  MCHitIdxList.clear();
+  DPlane *aPlane = aHit->GetPlane();
+  fMatchIdxList.clear();
   for(int ipixInHit=0;ipixInHit < NpixelsInCluster;ipixInHit++) {
-    MCHitIdxList.push_back((aHit->GetPlane()->GetPixelFromList(aHit->GetIndexInOriginalList(ipixInHit)))->GetPixelMCHitIdx());
-  }
-  
-  //List of non-repeated 
-  std::vector<int> ReducedMCHitIdxList;
-  ReducedMCHitIdxList.clear();
-  std::vector<int> ReducedMCHitIdxList_Npixels;
-  ReducedMCHitIdxList_Npixels.clear();
-  //Check how many different hit indexes are in this hit
-  for(int i=0;i<int(MCHitIdxList.size());i++) {
-    //Check if index  is already included in the list
-    bool IsNotAlreadyInList = true;
-    for(int iredu=0;iredu<int(ReducedMCHitIdxList.size());iredu++) {
-      if(ReducedMCHitIdxList[iredu] == MCHitIdxList[i]) {
-	IsNotAlreadyInList = false;
-	break;
-      }
-    }
-    
-    if(IsNotAlreadyInList) {
-      ReducedMCHitIdxList.push_back(MCHitIdxList[i]);
-      ReducedMCHitIdxList_Npixels.push_back(0);
-    }
+    fMatchIdxList.push_back((aPlane->GetPixelFromList(aHit->GetIndexInOriginalList(ipixInHit)))->GetPixelMCHitIdx());
   }
   
-  //Now counts many many times a given hit index repeats itself
-  for(int i=0;i<int(MCHitIdxList.size());i++) {
-    for(int iredu=0;iredu<int(ReducedMCHitIdxList.size());iredu++) {
-      if(ReducedMCHitIdxList[iredu] == MCHitIdxList[i]) {
-	ReducedMCHitIdxList_Npixels[iredu]++;
-	break;
-      }
-    }
-  }
-  
-  //Now orders the list of according to the number of times a given index repeats
-  for(int iii=2;iii<=int(ReducedMCHitIdxList.size());iii++) {
-    for(int jjj=0;jjj<=int(ReducedMCHitIdxList.size())-iii;jjj++) {
-      int N_jjj   = ReducedMCHitIdxList_Npixels[jjj];
-      int N_jjjp1 = ReducedMCHitIdxList_Npixels[jjj+1];
-      
-      if(N_jjj > N_jjjp1) {
-	int idx_aux                        = ReducedMCHitIdxList[jjj];
-	ReducedMCHitIdxList[jjj]           = ReducedMCHitIdxList[jjj+1];
-	ReducedMCHitIdxList[jjj+1]         = idx_aux;
-	
-	int N_aux                          = ReducedMCHitIdxList_Npixels[jjj];
-	ReducedMCHitIdxList_Npixels[jjj]   = ReducedMCHitIdxList_Npixels[jjj+1];
-	ReducedMCHitIdxList_Npixels[jjj+1] = N_aux;
-      }
-    }
-  }
-  
-  if(NpixelsInCluster == 2 && ReducedMCHitIdxList.size() > 1) {
-    // If reconstructed hit has only 2 pixels then take as the truth-matched 
-    // one that which is higher than -1 (i.e. coming from a real particle)
-    for(int iredu=0;iredu<int(ReducedMCHitIdxList.size());iredu++) {
-      if(ReducedMCHitIdxList[iredu] != -1) {
-	MCHitID        = ReducedMCHitIdxList[iredu];
-	NpixelsMCHitID = ReducedMCHitIdxList_Npixels[iredu];
-	break;
-      }
-    }
-  }
-  else {
-    // If reconstructed hit is not exacty 2 pixels size, then take the 
-    // MC-hit ID with the largest number of pixels in this cluster
-    MCHitID        = ReducedMCHitIdxList[0];
-    NpixelsMCHitID = ReducedMCHitIdxList_Npixels[0];
-  }
-  
-  MCHitIdxList.clear();
-  ReducedMCHitIdxList.clear();
-  ReducedMCHitIdxList_Npixels.clear();
+  GetMostFrequentIdx(fMatchIdxList, MCHitID, NpixelsMCHitID);
   
   return;
   
@@ -193,88 +186,53 @@ void  DEventMC::DoTrackTruthMatching(DTrack* aTrack, int &MCPartID, int &NHitsMC
   // - Returns as well the number of hits in the reconstructed track belogning to the MC-particle with ID = MCPartID
   
   
-  std::vector<int> MCPartIdxList;
-  MCPartIdxList.clear();
+  fMatchIdxList.clear();
   for(int ihitInTrk=0;ihitInTrk < aTrack->GetHitsNumber();ihitInTrk++) {
     int MCHitID = aTrack->GetHit(ihitInTrk)->GetMCHitID();
-    if(MCHitID < 0) MCPartIdxList.push_back(-1);
-    MCPartIdxList.push_back(GetASimHit(MCHitID).ParticleIdx);
+    if(MCHitID < 0) fMatchIdxList.push_back(-1);
+    else            fMatchIdxList.push_back(ListOfSimHits[MCHitID].ParticleIdx);
   }
 
-  //List of non-repeated 
-  std::vector<int> ReducedMCPartIdxList;
-  ReducedMCPartIdxList.clear();
-  std::vector<int> ReducedMCPartIdxList_NHits;
-  ReducedMCPartIdxList_NHits.clear();
-  //Check how many different MC-particle indexes are in this track
-  for(int i=0;i<int(MCPartIdxList.size());i++) {
-    //Check if index  is already included in the list
-    bool IsNotAlreadyInList = true;
-    for(int iredu=0;iredu<int(ReducedMCPartIdxList.size());iredu++) {
-      if(ReducedMCPartIdxList[iredu] == MCPartIdxList[i]) {
-	IsNotAlreadyInList = false;
-	break;
-      }
-    }
-    
-    if(IsNotAlreadyInList) {
-      ReducedMCPartIdxList.push_back(MCPartIdxList[i]);
-      ReducedMCPartIdxList_NHits.push_back(0);
-    }
-  }
+  GetMostFrequentIdx(fMatchIdxList, MCPartID, NHitsMCPartID);
+  
+  return;
+  
+}
+//_____________________________________________________________________________
+//
+void  DEventMC::DoHitsTruthMatching(int NHits, DHit** HitList)
+{
 
-  //Now counts many many times a given MC-particle index repeats itself
-  for(int i=0;i<int(MCPartIdxList.size());i++) {
-    for(int iredu=0;iredu<int(ReducedMCPartIdxList.size());iredu++) {
-      if(ReducedMCPartIdxList[iredu] == MCPartIdxList[i]) {
-	ReducedMCPartIdxList_NHits[iredu]++;
-	break;
-      }
-    }
-  }
+  // Truth matching of all the hits of a plane in one go,
+  // the results are stored in the hits.
 
-  //Now orders the list of according to the number of times a given index repeats
-  for(int iii=2;iii<=int(ReducedMCPartIdxList.size());iii++) {
-    for(int jjj=0;jjj<=int(ReducedMCPartIdxList.size())-iii;jjj++) {
-      int N_jjj   = ReducedMCPartIdxList_NHits[jjj];
-      int N_jjjp1 = ReducedMCPartIdxList_NHits[jjj+1];
-      
-      if(N_jjj > N_jjjp1) {
-	int idx_aux                       = ReducedMCPartIdxList[jjj];
-	ReducedMCPartIdxList[jjj]         = ReducedMCPartIdxList[jjj+1];
-	ReducedMCPartIdxList[jjj+1]       = idx_aux;
-	
-	int N_aux                         = ReducedMCPartIdxList_NHits[jjj];
-	ReducedMCPartIdxList_NHits[jjj]   = ReducedMCPartIdxList_NHits[jjj+1];
-	ReducedMCPartIdxList_NHits[jjj+1] = N_aux;
-      }
-    }
+  int MCHitID, NpixelsMCHitID;
+  for(int ihit=0;ihit<NHits;ihit++) {
+    DoHitTruthMatching(HitList[ihit],MCHitID,NpixelsMCHitID);
+    HitList[ihit]->SetMCHitID(MCHitID);
+    HitList[ihit]->SetStripsFromMCHitID(NpixelsMCHitID);
   }
 
-  if(aTrack->GetHitsNumber() == 2 && ReducedMCPartIdxList.size() > 1) {
-    // If reconstructed track has only 2 hits then take as the truth-matched 
-    // one that which is higher than -1 (i.e. coming from a real particle)
-    for(int iredu=0;iredu<int(ReducedMCPartIdxList.size());iredu++) {
-      if(ReducedMCPartIdxList[iredu] != -1) {
-	MCPartID      = ReducedMCPartIdxList[iredu];
-	NHitsMCPartID = ReducedMCPartIdxList_NHits[iredu];
-	break;
-      }
-    }
-  }
-  else {
-    // If reconstructed tracks is has not exacty 2 hits, then take the 
-    // MC-particle ID with the largest number of hits in this track
-    MCPartID      = ReducedMCPartIdxList[0];
-    NHitsMCPartID = ReducedMCPartIdxList_NHits[0];
+  return;
+
+}
+//_____________________________________________________________________________
+//
+void  DEventMC::DoTracksTruthMatching(int NTracks, DTrack** TrackList)
+{
+
+  // Truth matching of all the tracks of the tracker in one go,
+  // the results are stored in the tracks.
+
+  int MCPartID, NHitsMCPartID;
+  for(int itrk=0;itrk<NTracks;itrk++) {
+    DoTrackTruthMatching(TrackList[itrk],MCPartID,NHitsMCPartID);
+    TrackList[itrk]->SetMCPartID(MCPartID);
+    TrackList[itrk]->SetHitsFromMCPartID(NHitsMCPartID);
   }
 
-  MCPartIdxList.clear();
-  ReducedMCPartIdxList.clear();
-  ReducedMCPartIdxList_NHits.clear();
-  
   return;
-  
+
 }
 //_____________________________________________________________________________
 //
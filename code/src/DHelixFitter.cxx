@@ -3,7 +3,11 @@
 //Purpose of Class :
 //    Holds all the modules needed to perform Helix fitting
 //          - GetHelixParameter            : Perform Helix fitting with Hits give in Arguments
-//            Sub modules of GetHelixParameter
+//                                           dispatch to the analytic fit (default) or to Minuit
+//          - GetHelixParameterAnalytic    : Karimaki circle fit + linear s-z fit, optional
+//                                           Gauss-Newton refinement, no allocation per call
+//          - GetHelixParameterMinuit      : Chi2 minimisation with TMinuit, kept for validation
+//            Sub modules of GetHelixParameterMinuit
 //            -- GetResidual               : Give residual for the Chisquare minimization
 //            -- BuiltCovarianceMatrix     : Built Covariance matrix
 //            -- GetIntersectionHelixPlane : Get intersection of the helix with the sensor plane
@@ -24,21 +28,261 @@ DHelixFitter::DHelixFitter(DTracker *Tracker)
 {
   tTracker=Tracker;
   fgInstance=this;
+  aHelix=0;
+  ptMinuit=0;
+  fFitMethod=kHelixFitAnalytic;
+  fRefineFit=true;
+  fDebug=0;
+  fBField=1.5;
+  // same resolutions as in BuiltCovarianceMatrix, in mm
+  fSigmaIP_RPhi=2e-2;
+  fSigmaIP_Z=4e-1;
+  fSigmaHit_RPhi=3e-3;
+  fSigmaHit_Z=3e-3;
+  fLastFit.IsValid=false;
 return;
 }
 DHelixFitter::~DHelixFitter(){
   return;
 }
 //===========================================================================================================
-TVector3 DHelixFitter::GetHelixParameter(vector<TVector3> ListOfHits){
-  // DHelixFitter *aHelixFitter = new DHelixFitter();
-  std::cout << "GetHelixParameter" << '\n';
+TVector3 DHelixFitter::GetHelixParameter(const vector<TVector3> &ListOfHits, int nPositions){
+  // Fit a helix through the origin and the hits given in ListOfHits
+  //  ListOfHits[0] to [nPositions-1] are the hit positions in the lab frame [mm],
+  //  ListOfHits[nPositions], if given, holds the sensor indexes of the first two hits
+  //  (required by the Minuit fit, which uses two hits, ignored by the analytic fit).
+  // Returns (transverse momentum [GeV/c], chi2, tan(lambda)),
+  //  the momentum being signed by the charge.
+  //
+  // The analytic fit is used by default, the Minuit fit is kept for validation,
+  //  select it with SetFitMethod(DHelixFitter::kHelixFitMinuit).
+
+  if( fFitMethod==kHelixFitMinuit ) return GetHelixParameterMinuit(ListOfHits, nPositions);
+  return GetHelixParameterAnalytic(ListOfHits, nPositions);
+}
+//===========================================================================================================
+TVector3 DHelixFitter::GetHelixParameterAnalytic(const vector<TVector3> &ListOfHits, int nPositions){
+  // Analytic helix fit of the origin (beam spot constraint) plus the first
+  // nPositions hits of ListOfHits, see FitHelixAnalytic.
+  // An entry after them (sensor indexes for the Minuit fit) is not used.
+
+  int nHits = nPositions;
+  if( nHits>(int)ListOfHits.size() ) nHits = ListOfHits.size();
+  if( nHits>kMaxFitPoints-1 ) nHits = kMaxFitPoints-1;
+
+  int nPoints = 0;
+  fFitX[nPoints] = 0.;
+  fFitY[nPoints] = 0.;
+  fFitZ[nPoints] = 0.;
+  fFitSigRPhi[nPoints] = fSigmaIP_RPhi;
+  fFitSigZ[nPoints] = fSigmaIP_Z;
+  nPoints++;
+  for( int iHit=0; iHit<nHits; iHit++ ) {
+    fFitX[nPoints] = ListOfHits[iHit].X();
+    fFitY[nPoints] = ListOfHits[iHit].Y();
+    fFitZ[nPoints] = ListOfHits[iHit].Z();
+    fFitSigRPhi[nPoints] = fSigmaHit_RPhi;
+    fFitSigZ[nPoints] = fSigmaHit_Z;
+    nPoints++;
+  }
+
+  FitHelixAnalytic( nPoints, fFitX, fFitY, fFitZ, fFitSigRPhi, fFitSigZ, fLastFit);
+
+  if( fDebug ) {
+    printf("DHelixFitter::GetHelixParameterAnalytic %d points, valid=%d: pt=%.4f GeV, R=%.2f mm, phi=%.4f, d0=%.4f mm, z0=%.4f mm, tanL=%.4f, chi2 circle=%.3f, chi2 z=%.3f\n", nPoints, fLastFit.IsValid, fLastFit.Pt, fLastFit.Radius, fLastFit.Phi, fLastFit.D0, fLastFit.Z0, fLastFit.TanLambda, fLastFit.Chi2Circle, fLastFit.Chi2Z);
+  }
+
+  if( !fLastFit.IsValid ) return TVector3( -999., -999., -999.);
+  return TVector3( fLastFit.Pt, fLastFit.Chi2Circle+fLastFit.Chi2Z, fLastFit.TanLambda);
+}
+//===========================================================================================================
+bool DHelixFitter::FitHelixAnalytic(int nPoints, const double *x, const double *y, const double *z, const double *sigRPhi, const double *sigZ, HelixFitResult &result){
+  // Fast helix fit, the field is along z.
+  //
+  // 1) Karimaki circle fit in the transverse plane,
+  //    NIM A305 (1991) 187, parameters (rho, phi, d0) wrt the origin,
+  // 2) optionally, one Gauss-Newton step on (xc, yc, R) minimising the
+  //    true geometric distance of the points to the circle,
+  // 3) linear weighted fit z = z0 + tan(lambda)*s, s being the arc length
+  //    from the point of closest approach.
+  //
+  // Only fixed size local arrays are used, so this can be called for
+  // any number of candidates without heap allocation.
+
+  result.IsValid = false;
+  result.Rho = result.Phi = result.D0 = result.Z0 = result.TanLambda = 0.;
+  result.Xc = result.Yc = result.Radius = result.Pt = 0.;
+  result.Chi2Circle = result.Chi2Z = 0.;
+  result.NDF = 0;
+  if( nPoints<3 || nPoints>kMaxFitPoints ) return false;
+
+  // --- circle, Karimaki
+  double sw=0., sx=0., sy=0., sxx=0., sxy=0., syy=0., sr2=0., sxr=0., syr=0., srr=0.;
+  for( int i=0; i<nPoints; i++ ) {
+    double w = 1./(sigRPhi[i]*sigRPhi[i]);
+    double r2 = x[i]*x[i]+y[i]*y[i];
+    sw  += w;
+    sx  += w*x[i];
+    sy  += w*y[i];
+    sxx += w*x[i]*x[i];
+    sxy += w*x[i]*y[i];
+    syy += w*y[i]*y[i];
+    sr2 += w*r2;
+    sxr += w*x[i]*r2;
+    syr += w*y[i]*r2;
+    srr += w*r2*r2;
+  }
+  double xm = sx/sw, ym = sy/sw, r2m = sr2/sw;
+  double cxx = sxx/sw - xm*xm;
+  double cxy = sxy/sw - xm*ym;
+  double cyy = syy/sw - ym*ym;
+  double cxr = sxr/sw - xm*r2m;
+  double cyr = syr/sw - ym*r2m;
+  double crr = srr/sw - r2m*r2m;
+  if( crr<=0. ) return false;
+
+  double q1 = crr*cxy - cxr*cyr;
+  double q2 = crr*(cxx-cyy) - cxr*cxr + cyr*cyr;
+  double phi = 0.5*atan2( 2.*q1, q2);
+  double sphi = sin(phi), cphi = cos(phi);
+  double kappa = (sphi*cxr - cphi*cyr)/crr;
+  double delta = -kappa*r2m + sphi*xm - cphi*ym;
+  double disc = 1.-4.*delta*kappa;
+  if( disc<=0. || kappa==0. ) return false;
+  double rho = 2.*kappa/sqrt(disc);
+  double d0 = 2.*delta/(1.+sqrt(disc));
+
+  // The sign of phi is ambiguous by pi, orient the track from the origin
+  // towards the first measured point
+  double dirx = x[1]-x[0], diry = y[1]-y[0];
+  if( cphi*dirx + sphi*diry < 0. ) {
+    phi += (phi>0.)?-M_PI:M_PI;
+    sphi = -sphi;
+    cphi = -cphi;
+    rho = -rho;
+    d0 = -d0;
+  }
+
+  double xc = (d0+1./rho)*sphi;
+  double yc = -(d0+1./rho)*cphi;
+  double radius = fabs(1./rho);
+
+  // --- optional Gauss-Newton step on the geometric distance
+  if( fRefineFit ) {
+    double a[3][3] = {{0.,0.,0.},{0.,0.,0.},{0.,0.,0.}};
+    double b[3] = {0.,0.,0.};
+    for( int i=0; i<nPoints; i++ ) {
+      double w = 1./(sigRPhi[i]*sigRPhi[i]);
+      double dx = x[i]-xc, dy = y[i]-yc;
+      double dist = sqrt(dx*dx+dy*dy);
+      if( dist<=0. ) continue;
+      double jac[3] = { -dx/dist, -dy/dist, -1.};
+      double res = dist-radius;
+      for( int j=0; j<3; j++ ) {
+        b[j] -= w*jac[j]*res;
+        for( int k=0; k<3; k++ ) a[j][k] += w*jac[j]*jac[k];
+      }
+    }
+    // solve the 3x3 normal equations with Cramer's rule
+    double det = a[0][0]*(a[1][1]*a[2][2]-a[1][2]*a[2][1])
+               - a[0][1]*(a[1][0]*a[2][2]-a[1][2]*a[2][0])
+               + a[0][2]*(a[1][0]*a[2][1]-a[1][1]*a[2][0]);
+    if( fabs(det)>1e-30 ) {
+      double dxc = ( b[0]*(a[1][1]*a[2][2]-a[1][2]*a[2][1])
+                   - a[0][1]*(b[1]*a[2][2]-a[1][2]*b[2])
+                   + a[0][2]*(b[1]*a[2][1]-a[1][1]*b[2]) )/det;
+      double dyc = ( a[0][0]*(b[1]*a[2][2]-a[1][2]*b[2])
+                   - b[0]*(a[1][0]*a[2][2]-a[1][2]*a[2][0])
+                   + a[0][2]*(a[1][0]*b[2]-b[1]*a[2][0]) )/det;
+      double dr  = ( a[0][0]*(a[1][1]*b[2]-b[1]*a[2][1])
+                   - a[0][1]*(a[1][0]*b[2]-b[1]*a[2][0])
+                   + b[0]*(a[1][0]*a[2][1]-a[1][1]*a[2][0]) )/det;
+      xc += dxc;
+      yc += dyc;
+      radius += dr;
+      if( radius>0. ) {
+        // back to (rho, phi, d0), keeping the orientation found above
+        double sign = (rho>0.)?1.:-1.;
+        double dc = sqrt(xc*xc+yc*yc);
+        rho = sign/radius;
+        sphi = sign*xc/dc;
+        cphi = -sign*yc/dc;
+        phi = atan2( sphi, cphi);
+        d0 = sign*(dc-radius);
+      }
+    }
+  }
+
+  double chi2Circle = 0.;
+  for( int i=0; i<nPoints; i++ ) {
+    double res = sqrt((x[i]-xc)*(x[i]-xc)+(y[i]-yc)*(y[i]-yc))-radius;
+    chi2Circle += res*res/(sigRPhi[i]*sigRPhi[i]);
+  }
+
+  // --- arc length from the point of closest approach, unwrapped along the points
+  double psiPrev = atan2( d0*(-cphi)-yc, d0*sphi-xc);
+  double sPrev = 0.;
+  for( int i=0; i<nPoints; i++ ) {
+    double psi = atan2( y[i]-yc, x[i]-xc);
+    double dpsi = psi-psiPrev;
+    while( dpsi> M_PI ) dpsi -= 2.*M_PI;
+    while( dpsi<-M_PI ) dpsi += 2.*M_PI;
+    fFitS[i] = sPrev - dpsi/rho;
+    sPrev = fFitS[i];
+    psiPrev = psi;
+  }
+
+  // --- straight line in (s, z)
+  double tw=0., ts=0., tz=0., tss=0., tsz=0.;
+  for( int i=0; i<nPoints; i++ ) {
+    double w = 1./(sigZ[i]*sigZ[i]);
+    tw  += w;
+    ts  += w*fFitS[i];
+    tz  += w*z[i];
+    tss += w*fFitS[i]*fFitS[i];
+    tsz += w*fFitS[i]*z[i];
+  }
+  double detZ = tw*tss-ts*ts;
+  if( detZ==0. ) return false;
+  double tanLambda = (tw*tsz-ts*tz)/detZ;
+  double z0 = (tz*tss-ts*tsz)/detZ;
+  double chi2Z = 0.;
+  for( int i=0; i<nPoints; i++ ) {
+    double res = z[i]-z0-tanLambda*fFitS[i];
+    chi2Z += res*res/(sigZ[i]*sigZ[i]);
+  }
+
+  result.Rho = rho;
+  result.Phi = phi;
+  result.D0 = d0;
+  result.Z0 = z0;
+  result.TanLambda = tanLambda;
+  result.Xc = xc;
+  result.Yc = yc;
+  result.Radius = radius;
+  result.Pt = 0.3*fBField*1e-3/rho; // GeV/c, B in T and R in m, signed by the charge (sign of B*rho)
+  result.Chi2Circle = chi2Circle;
+  result.Chi2Z = chi2Z;
+  result.NDF = 2*nPoints-5;
+  result.IsValid = true;
+  return true;
+}
+//===========================================================================================================
+TVector3 DHelixFitter::GetHelixParameterMinuit(const vector<TVector3> &ListOfHits, int nPositions){
+  // Chi2 minimisation with TMinuit of the helix through the origin
+  // and the first two hits in ListOfHits, ListOfHits[nPositions] holds their sensor indexes.
+  // Slow, kept to validate the analytic fit.
+  if( fDebug ) std::cout << "GetHelixParameter" << '\n';
+  if( nPositions<2 || (int)ListOfHits.size()<=nPositions ) {
+    printf("DHelixFitter::GetHelixParameterMinuit: sensor indexes are required, cannot fit!\n");
+    return TVector3( -999., -999., -999.);
+  }
   aHelix = new DHelix();
-  aHelix->SetMagneticField(1.5);
+  aHelix->SetMagneticField(fBField);
   ListOfHitsToFitted_1 = ListOfHits[0];
   ListOfHitsToFitted_2 = ListOfHits[1];
-  SensorId_1           = ListOfHits[2].X();
-  SensorId_2           = ListOfHits[2].Y();
+  SensorId_1           = ListOfHits[nPositions].X();
+  SensorId_2           = ListOfHits[nPositions].Y();
   double c = 3e8;
   alpha    = 1./(0.3*1.5);
   dphi     = (TMath::Pi()/1000.);
@@ -77,41 +321,47 @@ TVector3 DHelixFitter::GetHelixParameter(vector<TVector3> ListOfHits){
   // ptMinuit->FixParameter(3);
   // ptMinuit->FixParameter(4);
 
-  std::cout << "INSIDE DHelixFitter" << '\n';
-  std::cout << "Position 1 X = "<< ListOfHits[0].X() << "[mm]"
+  if( fDebug ) std::cout << "INSIDE DHelixFitter" << '\n';
+  if( fDebug ) std::cout << "Position 1 X = "<< ListOfHits[0].X() << "[mm]"
             << ", Y = "<< ListOfHits[0].Y() << "[mm]"
             << ", Z = "<< ListOfHits[0].Z() << "[mm]" << '\n';
-  std::cout << "Position 2 X = "<< ListOfHits[1].X() << "[mm]"
+  if( fDebug ) std::cout << "Position 2 X = "<< ListOfHits[1].X() << "[mm]"
             << ", Y = "<< ListOfHits[1].Y() << "[mm]"
             << ", Z = "<< ListOfHits[1].Z() << "[mm]" << '\n';
 
-  std::cout << "Sensor Id 1 = "<<ListOfHits[2].X() <<" Sensor Id 2 = "<< ListOfHits[2].Y() << '\n';
+  if( fDebug ) std::cout << "Sensor Id 1 = "<<ListOfHits[2].X() <<" Sensor Id 2 = "<< ListOfHits[2].Y() << '\n';
   // Now ready for minimization step
   arglist[0] = 500  ;
   arglist[1] = 0.1;
   // ptMinuit->SetMaxIteration(500);
   ptMinuit->mnexcm("MIGRAD", arglist ,1,ierflg);
-  std::cout << "AFTER FIT" << '\n';
+  if( fDebug ) std::cout << "AFTER FIT" << '\n';
   // if you want to access to these parameters, use:
   Double_t amin,edm,errdef;
   Int_t nvpar,nparx,icstat;
   ptMinuit->mnstat(amin,edm,errdef,nvpar,nparx,icstat);
 
-  cout << "\n";
-  cout << " Minimum chi square = " << amin << "\n";
+  if( fDebug ) cout << "\n";
+  if( fDebug ) cout << " Minimum chi square = " << amin << "\n";
   // std::cout << "Probability = " << TMath::Prob(amin, 5)<<'\n';
-  cout << " Estimated vert. distance to min. = " << edm << "\n";
-  cout << " Number of variable parameters = " << nvpar << "\n";
-  cout << " Highest number of parameters defined by user = " << nparx << "\n";
-  cout << " Status of covariance matrix = " << icstat << "\n";
+  if( fDebug ) cout << " Estimated vert. distance to min. = " << edm << "\n";
+  if( fDebug ) cout << " Number of variable parameters = " << nvpar << "\n";
+  if( fDebug ) cout << " Highest number of parameters defined by user = " << nparx << "\n";
+  if( fDebug ) cout << " Status of covariance matrix = " << icstat << "\n";
 
   double fParamValbis;
   double fParamErrbis;
   ptMinuit->GetParameter(0,fParamValbis,fParamErrbis);
   double k =fParamValbis;
-  cout << "K =" << fParamValbis << "\n";
-  std::cout << "Momemtum[GeV] = "<<1./k << '\n';
-  TVector3 HelixParameter(1./k,amin,0.);
+  if( fDebug ) cout << "K =" << fParamValbis << "\n";
+  if( fDebug ) std::cout << "Momemtum[GeV] = "<<1./k << '\n';
+  double tanLambda;
+  ptMinuit->GetParameter(2,tanLambda,fParamErrbis);
+  TVector3 HelixParameter(1./k,amin,tanLambda);
+
+  delete ptMinuit;
+  delete aHelix;
+  aHelix = 0;
 
   return HelixParameter;
 }
@@ -134,26 +384,26 @@ void DHelixFitter::Helix_ChiSquare(Int_t &npar, Double_t *gin, Double_t &f, Doub
   ChisquareMatrix.ResizeTo(3,3);
   int NbFittedPoints=3;
   for(int i=0;i<NbFittedPoints;i++){
-    std::cout << "--------oooo00OO00oooo-----oooo00OO00oooo" << '\n';
-    std::cout << "FITTED n°"<<i << '\n';
-    std::cout << "--------oooo00OO00oooo-----oooo00OO00oooo" << '\n';
+    if( fDebug>1 ) std::cout << "--------oooo00OO00oooo-----oooo00OO00oooo" << '\n';
+    if( fDebug>1 ) std::cout << "FITTED n°"<<i << '\n';
+    if( fDebug>1 ) std::cout << "--------oooo00OO00oooo-----oooo00OO00oooo" << '\n';
 
     Residual=GetResidual(par,i);
-    std::cout << "Residual Matrix Print " << '\n';
-    Residual.Print();
+    if( fDebug>1 ) std::cout << "Residual Matrix Print " << '\n';
+    if( fDebug>1 ) Residual.Print();
     if(Residual(0,0)==-999){
       // std::cout << "BAD" << '\n';
       chisquare += 1e6;
     }else{
       Residual_T.Transpose(Residual);
-      Residual_T.Print();
+      if( fDebug>1 ) Residual_T.Print();
       BuiltCovarianceMatrix(CovarianceMatrix,i);
-      std::cout << "COVARIANCE MATRIX Print " << '\n';
-      CovarianceMatrix.Print();
+      if( fDebug>1 ) std::cout << "COVARIANCE MATRIX Print " << '\n';
+      if( fDebug>1 ) CovarianceMatrix.Print();
       StepMatrix = Residual_T*CovarianceMatrix;
       // ChisquareMatrix = StepMatrix*Residual;
-      (StepMatrix*Residual).Print();
-      std::cout << "chisquare for Fit point n°"<<i<<" = "<<(StepMatrix*Residual)(0,0) << '\n';
+      if( fDebug>1 ) (StepMatrix*Residual).Print();
+      if( fDebug>1 ) std::cout << "chisquare for Fit point n°"<<i<<" = "<<(StepMatrix*Residual)(0,0) << '\n';
       chisquare += (StepMatrix*Residual)(0,0);
     }
   }
@@ -162,11 +412,11 @@ void DHelixFitter::Helix_ChiSquare(Int_t &npar, Double_t *gin, Double_t &f, Doub
 }
 //===========================================================================================================
 TMatrixD DHelixFitter::GetResidual(Double_t *par, int MeasurmentIndex){
-  std::cout << "--*-----*-**----- par[0]:k = "<< par[0] << '\n';
-  std::cout << "--*-----*-**----- par[1]:phi0 = "<< par[1] << '\n';
-  std::cout << "--*-----*-**----- par[2]:TanLambda = "<< par[2] << '\n';
-  std::cout << "--*-----*-**----- par[3]:d0 = "<< par[3] << '\n';
-  std::cout << "--*-----*-**----- par[4]:z0 = "<< par[4] << '\n';
+  if( fDebug>1 ) std::cout << "--*-----*-**----- par[0]:k = "<< par[0] << '\n';
+  if( fDebug>1 ) std::cout << "--*-----*-**----- par[1]:phi0 = "<< par[1] << '\n';
+  if( fDebug>1 ) std::cout << "--*-----*-**----- par[2]:TanLambda = "<< par[2] << '\n';
+  if( fDebug>1 ) std::cout << "--*-----*-**----- par[3]:d0 = "<< par[3] << '\n';
+  if( fDebug>1 ) std::cout << "--*-----*-**----- par[4]:z0 = "<< par[4] << '\n';
   aHelix->SetAllParameters(par);
   // std::cout << "Test Get k = "<< 1./aHelix->GetTransverseMomentum() << '\n';
   // std::cout << "Test Get Phi0 = "<<   aHelix->GetPhi0()<< '\n';
@@ -209,7 +459,7 @@ TMatrixD DHelixFitter::GetResidual(Double_t *par, int MeasurmentIndex){
     Dprec  = aPlane->GetPrecAlignment();
     phi = GetIntersectionHelixPlane(aPlane,aHelix);
     if(phi<0) phi = 2*TMath::Pi()-abs(phi);
-    std::cout << "Phi Inside GetResidual = "<<phi << '\n';
+    if( fDebug>1 ) std::cout << "Phi Inside GetResidual = "<<phi << '\n';
     // if(phi == -999){
     //   Result(0,0) = -999;
     //   Result(1,0) = -999;
@@ -238,12 +488,12 @@ TMatrixD DHelixFitter::GetResidual(Double_t *par, int MeasurmentIndex){
       //           << " PosXYZ -> Z = "<< (HelixPosXYZMeasured)(2)<< '\n';
       DR3 HelixPosUVWFitted   = Dprec->TransformHitToPlane(HelixPosXYZFitted);//Return micrometers
       DR3 HelixPosUVWMeasured = Dprec->TransformHitToPlane(HelixPosXYZMeasured);//Return micrometers
-      std::cout << "-----oo0OO0oo----LOCAL POSITION MODELIZE-----oo0OO0oo----" << '\n';
-      std::cout << "PosUVW -> U = "<< (HelixPosUVWFitted)(0)
+      if( fDebug>1 ) std::cout << "-----oo0OO0oo----LOCAL POSITION MODELIZE-----oo0OO0oo----" << '\n';
+      if( fDebug>1 ) std::cout << "PosUVW -> U = "<< (HelixPosUVWFitted)(0)
                 << " PosUVW -> V = "<< (HelixPosUVWFitted)(1)
                 << " PosUVW -> W = "<< (HelixPosUVWFitted)(2)<< '\n';
-      std::cout << "-----oo0OO0oo----LOCAL POSITION MEASURED-----oo0OO0oo----" << '\n';
-      std::cout << "PosUVW -> U = "<< (HelixPosUVWMeasured)(0)
+      if( fDebug>1 ) std::cout << "-----oo0OO0oo----LOCAL POSITION MEASURED-----oo0OO0oo----" << '\n';
+      if( fDebug>1 ) std::cout << "PosUVW -> U = "<< (HelixPosUVWMeasured)(0)
                 << " PosUVW -> V = "<< (HelixPosUVWMeasured)(1)
                 << " PosUVW -> W = "<< (HelixPosUVWMeasured)(2)<< '\n';
       Result(0,0) = ((HelixPosUVWMeasured)(0)-(HelixPosUVWFitted)(0))/1000;//Result in millimeters
@@ -251,7 +501,7 @@ TMatrixD DHelixFitter::GetResidual(Double_t *par, int MeasurmentIndex){
       Result(2,0) = ((HelixPosUVWMeasured)(2)-(HelixPosUVWFitted)(2))/1000;
     // }
   }
-  Result.Print();
+  if( fDebug>1 ) Result.Print();
   return Result;
 }
 //<<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>><<>>
@@ -279,7 +529,7 @@ double DHelixFitter::GetIntersectionHelixPlane(DPlane *aPlane, DHelix *aHelix)
       RootFinderCounter++;
     }else{
     HaveSolution=true;
-    std::cout << "Solution Founded" << '\n';
+    if( fDebug>1 ) std::cout << "Solution Founded" << '\n';
     // std::cout << "Phi founded = "<<phi << '\n';
     }
   }
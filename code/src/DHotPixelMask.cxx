@@ -0,0 +1,215 @@
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DHotPixelMask                                   //
+  //                                                                      //
+  // Packed bit mask of the hot pixels of one plane.                      //
+  // Pixels are identified either by (line, column) or by their 1D        //
+  //  (DAQ) index, each identification has its own mask.                  //
+  //                                                                      //
+  // The mask is built once (from the hot pixel lists computed by DSetup  //
+  //  or read from a file) and then used by DAcq to drop hot pixels       //
+  //  before they become DPixel objects, and by MimosaAnalysis.           //
+  //                                                                      //
+  // Binary file format (all 32 bits integers):                           //
+  //  magic, version, nLines, nColumns, n 2D words, 2D words,             //
+  //  n 1D words, 1D words                                                //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include "DHotPixelMask.h"
+#include "Riostream.h"
+
+ClassImp(DHotPixelMask)
+
+static const UInt_t kHotPixelMaskMagic   = 0x4d505448; // "HTPM"
+static const UInt_t kHotPixelMaskVersion = 1;
+static const UInt_t kHotPixelMaskMaxBits = 1U<<26; // largest mask read from a file, 64 M pixels or indexes (8 MB)
+
+//______________________________________________________________________________
+//
+DHotPixelMask::DHotPixelMask()
+{
+  fNLines    = 0;
+  fNColumns  = 0;
+  fNHot2D    = 0;
+  fNHotIndex = 0;
+}
+
+//______________________________________________________________________________
+//
+DHotPixelMask::DHotPixelMask( Int_t nLines, Int_t nColumns)
+{
+  fNHot2D    = 0;
+  fNHotIndex = 0;
+  SetSize( nLines, nColumns);
+}
+
+//______________________________________________________________________________
+//
+DHotPixelMask::~DHotPixelMask()
+{
+}
+
+//______________________________________________________________________________
+//
+void DHotPixelMask::SetSize( Int_t nLines, Int_t nColumns)
+{
+  // Define the size of the (line, column) mask, the mask is cleared.
+
+  fNLines   = nLines>0 ? nLines : 0;
+  fNColumns = nColumns>0 ? nColumns : 0;
+  fMask2D.assign( ((ULong_t)fNLines*fNColumns+31)/32, 0);
+  fNHot2D = 0;
+}
+
+//______________________________________________________________________________
+//
+void DHotPixelMask::Reset()
+{
+  // Clear all the bits, keep the sizes.
+
+  fMask2D.assign( fMask2D.size(), 0);
+  fMask1D.clear();
+  fNHot2D    = 0;
+  fNHotIndex = 0;
+}
+
+//______________________________________________________________________________
+//
+void DHotPixelMask::Fill( const std::vector<Int_t> &lines, const std::vector<Int_t> &columns, const std::vector<Int_t> &indexes)
+{
+  // Build the masks from lists of hot pixels, as provided by
+  //  DSetup::GetListOfHotPixelsToMask_FakeRateCut or _FracToMask.
+  // If the (line, column) mask has no size yet,
+  //  it is sized to contain the largest line and column in the lists.
+
+  if( fNLines==0 || fNColumns==0 ) {
+    Int_t maxLine = -1, maxColumn = -1;
+    for( size_t i=0; i<lines.size() && i<columns.size(); i++) {
+      if( lines[i]>maxLine ) maxLine = lines[i];
+      if( columns[i]>maxColumn ) maxColumn = columns[i];
+    }
+    SetSize( maxLine+1, maxColumn+1);
+  }
+
+  for( size_t i=0; i<lines.size() && i<columns.size(); i++) SetHot( lines[i], columns[i]);
+  for( size_t i=0; i<indexes.size(); i++) SetHotIndex( indexes[i]);
+}
+
+//______________________________________________________________________________
+//
+void DHotPixelMask::SetHot( Int_t aLine, Int_t aColumn)
+{
+  if( aLine<0 || aLine>=fNLines || aColumn<0 || aColumn>=fNColumns ) {
+    printf("WARNING DHotPixelMask: pixel (%d, %d) outside the mask (%d lines, %d columns), ignored.\n", aLine, aColumn, fNLines, fNColumns);
+    return;
+  }
+  UInt_t bit = (UInt_t)(aLine*fNColumns+aColumn);
+  if( !((fMask2D[bit>>5]>>(bit&31))&1) ) {
+    fMask2D[bit>>5] |= (1U<<(bit&31));
+    fNHot2D++;
+  }
+}
+
+//______________________________________________________________________________
+//
+void DHotPixelMask::SetHotIndex( Int_t anIndex)
+{
+  if( anIndex<0 ) return;
+  UInt_t word = (UInt_t)anIndex>>5;
+  if( word>=fMask1D.size() ) fMask1D.resize( word+1, 0);
+  if( !((fMask1D[word]>>(anIndex&31))&1) ) {
+    fMask1D[word] |= (1U<<(anIndex&31));
+    fNHotIndex++;
+  }
+}
+
+//______________________________________________________________________________
+//
+Bool_t DHotPixelMask::WriteToFile( const char *fileName) const
+{
+  // Save the masks in a binary file, return kFALSE if it failed.
+
+  ofstream maskFile( fileName, ios::out | ios::binary);
+  if( maskFile.fail() ) {
+    printf("WARNING DHotPixelMask: cannot write file %s\n", fileName);
+    return kFALSE;
+  }
+
+  UInt_t header[4] = { kHotPixelMaskMagic, kHotPixelMaskVersion, (UInt_t)fNLines, (UInt_t)fNColumns };
+  maskFile.write( (const char*)header, sizeof(header));
+  UInt_t nWords = (UInt_t)fMask2D.size();
+  maskFile.write( (const char*)&nWords, sizeof(UInt_t));
+  if( nWords>0 ) maskFile.write( (const char*)&fMask2D[0], nWords*sizeof(UInt_t));
+  nWords = (UInt_t)fMask1D.size();
+  maskFile.write( (const char*)&nWords, sizeof(UInt_t));
+  if( nWords>0 ) maskFile.write( (const char*)&fMask1D[0], nWords*sizeof(UInt_t));
+
+  return maskFile.good();
+}
+
+//______________________________________________________________________________
+//
+Bool_t DHotPixelMask::ReadFromFile( const char *fileName)
+{
+  // Read the masks from a binary file written by WriteToFile.
+  // The bits are added to the ones already set,
+  //  which allows to combine a file with lists from the configuration,
+  //  as long as the (line, column) sizes are compatible.
+  // Return kFALSE if the file cannot be read, is not a mask file,
+  //  or declares more words than its size allows (at most kHotPixelMaskMaxBits bits).
+
+  ifstream maskFile( fileName, ios::in | ios::binary);
+  if( maskFile.fail() ) {
+    printf("WARNING DHotPixelMask: cannot read file %s\n", fileName);
+    return kFALSE;
+  }
+
+  UInt_t header[4];
+  maskFile.read( (char*)header, sizeof(header));
+  if( !maskFile.good() || header[0]!=kHotPixelMaskMagic || header[1]!=kHotPixelMaskVersion ) {
+    printf("WARNING DHotPixelMask: %s is not a hot pixel mask file.\n", fileName);
+    return kFALSE;
+  }
+
+  ULong64_t nBits2D = (ULong64_t)header[2]*header[3];
+  if( nBits2D>kHotPixelMaskMaxBits ) {
+    printf("WARNING DHotPixelMask: %s declares a %u x %u mask, larger than the maximum %u pixels.\n", fileName, header[2], header[3], kHotPixelMaskMaxBits);
+    return kFALSE;
+  }
+
+  UInt_t nWords = 0;
+  maskFile.read( (char*)&nWords, sizeof(UInt_t));
+  if( !maskFile.good() ) nWords = 0;
+  if( nWords>(nBits2D+31)/32 ) {
+    printf("WARNING DHotPixelMask: %s has %u words for a %u x %u mask, not a valid mask file.\n", fileName, nWords, header[2], header[3]);
+    return kFALSE;
+  }
+  std::vector<UInt_t> mask2D( nWords, 0);
+  if( nWords>0 ) maskFile.read( (char*)&mask2D[0], nWords*sizeof(UInt_t));
+  maskFile.read( (char*)&nWords, sizeof(UInt_t));
+  if( !maskFile.good() ) nWords = 0;
+  if( nWords>kHotPixelMaskMaxBits/32 ) {
+    printf("WARNING DHotPixelMask: %s has %u words for the index mask, more than the maximum %u, not a valid mask file.\n", fileName, nWords, kHotPixelMaskMaxBits/32);
+    return kFALSE;
+  }
+  std::vector<UInt_t> mask1D( nWords, 0);
+  if( nWords>0 ) maskFile.read( (char*)&mask1D[0], nWords*sizeof(UInt_t));
+  if( maskFile.fail() ) {
+    printf("WARNING DHotPixelMask: file %s is truncated.\n", fileName);
+    return kFALSE;
+  }
+
+  if( fNHot2D==0 || (Int_t)header[2]!=fNLines || (Int_t)header[3]!=fNColumns ) {
+    if( fNHot2D>0 ) printf("WARNING DHotPixelMask: (line, column) mask of %s has a different size, it replaces the current one.\n", fileName);
+    SetSize( (Int_t)header[2], (Int_t)header[3]);
+  }
+  for( Int_t bit=0; bit<fNLines*fNColumns && (UInt_t)(bit>>5)<mask2D.size(); bit++) {
+    if( (mask2D[bit>>5]>>(bit&31))&1 ) SetHot( bit/fNColumns, bit%fNColumns);
+  }
+  for( UInt_t bit=0; bit<32*mask1D.size(); bit++) {
+    if( (mask1D[bit>>5]>>(bit&31))&1 ) SetHotIndex( (Int_t)bit);
+  }
+
+  return kTRUE;
+}
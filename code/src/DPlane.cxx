@@ -78,6 +78,7 @@
 #include "DAlign.h"
 #include "DR3.h"
 #include "DGlobalTools.h"
+#include "DProfiler.h"
 #include <stdlib.h>
 #include "TMimosa24_25Map.h" //RDM120509
 
@@ -94,6 +95,9 @@ DPlane::DPlane()
   fDebugPlane=0;
 
   rand = new TRandom(182984);
+  fUpdateReadout = 0;
+  fMimosaMap = 0;
+  fMimosaLineOffset = 0;
 
 }
 
@@ -138,6 +142,9 @@ DPlane::DPlane(DTracker& aTracker, const Int_t aPlaneNumber, const Int_t aLadder
   fStatus              = fc->GetPlanePar(fPlaneNumber).Status;
   fAnalysisMode        = fc->GetPlanePar(fPlaneNumber).AnalysisMode;
   fReadout             = fc->GetPlanePar(fPlaneNumber).Readout;
+  SelectReadoutProcessor();
+  fMimosaMap           = 0;
+  fMimosaLineOffset    = 0;
   fMimosaType          = fc->GetPlanePar(fPlaneNumber).MimosaType; //RDM210509
   fMapping             = fc->GetPlanePar(fPlaneNumber).Mapping; // JB 2012/11/21
   fPlanePurpose        = fc->GetPlanePar(fPlaneNumber).Purpose;   //YV 08/02/2010
@@ -491,6 +498,11 @@ DPlane::DPlane(DTracker& aTracker, const Int_t aPlaneNumber, const Int_t aLadder
   fHitMax = fc->GetTrackerPar().HitsInPlaneMaximum;
   fKeepUnTrackedHitsBetw2evts = fc->GetTrackerPar().KeepUnTrackedHitsBetw2evts; // VR 2014.08.28
   fHitsUnTrackedLastEventN = 0; // VR 2014.08.28
+  fHitsUnTrackedParked = kTRUE;
+  fHitUnTrackedLastEvent = 0;
+  fAlignHitsInPlaneFrame = 0;
+  fAlignHitsInTrackerFrame = 0;
+  fTruthMatching = fc->GetTrackerPar().TruthMatching;
   DR3  aZero;
 
 
@@ -511,6 +523,7 @@ DPlane::DPlane(DTracker& aTracker, const Int_t aPlaneNumber, const Int_t aLadder
   {
     printf("Keeping untracked hits from an event to the next one in enabled \n");
 
+    // the upper half of the list receives the kept hits, see KeepUnTrackedHits
     fHit = new DHit*[2*fHitMax];
 
     for (Int_t ht = 0; ht < 2*fHitMax; ht++)
@@ -518,13 +531,14 @@ DPlane::DPlane(DTracker& aTracker, const Int_t aPlaneNumber, const Int_t aLadder
       fHit[ht] = new DHit(aZero, *this, ht+1);
     }
 
-    fHitUnTrackedLastEvent = new DHit*[fHitMax];
-    for (Int_t ht = 0; ht < fHitMax; ht++)
-    {
-      fHitUnTrackedLastEvent[ht] = new DHit(aZero, *this, ht+1);
-    }
+    fHitUnTrackedLastEvent = new Int_t[fHitMax];
   }
 
+  // buffers of AlignData, the hit list can hold the kept hits as well
+  Int_t hitSlots = fKeepUnTrackedHitsBetw2evts==0 ? fHitMax : 2*fHitMax;
+  fAlignHitsInPlaneFrame = new Double_t[3*hitSlots];
+  fAlignHitsInTrackerFrame = new Double_t[3*hitSlots];
+
   //-+-+-+   Alignement object
 
   fAlign = new DAlign( fPlaneNumber, fDebugPlane);
@@ -665,6 +679,8 @@ DPlane::~DPlane(){
   delete fListOfPixels;
   delete [] fHit;
   delete [] fHitUnTrackedLastEvent;
+  delete [] fAlignHitsInPlaneFrame;
+  delete [] fAlignHitsInTrackerFrame;
   delete fCut;
   delete fGeometry;
   delete fPlaneNode;
@@ -676,6 +692,8 @@ DPlane::~DPlane(){
   delete fEtaIntU2;
   delete fEtaIntV2;
   delete fNoiseFile;  //YV 27/11/09
+  delete fMimosaMap;
+  delete [] fMimosaLineOffset;
 
 }
 
@@ -1136,6 +1154,14 @@ void DPlane::AlignData(DTrack *aTrack, const Double_t tiniBound, std::vector<Dou
   tTrackPos = Intersection( aTrack); // trackPosition in uvw frame with new class, JB 2010/11/25
   DR3 trackInTrackerFrame = fPrecAlign->TransformHitToTracker(tTrackPos);
 
+  // all hits to the tracker frame in one call, in the buffers allocated with the hit list
+  for (Int_t k=1 ; k<= GetHitsN() ; k++) {
+    fAlignHitsInPlaneFrame[3*(k-1)]   = GetHit(k)->GetPositionUhitCG();
+    fAlignHitsInPlaneFrame[3*(k-1)+1] = GetHit(k)->GetPositionVhitCG();
+    fAlignHitsInPlaneFrame[3*(k-1)+2] = 0.;
+  }
+  if( GetHitsN()>0 ) fPrecAlign->TransformHitsToTracker( GetHitsN(), fAlignHitsInPlaneFrame, fAlignHitsInTrackerFrame);
+
   for (Int_t k=1 ; k<= GetHitsN() ; k++) {
 
     tDistanceU = GetHit(k)->GetPositionUhitCG() - tTrackPos(0);
@@ -1143,11 +1169,11 @@ void DPlane::AlignData(DTrack *aTrack, const Double_t tiniBound, std::vector<Dou
     double resolutionU = GetHit(k)->GetResolutionUhit();
     double resolutionV = GetHit(k)->GetResolutionVhit();
 
-    DR3 hitInTrackerFrame = fPrecAlign->TransformHitToTracker( DR3(GetHit(k)->GetPositionUhitCG(), GetHit(k)->GetPositionVhitCG(), 0.) );
+    const Double_t *hitInTrackerFrame = &fAlignHitsInTrackerFrame[3*(k-1)];
 
-    Double_t trackerFrameDistanceX = hitInTrackerFrame(0) - trackInTrackerFrame(0);
-    Double_t trackerFrameDistanceY = hitInTrackerFrame(1) - trackInTrackerFrame(1);
-    Double_t trackerFrameDistanceZ = hitInTrackerFrame(2) - trackInTrackerFrame(2);
+    Double_t trackerFrameDistanceX = hitInTrackerFrame[0] - trackInTrackerFrame(0);
+    Double_t trackerFrameDistanceY = hitInTrackerFrame[1] - trackInTrackerFrame(1);
+    Double_t trackerFrameDistanceZ = hitInTrackerFrame[2] - trackInTrackerFrame(2);
 
     tDist2D = sqrt( tDistanceU*tDistanceU + tDistanceV*tDistanceV );
 
@@ -1160,9 +1186,9 @@ void DPlane::AlignData(DTrack *aTrack, const Double_t tiniBound, std::vector<Dou
       myData.push_back( aTrack->GetLinearFit().GetOrigin()(2) );  // 4
       myData.push_back( aTrack->GetLinearFit().GetSlopeZ()(0) );  // 5
       myData.push_back( aTrack->GetLinearFit().GetSlopeZ()(1) );  // 6
-      myData.push_back( hitInTrackerFrame(0) );                   // 7
-      myData.push_back( hitInTrackerFrame(1) );                   // 8
-      myData.push_back( hitInTrackerFrame(2) );                   // 9
+      myData.push_back( hitInTrackerFrame[0] );                   // 7
+      myData.push_back( hitInTrackerFrame[1] );                   // 8
+      myData.push_back( hitInTrackerFrame[2] );                   // 9
 
       /*
        myData.push_back( GetHit(k)->GetPositionUhitCG() - tTrackPos(0) ); //tDistanceU // 7
@@ -1361,19 +1387,15 @@ Bool_t DPlane::Update(){
   // Last Modified, JB 2018/05/04 new readout==3 mode for polarity inversion
   // Last Modified, JB 2010/11/25 implemented mimosatype=61 (MonolithicImager)
 
+  TAF_PROFILE_SCOPE( DProfiler::kPlaneUpdate, fPlaneNumber);
+
   Bool_t goForAnalysis = kTRUE ;
   Bool_t planeReady = kTRUE ; // JB 2010/09/20
   fKillNoise=kFALSE;
+  if( fKeepUnTrackedHitsBetw2evts ) ParkUnTrackedHits(); // before the hits of the last event are overwritten
   fHitsN = 0; // necessary otherwise DSession::FillTree may screw up, JB 2007 June
 
 
-  DPixel  *aPixel;
-  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
-  DR3      tPosition(0,0,0);
-  DR3      tSize(0,0,0);
-  Double_t u=0,v=0,w=0;
-  Float_t  aRawvalue, aNoise, aPedestal;
-
   if(fDebugPlane) printf(" DPLane::Update Updating plane %d with readout %d status=%d analysisMode=%d mimosaType=%d noiseRun=%d\n", fPlaneNumber, fReadout, fStatus, fAnalysisMode, fMimosaType, fNoiseRun);
 
 
@@ -1385,6 +1407,121 @@ Bool_t DPlane::Update(){
   }
 
   //======================
+  // Readouts known: the processor was chosen at construction,
+  //  see SelectReadoutProcessor
+  else if ( fUpdateReadout ){
+    goForAnalysis = (this->*fUpdateReadout)();
+  }
+
+
+  //======================
+  // ANY OTHER READOUT issue a warning
+  else {
+    planeReady = kFALSE;
+    printf( "WARNING, DPlane:Update readout %d unknown, no analysis !\n", fReadout);
+  }
+
+
+  //======================
+  // Call the analysis now
+  //======================
+
+  if (goForAnalysis) {
+
+    //==============
+    // compute pedestal, noise and common noise shift
+    // or update the strip values
+    // exclude zero-suppressed data (readout>100), JB 2009/05/25
+    // exclude noise computed from previous run, JB 2014/01/07
+    // include multi-frame readout (232) only for init step, JB 2013/
+    // modified condition fInitialCounter<fInitialNoise instead of <=, JB 2016/08/23
+    if( (fReadout<100) || (fReadout==232 && fInitialCounter<fInitialNoise) ) {
+      analyze_basics();
+    }
+
+    //==============
+    // Analysis
+    // not performed if analysisMode==0, JB 2011/04/15
+    if (fSession->GetStatus() != 0 && fAnalysisMode>0) {
+
+      //==============
+      // Digitize the matrix if required
+      if( fIfDigitize>0 ) {
+        DigitizeMatrix();
+      }
+
+      //==============
+      // potentially update pedestal, noise
+      // or update the strip values
+      // only for not zero-suppressed data, JB 2011/04/15
+      //      if( fReadout<100 && fAnalysisMode<=1 ) {
+      //        UpdatePedestalAndNoise();
+      //      } // end if readout<100
+
+      //==============
+      // look for hits
+      find_hits();
+      if (fDebugPlane) cout << "  Plane " << fPlaneNumber << " : " << fHitsN << " new  hits found" << endl;
+
+    }
+
+  } // end if goForAnalysis
+  else {
+    if (fDebugPlane) cout << "Plane " << fPlaneNumber << ": can't analyse or no data " << endl ;
+  }
+
+  if ( !planeReady && fDebugPlane) cout << "Plane " << fPlaneNumber << ": bad raw data " << endl ;
+  TAF_PROFILE_COUNT( DProfiler::kPlaneUpdate, fPlaneNumber, fPixelsN);
+
+  if(fAcq->GetIfMCBoardReader()) { // AP, 2016/07/27. Do some operations only in the case of reading MC-data
+    //Now, if some hits where not digitized, then generate hits with the MC information
+    CheckNonDigitizedMCHits();
+
+    //Do hit truth matching and get the particle generating this hit
+    // unless it is switched off or deferred to DTracker::DoTruthMatching()
+    if( fTruthMatching==1 ) MCHitsTruthMatching();
+  } // end if reading MC-data
+
+  return !planeReady; // JB 2010/09/20
+
+}
+//______________________________________________________________________________
+//
+void DPlane::SelectReadoutProcessor()
+{
+  // Choose once, at construction, the method processing the pixels
+  //  of the plane readout in Update.
+  // None for readout 0 (plane not read) or an unknown readout.
+
+  switch( fReadout ) {
+    case 1:    fUpdateReadout = &DPlane::UpdateReadout1; break;
+    case 2:    fUpdateReadout = &DPlane::UpdateReadout2; break;
+    case 3:    fUpdateReadout = &DPlane::UpdateReadout3; break;
+    case 102:  fUpdateReadout = &DPlane::UpdateReadout102; break;
+    case 5:    fUpdateReadout = &DPlane::UpdateReadout5; break;
+    case 105:  fUpdateReadout = &DPlane::UpdateReadout105; break;
+    case 18:   fUpdateReadout = &DPlane::UpdateReadout18; break;
+    case 118:  fUpdateReadout = &DPlane::UpdateReadout118; break;
+    case 20:   fUpdateReadout = &DPlane::UpdateReadout20; break;
+    case 120:  fUpdateReadout = &DPlane::UpdateReadout120; break;
+    case 22:   fUpdateReadout = &DPlane::UpdateReadout22; break;
+    case 25:   fUpdateReadout = &DPlane::UpdateReadout25; break;
+    case 125:  fUpdateReadout = &DPlane::UpdateReadout125; break;
+    case 24:   fUpdateReadout = &DPlane::UpdateReadout24; break;
+    case 124:  fUpdateReadout = &DPlane::UpdateReadout124; break;
+    case 126:  fUpdateReadout = &DPlane::UpdateReadout126; break;
+    case 32:   fUpdateReadout = &DPlane::UpdateReadout32; break;
+    case 132:  fUpdateReadout = &DPlane::UpdateReadout132; break;
+    case 232:  fUpdateReadout = &DPlane::UpdateReadout232; break;
+    default:   fUpdateReadout = 0;
+  }
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout1()
+{
   // Readout 1
   // - without zero suppression
   // - no need to re-order channel numbering wrt strip numbering
@@ -1392,37 +1529,50 @@ Bool_t DPlane::Update(){
   // - further analysis done with DStrip object
   // - does not allow to take into account external noise or gain file
   // Checked JB 2012/08/21
-  else if ( fReadout==1 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      aPixel->SetPixelLine( st / fStripsNu);
-      aPixel->SetPixelColumn( st % fStripsNu);
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-      if( fMimosaType==60 && 60600<=fSession->GetRunNumber() && fSession->GetRunNumber()<60641) { // row 0-3 -> 4-7 and 4-7 -> 0-3
-        aPixel->SetPixelLine( (st/fStripsNu+4)%8 );
-        st = ((st/fStripsNu+4)%8)*fStripsNu + st%fStripsNu;
-      }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0;
+  const Bool_t swapLines = fMimosaType==60 && 60600<=fSession->GetRunNumber() && fSession->GetRunNumber()<60641; // row 0-3 -> 4-7 and 4-7 -> 0-3
+  const Int_t  maskedPixels = fMimosaType==33 ? 27 : 0;
 
-      GetStrip(st)->SetPixelIndex( tci);
-      GetStrip(st)->SetRawValue( aPixel->GetRawValue() );
-      //GetStrip(st)->SetRawValue(fRawData[st]);  // old way
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    aPixel->SetPixelLine( st / fStripsNu);
+    aPixel->SetPixelColumn( st % fStripsNu);
 
-      if ((fMimosaType==33 && tci<27)
-          ) {
-        aPixel->SetRawValue(0.);
-        aPixel->SetPulseHeight(0.);
-        GetStrip(st)->SetRawValue( 0.);
-      }
+    if( swapLines ) {
+      aPixel->SetPixelLine( (st/fStripsNu+4)%8 );
+      st = ((st/fStripsNu+4)%8)*fStripsNu + st%fStripsNu;
+    }
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, st / fStripsNu, st & fStripsNu, aPixel->GetRawValue(), GetStrip(st)->GetRawValue());
+    GetStrip(st)->SetPixelIndex( tci);
+    GetStrip(st)->SetRawValue( aPixel->GetRawValue() );
+    //GetStrip(st)->SetRawValue(fRawData[st]);  // old way
 
+    if( tci<maskedPixels ) {
+      aPixel->SetRawValue(0.);
+      aPixel->SetPulseHeight(0.);
+      GetStrip(st)->SetRawValue( 0.);
     }
-  } //end readout==1
 
-  //======================
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, st / fStripsNu, st & fStripsNu, aPixel->GetRawValue(), GetStrip(st)->GetRawValue());
+
+  }
+
+  return goForAnalysis;
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout2()
+{
   // Readout 2
   // - without zero suppression
   // - re-ordering of the channel numbering wrt strip numbering
@@ -1430,85 +1580,115 @@ Bool_t DPlane::Update(){
   // - allows to take into account external noise or gain file
   // - further analysis done with DPixel or DStrip objects
   // JB 2013/08/14
-  else if ( fReadout==2 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      if( fMimosaType==61 ) {
-        int input = st/32768; // input nb
-        int stinput = st%32768; // index in input
-        int pseudocol = stinput%128;
-        int adc = 3-(pseudocol%4);
-        int group = pseudocol/4;
-        linPhys = stinput / 128;
-        colPhys = input*128 + group + adc*32;
-        // printf( "    st=%6d, inp=%d, pseudoc=%3d, a=%d, g=%d\n", st, input, pseudocol, adc, group);
-      }
-      else {
-        linPhys = st / fStripsNu;
-        colPhys = st % fStripsNu;
-      }
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-      stPhys = colPhys + linPhys*fStripsNu;
-      if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-      ComputeStripPosition( colPhys, linPhys, u, v, w);
-      tPosition.SetValue(u,v,w); //
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t imager = fMimosaType==61;
+  const Bool_t maskPixels = 180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500;
+  const Bool_t pixelGain = fPixelGainRun;
+  const Bool_t noiseRun = fNoiseRun;
+
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    if( imager ) {
+      int input = st/32768; // input nb
+      int stinput = st%32768; // index in input
+      int pseudocol = stinput%128;
+      int adc = 3-(pseudocol%4);
+      int group = pseudocol/4;
+      linPhys = stinput / 128;
+      colPhys = input*128 + group + adc*32;
+      // printf( "    st=%6d, inp=%d, pseudoc=%3d, a=%d, g=%d\n", st, input, pseudocol, adc, group);
+    }
+    else {
+      linPhys = st / fStripsNu;
+      colPhys = st % fStripsNu;
+    }
 
-      // update the pixel
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+    stPhys = colPhys + linPhys*fStripsNu;
+    if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+    ComputeStripPosition( colPhys, linPhys, u, v, w);
+    tPosition.SetValue(u,v,w); //
 
-      if(180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500 && linPhys==0 && (colPhys==2 || colPhys==3) ) {
-        aPixel->SetRawValue(1.0e-6);
-        aPixel->SetPulseHeight(1.0e-6);
-      }
+    // update the pixel
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
 
-      if ( fPixelGainRun ) {
-        SetPixelGainFromHisto( colPhys, linPhys, aPixel);
-      }
+    if( maskPixels && linPhys==0 && (colPhys==2 || colPhys==3) ) {
+      aPixel->SetRawValue(1.0e-6);
+      aPixel->SetPulseHeight(1.0e-6);
+    }
 
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-      }
+    if ( pixelGain ) {
+      SetPixelGainFromHisto( colPhys, linPhys, aPixel);
+    }
 
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+    }
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d and rawvalue %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetRawValue());
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
 
-    }
-  } //end readout==2
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d and rawvalue %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetRawValue());
 
-  //======================
+  }
+
+  return goForAnalysis;
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout3()
+{
   // Readout 3
   // - same as Readout==1 BUT REVERESE POLARITY
   //  JB, MK 2018/05/04
-  else if ( fReadout==3 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      aPixel->SetPixelLine( st / fStripsNu);
-      aPixel->SetPixelColumn( st % fStripsNu);
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-      // reverse polarity here
-      aPixel->SetRawValue( -aPixel->GetRawValue());
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0;
 
-      GetStrip(st)->SetPixelIndex( tci);
-      GetStrip(st)->SetRawValue( aPixel->GetRawValue() );
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  if( fDebugPlane>1 ) printf(" DPlane::Update: Plane %d has %d pixels\n", fPlaneNumber, fPixelsN);
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    aPixel->SetPixelLine( st / fStripsNu);
+    aPixel->SetPixelColumn( st % fStripsNu);
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, st / fStripsNu, st & fStripsNu, aPixel->GetRawValue(), GetStrip(st)->GetRawValue());
+    // reverse polarity here
+    aPixel->SetRawValue( -aPixel->GetRawValue());
 
-    }
-  } //end readout==3
+    GetStrip(st)->SetPixelIndex( tci);
+    GetStrip(st)->SetRawValue( aPixel->GetRawValue() );
 
-  //======================
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, st / fStripsNu, st & fStripsNu, aPixel->GetRawValue(), GetStrip(st)->GetRawValue());
+
+  }
+
+  return goForAnalysis;
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout102()
+{
   // Readout 102
   // - with zero suppression
   // - re-ordering of the channel numbering wrt strip numbering
@@ -1516,1334 +1696,1443 @@ Bool_t DPlane::Update(){
   // - allows to take into account external noise file
   // - further analysis done with DPixel object
   // JB 2013/08/18
-  else if ( fReadout==102 ){
-
-    if(fMimosaType == 225) {
-      //Subtracting the fist 8 columns from the pixel list. Only applies to Mi22THR
-      //temporal list with hit pixels excluding hot-pixels
-     std::vector<DPixel*> Temp_list;
-      Temp_list.clear();
-      for(int iPix=0;iPix<int(fListOfPixels->size());iPix++) {
-        aPixel = fListOfPixels->at(iPix);
-        if(aPixel->GetPixelIndex() % fStripsNu >= 8) Temp_list.push_back(aPixel);
-        else                                         delete aPixel;
-      }
-      fListOfPixels->clear();
-      for(int iPix=0;iPix<int(Temp_list.size());iPix++) {
-        fListOfPixels->push_back(Temp_list[iPix]);
-      }
-      Temp_list.clear();
-    }
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      linPhys = st / fStripsNu;
-      colPhys = st % fStripsNu;
-      stPhys = colPhys + linPhys*fStripsNu;
-      //if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-      ComputeStripPosition( colPhys, linPhys, u, v, w);
-      tPosition.SetValue(u,v,w); //
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t swapHalves = fMimosaType == 226;
+  const Bool_t noiseRun = fNoiseRun;
+
+  if(fMimosaType == 225) {
+    //Subtracting the fist 8 columns from the pixel list. Only applies to Mi22THR
+    //temporal list with hit pixels excluding hot-pixels
+   std::vector<DPixel*> Temp_list;
+    Temp_list.clear();
+    for(int iPix=0;iPix<int(fListOfPixels->size());iPix++) {
+      aPixel = fListOfPixels->at(iPix);
+      if(aPixel->GetPixelIndex() % fStripsNu >= 8) Temp_list.push_back(aPixel);
+      else                                         delete aPixel;
+    }
+    fListOfPixels->clear();
+    for(int iPix=0;iPix<int(Temp_list.size());iPix++) {
+      fListOfPixels->push_back(Temp_list[iPix]);
+    }
+    Temp_list.clear();
+  }
 
-      if(fMimosaType == 226 && !(124<=linPhys && linPhys <= 248) ) {
-        aPixel->SetRawValue(0);
-        aPixel->SetPulseHeight(0);
-        if( colPhys>63 ) {
-          colPhys -= 64;
-        } else {
-          colPhys += 64;
-        }
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    linPhys = st / fStripsNu;
+    colPhys = st % fStripsNu;
+    stPhys = colPhys + linPhys*fStripsNu;
+    //if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+    ComputeStripPosition( colPhys, linPhys, u, v, w);
+    tPosition.SetValue(u,v,w); //
+
+    if( swapHalves && !(124<=linPhys && linPhys <= 248) ) {
+      aPixel->SetRawValue(0);
+      aPixel->SetPulseHeight(0);
+      if( colPhys>63 ) {
+        colPhys -= 64;
+      } else {
+        colPhys += 64;
       }
+    }
 
-      // update the pixel
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPixelIndex( stPhys); // JB 2014/08/26
-      aPixel->SetPosition( tPosition);
-
-      //if(fMimosaType == 225) {
-      //if(colPhys >= 0 && colPhys <= 7) {
-      //  aPixel->SetRawValue(-1.0);
-      //  aPixel->SetPulseHeight(1.0);
-      //}
-      //}
-
-
+    // update the pixel
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPixelIndex( stPhys); // JB 2014/08/26
+    aPixel->SetPosition( tPosition);
+
+    //if(fMimosaType == 225) {
+    //if(colPhys >= 0 && colPhys <= 7) {
+    //  aPixel->SetRawValue(-1.0);
+    //  aPixel->SetPulseHeight(1.0);
+    //}
+    //}
+
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+      //aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
+    }
 
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-        //aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
-      }
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, position (%.1f, %.1f, %.1f), size (%.1f, %.1f, %.1f) raw value %.1f  pulse height %.1f  S/N %.2f   ped=%.1f noise=%.1f\n", tci, st, linPhys, colPhys, stPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetRawValue(), aPixel->GetPulseHeight(), aPixel->GetPulseHeightToNoise(), aPixel->GetPedestal(), aPixel->GetNoise());
+  } // end loop over hit pixels
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, position (%.1f, %.1f, %.1f), size (%.1f, %.1f, %.1f) raw value %.1f  pulse height %.1f  S/N %.2f   ped=%.1f noise=%.1f\n", tci, st, linPhys, colPhys, stPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetRawValue(), aPixel->GetPulseHeight(), aPixel->GetPulseHeightToNoise(), aPixel->GetPedestal(), aPixel->GetNoise());
-    } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
+  }
 
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
-    }
-  } //end readout==102
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout5()
+{
   // Readout without zero suppression BUT recquiring re-ordering
   // of channels wrt strips
   // Readout adapted to Mimosa 5
-  else if ( fReadout==5 ){
-    // the plane data corresponds to 2 inputs of the daq module
-    // so basically st = 512*...
-    // we inverse all the channel indexes for the second half or input
-    //   (that is complementing the column number to 511)
-    // this is due to the readout of scheme of sub-matrices
-    // which is symetric wrt the center of the chip
-    Int_t nPix = 512; // actual number of pixels of submatrix
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-
-      if( st >= 3*nPix*nPix ) { // submatrix A3
-        linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
-        colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
-      }
-      else if( st >= 2*nPix*nPix ) { // submatrix A2
-        linPhys = nPix-1 -st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
-        colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
-      }
-      else if( st >= nPix*nPix ) { // submatrix A1
-        linPhys = nPix-1 - st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
-        colPhys = st % nPix;
-      }
-      else { // submatrix A0
-        linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
-        colPhys = st % nPix;
-      }
-      stPhys = colPhys + linPhys*fStripsNu;
-      if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).aPitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-      // update the pixel
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
 
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
-      //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
+  // the plane data corresponds to 2 inputs of the daq module
+  // so basically st = 512*...
+  // we inverse all the channel indexes for the second half or input
+  //   (that is complementing the column number to 511)
+  // this is due to the readout of scheme of sub-matrices
+  // which is symetric wrt the center of the chip
+  Int_t nPix = 512; // actual number of pixels of submatrix
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-    } // end loop over hit pixels
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
 
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+    if( st >= 3*nPix*nPix ) { // submatrix A3
+      linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
+      colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
     }
+    else if( st >= 2*nPix*nPix ) { // submatrix A2
+      linPhys = nPix-1 -st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
+      colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
+    }
+    else if( st >= nPix*nPix ) { // submatrix A1
+      linPhys = nPix-1 - st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
+      colPhys = st % nPix;
+    }
+    else { // submatrix A0
+      linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
+      colPhys = st % nPix;
+    }
+    stPhys = colPhys + linPhys*fStripsNu;
+    if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).aPitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+
+    // update the pixel
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
+    //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
+
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
-  } //end if Readout==5
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout105()
+{
   // Readout with zero-suppression using a list of hit pixels
   // MIMOSA5 type indexes, i.e. 4 submatrices from equal size
-  else if ( fReadout==105 ){
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = 512; // size of one submatrix
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      // special treatment for November 2009 PLUME test
-      if(fSession->GetRunNumber()/100==205 && fPlaneNumber==6 ) { // NCS 07/11/09
-        //cout << "fPlaneNumber=" << fPlaneNumber << endl ;
-        st = st +1;
-      }
-      // compute line and column index from the index
-      // test order modified, JB 2009/05/25
-      if( st >= 3*nPix*nPix ) { // submatrix A3
-        linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
-        colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
-      }
-      else if( st >= 2*nPix*nPix ) { // submatrix A2
-        linPhys = nPix-1 -st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
-        colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
-      }
-      else if( st >= nPix*nPix ) { // submatrix A1
-        linPhys = nPix-1 - st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
-        colPhys = st % nPix;
-      }
-      else { // submatrix A0
-        linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
-        colPhys = st % nPix;
-      }
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-        aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());	// added MB/10/11/2010
-        if( TMath::Abs(aPixel->GetPedestal()) == 1023 ) {
-          aPixel->SetPulseHeight( 0.);
-        }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t shiftIndex = fSession->GetRunNumber()/100==205 && fPlaneNumber==6; // special treatment for November 2009 PLUME test
+  const Bool_t noiseRun = fNoiseRun;
+
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = 512; // size of one submatrix
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    // special treatment for November 2009 PLUME test
+    if( shiftIndex ) { // NCS 07/11/09
+      //cout << "fPlaneNumber=" << fPlaneNumber << endl ;
+      st = st +1;
+    }
+    // compute line and column index from the index
+    // test order modified, JB 2009/05/25
+    if( st >= 3*nPix*nPix ) { // submatrix A3
+      linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
+      colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
+    }
+    else if( st >= 2*nPix*nPix ) { // submatrix A2
+      linPhys = nPix-1 -st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
+      colPhys = st % nPix + fStripsNu-nPix; // shift by nPix if fStripsNu=2xnPix
+    }
+    else if( st >= nPix*nPix ) { // submatrix A1
+      linPhys = nPix-1 - st/nPix + fStripsNv-nPix; // flip line 511->0 & 0->511 and shift by nPix if fStripsNv=2xnPix
+      colPhys = st % nPix;
+    }
+    else { // submatrix A0
+      linPhys = nPix-1 - st/nPix; // flip line 511->0 & 0->511
+      colPhys = st % nPix;
+    }
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+      aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());	// added MB/10/11/2010
+      if( TMath::Abs(aPixel->GetPedestal()) == 1023 ) {
+        aPixel->SetPulseHeight( 0.);
       }
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%.1f, %.1f, %.1f), size (%.1f, %.1f, %.1f) raw value %.1f  pulse height %.1f  S/N %.2f   ped=%.1f noise=%.1f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetRawValue(), aPixel->GetPulseHeight(), aPixel->GetPulseHeightToNoise(), aPixel->GetPedestal(), aPixel->GetNoise());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
     }
-  } //end readout==105
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%.1f, %.1f, %.1f), size (%.1f, %.1f, %.1f) raw value %.1f  pulse height %.1f  S/N %.2f   ped=%.1f noise=%.1f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetRawValue(), aPixel->GetPulseHeight(), aPixel->GetPulseHeightToNoise(), aPixel->GetPedestal(), aPixel->GetNoise());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
+  }
 
+  return goForAnalysis;
 
-  //======================
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout18()
+{
   // Readout without zero suppression BUT recquiring re-ordering
   // of channels wrt strips
   // Readout adapted to Mimosa 18
-  else if ( fReadout==18 ){
-    // the plane data corresponds to 2 inputs of the daq module
-    // so basically st = 256*...
-    // we inverse all the channel indexes for the second half or input
-    //   (that is complementing the column number to 255)
-    // this is due to the readout of scheme of sub-matrices
-    // which is symetric wrt the center of the chip
-    Int_t nPix = 256; // actual number of pixels of submatrix
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-
-      if( st >= 3*nPix*nPix ) { // submatrix A3
-        linPhys = st / nPix - 3*nPix; // shift from 768->1023 to 0->256
-        colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
-      }
-      else if( st >= 2*nPix*nPix ) { // submatrix A2
-        linPhys = (4*nPix-1) - st / nPix; // flip from 512->767 to 511->256
-        colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
-      }
-      else if( st >= nPix*nPix ) { // submatrix A1
-        linPhys = 3*nPix - (st / nPix)-1; // flip from 256->511 to 511->256
-        colPhys = st % nPix;
-      }
-      else { // submatrix A0
-        linPhys = st / nPix;
-        colPhys = st % nPix;
-      }
-      stPhys = colPhys + linPhys*fStripsNu;
-      if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-      // update the pixel
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t maskPixels = 180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500;
+
+  // the plane data corresponds to 2 inputs of the daq module
+  // so basically st = 256*...
+  // we inverse all the channel indexes for the second half or input
+  //   (that is complementing the column number to 255)
+  // this is due to the readout of scheme of sub-matrices
+  // which is symetric wrt the center of the chip
+  Int_t nPix = 256; // actual number of pixels of submatrix
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
 
-      if(180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500 && linPhys==0 && (colPhys==2 || colPhys==3) ) {
-        aPixel->SetRawValue(1.0e-6);
-        aPixel->SetPulseHeight(1.0e-6);
-      }
+    if( st >= 3*nPix*nPix ) { // submatrix A3
+      linPhys = st / nPix - 3*nPix; // shift from 768->1023 to 0->256
+      colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
+    }
+    else if( st >= 2*nPix*nPix ) { // submatrix A2
+      linPhys = (4*nPix-1) - st / nPix; // flip from 512->767 to 511->256
+      colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
+    }
+    else if( st >= nPix*nPix ) { // submatrix A1
+      linPhys = 3*nPix - (st / nPix)-1; // flip from 256->511 to 511->256
+      colPhys = st % nPix;
+    }
+    else { // submatrix A0
+      linPhys = st / nPix;
+      colPhys = st % nPix;
+    }
+    stPhys = colPhys + linPhys*fStripsNu;
+    if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+
+    // update the pixel
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+
+    if( maskPixels && linPhys==0 && (colPhys==2 || colPhys==3) ) {
+      aPixel->SetRawValue(1.0e-6);
+      aPixel->SetPulseHeight(1.0e-6);
+    }
 
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight()); // put minus sign if needed here
-      //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight()); // put minus sign if needed here
+    //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
 
-      if( fDebugPlane>4 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-    } // end loop over hit pixels
+    if( fDebugPlane>4 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+  } // end loop over hit pixels
 
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
-    }
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
-  } //end if Readout==18
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout118()
+{
   // Readout with zero-suppression using a list of hit pixels
   // MIMOSA18 type indexes, i.e. 4 submatrices from equal size
-  else if ( fReadout==118 ){
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = 256; // size of one submatrix, JB 2009/05/25
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      // special treatment for November 2009 PLUME test
-      if(fSession->GetRunNumber()/100==205 && fPlaneNumber==6 ) { // NCS 07/11/09
-        //cout << "fPlaneNumber=" << fPlaneNumber << endl ;
-        st = st +1;
-      }
-      // compute line and column index from the index
-      // test order modified, JB 2009/05/25
-      if( st >= 4*nPix*nPix ) { // submatrix imaginary !
-        cout << "WARNING DPlane: M-18 readout 118: pixel index crazy = " << st << endl;
-      }
-      else if( st >= 3*nPix*nPix ) { // submatrix A3
-        linPhys = st / nPix - 3*nPix; // shift from 768->1023 to 0->256
-        colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
-      }
-      else if( st >= 2*nPix*nPix ) { // submatrix A2
-        linPhys = (4*nPix-1) - st / nPix; // flip from 512->767 to 511->256
-        colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
-      }
-      else if( st >= nPix*nPix ) { // submatrix A1
-        linPhys = 3*nPix - (st / nPix)-1; // flip from 256->511 to 511->256
-        colPhys = st % nPix;
-      }
-      else { // submatrix A0
-        linPhys = st / nPix;
-        colPhys = st % nPix;
-      }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t shiftIndex = fSession->GetRunNumber()/100==205 && fPlaneNumber==6; // special treatment for November 2009 PLUME test
+  const Bool_t noiseRun = fNoiseRun;
+  const Bool_t maskPixels = 180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500;
 
-      // Specific since Oct 2011
-      if( 0<=colPhys && colPhys<28 ) {
-        colPhys +=228;
-      }
-      else if( 28<=colPhys && colPhys<256 ) {
-        colPhys -=28;
-      }
-      else if( 256<=colPhys && colPhys<512-28 ) {
-        colPhys +=28;
-      }
-      else if( 512-28<=colPhys && colPhys<512 ) {
-        colPhys -=228;
-      }
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = 256; // size of one submatrix, JB 2009/05/25
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    // special treatment for November 2009 PLUME test
+    if( shiftIndex ) { // NCS 07/11/09
+      //cout << "fPlaneNumber=" << fPlaneNumber << endl ;
+      st = st +1;
+    }
+    // compute line and column index from the index
+    // test order modified, JB 2009/05/25
+    if( st >= 4*nPix*nPix ) { // submatrix imaginary !
+      cout << "WARNING DPlane: M-18 readout 118: pixel index crazy = " << st << endl;
+    }
+    else if( st >= 3*nPix*nPix ) { // submatrix A3
+      linPhys = st / nPix - 3*nPix; // shift from 768->1023 to 0->256
+      colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
+    }
+    else if( st >= 2*nPix*nPix ) { // submatrix A2
+      linPhys = (4*nPix-1) - st / nPix; // flip from 512->767 to 511->256
+      colPhys = (nPix-1) - st % nPix + nPix; // flip from 0->255 to 255->0 and shift by 256
+    }
+    else if( st >= nPix*nPix ) { // submatrix A1
+      linPhys = 3*nPix - (st / nPix)-1; // flip from 256->511 to 511->256
+      colPhys = st % nPix;
+    }
+    else { // submatrix A0
+      linPhys = st / nPix;
+      colPhys = st % nPix;
+    }
 
+    // Specific since Oct 2011
+    if( 0<=colPhys && colPhys<28 ) {
+      colPhys +=228;
+    }
+    else if( 28<=colPhys && colPhys<256 ) {
+      colPhys -=28;
+    }
+    else if( 256<=colPhys && colPhys<512-28 ) {
+      colPhys +=28;
+    }
+    else if( 512-28<=colPhys && colPhys<512 ) {
+      colPhys -=228;
+    }
 
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPixelIndex( aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn()); // JB 2014/08/26
-      aPixel->SetPosition( tPosition);
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPixelIndex( aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn()); // JB 2014/08/26
+    aPixel->SetPosition( tPosition);
+
+    if( maskPixels && linPhys==0 && (colPhys==2 || colPhys==3) ) {
+      aPixel->SetRawValue(1.0e-6);
+      aPixel->SetPulseHeight(1.0e-6);
+    }
 
-      if(180000 <= fSession->GetRunNumber() && fSession->GetRunNumber() <= 180500 && linPhys==0 && (colPhys==2 || colPhys==3) ) {
-        aPixel->SetRawValue(1.0e-6);
-        aPixel->SetPulseHeight(1.0e-6);
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+      //aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
+      if( TMath::Abs(aPixel->GetPedestal()) == 1023 ) {
+        aPixel->SetPulseHeight( 0.);
       }
+    }
 
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-        //aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
-        if( TMath::Abs(aPixel->GetPedestal()) == 1023 ) {
-          aPixel->SetPulseHeight( 0.);
-        }
-      }
+    // Specific for LNF beam test May 2014
+    // useless since June 2014
+    //      if( colPhys==367 && linPhys<257 &&  fSession->GetRunNumber()<100) {
+    //        aPixel->SetPulseHeight( 0.);
+    //      }
+
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), value %f\n", tci, st, linPhys, colPhys, u, v, w, aPixel->GetPulseHeight());
+    //         if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
+  }
 
-      // Specific for LNF beam test May 2014
-      // useless since June 2014
-      //      if( colPhys==367 && linPhys<257 &&  fSession->GetRunNumber()<100) {
-      //        aPixel->SetPulseHeight( 0.);
-      //      }
-
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), value %f\n", tci, st, linPhys, colPhys, u, v, w, aPixel->GetPulseHeight());
-      //         if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      //cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
-    }
-  } //end readout==118
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout20()
+{
   // Readout using a list of hit pixels
   // MIMOSA20 type indexes, i.e. 5 submatrices 320 ligns * 66 columns
   // with the 2 first pixels out of 66 being markers and not used
   // NCS 27/09/09
-  else if ( fReadout==20 )
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
+
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPixPerBloc = 66; // size of one submatrix, in Nb of Columns NCS 27/09/09
+  Int_t nPixPerLign = 330; // size of one submatrix in Nb of columns, includes the 10 marker pixels
+  Int_t bloc=0 ; // to know in which submatrix we are (between 0 and 4)
+  Int_t colInsideBloc=0; // Column Number inside the submatrix
+  Int_t indexBloc=0; // Starting index of the submatrix
+  Int_t NbOfMarkers =0;
+
+  if(fDebugPlane>8) cout << "DPlane::Update, readout = "<< fReadout <<", fPixelsN=" << fPixelsN << endl ;
+  for (Int_t tci = 0; tci < fPixelsN; tci++) // loop over hit pixels
   {
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPixPerBloc = 66; // size of one submatrix, in Nb of Columns NCS 27/09/09
-    Int_t nPixPerLign = 330; // size of one submatrix in Nb of columns, includes the 10 marker pixels
-    Int_t bloc=0 ; // to know in which submatrix we are (between 0 and 4)
-    Int_t colInsideBloc=0; // Column Number inside the submatrix
-    Int_t indexBloc=0; // Starting index of the submatrix
-    Int_t NbOfMarkers =0;
-
-    if(fDebugPlane>8) cout << "DPlane::Update, readout = "<< fReadout <<", fPixelsN=" << fPixelsN << endl ;
-    for (Int_t tci = 0; tci < fPixelsN; tci++) // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex(); // TNT pixel index NCS 01/10/09
+    // ----- Organisation of indexes in physical Lines and columns ---- //
+    if(st<105600) // pixel TNT numbering ie with the markers submatrix A1
     {
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex(); // TNT pixel index NCS 01/10/09
-      // ----- Organisation of indexes in physical Lines and columns ---- //
-      if(st<105600) // pixel TNT numbering ie with the markers submatrix A1
+      // Determination of the lign in the matrix
+      linPhys=st/nPixPerLign; // entire part of the division
+      // For chip in vertical position Height 640 width 320
+      //++colPhys=st/nPixPerLign; // entire part of the division
+      // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
+      bloc=st%5;
+      // Determination of the column number inside a submatrix
+      colInsideBloc=(st-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
+      // For chip in vertical position Height 640 width 320
+      //++colInsideBloc=(st-colPhys*nPixPerLign-bloc)/5 - 2 ; //=> LineInsideBloc en fait puisque vertical
+      if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
       {
-        // Determination of the lign in the matrix
-        linPhys=st/nPixPerLign; // entire part of the division
-        // For chip in vertical position Height 640 width 320
-        //++colPhys=st/nPixPerLign; // entire part of the division
-        // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
-        bloc=st%5;
-        // Determination of the column number inside a submatrix
-        colInsideBloc=(st-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
-        // For chip in vertical position Height 640 width 320
-        //++colInsideBloc=(st-colPhys*nPixPerLign-bloc)/5 - 2 ; //=> LineInsideBloc en fait puisque vertical
-        if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
-        {
-          cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;
-          //tci++ ;
-          NbOfMarkers ++;
-          //if(tci<fPixelsN) goto WasAMarker20;
-          continue;
-          //else goto WasAMarkerEnd20;
-        }
-
-        // Shift index with respect to the beginning of the global matrix
-        indexBloc= bloc*(nPixPerBloc-2);
-        // Column number inside the general matrix
-        colPhys = indexBloc+colInsideBloc;
-        // For chip in vertical position Height 640 width 320
-        //++linPhys = indexBloc+colInsideBloc;
-
+        cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;
+        //tci++ ;
+        NbOfMarkers ++;
+        //if(tci<fPixelsN) goto WasAMarker20;
+        continue;
+        //else goto WasAMarkerEnd20;
       }
-      else if(st>105599)// pixel TNT numbering, submatrix A0
-      {
-        // Determination of the lign in the matrix
-        //linPhys=st/nPixPerLign; // entire part of the division
-        // For chip in vertical position Height 640 width 320
-        colPhys=(st-105600)/nPixPerLign; // entire part of the division
-        // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
-        bloc=(st-105600)%5;
-        // Determination of the column number inside a submatrix
-        //colInsideBloc=(st-105600-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
-        // For chip in vertical position Height 640 width 320
-        colInsideBloc=(st-105600-colPhys*nPixPerLign-bloc)/5 - 2 ;
-        if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
-        {
-          cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;
-          //tci++;
-          NbOfMarkers ++;
-          //if(tci<fPixelsN) goto WasAMarker;
-          continue;
-          //else goto WasAMarkerEnd;
 
-        }
+      // Shift index with respect to the beginning of the global matrix
+      indexBloc= bloc*(nPixPerBloc-2);
+      // Column number inside the general matrix
+      colPhys = indexBloc+colInsideBloc;
+      // For chip in vertical position Height 640 width 320
+      //++linPhys = indexBloc+colInsideBloc;
 
-        // Shift index with respect to the beginning of the global matrix
-        indexBloc= (bloc+5)*(nPixPerBloc-2); // adding matrix A1 columns (5 blocs)
-        // Column number inside the general matrix
-
-        //colPhys = indexBloc+colInsideBloc;
-        // For chip in vertical position Height 640 width 320
-        linPhys = indexBloc+colInsideBloc;
+    }
+    else if(st>105599)// pixel TNT numbering, submatrix A0
+    {
+      // Determination of the lign in the matrix
+      //linPhys=st/nPixPerLign; // entire part of the division
+      // For chip in vertical position Height 640 width 320
+      colPhys=(st-105600)/nPixPerLign; // entire part of the division
+      // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
+      bloc=(st-105600)%5;
+      // Determination of the column number inside a submatrix
+      //colInsideBloc=(st-105600-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
+      // For chip in vertical position Height 640 width 320
+      colInsideBloc=(st-105600-colPhys*nPixPerLign-bloc)/5 - 2 ;
+      if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
+      {
+        cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;
+        //tci++;
+        NbOfMarkers ++;
+        //if(tci<fPixelsN) goto WasAMarker;
+        continue;
+        //else goto WasAMarkerEnd;
 
-        //cout << "NCS colPhys=" << colPhys << " linPhys=" << linPhys << endl ;
+      }
 
+      // Shift index with respect to the beginning of the global matrix
+      indexBloc= (bloc+5)*(nPixPerBloc-2); // adding matrix A1 columns (5 blocs)
+      // Column number inside the general matrix
 
-      } // end pixel TNT numbering > 105600 (after shift), matrix A0
+      //colPhys = indexBloc+colInsideBloc;
+      // For chip in vertical position Height 640 width 320
+      linPhys = indexBloc+colInsideBloc;
 
+      //cout << "NCS colPhys=" << colPhys << " linPhys=" << linPhys << endl ;
 
-      // physical index start
-      stPhys = colPhys + linPhys*fStripsNu;
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      if (fDebugPlane>8) cout << "DPlane::Update() EvtNumber=" << fSession->GetCurrentEventNumber()<< "** Plane=" << fSession->GetPlaneNumber() << "** tci= " << tci << "** st= " << st << "** colPhys=" << colPhys << "**linPhys=" << linPhys << "** stPhys=" << stPhys << "** value=" << aPixel->GetPulseHeight()<<endl ;
+    } // end pixel TNT numbering > 105600 (after shift), matrix A0
 
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
-      //cout <<  "GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight())=" << aPixel->GetPulseHeight()<< endl ;
-      //GetStrip(stPhys)->UpdateSignal();  // done at call for analyze_basic, JB 2011/04/15 // Remark : NCS 05/10/09 update only for signals
+    // physical index start
+    stPhys = colPhys + linPhys*fStripsNu;
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    if (fDebugPlane>8) cout << "DPlane::Update() EvtNumber=" << fSession->GetCurrentEventNumber()<< "** Plane=" << fSession->GetPlaneNumber() << "** tci= " << tci << "** st= " << st << "** colPhys=" << colPhys << "**linPhys=" << linPhys << "** stPhys=" << stPhys << "** value=" << aPixel->GetPulseHeight()<<endl ;
 
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
+    //cout <<  "GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight())=" << aPixel->GetPulseHeight()<< endl ;
+    //GetStrip(stPhys)->UpdateSignal();  // done at call for analyze_basic, JB 2011/04/15 // Remark : NCS 05/10/09 update only for signals
 
-    } // end loop over hit pixels
-    if( fPixelsN==0 )
-    {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
-    }
+  } // end loop over hit pixels
+  if( fPixelsN==0 )
+  {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
+  }
 
+  return goForAnalysis;
 
-  } //end readout==20, fin NCS 27/09/09 Mimosa20 readout
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout120()
+{
   // Readout with zero-suppression using a list of hit pixels
   // MIMOSA20 type indexes
-  else if ( fReadout==120 )
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
+
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+
+  //if(fPlaneNumber==1 || fPlaneNumber==3)
+  //cout << "M20 DPlane.cxx st=" << st << " fPlaneNumber=" << fPlaneNumber <<", evtnumber = " << fSession->GetCurrentEventNumber()<< endl;
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPixPerBloc = 66; // size of one submatrix, in Nb of Columns NCS 27/09/09
+  Int_t nPixPerLign = 330; // size of one submatrix in Nb of columns, includes the 10 marker pixels
+  Int_t bloc=0 ; // to know in which submatrix we are (between 0 and 4)
+  Int_t colInsideBloc=0; // Column Number inside the submatrix
+  Int_t indexBloc=0; // Starting index of the submatrix
+  Int_t NbOfMarkers =0;
+
+  if(fDebugPlane>8) cout << "DPlane::Update, readout = "<< fReadout <<", fPixelsN=" << fPixelsN << endl ;
+  for (Int_t tci = 0; tci < fPixelsN; tci++) // loop over hit pixels
   {
-    //if(fPlaneNumber==1 || fPlaneNumber==3)
-    //cout << "M20 DPlane.cxx st=" << st << " fPlaneNumber=" << fPlaneNumber <<", evtnumber = " << fSession->GetCurrentEventNumber()<< endl;
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPixPerBloc = 66; // size of one submatrix, in Nb of Columns NCS 27/09/09
-    Int_t nPixPerLign = 330; // size of one submatrix in Nb of columns, includes the 10 marker pixels
-    Int_t bloc=0 ; // to know in which submatrix we are (between 0 and 4)
-    Int_t colInsideBloc=0; // Column Number inside the submatrix
-    Int_t indexBloc=0; // Starting index of the submatrix
-    Int_t NbOfMarkers =0;
-
-    if(fDebugPlane>8) cout << "DPlane::Update, readout = "<< fReadout <<", fPixelsN=" << fPixelsN << endl ;
-    for (Int_t tci = 0; tci < fPixelsN; tci++) // loop over hit pixels
-    {
 
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex(); // TNT pixel index NCS 01/10/09
-      //cout << endl  << "M20 st=" << st << " fPlaneNumber=" << fPlaneNumber <<", evtnumber = " << fSession->GetCurrentEventNumber()<< endl;
-
-      //if(st<11){ cout << "st<11=" << st << endl ; getchar();}
-      //cout << " st = " << st << endl ;
-      //cout << "aPixel->GetPulseHeight()=" << aPixel->GetPulseHeight()<< endl ;
-      //if(fSession->GetPlaneNumber()==0){h1->Fill(st);h5->Fill(aPixel->GetPulseHeight());}
-      //if(aPixel->GetPulseHeight()>3300) {cout << "st=" << st << " GetPulseHeight=" << aPixel->GetPulseHeight()<< endl ;}
-      //if(st==65012){ cout << "marker!"<< endl ; getchar();}
-
-      // ----- Organisation of indexes in physical Lines and columns ---- //
-      if(st<105600) // pixel TNT numbering ie with the markers submatrix A1
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex(); // TNT pixel index NCS 01/10/09
+    //cout << endl  << "M20 st=" << st << " fPlaneNumber=" << fPlaneNumber <<", evtnumber = " << fSession->GetCurrentEventNumber()<< endl;
+
+    //if(st<11){ cout << "st<11=" << st << endl ; getchar();}
+    //cout << " st = " << st << endl ;
+    //cout << "aPixel->GetPulseHeight()=" << aPixel->GetPulseHeight()<< endl ;
+    //if(fSession->GetPlaneNumber()==0){h1->Fill(st);h5->Fill(aPixel->GetPulseHeight());}
+    //if(aPixel->GetPulseHeight()>3300) {cout << "st=" << st << " GetPulseHeight=" << aPixel->GetPulseHeight()<< endl ;}
+    //if(st==65012){ cout << "marker!"<< endl ; getchar();}
+
+    // ----- Organisation of indexes in physical Lines and columns ---- //
+    if(st<105600) // pixel TNT numbering ie with the markers submatrix A1
+    {
+      //cout << "NCS DPlane.cxx st<105600 : st=" << st << endl ;
+      // Determination of the lign in the matrix
+      //linPhys=st/nPixPerLign; // entire part of the division
+      // For chip in vertical position Height 640 width 320
+      colPhys=st/nPixPerLign; // entire part of the division
+      //cout << "colPhys=st/330=" << colPhys << endl ;
+      // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
+      bloc=st%5;
+      //cout << "bloc=st%5=" << bloc << endl ;
+
+      // Determination of the column number inside a submatrix
+      //colInsideBloc=(st-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the 2 markers of each bloc
+      // For chip in vertical position Height 640 width 320
+      colInsideBloc=(st-colPhys*nPixPerLign-bloc)/5 - 2 ; //=> LineInsideBloc en fait puisque vertical
+      //cout << "colInsideBloc=(st-colPhys*330-bloc)/5 - 2 =" << colInsideBloc<< endl ;
+      if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
       {
-        //cout << "NCS DPlane.cxx st<105600 : st=" << st << endl ;
-        // Determination of the lign in the matrix
-        //linPhys=st/nPixPerLign; // entire part of the division
-        // For chip in vertical position Height 640 width 320
-        colPhys=st/nPixPerLign; // entire part of the division
-        //cout << "colPhys=st/330=" << colPhys << endl ;
-        // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
-        bloc=st%5;
-        //cout << "bloc=st%5=" << bloc << endl ;
-
-        // Determination of the column number inside a submatrix
-        //colInsideBloc=(st-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the 2 markers of each bloc
+        //if(st!=0){cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;getchar();}
+        //if(st==65012 ||st==79861 ){ cout << "marker!"<< endl ; return 0;}
+        //tci++ ;
+        NbOfMarkers ++;
+        //if(tci<fPixelsN)
+        //continue;
+        //else goto WasAMarkerEnd;
+      }
+      else if(colInsideBloc>=0)
+      {
+        // Shift index with respect to the beginning of the global matrix
+        indexBloc= bloc*(nPixPerBloc-2);
+        //cout << "indexBloc= bloc*(nPixPerBloc-2)=" << indexBloc <<endl ;
+        // Column number inside the general matrix
+        //colPhys = indexBloc+colInsideBloc;
         // For chip in vertical position Height 640 width 320
-        colInsideBloc=(st-colPhys*nPixPerLign-bloc)/5 - 2 ; //=> LineInsideBloc en fait puisque vertical
-        //cout << "colInsideBloc=(st-colPhys*330-bloc)/5 - 2 =" << colInsideBloc<< endl ;
-        if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
-        {
-          //if(st!=0){cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ;getchar();}
-          //if(st==65012 ||st==79861 ){ cout << "marker!"<< endl ; return 0;}
-          //tci++ ;
-          NbOfMarkers ++;
-          //if(tci<fPixelsN)
-          //continue;
-          //else goto WasAMarkerEnd;
-        }
-        else if(colInsideBloc>=0)
+        linPhys = indexBloc+colInsideBloc;
+        //cout << "linPhys = indexBloc+colInsideBloc=" << linPhys << endl ;
+        //******************************************************************************
+        ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+        //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+        //		  v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+        //		  w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+        u=-u;// NCS 101209 OK for PLUME VERTICAL
+        v=-v; // NCS 101209 OK for PLUME VERTICAL
+        //temp=u; // NCS 101209 for PLUME HORIZONTAL
+        //u=v;
+        //v=temp;
+
+        //cout << "tci=" << tci << " colPhys=" << colPhys << "  u=" << u << endl ;
+        //cout << "linPhys=" << linPhys << "  v=" << v << endl ;
+        //cout << "(u,v)=("<< u <<","<< v<<")" << " (line,col)=(" << linPhys << "," << colPhys <<")" << endl ;
+
+        //if(TMath::Abs(u)<3000 && v > (-7500) && v < (-500)  )
         {
-          // Shift index with respect to the beginning of the global matrix
-          indexBloc= bloc*(nPixPerBloc-2);
-          //cout << "indexBloc= bloc*(nPixPerBloc-2)=" << indexBloc <<endl ;
-          // Column number inside the general matrix
-          //colPhys = indexBloc+colInsideBloc;
-          // For chip in vertical position Height 640 width 320
-          linPhys = indexBloc+colInsideBloc;
-          //cout << "linPhys = indexBloc+colInsideBloc=" << linPhys << endl ;
-          //******************************************************************************
-          ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-          //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-          //		  v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-          //		  w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-          u=-u;// NCS 101209 OK for PLUME VERTICAL
-          v=-v; // NCS 101209 OK for PLUME VERTICAL
-          //temp=u; // NCS 101209 for PLUME HORIZONTAL
-          //u=v;
-          //v=temp;
-
-          //cout << "tci=" << tci << " colPhys=" << colPhys << "  u=" << u << endl ;
-          //cout << "linPhys=" << linPhys << "  v=" << v << endl ;
-          //cout << "(u,v)=("<< u <<","<< v<<")" << " (line,col)=(" << linPhys << "," << colPhys <<")" << endl ;
-
-          //if(TMath::Abs(u)<3000 && v > (-7500) && v < (-500)  )
-          {
-            tPosition.SetValue(u,v,w); //
-            aPixel->SetSize( (*fPitch));
-            aPixel->SetPixelLine( linPhys);
-            aPixel->SetPixelColumn( colPhys);
-            aPixel->SetPosition( tPosition);
-          }
-          //else{cout << "je suis sur la matrice du haut "<< endl ;}
-          //******************************************************************************
+          tPosition.SetValue(u,v,w); //
+          aPixel->SetSize( (*fPitch));
+          aPixel->SetPixelLine( linPhys);
+          aPixel->SetPixelColumn( colPhys);
+          aPixel->SetPosition( tPosition);
         }
+        //else{cout << "je suis sur la matrice du haut "<< endl ;}
+        //******************************************************************************
+      }
+
+    }
+    else if(st>105599)// pixel TNT numbering, submatrix A0
+    {
+      //cout << "NCS DPlane.cxx st>105599 : st=" << st << endl ;
+      // Determination of the lign in the matrix
+      //linPhys=(st-105600)/nPixPerLign; // entire part of the division
+      // For chip in vertical position Height 640 width 320
+      //cout << "NCS DPlane.cxx st=+3200 : st=" << st << endl ;
+      colPhys=(st-105600)/nPixPerLign; // entire part of the division
+      //cout << "colPhys=(st-105600)/330=" << colPhys << endl ;
+
+      // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
+      bloc=(st-105600)%5;
+      //cout << "bloc=(st-105600)%5=" << bloc <<endl ;
+      // Determination of the column number inside a submatrix
+      //colInsideBloc=(st-105600-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
+      // For chip in vertical position Height 640 width 320
+      colInsideBloc=(st-105600-colPhys*nPixPerLign-bloc)/5 - 2 ;
+      //cout << "colInsideBloc=(st-105600-colPhys*330-bloc)/5 - 2=" << colInsideBloc << endl ;
+      if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
+      {
+        //if(st!=105600) {cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ; getchar();}
+        //tci++;
+        //if(st==65012 ||st==79861 ){ cout << "marker!"<< endl ;return 0;}
+        NbOfMarkers ++;
+        //if(tci<fPixelsN)
+        //continue;
+        //else goto WasAMarkerEnd;
 
       }
-      else if(st>105599)// pixel TNT numbering, submatrix A0
+      else if(colInsideBloc>=0)
       {
-        //cout << "NCS DPlane.cxx st>105599 : st=" << st << endl ;
-        // Determination of the lign in the matrix
-        //linPhys=(st-105600)/nPixPerLign; // entire part of the division
-        // For chip in vertical position Height 640 width 320
-        //cout << "NCS DPlane.cxx st=+3200 : st=" << st << endl ;
-        colPhys=(st-105600)/nPixPerLign; // entire part of the division
-        //cout << "colPhys=(st-105600)/330=" << colPhys << endl ;
-
-        // Determination of the submatrix  number (between 0 and 4) = rest of the division by 5 gives the number of the submatrix
-        bloc=(st-105600)%5;
-        //cout << "bloc=(st-105600)%5=" << bloc <<endl ;
-        // Determination of the column number inside a submatrix
-        //colInsideBloc=(st-105600-linPhys*nPixPerLign-bloc)/5 - 2 ; // shift of 2 because of the markers
-        // For chip in vertical position Height 640 width 320
-        colInsideBloc=(st-105600-colPhys*nPixPerLign-bloc)/5 - 2 ;
-        //cout << "colInsideBloc=(st-105600-colPhys*330-bloc)/5 - 2=" << colInsideBloc << endl ;
-        if(colInsideBloc<0)// a negative colInsideBloc indicates a marker
-        {
-          //if(st!=105600) {cout << "fPixelsN =" << fPixelsN << "** tci marker=" << tci << "** st=" << st << endl ; getchar();}
-          //tci++;
-          //if(st==65012 ||st==79861 ){ cout << "marker!"<< endl ;return 0;}
-          NbOfMarkers ++;
-          //if(tci<fPixelsN)
-          //continue;
-          //else goto WasAMarkerEnd;
+        // Shift index with respect to the beginning of the global matrix
+        indexBloc= (bloc+5)*(nPixPerBloc-2); // adding matrix A1 columns (5 blocs)
+        //cout << "indexBloc= (bloc+5)*(nPixPerBloc-2)=" << indexBloc << endl ;
 
-        }
-        else if(colInsideBloc>=0)
+        // Column number inside the general matrix
+        //colPhys = indexBloc+colInsideBloc;
+        // For chip in vertical position Height 640 width 320
+        linPhys = indexBloc+colInsideBloc;
+        //cout << "linPhys = indexBloc+colInsideBloc=" << linPhys << endl ;
+        //******************************************************************************
+        ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+        //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+        //		  v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+        //		  w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+        u=-u;// NCS 101209 OK for PLUME VERTICAL
+        v=-v;// NCS 101209 OK for PLUME VERTICAL
+        //temp=u; // NCS 101209 for PLUME HORIZONTAL
+        //u=v;
+        //v=temp;
+
+        //cout << "tci=" << tci << " colPhys=" << colPhys << "  u=" << u << endl ;
+        //cout << "linPhys=" << linPhys << "  v=" << v << endl ;
+        //cout << "(u,v)=("<< u <<","<< v<<")" << " (line,col)=(" << linPhys << "," << colPhys <<")" << endl ;
+
+        //if(TMath::Abs(u)<3000 && v > (-7500) && v < (-500)  )
         {
-          // Shift index with respect to the beginning of the global matrix
-          indexBloc= (bloc+5)*(nPixPerBloc-2); // adding matrix A1 columns (5 blocs)
-          //cout << "indexBloc= (bloc+5)*(nPixPerBloc-2)=" << indexBloc << endl ;
-
-          // Column number inside the general matrix
-          //colPhys = indexBloc+colInsideBloc;
-          // For chip in vertical position Height 640 width 320
-          linPhys = indexBloc+colInsideBloc;
-          //cout << "linPhys = indexBloc+colInsideBloc=" << linPhys << endl ;
-          //******************************************************************************
-          ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-          //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-          //		  v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-          //		  w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-          u=-u;// NCS 101209 OK for PLUME VERTICAL
-          v=-v;// NCS 101209 OK for PLUME VERTICAL
-          //temp=u; // NCS 101209 for PLUME HORIZONTAL
-          //u=v;
-          //v=temp;
-
-          //cout << "tci=" << tci << " colPhys=" << colPhys << "  u=" << u << endl ;
-          //cout << "linPhys=" << linPhys << "  v=" << v << endl ;
-          //cout << "(u,v)=("<< u <<","<< v<<")" << " (line,col)=(" << linPhys << "," << colPhys <<")" << endl ;
-
-
-          //if(TMath::Abs(u)<3000 && v > (-7500) && v < (-500)  )
-          {
-            tPosition.SetValue(u,v,w); //
-            aPixel->SetSize( (*fPitch));
-            aPixel->SetPixelLine( linPhys);
-            aPixel->SetPixelColumn( colPhys);
-            aPixel->SetPosition( tPosition);
-          }
-          //else{cout << "je suis sur la matrice du haut "<< endl ;}
-          //******************************************************************************
+          tPosition.SetValue(u,v,w); //
+          aPixel->SetSize( (*fPitch));
+          aPixel->SetPixelLine( linPhys);
+          aPixel->SetPixelColumn( colPhys);
+          aPixel->SetPosition( tPosition);
         }
-      } // end pixel TNT numbering > 105600 (after shift), matrix A0
+        //else{cout << "je suis sur la matrice du haut "<< endl ;}
+        //******************************************************************************
+      }
+    } // end pixel TNT numbering > 105600 (after shift), matrix A0
 
-      if( fDebugPlane>8 ) printf("DPlane::Update()  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
+    if( fDebugPlane>8 ) printf("DPlane::Update()  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
 
-    } // end loop over hit pixels
-    if( fPixelsN==0 )
-    {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
-    }
-  } //end readout==120, fin NCS 30/10/09 Mimosa20 readout
+  } // end loop over hit pixels
+  if( fPixelsN==0 )
+  {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in event " << fAcq->GetEventNumber() << endl;
+  }
 
+  return goForAnalysis;
 
-  //======================
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout22()
+{
   // Readout :
   // - without zero suppression
   // - recquiring re-ordering of channels wrt strips
   // - with binary output
   // Readout adapted to Mimosa 22 digital part
   // JB 2013/08/14
-  else if ( fReadout==22 ){
-    // the plane data corresponds to 2 inputs of the daq module
-    // so basically st = 256*...
-    // we inverse all the channel indexes for the second half or input
-    //   (that is complementing the column number to 255)
-    // this is due to the readout of scheme of sub-matrices
-    // which is symetric wrt the center of the chip
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      if(fMimosaType != 225) {
-        linPhys = st / fStripsNu;
-        colPhys = st % fStripsNu;
-      }
-      else {
-        linPhys = st / fStripsNu;
-        if((st / (fStripsNu/2)) % 2) colPhys = 2*(st % (fStripsNu/2)) + 1;
-        else                         colPhys = 2*(st % (fStripsNu/2));
-      }
-      stPhys = colPhys + linPhys*fStripsNu;
-      if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      tPosition.SetValue(u,v,w); //
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t interleaved = fMimosaType == 225;
+  Int_t maskFromColumn = -1; // Trick to consider only one part of MIMOSA 22, -1 for none
+  if( 22700<=fSession->GetRunNumber() && fSession->GetRunNumber()<22800 ) maskFromColumn = 320; // 22AHR: S1-S10 col<320, S11-S16 col>=320
+  else if( 22800<=fSession->GetRunNumber() && fSession->GetRunNumber()<22900 ) maskFromColumn = 97; // 22AHR: S1-S4 col:96/192/256
+
+  // the plane data corresponds to 2 inputs of the daq module
+  // so basically st = 256*...
+  // we inverse all the channel indexes for the second half or input
+  //   (that is complementing the column number to 255)
+  // this is due to the readout of scheme of sub-matrices
+  // which is symetric wrt the center of the chip
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    if( !interleaved ) {
+      linPhys = st / fStripsNu;
+      colPhys = st % fStripsNu;
+    }
+    else {
+      linPhys = st / fStripsNu;
+      if((st / (fStripsNu/2)) % 2) colPhys = 2*(st % (fStripsNu/2)) + 1;
+      else                         colPhys = 2*(st % (fStripsNu/2));
+    }
+    stPhys = colPhys + linPhys*fStripsNu;
+    if( fDebugPlane>2 && stPhys>fStripsN-1) printf(" Pb1 with st %d, (line,col)=(%d,%d), physIndex %d, value %f\n", st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    tPosition.SetValue(u,v,w); //
+
+    // update the pixel
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci); // JB 2013/08/20
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
+    //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
+
+    // Trick to consider only one part of MIMOSA 22
+    if ( maskFromColumn>=0 && colPhys>=maskFromColumn ) {
+      aPixel->SetRawValue(0);
+      aPixel->SetPulseHeight(0);
+      GetStrip(stPhys)->SetRawValue(0);
+    }
 
-      // update the pixel
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+  } // end loop over hit pixels
 
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci); // JB 2013/08/20
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
-      //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
-
-      // Trick to consider only one part of MIMOSA 22
-      if (
-          (22700<=fSession->GetRunNumber() && fSession->GetRunNumber()<22800 && colPhys>=320) // 22AHR: S1-S10 col<320, S11-S16 col>=320
-          ||
-          (22800<=fSession->GetRunNumber() && fSession->GetRunNumber()<22900 && colPhys>96) // 22AHR: S1-S4 col:96/192/256
-          ) {
-        aPixel->SetRawValue(0);
-        aPixel->SetPulseHeight(0);
-        GetStrip(stPhys)->SetRawValue(0);
-      }
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
+  return goForAnalysis;
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-    } // end loop over hit pixels
+}
 
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+//______________________________________________________________________________
+//
+void DPlane::BuildMimosa25Map(const char *aChip)
+{
+  // Channel map of the MIMOSA25 readouts (25 and 125) for the pitch given
+  //  by fMimosaType, aChip being "Mi25A" or "Mi25B".
+  // The first line of each submatrix depends on the pitch: it is stored
+  //  in fMimosaLineOffset, so that the pixel loops do not test the pitch.
+
+  Int_t linesPerSubmatrix = 0;
+  switch (fMimosaType) {
+    case 20:
+      fMimosaMap = new TMimosa24_25Map(Form("%s_20um",aChip)); //20um pitch
+      linesPerSubmatrix = 32;
+      break;
+    case 30:
+      fMimosaMap = new TMimosa24_25Map(Form("%s_30um",aChip)); //30um pitch
+      break;
+    case 40:
+      fMimosaMap = new TMimosa24_25Map(Form("%s_40um",aChip)); //40um pitch
+      linesPerSubmatrix = 16;
+      break;
+    default:
+      cout << "MimosaType " << fMimosaType << " unknown for Mimosa25" << endl;
+      Fatal("DPlane:Update", "==> CHANGE CONFIG FILE, I AM STOPPING! <==");
+  };
+
+  fMimosaLineOffset = new Int_t[TMimosa24_25Map::buff_m_max];
+  for( Int_t sub=0; sub<TMimosa24_25Map::buff_m_max; sub++) {
+    if( linesPerSubmatrix>0 ) { // submatrices of the same size
+      fMimosaLineOffset[sub] = sub*linesPerSubmatrix;
     }
+    else { // 30um pitch, submatrices of 21, 22 and 21 lines
+      fMimosaLineOffset[sub] = sub==0 ? 0 : sub==1 ? 21 : sub==2 ? 43 : -1;
+    }
+  }
 
-  } //end if Readout==22
-
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout25()
+{
   // Readout without zero-suppression BUT recquiring re-ordering
   // MIMOSA25 type indexes
   // RDM 210509, JB 2009/05/25
-  else if ( fReadout==25 ){
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    TMimosa24_25Map *Mi=0;
-    switch (fMimosaType) {
-      case 20:
-        Mi = new TMimosa24_25Map("Mi25B_20um"); //20um pitch
-        break;
-      case 30:
-        Mi = new TMimosa24_25Map("Mi25B_30um"); //30um pitch
-        break;
-      case 40:
-        Mi = new TMimosa24_25Map("Mi25B_40um"); //40um pitch
-        break;
-      default:
-        cout << "MimosaType " << fMimosaType << " unknown for Mimosa25" << endl;
-        Fatal("DPlane:Update", "==> CHANGE CONFIG FILE, I AM STOPPING! <==");
-    };
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = TMath::Max( fStripsNu/2, fStripsNv*2); // size of submatrix is the smallest
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
 
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      // compute line and column index from the index
-      switch (fMimosaType) {
-        case 20:
-          linPhys = Mi->get_submatrix(st / nPix,st % nPix)*32+Mi->get_row(st / nPix,st % nPix);
-          break;
-        case 30:
-          if (Mi->get_submatrix(st / nPix,st % nPix)==0)
-            linPhys = Mi->get_row(st / nPix,st % nPix);
-          else if (Mi->get_submatrix(st / nPix,st % nPix)==1)
-            linPhys = 21 + Mi->get_row(st / nPix,st % nPix);
-          else if (Mi->get_submatrix(st / nPix,st % nPix)==2)
-            linPhys = 43 + Mi->get_row(st / nPix,st % nPix);
-          break;
-        case 40:
-          linPhys = Mi->get_submatrix(st / nPix,st % nPix)*16+Mi->get_row(st / nPix,st % nPix);
-          break;
-      };
-
-      colPhys = Mi->get_column(st / nPix,st % nPix);
-      // physical index
-      stPhys = colPhys + linPhys*fStripsNu;
-
-      aPixel->SetPixelLine( linPhys); // YV, 2009/06/05
-      aPixel->SetPixelColumn( colPhys); // YV, 2009/06/05
-
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
-      //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
-    }
-    delete Mi;  //RDM290509
-  } //end readout==25
+  // channel map, built at the first event
+  if( fMimosaMap==0 ) BuildMimosa25Map("Mi25B");
+  TMimosa24_25Map *Mi = fMimosaMap;
+  const Int_t *lineOffset = fMimosaLineOffset;
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = TMath::Max( fStripsNu/2, fStripsNv*2); // size of submatrix is the smallest
 
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    // compute line and column index from the index,
+    //  the line is kept from the previous pixel for a submatrix without offset
+    Int_t offset = lineOffset[Mi->get_submatrix(st / nPix,st % nPix)];
+    if( offset>=0 ) linPhys = offset + Mi->get_row(st / nPix,st % nPix);
+
+    colPhys = Mi->get_column(st / nPix,st % nPix);
+    // physical index
+    stPhys = colPhys + linPhys*fStripsNu;
+
+    aPixel->SetPixelLine( linPhys); // YV, 2009/06/05
+    aPixel->SetPixelColumn( colPhys); // YV, 2009/06/05
+
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
+    //GetStrip(stPhys)->UpdateSignal(); // done at call for analyze_basic, JB 2011/04/15
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
-  //======================
+  return goForAnalysis;
+
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout125()
+{
   // Readout with zero-suppression using a list of hit pixels
   // RDM 210509 largely modified!!!
   // MIMOSA25 type indexes
-  else if ( fReadout==125 ){
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    TMimosa24_25Map *Mi=0;
-    switch (fMimosaType) {
-      case 20:
-        Mi = new TMimosa24_25Map("Mi25A_20um"); //20um pitch
-        break;
-      case 30:
-        Mi = new TMimosa24_25Map("Mi25A_30um"); //30um pitch
-        break;
-      case 40:
-        Mi = new TMimosa24_25Map("Mi25A_40um"); //40um pitch
-        break;
-      default:
-        cout << "MimosaType " << fMimosaType << " unknown for Mimosa25" << endl;
-        Fatal("DPlane:Update", "==> CHANGE CONFIG FILE, I AM STOPPING! <==");
-    };
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = TMath::Max( fStripsNu/2, fStripsNv*2); // size of submatrix is the smallest
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
 
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-      // compute line and column index from the index
-      switch (fMimosaType) {
-        case 20:
-          linPhys = Mi->get_submatrix(st / nPix,st % nPix)*32+Mi->get_row(st / nPix,st % nPix);
-          break;
-        case 30:
-          if (Mi->get_submatrix(st / nPix,st % nPix)==0)
-            linPhys = Mi->get_row(st / nPix,st % nPix);
-          else if (Mi->get_submatrix(st / nPix,st % nPix)==1)
-            linPhys = 21 + Mi->get_row(st / nPix,st % nPix);
-          else if (Mi->get_submatrix(st / nPix,st % nPix)==2)
-            linPhys = 43 + Mi->get_row(st / nPix,st % nPix);
-          break;
-        case 40:
-          linPhys = Mi->get_submatrix(st / nPix,st % nPix)*16+Mi->get_row(st / nPix,st % nPix);
-          break;
-      };
-
-      colPhys = Mi->get_column(st / nPix,st % nPix);
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+  // channel map, built at the first event
+  if( fMimosaMap==0 ) BuildMimosa25Map("Mi25A");
+  TMimosa24_25Map *Mi = fMimosaMap;
+  const Int_t *lineOffset = fMimosaLineOffset;
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = TMath::Max( fStripsNu/2, fStripsNv*2); // size of submatrix is the smallest
 
-      aPixel->SetPixelIndex(colPhys + linPhys*16); //RDM060809
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+    // compute line and column index from the index,
+    //  the line is kept from the previous pixel for a submatrix without offset
+    Int_t offset = lineOffset[Mi->get_submatrix(st / nPix,st % nPix)];
+    if( offset>=0 ) linPhys = offset + Mi->get_row(st / nPix,st % nPix);
+
+    colPhys = Mi->get_column(st / nPix,st % nPix);
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+
+    aPixel->SetPixelIndex(colPhys + linPhys*16); //RDM060809
+
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    if( fDebugPlane>2 ) cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl; //RDM310509 add if debug
+  }
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, st, linPhys, colPhys, u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      if( fDebugPlane>2 ) cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl; //RDM310509 add if debug
-    }
-    delete Mi; //RDM290509
-  } //end readout==125
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout24()
+{
   // Readout without zero suppression BUT recquiring re-ordering
   // of channels wrt strips
   // RDM 210509, then JB 2009/05/25, YV 27/11/09
   // MIMOSA24 type indexes
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-  else if ( fReadout==24 ){
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
 
-    TMimosa24_25Map *Mi;
-    Mi = new TMimosa24_25Map("Mi24");
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = 4096 ;     //YV 09/06/09
+  // channel map, built at the first event
+  if( fMimosaMap==0 ) fMimosaMap = new TMimosa24_25Map("Mi24");
+  TMimosa24_25Map *Mi = fMimosaMap;
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = 4096 ;     //YV 09/06/09
 
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+
+    // compute line and column index from the index
+    switch(Mi->get_submatrix(st / nPix,st % nPix)) {
+      case 0:// OK ?
+        linPhys = 62 - Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 1: // OK
+        linPhys = 31 - Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 2: // OK
+        linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 3: // OK
+        linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 4: // OK
+        linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 5: // OK
+        linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 6: // OK
+        linPhys = 30 - Mi->get_row(st / nPix,st % nPix);
+        //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);  //YV 11/10/09
+        break;
+      case 7: // OK
+        linPhys = 15 - Mi->get_row(st / nPix,st % nPix);
+        //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);  //YV 11/10/09
+        break;
+      default: // OK
+        linPhys = -1111;
+        colPhys = -1111;
+        break;
+    };
 
-      // compute line and column index from the index
-      switch(Mi->get_submatrix(st / nPix,st % nPix)) {
-        case 0:// OK ?
-          linPhys = 62 - Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 1: // OK
-          linPhys = 31 - Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 2: // OK
-          linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 3: // OK
-          linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 4: // OK
-          linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 5: // OK
-          linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 6: // OK
-          linPhys = 30 - Mi->get_row(st / nPix,st % nPix);
-          //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);  //YV 11/10/09
-          break;
-        case 7: // OK
-          linPhys = 15 - Mi->get_row(st / nPix,st % nPix);
-          //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);  //YV 11/10/09
-          break;
-        default: // OK
-          linPhys = -1111;
-          colPhys = -1111;
-          break;
-      };
-
-      //commented out 30/06/09
-      //linPhys = Mi->get_submatrix(st / nPix,st % nPix)*32+Mi->get_row(st / nPix,st % nPix);
-      //colPhys = Mi->get_column(st / nPix,st % nPix);
-
-      //phys. index
-      stPhys = colPhys + linPhys*fStripsNu;
-      aPixel->SetPixelLine( linPhys); // YV, 2009/06/02
-      aPixel->SetPixelColumn( colPhys); // YV, 2009/06/02
-
-      // update the strip
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
-      //GetStrip(stPhys)->UpdateSignal();   // done at call for analyze_basic, JB 2011/04/15
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-    }
-    delete Mi;  //RDM290509
+    //commented out 30/06/09
+    //linPhys = Mi->get_submatrix(st / nPix,st % nPix)*32+Mi->get_row(st / nPix,st % nPix);
+    //colPhys = Mi->get_column(st / nPix,st % nPix);
+
+    //phys. index
+    stPhys = colPhys + linPhys*fStripsNu;
+    aPixel->SetPixelLine( linPhys); // YV, 2009/06/02
+    aPixel->SetPixelColumn( colPhys); // YV, 2009/06/02
+
+    // update the strip
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    GetStrip(stPhys)->SetRawValue( aPixel->GetPulseHeight());
+    //GetStrip(stPhys)->UpdateSignal();   // done at call for analyze_basic, JB 2011/04/15
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d, value %f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+  }
 
-  } //end readout==24
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout124()
+{
   // Readout with zero-suppression using a list of hit pixels
   // RDM 210509
   // RDM 220509
   // YV  27/11/09
   // MIMOSA24 type indexes
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-  else if ( fReadout==124 ){
-
-    TMimosa24_25Map *Mi;
-    Mi = new TMimosa24_25Map("Mi24");
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    Int_t nPix = 4096;
-
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  Float_t  aNoise, aPedestal;
 
-      //readout M24 as 1 plane
+  // channel map, built at the first event
+  if( fMimosaMap==0 ) fMimosaMap = new TMimosa24_25Map("Mi24");
+  TMimosa24_25Map *Mi = fMimosaMap;
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Int_t nPix = 4096;
 
-      switch(Mi->get_submatrix(st / nPix,st % nPix)) {
-        case 0:// OK ?
-          linPhys = 62 - Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 1: // OK
-          linPhys = 31 - Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 2: // OK
-          linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 3: // OK
-          linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 4: // OK
-          linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 5: // OK
-          linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
-          break;
-        case 6: // OK
-          linPhys = 30 - Mi->get_row(st / nPix,st % nPix);
-          //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);   //YV 11/10/09
-          break;
-        case 7: // OK
-          linPhys = 15 - Mi->get_row(st / nPix,st % nPix);
-          //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
-          colPhys = 127 - Mi->get_column(st / nPix,st % nPix);   //YV 11/10/09
-          break;
-        default: // OK
-          //printf("pixel index = %d, row = %d, column = %d, submatrix = %d \n", st, Mi->get_row(st / nPix,st % nPix), Mi->get_column(st / nPix,st % nPix), Mi->get_submatrix(st / nPix,st % nPix)); //YV 23/09/09
-          linPhys = -1111;
-          colPhys = -1111;
-          break;
-      };
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
 
+    //readout M24 as 1 plane
 
-      ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
-      //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w);
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPosition( tPosition);
+    switch(Mi->get_submatrix(st / nPix,st % nPix)) {
+      case 0:// OK ?
+        linPhys = 62 - Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 1: // OK
+        linPhys = 31 - Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 2: // OK
+        linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 3: // OK
+        linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 4: // OK
+        linPhys = 64 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 5: // OK
+        linPhys = 95 + Mi->get_row(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);
+        break;
+      case 6: // OK
+        linPhys = 30 - Mi->get_row(st / nPix,st % nPix);
+        //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);   //YV 11/10/09
+        break;
+      case 7: // OK
+        linPhys = 15 - Mi->get_row(st / nPix,st % nPix);
+        //colPhys = 31 - Mi->get_column(st / nPix,st % nPix);
+        colPhys = 127 - Mi->get_column(st / nPix,st % nPix);   //YV 11/10/09
+        break;
+      default: // OK
+        //printf("pixel index = %d, row = %d, column = %d, submatrix = %d \n", st, Mi->get_row(st / nPix,st % nPix), Mi->get_column(st / nPix,st % nPix), Mi->get_submatrix(st / nPix,st % nPix)); //YV 23/09/09
+        linPhys = -1111;
+        colPhys = -1111;
+        break;
+    };
 
-      //YV 21/10/09
-
-      TH2F *h2 = fHNoise;
-      aNoise = h2->GetBinContent(st%64,64-(st/64));  //1st channel
-      //aNoise = h2->GetBinContent(st%64,(st-4096)/64);  //2nd channel
-      //aNoise = h2->GetBinContent(st%64,(st-8192)/64);   //3rd channel
-      //aNoise = h2->GetBinContent((st%64)+1,(st-12288)/64+32);   //4rth channel
-      aPixel->SetNoise(aNoise);
-      //printf("pixel %d, noise = %f\n",st,aNoise);
-
-      TH2F *h3 = fHPedestal;
-      //aPedestal = h3->GetBinContent((st%64)+1,(st/64));  //channel 1
-      //aPedestal = h3->GetBinContent((st%64)+1,(st-4096)/64);  //channel 2
-      //aPedestal = h3->GetBinContent((st%64)+1,(st-8192)/64);   //channel 3
-      aPedestal = h3->GetBinContent((st%64)+1,(st-12288)/64+32);   //channel 4
-      aPixel->SetPedestal(aPedestal);
-      Float_t newRawValue = aPixel->GetPulseHeight() - aPedestal;
-      aPixel->SetPulseHeight(newRawValue);
-      //printf("pixel: %d, new raw value=%f \n",st,aPixel->GetPulseHeight());
-
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d and rawvalue (pix)%f (strip)%f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetRawValue(), GetStrip(stPhys)->GetRawValue());
-
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-    }
-    delete Mi; //RDM290509
+    ComputeStripPosition( colPhys, linPhys, u, v, w); // JB 2012/11/21
+    //      u = ((2*colPhys - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*linPhys - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w);
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPosition( tPosition);
+
+    //YV 21/10/09
+
+    TH2F *h2 = fHNoise;
+    aNoise = h2->GetBinContent(st%64,64-(st/64));  //1st channel
+    //aNoise = h2->GetBinContent(st%64,(st-4096)/64);  //2nd channel
+    //aNoise = h2->GetBinContent(st%64,(st-8192)/64);   //3rd channel
+    //aNoise = h2->GetBinContent((st%64)+1,(st-12288)/64+32);   //4rth channel
+    aPixel->SetNoise(aNoise);
+    //printf("pixel %d, noise = %f\n",st,aNoise);
+
+    TH2F *h3 = fHPedestal;
+    //aPedestal = h3->GetBinContent((st%64)+1,(st/64));  //channel 1
+    //aPedestal = h3->GetBinContent((st%64)+1,(st-4096)/64);  //channel 2
+    //aPedestal = h3->GetBinContent((st%64)+1,(st-8192)/64);   //channel 3
+    aPedestal = h3->GetBinContent((st%64)+1,(st-12288)/64+32);   //channel 4
+    aPixel->SetPedestal(aPedestal);
+    Float_t newRawValue = aPixel->GetPulseHeight() - aPedestal;
+    aPixel->SetPulseHeight(newRawValue);
+    //printf("pixel: %d, new raw value=%f \n",st,aPixel->GetPulseHeight());
+
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d updated at (line,col)=(%d,%d) channel=%d and rawvalue (pix)%f (strip)%f\n", tci, st, linPhys, colPhys, stPhys, aPixel->GetRawValue(), GetStrip(stPhys)->GetRawValue());
+
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+  }
 
-  } //end readout==124
+  return goForAnalysis;
 
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout126()
+{
   // Readout with binary zero-suppression using a list of hit pixels
   // JB 2009/08/17
   // MIMOSA26 && MIMOSA28 && FSBB
-  else if ( fReadout==126 ){
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
 
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
-      ComputeStripPosition( aPixel->GetPixelColumn(), aPixel->GetPixelLine(), u, v, w); // JB 2012/11/21
-      //      u = ((2*aPixel->GetPixelColumn() - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
-      //      v = ((2*aPixel->GetPixelLine() - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
-      //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
-      tPosition.SetValue(u,v,w); //
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPosition( tPosition);
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, aPixel->GetPixelIndex(), aPixel->GetPixelLine(), aPixel->GetPixelColumn(), u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-    }
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
 
-  } //end readout==126
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
+    ComputeStripPosition( aPixel->GetPixelColumn(), aPixel->GetPixelLine(), u, v, w); // JB 2012/11/21
+    //      u = ((2*aPixel->GetPixelColumn() - fStripsNu + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(0))/2 ;
+    //      v = ((2*aPixel->GetPixelLine() - fStripsNv + 1 ) * fc->GetPlanePar(fPlaneNumber).Pitch(1))/2 ;
+    //      w = fc->GetPlanePar(fPlaneNumber).Pitch(2);
+    tPosition.SetValue(u,v,w); //
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPosition( tPosition);
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d at (line,col)=(%d,%d), position (%f, %f, %f), size (%f, %f, %f) value %f\n", tci, aPixel->GetPixelIndex(), aPixel->GetPixelLine(), aPixel->GetPixelColumn(), u, v, w, (*fPitch)(0), (*fPitch)(1), (*fPitch)(2), aPixel->GetPulseHeight());
+  } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+  }
 
+  return goForAnalysis;
 
-  //======================
+}
+
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout32()
+{
   // Readout without zero suppression for Mimosa 32A
-  else if ( fReadout==32 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    //    if( fPixelsN!=fChannelsN ) {
-    //      cout <<"WARNING Plane " << fPlaneNumber << " has " << fPixelsN << " hit pixels which is different from the exepected " << fChannelsN << "channels in non-sparsified mode." << endl;
-    //    }
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-
-      linPhys = st / fStripsNu ;
-      colPhys = st % fStripsNu ;
-      //SS 2012.08.10 - Solution for the wrong line order
-      // for run taken with PXIe (>328xx)
-      if( fSession->GetRunNumber()>=32800 ) {
-        if (colPhys==0) colPhys=63;
-        else colPhys--;
-        //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
-        //  note that real columns are lines in our config
-        // ONLY FOR RUN 32824
-        if( fSession->GetRunNumber()==32824 ) {
-          if( 8<=linPhys && linPhys<=11) linPhys += 4;
-          else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
-        }
-      }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  Float_t  aRawvalue, aNoise, aPedestal;
+  const Bool_t shiftColumns = fSession->GetRunNumber()>=32800; // for run taken with PXIe (>328xx)
+  const Bool_t swapLines = fSession->GetRunNumber()==32824;
+  const Bool_t initialising = fInitialCounter <= fInitialNoise;
+  const Bool_t digitize = fIfDigitize && !initialising;
 
-      // update the pixel
-      stPhys = colPhys + linPhys*fStripsNu;
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPixelIndex( stPhys);
-
-      // update the strip,
-      // take into account that after noise initialization
-      //  we consider only absolute value of frame1-frame2.
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      if(fInitialCounter <= fInitialNoise) {
-        GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
-      }
-      else {
-        GetStrip(stPhys)->SetRawValue( fabs(aPixel->GetRawValue()) );
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+
+  //    if( fPixelsN!=fChannelsN ) {
+  //      cout <<"WARNING Plane " << fPlaneNumber << " has " << fPixelsN << " hit pixels which is different from the exepected " << fChannelsN << "channels in non-sparsified mode." << endl;
+  //    }
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+
+    linPhys = st / fStripsNu ;
+    colPhys = st % fStripsNu ;
+    //SS 2012.08.10 - Solution for the wrong line order
+    // for run taken with PXIe (>328xx)
+    if( shiftColumns ) {
+      if (colPhys==0) colPhys=63;
+      else colPhys--;
+      //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
+      //  note that real columns are lines in our config
+      // ONLY FOR RUN 32824
+      if( swapLines ) {
+        if( 8<=linPhys && linPhys<=11) linPhys += 4;
+        else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
       }
+    }
+
+    // update the pixel
+    stPhys = colPhys + linPhys*fStripsNu;
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPixelIndex( stPhys);
+
+    // update the strip,
+    // take into account that after noise initialization
+    //  we consider only absolute value of frame1-frame2.
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    if( initialising ) {
+      GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
+    }
+    else {
+      GetStrip(stPhys)->SetRawValue( fabs(aPixel->GetRawValue()) );
+    }
 
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue(), GetStrip(stPhys)->GetRawValue());
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f or %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue(), GetStrip(stPhys)->GetRawValue());
 
+    if ( digitize ) { // if some digitization is required and after initialization
+      // further update the pixel
+      ComputeStripPosition( colPhys, linPhys, u, v, w);
+      tPosition.SetValue(u,v,w); //
+      aPixel->SetSize( (*fPitch) );
+      aPixel->SetPosition( tPosition);
 
-      if ( fIfDigitize && fInitialCounter > fInitialNoise ) { // if some digitization is required and after initialization
-        // further update the pixel
-        ComputeStripPosition( colPhys, linPhys, u, v, w);
-        tPosition.SetValue(u,v,w); //
-        aPixel->SetSize( (*fPitch) );
-        aPixel->SetPosition( tPosition);
+      aRawvalue = fabs(aPixel->GetRawValue());
+      aPedestal = GetStrip(stPhys)->GetPedestal();
+      aNoise = GetStrip(stPhys)->GetNoise();
+      aPixel->SetNoise( aNoise);
+      aPixel->SetPedestal( aPedestal);
+      //aRawvalue = Digitize( aRawvalue - aPedestal );
+      //aPixel->SetRawValue( aRawvalue );
+      aPixel->SetPulseHeight( aRawvalue - aPedestal );
 
-        aRawvalue = fabs(aPixel->GetRawValue());
-        aPedestal = GetStrip(stPhys)->GetPedestal();
-        aNoise = GetStrip(stPhys)->GetNoise();
-        aPixel->SetNoise( aNoise);
-        aPixel->SetPedestal( aPedestal);
-        //aRawvalue = Digitize( aRawvalue - aPedestal );
-        //aPixel->SetRawValue( aRawvalue );
-        aPixel->SetPulseHeight( aRawvalue - aPedestal );
+      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f, pulse height %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue(), aPixel->GetPulseHeight());
 
-        if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f, pulse height %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue(), aPixel->GetPulseHeight());
+    } // end some digitization is required
 
-      } // end some digitization is required
+  } // end loop over hit pixels
 
-    } // end loop over hit pixels
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
-    }
+  return goForAnalysis;
 
-  } //end if Readout==32
+}
 
-  //======================
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout132()
+{
   // Readout with zero suppression for Mimosa 32A
-  else if ( fReadout==132 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    //    if( fPixelsN!=fChannelsN ) {
-    //      cout <<"WARNING Plane " << fPlaneNumber << " has " << fPixelsN << " hit pixels which is different from the exepected " << fChannelsN << "channels in non-sparsified mode." << endl;
-    //    }
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-
-      linPhys = st / fStripsNu ;
-      colPhys = st % fStripsNu ;
-      //SS 2012.08.10 - Solution for the wrong line order
-      // for run taken with PXIe (>328xx)
-      if( fSession->GetRunNumber()>=32800 ) {
-        if (colPhys==0) colPhys=63;
-        else colPhys--;
-        //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
-        //  note that real columns are lines in our config
-        // ONLY FOR RUN 32824
-        if( fSession->GetRunNumber()==32824 ) {
-          if( 8<=linPhys && linPhys<=11) linPhys += 4;
-          else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
-        }
-      }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  const Bool_t shiftColumns = fSession->GetRunNumber()>=32800; // for run taken with PXIe (>328xx)
+  const Bool_t swapLines = fSession->GetRunNumber()==32824;
+  const Bool_t noiseRun = fNoiseRun;
 
-      stPhys = colPhys + linPhys*fStripsNu;
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      aPixel->SetPixelIndex( stPhys);
-      ComputeStripPosition( colPhys, linPhys, u, v, w);
-      tPosition.SetValue(u,v,w); //
-      aPixel->SetSize( (*fPitch));
-      aPixel->SetPosition( tPosition);
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
 
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-        aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
+  //    if( fPixelsN!=fChannelsN ) {
+  //      cout <<"WARNING Plane " << fPlaneNumber << " has " << fPixelsN << " hit pixels which is different from the exepected " << fChannelsN << "channels in non-sparsified mode." << endl;
+  //    }
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+
+    linPhys = st / fStripsNu ;
+    colPhys = st % fStripsNu ;
+    //SS 2012.08.10 - Solution for the wrong line order
+    // for run taken with PXIe (>328xx)
+    if( shiftColumns ) {
+      if (colPhys==0) colPhys=63;
+      else colPhys--;
+      //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
+      //  note that real columns are lines in our config
+      // ONLY FOR RUN 32824
+      if( swapLines ) {
+        if( 8<=linPhys && linPhys<=11) linPhys += 4;
+        else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
       }
-
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue());
-    } // end loop over hit pixels
-
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
     }
 
-  } //end if Readout==132
-
-  //======================
-  // Readout without zero suppression AND multiframe for Mimosa 32
-  else if ( fReadout==232 ){
-    fPixelsN = fListOfPixels->size(); // update number of hit pixels
-    if( fDebugPlane>3 ) Printf( "Update:: %d hits to update\n", fPixelsN);
-
-    for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
-      aPixel = fListOfPixels->at(tci);
-      st = aPixel->GetPixelIndex();
-
-      linPhys = st / fStripsNu ;
-      colPhys = st % fStripsNu ;
-      //SS 2012.08.10 - Solution for the wrong line order
-      // for run taken with PXIe (>328xx)
-      if( fSession->GetRunNumber()>=32800 && fSession->GetRunNumber() < 33000) {
-        if (colPhys==0) colPhys=63;
-        else colPhys--;
-        //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
-        //  note that real columns are lines in our config
-        // ONLY FOR RUN 32824
-        if( fSession->GetRunNumber()==32824 ) {
-          if( 8<=linPhys && linPhys<=11) linPhys += 4;
-          else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
-        }
-      }
-      stPhys = colPhys + linPhys*fStripsNu;
-      aPixel->SetPixelLine( linPhys);
-      aPixel->SetPixelColumn( colPhys);
-      ComputeStripPosition( colPhys, linPhys, u, v, w);
-      tPosition.SetValue(u,v,w);
-      aPixel->SetPosition( tPosition);
-      aPixel->SetSize( (*fPitch));
-
-      if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d), raw value %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue());
-
-      // update the corresponding strip and pixel,
-      // Note that after noise initialization
-      //  we consider the signed value of frame1-frame2 to properly observe pixel behavior
-      // Case for external noise computation (fNoiseRun==kTrue) added.
-      // JB 2016/08/17
-      GetStrip(stPhys)->SetPixelIndex( tci);
-      if( fNoiseRun) {
-        SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
-        GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
-      }
-      else {
-        if(fInitialCounter <= fInitialNoise ) {
-          //GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
-          if( Int_t(aPixel->GetRawValue()) != 0 ) GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
-          aPixel->SetPulseHeight( aPixel->GetRawValue() );
-        }
-        else {
-          aRawvalue = aPixel->GetRawValue();
-          aPedestal = GetStrip(stPhys)->GetPedestal();
-          aNoise = GetStrip(stPhys)->GetNoise();
-          GetStrip(stPhys)->SetRawValue( aRawvalue );
-          aPixel->SetNoise( aNoise);
-          aPixel->SetPedestal( aPedestal);
-          aPixel->SetPulseHeight( aRawvalue - aPedestal);
-          //if( aRawvalue>200 ) printf("     pixel %d index %d at (line,col)=(%d,%d), timestamp %d, raw value %.1f, pedestal %.1f, noise %.1f, pulseheight %.1f\n", tci, st, stPhys, linPhys, aPixel->GetTimestamp(), GetStrip(stPhys)->GetRawValue(), aPixel->GetPedestal(), aPixel->GetNoise(), aPixel->GetPulseHeight());
-        }
-      }
-
-      if( fDebugPlane>3 ) printf("              pixel %d raw value %.1f, pedestal %.1f, noise %.1f, pulseheight %.1f\n", tci, GetStrip(stPhys)->GetRawValue(), aPixel->GetPedestal(), aPixel->GetNoise(), aPixel->GetPulseHeight());
-    } // end loop over hit pixels
-
-    if( fPixelsN==0 ) {
-      goForAnalysis = kFALSE;
-      cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+    stPhys = colPhys + linPhys*fStripsNu;
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    aPixel->SetPixelIndex( stPhys);
+    ComputeStripPosition( colPhys, linPhys, u, v, w);
+    tPosition.SetValue(u,v,w); //
+    aPixel->SetSize( (*fPitch));
+    aPixel->SetPosition( tPosition);
+
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+      aPixel->SetPixelIndex(aPixel->GetPixelLine()*fStripsNu + aPixel->GetPixelColumn());
     }
 
-  } //end if Readout==232
-
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d) and raw value %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue());
+  } // end loop over hit pixels
 
-  //======================
-  // ANY OTHER READOUT issue a warning
-  else {
-    planeReady = kFALSE;
-    printf( "WARNING, DPlane:Update readout %d unknown, no analysis !\n", fReadout);
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
   }
 
+  return goForAnalysis;
 
-  //======================
-  // Call the analysis now
-  //======================
+}
 
-  if (goForAnalysis) {
+//______________________________________________________________________________
+//
+Bool_t DPlane::UpdateReadout232()
+{
+  // Readout without zero suppression AND multiframe for Mimosa 32
+  //
+  // Called by Update, returns kFALSE when there is nothing to analyse.
 
-    //==============
-    // compute pedestal, noise and common noise shift
-    // or update the strip values
-    // exclude zero-suppressed data (readout>100), JB 2009/05/25
-    // exclude noise computed from previous run, JB 2014/01/07
-    // include multi-frame readout (232) only for init step, JB 2013/
-    // modified condition fInitialCounter<fInitialNoise instead of <=, JB 2016/08/23
-    if( (fReadout<100) || (fReadout==232 && fInitialCounter<fInitialNoise) ) {
-      analyze_basics();
-    }
+  Bool_t goForAnalysis = kTRUE;
+  DPixel  *aPixel;
+  Int_t    st=0, colPhys=0, linPhys=0, stPhys=0;
+  DR3      tPosition(0,0,0);
+  Double_t u=0,v=0,w=0;
+  Float_t  aRawvalue, aNoise, aPedestal;
+  const Bool_t shiftColumns = fSession->GetRunNumber()>=32800 && fSession->GetRunNumber() < 33000; // for run taken with PXIe (>328xx)
+  const Bool_t swapLines = fSession->GetRunNumber()==32824;
+  const Bool_t noiseRun = fNoiseRun;
+  const Bool_t initialising = fInitialCounter <= fInitialNoise;
 
-    //==============
-    // Analysis
-    // not performed if analysisMode==0, JB 2011/04/15
-    if (fSession->GetStatus() != 0 && fAnalysisMode>0) {
+  fPixelsN = fListOfPixels->size(); // update number of hit pixels
+  if( fDebugPlane>3 ) Printf( "Update:: %d hits to update\n", fPixelsN);
 
-      //==============
-      // Digitize the matrix if required
-      if( fIfDigitize>0 ) {
-        DigitizeMatrix();
+  for (Int_t tci = 0; tci < fPixelsN; tci++) { // loop over hit pixels
+    aPixel = fListOfPixels->at(tci);
+    st = aPixel->GetPixelIndex();
+
+    linPhys = st / fStripsNu ;
+    colPhys = st % fStripsNu ;
+    //SS 2012.08.10 - Solution for the wrong line order
+    // for run taken with PXIe (>328xx)
+    if( shiftColumns ) {
+      if (colPhys==0) colPhys=63;
+      else colPhys--;
+      //JB 2012/08/18 - swapping of real column groups 8-11 with 12-15
+      //  note that real columns are lines in our config
+      // ONLY FOR RUN 32824
+      if( swapLines ) {
+        if( 8<=linPhys && linPhys<=11) linPhys += 4;
+        else if( 12<=linPhys && linPhys<=15) linPhys -= 4;
+      }
+    }
+    stPhys = colPhys + linPhys*fStripsNu;
+    aPixel->SetPixelLine( linPhys);
+    aPixel->SetPixelColumn( colPhys);
+    ComputeStripPosition( colPhys, linPhys, u, v, w);
+    tPosition.SetValue(u,v,w);
+    aPixel->SetPosition( tPosition);
+    aPixel->SetSize( (*fPitch));
+
+    if( fDebugPlane>3 ) printf("DPlane:Update  pixel %d with index %d, physical index %d at (line,col)=(%d,%d), raw value %.1f\n", tci, st, stPhys, linPhys, colPhys, aPixel->GetRawValue());
+
+    // update the corresponding strip and pixel,
+    // Note that after noise initialization
+    //  we consider the signed value of frame1-frame2 to properly observe pixel behavior
+    // Case for external noise computation (fNoiseRun==kTrue) added.
+    // JB 2016/08/17
+    GetStrip(stPhys)->SetPixelIndex( tci);
+    if( noiseRun) {
+      SetPedandNoiseFromHisto( colPhys, linPhys, aPixel);
+      GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
+    }
+    else {
+      if( initialising ) {
+        //GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
+        if( Int_t(aPixel->GetRawValue()) != 0 ) GetStrip(stPhys)->SetRawValue( aPixel->GetRawValue() );
+        aPixel->SetPulseHeight( aPixel->GetRawValue() );
+      }
+      else {
+        aRawvalue = aPixel->GetRawValue();
+        aPedestal = GetStrip(stPhys)->GetPedestal();
+        aNoise = GetStrip(stPhys)->GetNoise();
+        GetStrip(stPhys)->SetRawValue( aRawvalue );
+        aPixel->SetNoise( aNoise);
+        aPixel->SetPedestal( aPedestal);
+        aPixel->SetPulseHeight( aRawvalue - aPedestal);
+        //if( aRawvalue>200 ) printf("     pixel %d index %d at (line,col)=(%d,%d), timestamp %d, raw value %.1f, pedestal %.1f, noise %.1f, pulseheight %.1f\n", tci, st, stPhys, linPhys, aPixel->GetTimestamp(), GetStrip(stPhys)->GetRawValue(), aPixel->GetPedestal(), aPixel->GetNoise(), aPixel->GetPulseHeight());
       }
-
-      //==============
-      // potentially update pedestal, noise
-      // or update the strip values
-      // only for not zero-suppressed data, JB 2011/04/15
-      //      if( fReadout<100 && fAnalysisMode<=1 ) {
-      //        UpdatePedestalAndNoise();
-      //      } // end if readout<100
-
-      //==============
-      // look for hits
-      find_hits();
-      if (fDebugPlane) cout << "  Plane " << fPlaneNumber << " : " << fHitsN << " new  hits found" << endl;
-
     }
 
-  } // end if goForAnalysis
-  else {
-    if (fDebugPlane) cout << "Plane " << fPlaneNumber << ": can't analyse or no data " << endl ;
-  }
-
-  if ( !planeReady && fDebugPlane) cout << "Plane " << fPlaneNumber << ": bad raw data " << endl ;
-
-  if(fAcq->GetIfMCBoardReader()) { // AP, 2016/07/27. Do some operations only in the case of reading MC-data
-    //Now, if some hits where not digitized, then generate hits with the MC information
-    CheckNonDigitizedMCHits();
+    if( fDebugPlane>3 ) printf("              pixel %d raw value %.1f, pedestal %.1f, noise %.1f, pulseheight %.1f\n", tci, GetStrip(stPhys)->GetRawValue(), aPixel->GetPedestal(), aPixel->GetNoise(), aPixel->GetPulseHeight());
+  } // end loop over hit pixels
 
-    //Do hit truth matching and get the particle generating this hit
-    MCHitsTruthMatching();
-  } // end if reading MC-data
+  if( fPixelsN==0 ) {
+    goForAnalysis = kFALSE;
+    cout <<"WARNING Plane " << fPlaneNumber << " has no hit pixels, no more analysis for it in real event " << fAcq->GetEventNumber() << endl;
+  }
 
-  return !planeReady; // JB 2010/09/20
+  return goForAnalysis;
 
 }
 //______________________________________________________________________________
@@ -3470,9 +3759,12 @@ void DPlane::find_hits(){
   // Last modified JB 2012/08/18 management of non-sparsified clustering with DStrip objects
   // Last modified AP 2014/07 addition of hit finder option
 
+  TAF_PROFILE_SCOPE( DProfiler::kFindHits, fPlaneNumber);
+
   if( fDebugPlane>1 ) printf("DPlane: finding hits in plane %d with readout=%d analysis=%d over %d pixels\n", fPlaneNumber, fReadout, fAnalysisMode, fPixelsN);
 
   fHitsN = 0;
+  Int_t clustersTried = 0; // seeds clustered, counter of the profiler clustering stage
 
   std::vector<int> SeedPixelsList;
   SeedPixelsList.clear();
@@ -3639,6 +3931,7 @@ void DPlane::find_hits(){
 
   int potential_seed_counter = 0;
 
+  TAF_PROFILE_SCOPE( DProfiler::kClustering, fPlaneNumber); // seed search and clustering, timed once per call
   Bool_t hitOK   = kTRUE; // true while hits are found
   while ( hitOK == kTRUE && fHitsN < fHitMax ) { // Main loop to find hits
 
@@ -3751,6 +4044,8 @@ void DPlane::find_hits(){
 
         Int_t stPhys = fListOfPixels->at(seed)->GetPixelColumn()+fListOfPixels->at(seed)->GetPixelLine()*fStripsNu;
 
+        { // clustering around the seed
+        clustersTried++;
         // for non zero-suppressed read-out
         if( fReadout<100 && !fIfDigitize ) { // new condition to exclude digital-emulated data which, JB 2013/08/29
           //cout << " using analyse dstrip " << endl ;
@@ -3803,6 +4098,7 @@ void DPlane::find_hits(){
           GetHitResolution(col,lin,fHit[fHitsN]->GetStripsInCluster(),HitResolution);
           fHit[fHitsN]->SetResolutionUVhit(HitResolution.X(),HitResolution.Y());
         }
+        } // end clustering around the seed
 
 
         if ( hitOK == kTRUE ) {
@@ -3846,6 +4142,8 @@ void DPlane::find_hits(){
 
   delete[] tested; // reduce memory leakage, BH 2013/08/21
 
+  TAF_PROFILE_COUNT( DProfiler::kFindHits, fPlaneNumber, fHitsN);
+  TAF_PROFILE_COUNT( DProfiler::kClustering, fPlaneNumber, clustersTried);
   if( fDebugPlane>1 ) printf("         %d hits found\n", fHitsN);
 
   return;
@@ -4152,6 +4450,8 @@ void DPlane::PrintTilt(void)
 void DPlane::AddMCGeneratedHit(DR3 aPosition,DR3 aResolution,Int_t hitMC)
 {
 
+  if( fKeepUnTrackedHitsBetw2evts && fHitsN==0 ) ParkUnTrackedHits();
+
   if(fHitsN == fHitMax) {
     cout << endl;
     cout << "Number of hits " << fHitsN << " is at maximum " << fHitMax << endl;
@@ -4168,6 +4468,77 @@ void DPlane::AddMCGeneratedHit(DR3 aPosition,DR3 aResolution,Int_t hitMC)
 }
 //______________________________________________________________________________
 //
+void DPlane::SwapHits(Int_t aSlot1, Int_t aSlot2)
+{
+  // Exchange the hit objects of two slots of fHit (from 0),
+  //  the hit number stays the slot number.
+
+  DHit *aHit = fHit[aSlot1];
+  fHit[aSlot1] = fHit[aSlot2];
+  fHit[aSlot2] = aHit;
+  fHit[aSlot1]->SetNumber( aSlot1+1);
+  fHit[aSlot2]->SetNumber( aSlot2+1);
+}
+//______________________________________________________________________________
+//
+void DPlane::KeepUnTrackedHits()
+{
+  // Called at the end of the event (DTracker::Update), when the option
+  //  KeepUnTrackedHitsBetw2evts is on.
+  // Only the slots of the new hits not associated to a track are recorded,
+  //  the hits stay in the list (the event may still be stored or analysed)
+  //  and are moved by pointer to the upper half of fHit when the next event
+  //  starts (ParkUnTrackedHits), without any copy.
+
+  fHitsUnTrackedLastEventN = 0;
+  for( Int_t iHit=0; iHit<fHitsNew; iHit++) {
+    if( !fHit[iHit]->GetFound() && !fHit[iHit]->GetIsFromPreviousEvent() ) {
+      fHitUnTrackedLastEvent[fHitsUnTrackedLastEventN++] = iHit;
+    }
+  }
+  fHitsUnTrackedParked = kFALSE;
+}
+//______________________________________________________________________________
+//
+void DPlane::ParkUnTrackedHits()
+{
+  // Move the hits recorded by KeepUnTrackedHits to the slots fHitMax,
+  //  fHitMax+1, ... which the hit finding does not use.
+  // Their slots get back the objects found there, so the list keeps its size.
+
+  if( fHitsUnTrackedParked ) return;
+
+  for( Int_t iHit=0; iHit<fHitsUnTrackedLastEventN; iHit++) {
+    SwapHits( fHitUnTrackedLastEvent[iHit], fHitMax+iHit);
+    fHit[fHitMax+iHit]->SetIsFromPreviousEvent(1);
+  }
+  fHitsUnTrackedParked = kTRUE;
+}
+//______________________________________________________________________________
+//
+void DPlane::AddUnTrackedHitsOfLastEvent()
+{
+  // Called after the hit finding (DTracker::Update), when the option
+  //  KeepUnTrackedHitsBetw2evts is on.
+  // The hits kept from the last event follow the new ones in the list,
+  //  in the same order. Slot fHitsNew+i is either free or, when beyond
+  //  fHitMax, the carry slot of a kept hit already moved, so the pointer
+  //  exchanges never overwrite a kept hit.
+
+  ParkUnTrackedHits(); // if no hit was added to the plane in this event
+
+  fHitsNew = fHitsN;
+  fHitsOld = fHitsUnTrackedLastEventN;
+
+  for( Int_t iHit=0; iHit<fHitsNew; iHit++) fHit[iHit]->SetIsFromPreviousEvent(0);
+  for( Int_t iHit=0; iHit<fHitsOld; iHit++) {
+    SwapHits( fHitsNew+iHit, fHitMax+iHit);
+  }
+
+  fHitsN = fHitsNew + fHitsOld;
+}
+//______________________________________________________________________________
+//
 Int_t DPlane::Compare( const TObject * obj) const {
   // QL 04/06/2016
   // to enable Sort method in a TList
@@ -4279,13 +4650,7 @@ void  DPlane::MCHitsTruthMatching(void)
 
   //AP 2016/07/27: Function to perform the truth matching of the reconstructed hits
 
-  for(int ihit=0;ihit<fHitsN;ihit++) {
-    int MCHitID, NpixelsMCHitID;
-    MCInfoHolder->DoHitTruthMatching(fHit[ihit],MCHitID,NpixelsMCHitID);
-
-    fHit[ihit]->SetMCHitID(MCHitID);
-    fHit[ihit]->SetStripsFromMCHitID(NpixelsMCHitID);
-  }
+  MCInfoHolder->DoHitsTruthMatching(fHitsN, fHit);
 
   return;
 
@@ -30,6 +30,12 @@
 // - Transformation track coordinated from plane frame                 //
 //   to tracker frame with:                                            //
 //   DR3 track_u = TransformTrackToPlane( Double_t tx, Double_t ty, Double_t tz, Double_t tdx, Double_t tdy);                                             //
+// - arrays of hits or tracks are transformed in one call with
+//   TransformHitsToTracker and TransformTracksToPlane.
+//   All transformations use the matrices cached by ComputeTransform
+//   (no temporary object), with the same operations as the DR3 ones.
+//   The cache is updated by the methods changing the rotations,
+//   the translation is read directly.
 // - if the alignment parameters are relative to another alignment (refAlign),
 //   the absolute alignment (wrt the tracker) can be obtained with
 //   ConvoluteAlignment( DPRecAlign *refAlign)
@@ -154,6 +160,11 @@ DPrecAlign::DPrecAlign( Int_t method )
   if(fDebugDPrecAlign)   cout << "DPrecAlign constructor" << endl;
   DPrecAlignMethod = method;
   _fIfDeformation = 0;
+  for (Int_t i=0 ; i< 3 ; i++) {
+    _fTh[i] = 0.;
+    _fTr[i] = 0.;
+  }
+  ComputeRotationMatrix();
 
 }
 
@@ -165,6 +176,11 @@ DPrecAlign::DPrecAlign()
   if(fDebugDPrecAlign)   cout << "DPrecAlign constructor : BEWARE Method 0 !!!" << endl;
   DPrecAlignMethod = 0;
   _fIfDeformation = 0;
+  for (Int_t i=0 ; i< 3 ; i++) {
+    _fTh[i] = 0.;
+    _fTr[i] = 0.;
+  }
+  ComputeRotationMatrix();
 }
 
 //______________________________________________________________________________
@@ -597,6 +613,8 @@ void DPrecAlign::ComputeTorationMatrix()
     */
   }
 
+
+  ComputeTransform();
 }
 //______________________________________________________________________________
 //
@@ -936,6 +954,130 @@ DR3 DPrecAlign::RotateToTracker(DR3 uuu)
   //printf("DPrec::RotateToTracker: rotated vector= %f %f %f\n",xxx(0),xxx(1),xxx(2));
   return xxx;
 }
+//______________________________________________________________________________
+//
+void DPrecAlign::ComputeTransform()
+{
+  // Cache the rotation matrices in the orientation used by the current method,
+  //  and the angle dependent terms of the deformation,
+  //  for the transformations without DR3 temporaries.
+  //
+  // Called each time the rotation matrices, the angles or the method change.
+
+  for (Int_t i=0 ; i< 3 ; i++){
+    for (Int_t j=0 ; j< 3 ; j++){
+      if(DPrecAlignMethod==0) {
+        fToPlane[i][j]   = _rotmat[j][i];
+        fToTracker[i][j] = _tormat[j][i];
+      }
+      else if(DPrecAlignMethod==1) {
+        fToPlane[i][j]   = _rotmat[i][j];
+        fToTracker[i][j] = _tormat[i][j];
+      }
+      else { // no rotation for unknown methods, as RotateToPlane/Tracker
+        fToPlane[i][j]   = 0.;
+        fToTracker[i][j] = 0.;
+      }
+    }
+  }
+
+  fTanTiltY = tan(_fTh[1]);
+  fFlippedTiltX = (_fTh[2]*180./M_PI) < 180. && abs(_fTh[2]*180./M_PI) > 175.;
+}
+
+//______________________________________________________________________________
+//
+void DPrecAlign::HitToTracker( const Double_t *uvw, Double_t *xyz)
+{
+  // Same operations as the DR3 path of TransformHitToTracker
+
+  Double_t aPoint[3] = { uvw[0], uvw[1], uvw[2] };
+
+  if( _fIfDeformation ) {
+    double unorm = uvw[0];
+    aPoint[2] += fTool.CLof7LegendrePol( &unorm, _fUDeformationCoef);
+    double vnorm = uvw[1];
+    aPoint[2] += fTool.CLof7LegendrePol( &vnorm, _fVDeformationCoef);
+  }
+
+  for (Int_t i=0 ; i< 3 ; i++){
+    xyz[i] = fToTracker[i][0]*aPoint[0] + fToTracker[i][1]*aPoint[1] + fToTracker[i][2]*aPoint[2] + _fTr[i];
+  }
+}
+
+//______________________________________________________________________________
+//
+void DPrecAlign::TrackToPlane( const Double_t *xyz, const Double_t *slope, Double_t *uvw)
+{
+  // Same operations as the DR3 path of TransformTrackToPlane(),
+  //  xyz is the track position at the plane and slope its direction, in the telescope frame.
+
+  Double_t shifted[3] = { xyz[0]-_fTr[0], xyz[1]-_fTr[1], xyz[2]-_fTr[2] };
+  for (Int_t i=0 ; i< 3 ; i++){
+    uvw[i] = fToPlane[i][0]*shifted[0] + fToPlane[i][1]*shifted[1] + fToPlane[i][2]*shifted[2];
+  }
+
+  if( _fIfDeformation ) {
+    Double_t flatW = uvw[2];
+    double unorm = uvw[0];
+    uvw[2] += fTool.CLof7LegendrePol( &unorm, _fUDeformationCoef);
+    double vnorm = uvw[1];
+    uvw[2] += fTool.CLof7LegendrePol( &vnorm, _fVDeformationCoef);
+
+    Double_t slopeU = fToPlane[0][0]*slope[0] + fToPlane[0][1]*slope[1] + fToPlane[0][2]*slope[2];
+    Double_t slopeV = fToPlane[1][0]*slope[0] + fToPlane[1][1]*slope[1] + fToPlane[1][2]*slope[2];
+    Double_t deltaZU = uvw[2]/fTanTiltY - flatW;
+    Double_t deltaZV = uvw[2] - flatW;
+    if( fFlippedTiltX ) {
+      uvw[0] -= slopeU*deltaZU;
+      uvw[1] -= slopeV*deltaZV;
+    }
+    else {
+      uvw[0] += slopeU*deltaZU;
+      uvw[1] += slopeV*deltaZV;
+    }
+  }
+}
+
+//______________________________________________________________________________
+//
+void DPrecAlign::TransformHitsToTracker( Int_t nHits, const Double_t *uvw, Double_t *xyz)
+{
+  // Boost nHits positions from the plane frame to the telescope frame,
+  //  uvw and xyz hold 3*nHits coordinates.
+
+  for (Int_t iHit=0 ; iHit<nHits ; iHit++){
+    HitToTracker( uvw+3*iHit, xyz+3*iHit);
+  }
+}
+
+//______________________________________________________________________________
+//
+void DPrecAlign::TransformTracksToPlane( Int_t nTracks, const Double_t *origins, const Double_t *slopes, Double_t *uvw)
+{
+  // Position where nTracks tracks cross the plane, in the plane frame,
+  //  as TransformTrackToPlane( tx, ty, tz, tdx, tdy) for each track.
+  // origins hold 3*nTracks coordinates (x,y,z), slopes 2*nTracks (dx/dz,dy/dz),
+  //  uvw receives 3*nTracks coordinates.
+  // The last track is kept as the current track position (GetTrackPosition).
+
+  for (Int_t iTrack=0 ; iTrack<nTracks ; iTrack++){
+    const Double_t *origin = origins+3*iTrack;
+    Double_t slope[3] = { slopes[2*iTrack], slopes[2*iTrack+1], 1. };
+    Double_t t=-(_Acoeff*origin[0]+_Bcoeff*origin[1]+origin[2]+_Ccoeff)/(_Acoeff*slope[0]+_Bcoeff*slope[1]+1.);
+    Double_t position[3] = { origin[0]+t*slope[0], origin[1]+t*slope[1], origin[2]+t*1. };
+    TrackToPlane( position, slope, uvw+3*iTrack);
+    if( iTrack==nTracks-1 ) {
+      _xh = position[0];
+      _yh = position[1];
+      _zh = position[2];
+      _xtd = slope[0];
+      _ytd = slope[1];
+      _ztd = slope[2];
+    }
+  }
+}
+
 //______________________________________________________________________________
 //
 DR3 DPrecAlign::TransformHitToTracker(DR3 uuu)
@@ -945,6 +1087,14 @@ DR3 DPrecAlign::TransformHitToTracker(DR3 uuu)
   // Created: JB 2010/09/03
   // Modified JB 2015/10/31 take deformation into account
 
+  // Cached transform, the DR3 path below prints the steps in debug mode
+  if( !fDebugDPrecAlign ) {
+    Double_t aPlanePoint[3] = { uuu(0), uuu(1), uuu(2) };
+    Double_t aTrackerPoint[3];
+    HitToTracker( aPlanePoint, aTrackerPoint);
+    return DR3( aTrackerPoint[0], aTrackerPoint[1], aTrackerPoint[2]);
+  }
+
   DR3 aPoint = uuu;
 
   // Take into account deformation if required
@@ -990,6 +1140,15 @@ DR3 DPrecAlign::TransformTrackToPlane()
   // Note the plane is considered as flat with no deformation,
   //  to take into account deformation, call DPlane::Intersection
 
+  // Cached transform, the DR3 path below prints the steps in debug mode
+  if( !fDebugDPrecAlign ) {
+    Double_t aTrackerPoint[3] = { _xh, _yh, _zh };
+    Double_t aSlope[3] = { _xtd, _ytd, _ztd };
+    Double_t aPlanePoint[3];
+    TrackToPlane( aTrackerPoint, aSlope, aPlanePoint);
+    return DR3( aPlanePoint[0], aPlanePoint[1], aPlanePoint[2]);
+  }
+
   DR3 tmp = GetTrackPosition() ;
   DR3 trans(_fTr[0],_fTr[1],_fTr[2]);
   DR3 aFlatPoint(0.0,0.0,0.0) ;
@@ -1040,6 +1199,13 @@ DR3 DPrecAlign::TransformTrackToPlane( Double_t tx, Double_t ty, Double_t tz, Do
   // the track equation is: x=(z-tz)*tdx+tx, y=(z-tz)*tdy+ty, z=(z-tz)*tdz+tz
   //
   // Created: JB 2010/09/10
+  if( !fDebugDPrecAlign ) { // no DataPoints object
+    Double_t anOrigin[3] = { tx, ty, tz };
+    Double_t aSlope[2] = { tdx, tdy };
+    Double_t aPlanePoint[3];
+    TransformTracksToPlane( 1, anOrigin, aSlope, aPlanePoint);
+    return DR3( aPlanePoint[0], aPlanePoint[1], aPlanePoint[2]);
+  }
   DataPoints aPosition(0,0,0,0,tx,ty,tz,tdx,tdy); // track at origin in the telescope frame
   CalculateIntersection(&aPosition); // track at the plane surface in the telescope frame
   return TransformTrackToPlane(); // track at the plane surface in the plane frame
@@ -1545,6 +1711,7 @@ void DPrecAlign::DecomposeRotations()
   */
   } // enf if Method 1
 
+  ComputeTransform();
 }
 //______________________________________________________________________________
 //
@@ -1560,6 +1727,7 @@ void DPrecAlign::Streamer(TBuffer &R__b)
     if(fDebugDPrecAlign)  cout << "Version "<< R__v << endl;
     if ( R__v > 1 ) {
       DPrecAlign::Class()->ReadBuffer(R__b,this,R__v,R__s,R__c);
+      ComputeTransform();
       return;
     }
     //====process old versions before automatic schema evolution=v1
@@ -1592,6 +1760,7 @@ void DPrecAlign::Streamer(TBuffer &R__b)
       R__b.ReadStaticArray((double*)_initialRotations);
       R__b.ReadStaticArray((double*)_initialPosition);
       R__b.CheckByteCount(R__s, R__c, DPrecAlign::IsA());
+      ComputeTransform();
       //====end of old version
   } else {
   if(fDebugDPrecAlign)  cout << "Buffer is writing " << endl;
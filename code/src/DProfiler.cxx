@@ -0,0 +1,214 @@
+  //////////////////////////////////////////////////////////////////////////
+  //                                                                      //
+  // Class Description of DProfiler                                       //
+  //                                                                      //
+  // Accumulates per stage and per slot (plane or module type) the        //
+  //  number of calls, the time and a counter,                            //
+  //  see DProfiler.h for the usage.                                      //
+  //                                                                      //
+  // At the end of the run (DSession::Finish) the summary is              //
+  //  - printed as a table,                                               //
+  //  - written in a JSON file,                                           //
+  //  - stored as histograms in the DSF file.                             //
+  //                                                                      //
+  //////////////////////////////////////////////////////////////////////////
+
+#include "DProfiler.h"
+#include "TString.h"
+#include "TH2D.h"
+
+Int_t                  DProfiler::fgSlotsN = 0;
+std::atomic<Long64_t> *DProfiler::fgNanoseconds = 0;
+std::atomic<Long64_t> *DProfiler::fgCalls = 0;
+std::atomic<Long64_t> *DProfiler::fgCounts = 0;
+std::atomic<Long64_t>  DProfiler::fgLost( 0);
+
+// nesting depth of each stage, per thread
+static thread_local Int_t gProfilerDepth[DProfiler::kStagesN] = { 0 };
+
+static const char *gProfilerStageNames[DProfiler::kStagesN] = {
+  "decode", "plane_update", "find_hits", "clustering", "track_finding", "track_fitting", "vertexing", "fill_tree"
+};
+static const char *gProfilerCountNames[DProfiler::kStagesN] = {
+  "pixels", "pixels", "hits", "clusters", "tracks", "fits", "-", "-"
+};
+
+//______________________________________________________________________________
+//
+void DProfiler::SetSlotsN( Int_t nSlots)
+{
+  // Make room for the slots 0 to nSlots-1, the values already accumulated
+  //  are kept. Called when the planes and the modules are built, never
+  //  while the reconstruction runs (the arrays are reallocated).
+
+  if( nSlots<=fgSlotsN ) return;
+
+  std::atomic<Long64_t> *arrays[3] = { new std::atomic<Long64_t>[kStagesN*nSlots],
+                                       new std::atomic<Long64_t>[kStagesN*nSlots],
+                                       new std::atomic<Long64_t>[kStagesN*nSlots] };
+  std::atomic<Long64_t> *old[3] = { fgNanoseconds, fgCalls, fgCounts };
+  for( Int_t ia=0; ia<3; ia++) {
+    for( Int_t iStage=0; iStage<kStagesN; iStage++) {
+      for( Int_t iSlot=0; iSlot<nSlots; iSlot++) {
+        arrays[ia][iStage*nSlots+iSlot].store( iSlot<fgSlotsN ? old[ia][iStage*fgSlotsN+iSlot].load() : 0);
+      }
+    }
+    delete [] old[ia];
+  }
+  fgNanoseconds = arrays[0];
+  fgCalls       = arrays[1];
+  fgCounts      = arrays[2];
+  fgSlotsN      = nSlots;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DProfiler::Enter( Int_t aStage)
+{
+  // Returns kTRUE if no scope of this stage is already open in this thread.
+
+  return gProfilerDepth[aStage]++ == 0;
+}
+
+//______________________________________________________________________________
+//
+void DProfiler::Leave( Int_t aStage)
+{
+  gProfilerDepth[aStage]--;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DProfiler::IsNested( Int_t aStage)
+{
+  // Returns kTRUE if the calling code is in a scope of this stage nested
+  //  in another one, its counters are then already counted.
+
+  return gProfilerDepth[aStage]>1;
+}
+
+//______________________________________________________________________________
+//
+void DProfiler::Reset()
+{
+  for( Int_t i=0; i<kStagesN*fgSlotsN; i++) {
+    fgNanoseconds[i].store( 0);
+    fgCalls[i].store( 0);
+    fgCounts[i].store( 0);
+  }
+  fgLost.store( 0);
+}
+
+//______________________________________________________________________________
+//
+Bool_t DProfiler::IsEmpty()
+{
+  for( Int_t iStage=0; iStage<kStagesN; iStage++) {
+    for( Int_t iSlot=0; iSlot<fgSlotsN; iSlot++) {
+      if( GetCalls( iStage, iSlot) ) return kFALSE;
+    }
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+const char* DProfiler::GetStageName( Int_t aStage)
+{
+  if( aStage<0 || aStage>=kStagesN ) return "unknown";
+  return gProfilerStageNames[aStage];
+}
+
+//______________________________________________________________________________
+//
+void DProfiler::Print( ostream &stream)
+{
+  // Print one line per stage and slot used, with the total time,
+  //  the average per call and the counter.
+  // The slot is the plane number, or the module type for "decode",
+  //  0 means the stage is not related to a plane.
+
+  if( IsEmpty() ) return;
+
+  stream << "DProfiler: time spent per stage (inclusive)" << endl;
+  stream << Form( "  %-14s %5s %12s %12s %12s %12s", "stage", "slot", "calls", "total[ms]", "mean[us]", "counter") << endl;
+  for( Int_t iStage=0; iStage<kStagesN; iStage++) {
+    Long64_t stageTime = 0;
+    Int_t usedSlots = 0;
+    for( Int_t iSlot=0; iSlot<fgSlotsN; iSlot++) {
+      if( GetCalls( iStage, iSlot)==0 ) continue;
+      stageTime += GetNanoseconds( iStage, iSlot);
+      usedSlots++;
+      stream << Form( "  %-14s %5d %12lld %12.3f %12.3f %12lld %s",
+                      gProfilerStageNames[iStage], iSlot,
+                      GetCalls( iStage, iSlot),
+                      GetNanoseconds( iStage, iSlot)*1.e-6,
+                      GetNanoseconds( iStage, iSlot)*1.e-3/GetCalls( iStage, iSlot),
+                      GetCounts( iStage, iSlot), gProfilerCountNames[iStage]) << endl;
+    }
+    if( usedSlots>1 ) stream << Form( "  %-14s %5s %12s %12.3f", gProfilerStageNames[iStage], "all", "", stageTime*1.e-6) << endl;
+  }
+  if( GetLost() ) stream << "  WARNING: " << GetLost() << " values for slots beyond " << fgSlotsN-1 << " not counted" << endl;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DProfiler::WriteJSON( const char *fileName)
+{
+  // Write the summary as a JSON list of records
+  //  {"stage":..., "slot":..., "calls":..., "ns":..., "count":...}
+  // Return kFALSE if the file cannot be written.
+
+  ofstream jsonFile( fileName);
+  if( jsonFile.fail() ) {
+    printf("WARNING DProfiler: cannot write file %s\n", fileName);
+    return kFALSE;
+  }
+
+  jsonFile << "[";
+  Bool_t first = kTRUE;
+  for( Int_t iStage=0; iStage<kStagesN; iStage++) {
+    for( Int_t iSlot=0; iSlot<fgSlotsN; iSlot++) {
+      if( GetCalls( iStage, iSlot)==0 ) continue;
+      jsonFile << (first?"\n":",\n");
+      jsonFile << Form( "  {\"stage\": \"%s\", \"slot\": %d, \"calls\": %lld, \"ns\": %lld, \"count\": %lld, \"count_unit\": \"%s\"}",
+                        gProfilerStageNames[iStage], iSlot,
+                        GetCalls( iStage, iSlot), GetNanoseconds( iStage, iSlot), GetCounts( iStage, iSlot),
+                        gProfilerCountNames[iStage]);
+      first = kFALSE;
+    }
+  }
+  jsonFile << "\n]\n";
+  jsonFile.close();
+
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+void DProfiler::WriteHistograms()
+{
+  // Write three 2D histograms (stage x slot) in the current directory:
+  //  hProfilerTime (ns), hProfilerCalls and hProfilerCounts.
+
+  if( IsEmpty() ) return;
+
+  TH2D hTime( "hProfilerTime", "Time per stage and slot;stage;slot;time (ns)", kStagesN, 0, kStagesN, fgSlotsN, 0, fgSlotsN);
+  TH2D hCalls( "hProfilerCalls", "Calls per stage and slot;stage;slot;calls", kStagesN, 0, kStagesN, fgSlotsN, 0, fgSlotsN);
+  TH2D hCounts( "hProfilerCounts", "Counter per stage and slot;stage;slot;counter", kStagesN, 0, kStagesN, fgSlotsN, 0, fgSlotsN);
+  TH2D *histos[3] = { &hTime, &hCalls, &hCounts };
+  for( Int_t ih=0; ih<3; ih++) {
+    histos[ih]->SetDirectory(0);
+    for( Int_t iStage=0; iStage<kStagesN; iStage++) histos[ih]->GetXaxis()->SetBinLabel( iStage+1, gProfilerStageNames[iStage]);
+  }
+
+  for( Int_t iStage=0; iStage<kStagesN; iStage++) {
+    for( Int_t iSlot=0; iSlot<fgSlotsN; iSlot++) {
+      hTime.SetBinContent( iStage+1, iSlot+1, (Double_t)GetNanoseconds( iStage, iSlot));
+      hCalls.SetBinContent( iStage+1, iSlot+1, (Double_t)GetCalls( iStage, iSlot));
+      hCounts.SetBinContent( iStage+1, iSlot+1, (Double_t)GetCounts( iStage, iSlot));
+    }
+  }
+
+  for( Int_t ih=0; ih<3; ih++) histos[ih]->Write();
+}
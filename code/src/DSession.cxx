@@ -47,6 +47,12 @@
 //#include "DReader.h"
 #include "DR3.h"
 #include "TBits.h"
+#include "DProfiler.h"
+#include "TH1I.h"
+#include "TH1D.h"
+#include "TROOT.h"
+#include "RVersion.h"
+#include "Compression.h"
 
 ClassImp(DSession) // DSession
 
@@ -86,6 +92,18 @@ DSession::DSession()
 
   fEventsToDo = 0;
   fCurrentEventNumber = 0;
+  fFirstEvent = 0;
+  fWarmUpEvents = 0;
+  fChunkId = 0;
+  fChunksN = 1;
+  fEventsLooped = 0;
+  fLastEvent = -1;
+  fDSFCompression = "";
+  fDSFCompressionLevel = -1;
+  fDSFBasketSize = -1;
+  fDSFAutoFlush = 0;
+  fDSFThreads = -1;
+  fImplicitMTStarted = kFALSE;
 
   // JB 2013/06/11
   fTrackLimitsForAlignX[0] = 0.;
@@ -170,14 +188,35 @@ void DSession::InitSession()
   //fReader->ReadHeaderFile(*fc);
 
   // Build the run environment from previous info
+  TStopwatch startTimer;
+  startTimer.Start();
   fAcq          = new DAcq(*fc);             // construct "DataAcquisition" object.
   if( fDebugSession<=0 ) fAcq->SetDebug( fDebugSession); // JB, 2010/11/25
+  startTimer.Stop();
+  Double_t timeAcq = startTimer.RealTime();
 
+  startTimer.Start(kTRUE);
   fTracker      = new DTracker(*fc, *fAcq);  // construct the DTracker
   if( fDebugSession>=0 ) fTracker->SetDebug( fDebugSession); // JB, 2010/11/25
+  startTimer.Stop();
+  Double_t timeTracker = startTimer.RealTime();
+
+  // Report where the start-up time goes
+  cout << " - Start-up timing:" << endl;
+  printf("     config parsing           %8.3f s\n", fc->GetTimeReadConfiguration()-fc->GetTimePerformancesParams()-fc->GetTimeHotPixels());
+  printf("     resolution files         %8.3f s\n", fc->GetTimePerformancesParams());
+  printf("     hot pixel lists          %8.3f s\n", fc->GetTimeHotPixels());
+  printf("     DAcq construction        %8.3f s\n", timeAcq);
+  printf("     DTracker construction    %8.3f s\n", timeTracker);
 
   fEventsToDo = 0;
   fCurrentEventNumber = 0;
+  fFirstEvent = 0;
+  fWarmUpEvents = 0;
+  fChunkId = 0;
+  fChunksN = 1;
+  fEventsLooped = 0;
+  fLastEvent = -1;
 
   // Test if the DAQ is able to go to a specif event
   fDaqAbleToGoToAspecificEvent = 0;
@@ -324,6 +363,15 @@ Bool_t DSession::NextRawEvent( Int_t aTrigger)
 
   TBits* DAcqResult=new TBits(2);
 
+  // With an event index, the event carrying the trigger is reached directly
+  if( aTrigger!=-1 && fAcq->IsAbleToGoToEvent() ) {
+    Int_t eventWithTrigger = fAcq->FindEventWithTrigger( aTrigger);
+    if( eventWithTrigger>=0 && fAcq->GoToEvent( eventWithTrigger) ) {
+      fCurrentEventNumber = eventWithTrigger;
+      aTrigger = -1;
+    }
+  }
+
   if (fCurrentEventNumber++ <= fEventsToDo) {
     //------------------------
     DAcqResult = fAcq->NextEvent( fCurrentEventNumber-1, aTrigger); // get the next event from DAcq, -1 to start at 0, JB 2011/03/14
@@ -393,6 +441,30 @@ Int_t DSession::GoToEvent(Int_t anEvent)
 
     return fCurrentEventNumber;
   }
+  else if (fAcq->IsAbleToGoToEvent())
+  {
+    // The readers keep an event index: seek, then read the event
+    if (!fAcq->GoToEvent(anEvent))
+    {
+      cout << "WARNING: DSession::GoToEvent : event " << anEvent << " can't be reached!" << endl;
+      return -1;
+    }
+    TBits* DAcqResult = fAcq->NextEvent(anEvent);
+    if( !DAcqResult->TestBitNumber(0))
+    {
+      cout << "WARNING: DSession::GoToEvent : event " << anEvent << " can't be retrieve!" << endl;
+      return -1;
+    }
+
+    fCurrentEventNumber = anEvent+1; // as after NextRawEvent, the next event read is anEvent+1
+
+    if (GetStatus()==0 && fTracker->GetPlanesStatus() )
+    {
+      SetStatus(fTracker->GetPlanesStatus()) ;
+    }
+
+    return anEvent;
+  }
   else
   {
     cout << "ERROR: DSession::GoToEvent : to use this function, the real event nb must be able to be calculated, not the case!" << endl;
@@ -400,6 +472,48 @@ Int_t DSession::GoToEvent(Int_t anEvent)
   }
 }
 
+//______________________________________________________________________________
+//
+Int_t DSession::GoToTrigger(Int_t aTrigger)
+{
+  // Read the event carrying the trigger aTrigger,
+  //  found thanks to the event index kept by the readers.
+  // Return the event number, -1 if the trigger is unknown.
+
+  Int_t anEvent = fAcq->FindEventWithTrigger(aTrigger);
+  if (anEvent<0)
+  {
+    cout << "WARNING: DSession::GoToTrigger : trigger " << aTrigger << " is not in the event index!" << endl;
+    return -1;
+  }
+  return GoToEvent(anEvent);
+}
+
+//______________________________________________________________________________
+//
+Bool_t DSession::SkipRawEvents(Int_t nEvents)
+{
+  // Skip the next nEvents events.
+  // When the readers keep an event index, the reading is directly
+  //  positioned after the skipped events, otherwise they are read.
+  // Positioned events are not decoded: DAcq counts them as skipped
+  //  and they are absent from its synchronisation and data statistics,
+  //  whereas read events enter them.
+  // Return kFALSE if the end of the run was reached.
+
+  if (fAcq->IsAbleToGoToEvent())
+  {
+    if (!fAcq->GoToEvent(fCurrentEventNumber+nEvents)) return kFALSE;
+    fCurrentEventNumber += nEvents;
+    return kTRUE;
+  }
+
+  for( Int_t iEvent=0; iEvent<nEvents; iEvent++ ) {
+    if( !NextRawEvent() ) return kFALSE;
+  }
+  return kTRUE;
+}
+
 //______________________________________________________________________________
 //
 Int_t DSession::GoToNextEvent(void)
@@ -460,27 +574,65 @@ Int_t DSession::GoToNextEvent(void)
 void DSession::MakeTree()
 {
   // Create a new ROOT file with Tree.
+  //
+  // Compression algorithm and level, basket size, auto-flush and number
+  //  of compression threads come from the run parameters of the config file
+  //  (DSFCompression, ...), unless set with SetDSFCompression.
 
   // Not needed with new reading, JB 2008/10/13
   //fReader->Reset();
   //fCurrentEventNumber   = 0;
   fStatus       = 0;
-  Int_t   tCompressionLevel = 2;
-
+  DSetup::RunParameter_t &runPar = fc->GetRunPar();
+  TString tCompression    = fDSFCompression.IsNull() ? TString( runPar.DSFCompression) : fDSFCompression;
+  Int_t tCompressionLevel = fDSFCompressionLevel>=0 ? fDSFCompressionLevel : runPar.DSFCompressionLevel;
+  Int_t tBasketSize       = fDSFBasketSize>0 ? fDSFBasketSize : runPar.DSFBasketSize;
+  Int_t tAutoFlush        = fDSFAutoFlush!=0 ? fDSFAutoFlush : runPar.DSFAutoFlush;
+  Int_t tThreads          = fDSFThreads>=0 ? fDSFThreads : runPar.DSFThreads;
+
+  // With ZLIB:
   // If level = 1, only branches containing integers will be compressed.
   // If level >= 2, all branches will be compressed with compression level-1.
 
+  DProfiler::Reset(); // profile the DSF production only
   fSummaryFile = new TFile(fSummaryFilePathAndName, "RECREATE", fSummaryFileTitle);
+  if( !tCompression.IsNull() ) {
+    Int_t tAlgorithm = GetCompressionAlgorithm( tCompression);
+    if( tAlgorithm<0 ) {
+      cout << "WARNING: DSession, compression algorithm " << tCompression << " unknown, ROOT default used." << endl;
+      tCompression = "";
+    }
+    else {
+      fSummaryFile->SetCompressionAlgorithm(tAlgorithm);
+    }
+  }
   fSummaryFile->SetCompressionLevel(tCompressionLevel);
   fEvent = new DEvent(*fc);
 
+  // Baskets are compressed in parallel when the tree is flushed
+  //  if ROOT implicit multi-threading is on.
+  // It is stopped in Finish, to leave the other loops sequential.
+  if( tThreads>0 ) {
+#ifdef R__USE_IMT
+    if( !ROOT::IsImplicitMTEnabled() ) {
+      ROOT::EnableImplicitMT(tThreads);
+      fImplicitMTStarted = kTRUE;
+    }
+#else
+    cout << "WARNING: DSession, ROOT was built without implicit multi-threading, DSF baskets compressed sequentially." << endl;
+#endif
+  }
+
+  printf("DSession, DSF compression %s level %d, basket %d bytes, auto-flush %d, %d thread(s)\n", tCompression.IsNull()?"default":tCompression.Data(), tCompressionLevel, tBasketSize, tAutoFlush, tThreads);
+
   // Create a ROOT Tree and one branch
 
   //TTree::SetMaxTreeSize(1000*Long64_t(2000000000));
   fEventTree = new TTree("T", fSummaryFileTitle);
   fEventTree->SetAutoSave(100000000);  // autosave when 1 Mbyte written
+  if( tAutoFlush!=0 ) fEventTree->SetAutoFlush(tAutoFlush);
   fEventTree->Print();
-  TBranch *b = fEventTree->Branch("fEvent","DEvent",&fEvent,64000,99);
+  TBranch *b = fEventTree->Branch("fEvent","DEvent",&fEvent,tBasketSize,99);
    b->SetAutoDelete(kFALSE);
 
    if( !fEventTree || !b ) printf("\n\n-*-*- ERROR DSession:MakeTree, something is wrong with the creation of the TTree!\n\n");
@@ -496,7 +648,28 @@ void DSession::Loop()
 
   fWatch.Start(); // Start to count processing time, JB 2008/08/08
 
+  // Production of a range of events (see SetEventRange):
+  //  go to the first event, the warm-up events before it are reconstructed
+  //  (pedestal and noise of analog planes) but neither written nor counted.
+  if( fFirstEvent>0 ) {
+    cout << "Session: skipping " << fFirstEvent-fWarmUpEvents << " events, then " << fWarmUpEvents << " warm-up events" << endl;
+    if( !SkipRawEvents( fFirstEvent-fWarmUpEvents) ) {
+      cout << "WARNING: DSession, the run ends before event " << fFirstEvent << ", nothing to do!" << endl;
+      return;
+    }
+    for( Int_t iEvent=0; iEvent<fWarmUpEvents; iEvent++ ) {
+      if( !NextRawEvent() ) break;
+      fTracker->Update();
+    }
+    fTracker->ResetStatistics();
+    fAcq->ResetStatistics();
+  }
+  fEventsLooped = 0;
+  fLastEvent = fFirstEvent-1;
+
   while(NextRawEvent() == kTRUE) { // event loop
+    fEventsLooped++;
+    fLastEvent = GetCurrentEventNumber()-1;
     //==============
     Int_t Updt = fTracker->Update();
 //cout << __FILE__ << __LINE__ << endl;
@@ -573,10 +746,20 @@ void DSession::Finish()
   logfile.open("DSFProd.log",ios::app);
   logfile<<"============================================"<<endl;
   logfile<<aTime.AsString()<<endl;
+  if( fChunksN>1 || fFirstEvent>0 ) logfile<<"Chunk "<<fChunkId<<"/"<<fChunksN<<": events "<<fFirstEvent<<" to "<<fLastEvent<<", "<<fWarmUpEvents<<" warm-up events"<<endl;
   fTracker->PrintStatistics(logfile);
   fAcq->PrintStatistics(logfile);
+  DProfiler::Print(logfile);
   logfile.close();
 
+  // Where the time was spent, also as JSON and in the DSF file
+  DProfiler::Print();
+  if( !DProfiler::IsEmpty() ) {
+    TString profileFileName = fSummaryFilePathAndName;
+    profileFileName.ReplaceAll( ".root", "_profile.json");
+    DProfiler::WriteJSON( profileFileName.Data());
+  }
+
   printf("************************************\n");
   printf("Entries in TTree: %ld\n.", (long int)fEventTree->GetEntries()); // JB 2009/10/02, could be Long64_t
   printf("************************************\n");
@@ -586,7 +769,15 @@ void DSession::Finish()
 
   fSummaryFile->cd();
   fEventTree->Write();
+  DProfiler::WriteHistograms();
+  WriteProductionInfo();
   fSummaryFile->Close();
+#ifdef R__USE_IMT
+  if( fImplicitMTStarted ) {
+    ROOT::DisableImplicitMT();
+    fImplicitMTStarted = kFALSE;
+  }
+#endif
   //fWeightFile->Close(); // JB 2011/04/12
 
 }
@@ -616,6 +807,8 @@ void DSession::FillTree()
   // Last modified: JB 2014/08/29, indicate if track fitted with hit and new fill conditions
   // Last modified: BB 2015/11/17, change for loop on track to do...while to be sure that the event is read
 
+  TAF_PROFILE_SCOPE( DProfiler::kFillTree, 0);
+
   DPlane        *tPlane=nullptr; //nullptr instead of 0
   DTrack        *tTrack=nullptr; //nullptr instead of 0
   DHit          *tHit=nullptr;
@@ -694,6 +887,126 @@ void DSession::FillTree()
 
 }
 
+//______________________________________________________________________________
+//
+void DSession::SetEventRange(Int_t firstEvent, Int_t lastEvent, Int_t warmUpEvents)
+{
+  // Restrict Loop() to the events firstEvent to lastEvent (counted from 0),
+  //  to produce one part of a run.
+  // The warmUpEvents events before firstEvent are reconstructed but not written,
+  //  so that the analog planes start with initialized pedestal and noise.
+
+  if( firstEvent<0 ) firstEvent = 0;
+  if( warmUpEvents<0 ) warmUpEvents = 0;
+  if( warmUpEvents>firstEvent ) warmUpEvents = firstEvent;
+
+  fFirstEvent = firstEvent;
+  fWarmUpEvents = warmUpEvents;
+  fEventsToDo = lastEvent;
+}
+
+//______________________________________________________________________________
+//
+void DSession::SetDSFCompression( const char *algorithm, Int_t level, Int_t basketSize, Int_t autoFlush, Int_t threads)
+{
+  // Overwrite the DSF output settings of the config file for the next MakeTree:
+  //  algorithm "ZLIB", "LZ4", "ZSTD" or "LZMA" ("" or 0 keeps the config),
+  //  level (-1), basket size in bytes (-1), auto-flush (0) and
+  //  compression threads (-1), the value in parenthesis keeps the config.
+  // LZ4 is the fastest choice for intermediate DSF files.
+
+  fDSFCompression = algorithm ? algorithm : "";
+  fDSFCompressionLevel = level;
+  fDSFBasketSize = basketSize;
+  fDSFAutoFlush = autoFlush;
+  fDSFThreads = threads;
+}
+
+//______________________________________________________________________________
+//
+Int_t DSession::GetCompressionAlgorithm( TString aName)
+{
+  // ROOT code of the compression algorithm named aName, -1 if unknown.
+
+  aName.ToUpper();
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+  if( aName=="ZLIB" ) return ROOT::RCompressionSetting::EAlgorithm::kZLIB;
+  if( aName=="LZMA" ) return ROOT::RCompressionSetting::EAlgorithm::kLZMA;
+  if( aName=="LZ4" )  return ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+  if( aName=="ZSTD" ) return ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+#else
+  if( aName=="ZLIB" ) return ROOT::kZLIB;
+  if( aName=="LZMA" ) return ROOT::kLZMA;
+  if( aName=="LZ4" )  return ROOT::kLZ4;
+#endif
+  return -1;
+}
+
+//______________________________________________________________________________
+//
+Int_t DSession::GetDefaultWarmUpEvents()
+{
+  // Number of warm-up events needed before a range of events:
+  //  the largest number of events used for the noise initialization
+  //  by the planes with non-sparsified (analog) readout, 0 if none.
+
+  Int_t warmUpEvents = 0;
+  for( Int_t pl=1; pl<=fTracker->GetPlanesN(); pl++ ) {
+    DPlane *tPlane = fTracker->GetPlane(pl);
+    Int_t readout = tPlane->GetReadout();
+    if( readout!=0 && ( readout<100 || readout==232 ) && tPlane->GetInitialNoise()>warmUpEvents ) {
+      warmUpEvents = tPlane->GetInitialNoise();
+    }
+  }
+  return warmUpEvents;
+}
+
+//______________________________________________________________________________
+//
+void DSession::WriteProductionInfo()
+{
+  // Write in the current directory the description of the production,
+  //  used to merge the DSF files of a run produced by chunks
+  //  (see MimosaAnalysis::MergeDSFChunks):
+  //  - hDSFChunk: chunk id, nb of chunks, first and last events, warm-up events,
+  //  - hDSFStatistics: event, DAQ and track counters, summed when merging.
+
+  TH1I hChunk( "hDSFChunk", "DSF production range", 5, 0, 5);
+  hChunk.SetDirectory(0);
+  const char *chunkLabels[5] = { "chunk", "chunks", "first event", "last event", "warm-up events" };
+  Int_t chunkValues[5] = { fChunkId, fChunksN, fFirstEvent, fLastEvent, fWarmUpEvents };
+  for( Int_t ib=0; ib<5; ib++) {
+    hChunk.GetXaxis()->SetBinLabel( ib+1, chunkLabels[ib]);
+    hChunk.SetBinContent( ib+1, chunkValues[ib]);
+  }
+  hChunk.Write();
+
+  Int_t nPlanes = fTracker->GetPlanesN();
+  TH1D hStatistics( "hDSFStatistics", "DSF production statistics", 6+2*nPlanes, 0, 6+2*nPlanes);
+  hStatistics.SetDirectory(0);
+  hStatistics.GetXaxis()->SetBinLabel( 1, "events reconstructed");
+  hStatistics.SetBinContent( 1, fEventsLooped);
+  hStatistics.GetXaxis()->SetBinLabel( 2, "events stored");
+  hStatistics.SetBinContent( 2, (Double_t)fEventTree->GetEntries());
+  hStatistics.GetXaxis()->SetBinLabel( 3, "events missed (synchro)");
+  hStatistics.SetBinContent( 3, fAcq->GetEventsMissed());
+  hStatistics.GetXaxis()->SetBinLabel( 4, "events with wrong data");
+  hStatistics.SetBinContent( 4, fAcq->GetEventsDataNotOK());
+  hStatistics.GetXaxis()->SetBinLabel( 5, "events with module pb");
+  hStatistics.SetBinContent( 5, fAcq->GetEventsModuleNotOK());
+  hStatistics.GetXaxis()->SetBinLabel( 6, "tracks");
+  hStatistics.SetBinContent( 6, fTracker->GetTrackCount(0));
+  for( Int_t ip=1; ip<=nPlanes; ip++) {
+    hStatistics.GetXaxis()->SetBinLabel( 6+ip, Form("tracks with %d hits", ip));
+    hStatistics.SetBinContent( 6+ip, fTracker->GetTrackCount(ip));
+    hStatistics.GetXaxis()->SetBinLabel( 6+nPlanes+ip, Form("tracks with plane %d", ip));
+    hStatistics.SetBinContent( 6+nPlanes+ip, fTracker->GetTrackCountPerPlane(ip));
+  }
+  hStatistics.Write();
+}
+
+//______________________________________________________________________________
+//
 void DSession::ResetDaq()
 {
   fEventsToDo = 0;
@@ -86,6 +86,14 @@
 // EndIndex         = [MANDATORY for IMGBoardReader] (int) {0}
 // NoiseRun         = [optional] (int) {0}  defines either the file with the noise for each pixel, or a specific method to remove noisy pixels (see DGlobalTools::VetoPixels)
 // PixelGainRun     = [optional] (int) {0}  if not 0, defines the file with individual pixel gain map
+// DSFCompression   = [optional] (char) {""} compression algorithm of the DSF file: "ZLIB", "LZ4", "ZSTD" or "LZMA", "" keeps the ROOT default
+// DSFCompressionLevel = [optional] (int) {2} compression level of the DSF file, 0 to 9
+// DSFBasketSize    = [optional] (int) {64000} basket size in bytes of the DSF tree
+// DSFAutoFlush     = [optional] (int) {0} cluster size of the DSF tree (>0 entries, <0 bytes), 0 keeps the ROOT default
+// DSFThreads       = [optional] (int) {0} threads used to compress the DSF baskets (ROOT implicit multi-threading)
+//   Trade-offs (measure them on a given run with macros/DSFCompressionBenchmark.C):
+//    LZ4 is the fastest to write and read but gives larger files, suited to intermediate DSF,
+//    ZSTD compresses like ZLIB but faster, LZMA gives the smallest and slowest files, for archiving.
 // -----------------------------------------------------------------------------
 
 
@@ -110,6 +118,8 @@
 // HitsInPlaneMaximum      = [MANDATORY] (int)       the nb hits which will be reconstruted in each plane, 0 : not clustering
 // KeepUnTrackedHitsBetw2evts =[optional]   (int) {0}
 //                                                  1 memorise untracked hits between 2 evenements
+// PlaneThreads            = [optional]  (int) {0}   threads updating the planes of an event in parallel (ROOT implicit MT),
+//                                                   0 or 1 = sequential, requires TruthMatching 0 or 2 for MC data
 //
 // ----------------------------------
 //     Tracking parameters
@@ -137,6 +147,8 @@
 // SubtrackPlanes          = [MANDATORY if SubtrackNplanes!=0] list of planes (separated by ":" to be used by subtrack
 // HitMonteCarlo           = [optional] (int) {0}:
 // DPrecAlignMethod        = [optional] (int) {0} 0=Old DPrecAlign, 1=New DrecAlign -> Redifinitions of Matrices, Rotations and Plane Equations.
+// TruthMatching           = [optional] (int) {1} only for MC data, 0=no truth matching, 1=hits matched during reconstruction,
+//                                                   2=deferred, call DTracker::DoTruthMatching() when needed
 //
 // ----------------------------------
 //     Tracking parameters specifics for TracksFinder=2, all MANDATORY
@@ -272,6 +284,14 @@
 //                   for computing the noise and pedestal
 // HotPixelMapFile = [optional] (char) ROOT file name with fake rate map
 //   FakeRateCut     = [MANDATORY if HotPixelMapFile] (float) Single pixel fake rate cut
+//                   The hot pixel lists derived from the map are stored in the directory
+//                   given by the environment variable TAF_CONFIG_CACHE (if set),
+//                   and reused as long as the config file and the map file are unchanged.
+// HotPixelMaskFile = [optional] (char) binary file with a hot pixel mask (see DHotPixelMask),
+//                   e.g. saved with DAcq::SaveHotPixelMasks, which writes the masks of the
+//                   current run as built from its HotPixelMapFile and HotPixelMaskFile,
+//                   not from the pixel occupancy of the run,
+//                   these pixels are dropped while decoding, in addition to the HotPixelMapFile ones
 // IfDigitize      = [optional] (int) {0} # thresholds to emulate the digitization
 //                   0 (default) means no-digitization
 //     DigitizeThresholds = [MANDATORY if IfDigitize>0] (array of int)
@@ -503,6 +523,9 @@
 //  Inputs          = [MANDATORY] (int) at least 1
 //  DataFile        = [MANDATORY] (char) typically "FILEdata_Geant_RUN1_ch"
 //  MCTreeName      = [MANDATORY] (char) tree name in the MC generated file
+//  MCCacheSize     = [optional] (int) {0} TTreeCache size in MB, 0 sized from the tree clusters, <0 no cache
+//  MCThreads       = [optional] (int) {0} threads decompressing the tree baskets (ROOT implicit multi-threading)
+//  MCReadAheadFiles = [optional] (int) {1} files of the DataFile list (.txt) read ahead of the current one
 //  TriggerMode, BinaryCoding, EventBufferSize, FileHeaderLine -> unused
 //  Channels, Bits, SignificantBits, EventBuildingBoardMode -> unused
 //  FirstTriggerChannel, LastTriggerChannelNbOfFramesPerChannel -> unused
@@ -604,8 +627,10 @@
 #include "TH2F.h"
 #include "TROOT.h"
 #include "TVector2.h"
+#include "TStopwatch.h"
 
 #include <assert.h>
+#include <ctype.h>
 
 ClassImp(DSetup) // DSetup of Test Beam Setup and Data Structure
 
@@ -616,6 +641,14 @@ DSetup::DSetup() {
     fFieldMaxLength = 100;
     fFieldName = new Char_t[fFieldMaxLength];
 
+    fConfigPos = 0;
+    fConfigEof = kFALSE;
+    fConfigHash = 0;
+    fCacheDir = gSystem->Getenv("TAF_CONFIG_CACHE");
+    fTimeReadConfiguration = 0.;
+    fTimePerformancesParams = 0.;
+    fTimeHotPixels = 0.;
+
 }
 //______________________________________________________________________________
 //
@@ -628,6 +661,14 @@ DSetup::DSetup(DSession& aSession)
   fFieldMaxLength = 100;
   fFieldName = new Char_t[fFieldMaxLength];
 
+  fConfigPos = 0;
+  fConfigEof = kFALSE;
+  fConfigHash = 0;
+  fCacheDir = gSystem->Getenv("TAF_CONFIG_CACHE");
+  fTimeReadConfiguration = 0.;
+  fTimePerformancesParams = 0.;
+  fTimeHotPixels = 0.;
+
 }
 //______________________________________________________________________________
 //
@@ -690,6 +731,11 @@ void DSetup::ReadRunParameters()
   RunParameter.EndIndex = 0;// [MANDATORY for IMGBoardReader]
   RunParameter.NoiseRun = 0;
   RunParameter.PixelGainRun = 0;
+  sprintf(RunParameter.DSFCompression,"");
+  RunParameter.DSFCompressionLevel = 2;
+  RunParameter.DSFBasketSize = 64000;
+  RunParameter.DSFAutoFlush = 0;
+  RunParameter.DSFThreads = 0;
 
   if( !fSourcePath.IsNull() ) { // Read the path only if not set already
     sprintf( RunParameter.DataPath, "%s", fSourcePath.Data());
@@ -748,6 +794,21 @@ void DSetup::ReadRunParameters()
     else if( ! strcmp( fFieldName, "PixelGainRun" ) ) {
       read_item(RunParameter.PixelGainRun);   //JB 2018/07/04
     }
+    else if( ! strcmp( fFieldName, "DSFCompression" ) ) {
+      read_strings( RunParameter.DSFCompression, RunParameter.tpsz);
+    }
+    else if( ! strcmp( fFieldName, "DSFCompressionLevel" ) ) {
+      read_item(RunParameter.DSFCompressionLevel);
+    }
+    else if( ! strcmp( fFieldName, "DSFBasketSize" ) ) {
+      read_item(RunParameter.DSFBasketSize);
+    }
+    else if( ! strcmp( fFieldName, "DSFAutoFlush" ) ) {
+      read_item(RunParameter.DSFAutoFlush);
+    }
+    else if( ! strcmp( fFieldName, "DSFThreads" ) ) {
+      read_item(RunParameter.DSFThreads);
+    }
     else
     {
       if ( strcmp( fFieldName, "Planes") && strcmp( fFieldName, "Ladders") )
@@ -818,6 +879,8 @@ void DSetup::ReadTrackerParameters()
   TrackerParameter.KeepUnTrackedHitsBetw2evts = 0;
   TrackerParameter.HitMonteCarlo = 0; // LC 2015/01
   TrackerParameter.DPrecAlignMethod = 0; // LC 2015/01/31
+  TrackerParameter.TruthMatching = 1;
+  TrackerParameter.PlaneThreads = 0;
 
   // *****************************
   //  Tracking with track_finder 2
@@ -921,6 +984,12 @@ void DSetup::ReadTrackerParameters()
     else if( ! strcmp( fFieldName, "DPrecAlignMethod" ) ) {
       read_item(TrackerParameter.DPrecAlignMethod);
     }
+    else if( ! strcmp( fFieldName, "TruthMatching" ) ) {
+      read_item(TrackerParameter.TruthMatching);
+    }
+    else if( ! strcmp( fFieldName, "PlaneThreads" ) ) {
+      read_item(TrackerParameter.PlaneThreads);
+    }
     // -------------------------------------------
     //     Tracking parameters for track_finder 2
     // -------------------------------------------
@@ -1795,6 +1864,7 @@ void DSetup::ReadPlaneParameters( Int_t aPlaneNumber)
   pPlaneParameter[aPlaneNumber].HotPixelList_lin.clear();
   pPlaneParameter[aPlaneNumber].HotPixelList_col.clear();
   pPlaneParameter[aPlaneNumber].HotPixelList_index.clear();
+  pPlaneParameter[aPlaneNumber].HotPixelMaskFile = "";
 
   // Initialize some default values for non mandatory parameters
   TString  HotPixelMapFile(""); // ROOT file name with fake rate map, Added, AP 2014/07/31
@@ -1883,6 +1953,9 @@ void DSetup::ReadPlaneParameters( Int_t aPlaneNumber)
     else if( ! strcmp( fFieldName, "FixedGlobalAlign" ) ) { // JB 2013/07/17
       read_item(pPlaneParameter[aPlaneNumber].FixedGlobalAlign);
     }
+    else if( ! strcmp( fFieldName, "HotPixelMaskFile" ) ) {
+      read_TStrings( pPlaneParameter[aPlaneNumber].HotPixelMaskFile, 350);
+    }
     else if( ! strcmp( fFieldName, "HotPixelMapFile" ) ) {  // AP 2014/07/31
       read_TStrings( HotPixelMapFile, 350);
     }
@@ -2149,15 +2222,26 @@ void DSetup::ReadPlaneParameters( Int_t aPlaneNumber)
 
   //Set of specific parameters for the hit spatial resolution
   //AP 12/01/2015
+  TStopwatch phaseTimer;
+  phaseTimer.Start();
   InitializePerformancesParams(aPlaneNumber);
+  phaseTimer.Stop();
+  fTimePerformancesParams += phaseTimer.RealTime();
 
   //Set specific parameters for hot pixel map
   //AP 01/12/2015
-  if(_FakeRateCutList.size() > 0 && _FractionToMaskList.size() == 0) {
+  // The lists are taken from the cache when available and up to date.
+  phaseTimer.Start(kTRUE);
+  if( (_FakeRateCutList.size() > 0) != (_FractionToMaskList.size() > 0) && readHotPixelCache(aPlaneNumber,HotPixelMapFile) ) {
+    if(DSetupDebug) cout << "  hot pixel lists of plane " << aPlaneNumber+1 << " read from cache " << hotPixelCacheFileName(aPlaneNumber,HotPixelMapFile) << endl;
+  }
+  else if(_FakeRateCutList.size() > 0 && _FractionToMaskList.size() == 0) {
     GetListOfHotPixelsToMask_FakeRateCut(aPlaneNumber,HotPixelMapFile);
+    writeHotPixelCache(aPlaneNumber,HotPixelMapFile);
   }
   else if(_FakeRateCutList.size() == 0 && _FractionToMaskList.size() > 0) {
     GetListOfHotPixelsToMask_FracToMask(aPlaneNumber,HotPixelMapFile);
+    writeHotPixelCache(aPlaneNumber,HotPixelMapFile);
   }
   else if(_FakeRateCutList.size() > 0 && _FractionToMaskList.size() > 0) {
     cout << endl;
@@ -2166,6 +2250,8 @@ void DSetup::ReadPlaneParameters( Int_t aPlaneNumber)
     cout << "          Check your inputs. Doing nothing!!!" << endl;
     cout << endl;
   }
+  phaseTimer.Stop();
+  fTimeHotPixels += phaseTimer.RealTime();
   PrintListOfHotPixelsToMask(aPlaneNumber);
 
   _ResolutionList.clear();
@@ -2367,6 +2453,9 @@ void DSetup::ReadDAQBoardParameters( Int_t aBoardNumber)
   pAcqModuleParameter[aBoardNumber].AmpFactor                 = -1;
   pAcqModuleParameter[aBoardNumber].Trailer                   = 0;
   pAcqModuleParameter[aBoardNumber].MCTreeName                = TString("");
+  pAcqModuleParameter[aBoardNumber].MCCacheSize               = 0;
+  pAcqModuleParameter[aBoardNumber].MCThreads                 = 0;
+  pAcqModuleParameter[aBoardNumber].MCReadAheadFiles          = 1;
   pAcqModuleParameter[aBoardNumber].IfZeroSuppress            =  0;
   pAcqModuleParameter[aBoardNumber].ThresholdZero             = -1000000;
 
@@ -2469,6 +2558,15 @@ void DSetup::ReadDAQBoardParameters( Int_t aBoardNumber)
     else if( ! strcmp( fFieldName, "MCTreeName" ) ) {  // 2016/04/18, AP MC tree name. Only for MCBoardReader to read MC simulation
       read_TStrings( pAcqModuleParameter[aBoardNumber].MCTreeName, 350);
     }
+    else if( ! strcmp( fFieldName, "MCCacheSize" ) ) {
+      read_item(pAcqModuleParameter[aBoardNumber].MCCacheSize);
+    }
+    else if( ! strcmp( fFieldName, "MCThreads" ) ) {
+      read_item(pAcqModuleParameter[aBoardNumber].MCThreads);
+    }
+    else if( ! strcmp( fFieldName, "MCReadAheadFiles" ) ) {
+      read_item(pAcqModuleParameter[aBoardNumber].MCReadAheadFiles);
+    }
     else if( ! strcmp( fFieldName, "DataFile" ) || ! strcmp( fFieldName, "DataFile1" )) {
       // reading data file name for each device of this type, JB 2009/05/25
       for( Int_t iMod=0; iMod<pAcqModuleParameter[aBoardNumber].Devices; iMod++) {
@@ -2729,7 +2827,7 @@ void DSetup::ReadAnalysisParameters()
     }
     else
     {
-      if (  strcmp( fFieldName, "PixelSizeU" ) && !fConfigFileStream.eof() )
+      if (  strcmp( fFieldName, "PixelSizeU" ) && !configEof() )
       {
         cout << "WARNING : parameter '" << fFieldName << "' in config file is not understood !" << endl;
         getRidOfLine();
@@ -2737,7 +2835,7 @@ void DSetup::ReadAnalysisParameters()
     }
     nextField();
 
-  } while (  strcmp( fFieldName, "PixelSizeU" ) && !fConfigFileStream.eof() );
+  } while (  strcmp( fFieldName, "PixelSizeU" ) && !configEof() );
 
   if( DSetupDebug) {
     cout << " - Final analysis cuts: " << endl;
@@ -2873,7 +2971,7 @@ void DSetup::ReadSubmatrixParameters( Int_t aSubmatrixNumber)
 
     nextField();
 
-  } while (  strcmp( fFieldName, "PixelSizeU" ) && !fConfigFileStream.eof() );
+  } while (  strcmp( fFieldName, "PixelSizeU" ) && !configEof() );
 
   if( DSetupDebug )  {
     cout << "  * Submatrix " << aSubmatrixNumber << endl;
@@ -2916,6 +3014,11 @@ void DSetup::ReadConfiguration()
 
   cout << endl << " -*-*- DSetup User Constructor -*-*- " << endl;
 
+  TStopwatch timer;
+  timer.Start();
+  fTimePerformancesParams = 0.;
+  fTimeHotPixels = 0.;
+
   // -+-+-+-+-+--+-+-
   // --- Initialization
   // -+-+-+-+-+--+-+-
@@ -2928,9 +3031,7 @@ void DSetup::ReadConfiguration()
   // -+-+-+-+-+--+-+-
   // --- open config file:
   // -+-+-+-+-+--+-+-
-  fConfigFileStream.open(fConfigPathAndFileName);
-
-  Bool_t    answer = fConfigFileStream.fail();
+  Bool_t    answer = !loadConfigFile();
   if(answer && gROOT->IsBatch()) {
     printf("ERROR ! Can't read file %s\nQuit (because in batch mode)\n", fConfigPathAndFileName.Data());
     gSystem->Exit(-1);
@@ -2940,9 +3041,9 @@ void DSetup::ReadConfiguration()
     cin >> fConfigFileName;
     fConfigPathAndFileName = fConfigPath + fConfigFileName;
     printf(" - Reading Setup from %s\n", fConfigPathAndFileName.Data());
-    fConfigFileStream.open(fConfigPathAndFileName);
-    answer=fConfigFileStream.fail();
+    answer = !loadConfigFile();
   }
+  if(DSetupDebug) printf(" - config file hash %016llx\n", fConfigHash);
 
   // -+-+-+-+-+--+-+-+-+-+--+-+-+-+-+--+-+-+-+-+--+-+-+-+-+--+-+-+-+-+--+-+-+-+-+-
   // Run Parameter
@@ -3014,7 +3115,7 @@ void DSetup::ReadConfiguration()
   // -+-+-+-+-+--+-+-
   // --- closing config file:
   // -+-+-+-+-+--+-+-
-  //if(fConfigFileStream) fConfigFileStream.close();  // TAF stop here : the file will be closed in the destructor call, so I comment this line
+  fConfigBuffer.clear(); // the whole file is in memory, nothing to close
 
   /*
   Char_t    tWeightFileName[200];
@@ -3033,6 +3134,10 @@ void DSetup::ReadConfiguration()
   //fWeightFile->Close(); // JB, Sept 2008
   */
 
+  timer.Stop();
+  fTimeReadConfiguration = timer.RealTime();
+  if(DSetupDebug) printf(" - Configuration read in %.3f s\n", fTimeReadConfiguration);
+
   cout << endl << " -*-*- DSetup User Constructor DONE -*-*- " << endl;
 
 }
@@ -3056,15 +3161,108 @@ void DSetup::copy(const DSetup& a)
   // Prepare a Copy into this class
 }
 
+//______________________________________________________________________________
+//
+Bool_t DSetup::loadConfigFile()
+{
+  // Read the whole config file in memory, all the parsing methods below
+  // then work from this buffer instead of extracting characters one by one
+  // from a stream.
+  // Also compute a hash (64 bits FNV-1a) of the file content.
+  //
+  // Return kFALSE if the file cannot be read.
+
+  fConfigBuffer.clear();
+  fConfigPos = 0;
+  fConfigEof = kFALSE;
+  fConfigHash = 0;
+
+  ifstream configFile( fConfigPathAndFileName.Data(), ios::in | ios::binary);
+  if( configFile.fail() ) return kFALSE;
+
+  configFile.seekg( 0, ios::end);
+  std::streamoff fileSize = configFile.tellg();
+  configFile.seekg( 0, ios::beg);
+  if( fileSize>0 ) {
+    fConfigBuffer.resize( (size_t)fileSize);
+    configFile.read( &fConfigBuffer[0], fileSize);
+    fConfigBuffer.resize( (size_t)configFile.gcount());
+  }
+  configFile.close();
+
+  fConfigHash = 14695981039346656037ULL;
+  for( size_t i=0; i<fConfigBuffer.size(); i++) {
+    fConfigHash ^= (unsigned char)fConfigBuffer[i];
+    fConfigHash *= 1099511628211ULL;
+  }
+
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DSetup::getChar(Char_t &c)
+{
+  // Get the next character which is not a white space,
+  // as done by "stream >> c".
+  // At the end of the buffer, c is left unchanged and kFALSE is returned.
+
+  while( fConfigPos<fConfigBuffer.size() && isspace((unsigned char)fConfigBuffer[fConfigPos]) ) fConfigPos++;
+  if( fConfigPos>=fConfigBuffer.size() ) {
+    fConfigEof = kTRUE;
+    return kFALSE;
+  }
+  c = fConfigBuffer[fConfigPos++];
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+Bool_t DSetup::getNumberToken(Char_t *token, Int_t maxLength, Bool_t isFloat)
+{
+  // Copy in token the characters of the next number,
+  // following the same grammar as "stream >> number":
+  //  [sign] digits, and for float [. digits] [e [sign] digits].
+  // Return kFALSE if there is no number at the parsing position.
+
+  Int_t k = 0;
+  Int_t nDigits = 0;
+  size_t size = fConfigBuffer.size();
+
+  while( fConfigPos<size && isspace((unsigned char)fConfigBuffer[fConfigPos]) ) fConfigPos++;
+
+  if( fConfigPos<size && (fConfigBuffer[fConfigPos]=='+' || fConfigBuffer[fConfigPos]=='-') && k<maxLength-1 ) token[k++] = fConfigBuffer[fConfigPos++];
+  while( fConfigPos<size && isdigit((unsigned char)fConfigBuffer[fConfigPos]) && k<maxLength-1 ) { token[k++] = fConfigBuffer[fConfigPos++]; nDigits++; }
+  if( isFloat ) {
+    if( fConfigPos<size && fConfigBuffer[fConfigPos]=='.' && k<maxLength-1 ) {
+      token[k++] = fConfigBuffer[fConfigPos++];
+      while( fConfigPos<size && isdigit((unsigned char)fConfigBuffer[fConfigPos]) && k<maxLength-1 ) { token[k++] = fConfigBuffer[fConfigPos++]; nDigits++; }
+    }
+    if( nDigits>0 && fConfigPos<size && (fConfigBuffer[fConfigPos]=='e' || fConfigBuffer[fConfigPos]=='E') && k<maxLength-1 ) {
+      token[k++] = fConfigBuffer[fConfigPos++];
+      if( fConfigPos<size && (fConfigBuffer[fConfigPos]=='+' || fConfigBuffer[fConfigPos]=='-') && k<maxLength-1 ) token[k++] = fConfigBuffer[fConfigPos++];
+      while( fConfigPos<size && isdigit((unsigned char)fConfigBuffer[fConfigPos]) && k<maxLength-1 ) token[k++] = fConfigBuffer[fConfigPos++];
+    }
+  }
+  token[k] = '\0';
+
+  if( fConfigPos>=size ) fConfigEof = kTRUE;
+  if( nDigits==0 ) {
+    printf("WARNING in DSetup: number expected for field %s, got '%.20s'\n", fFieldName, fConfigBuffer.c_str()+fConfigPos);
+    return kFALSE;
+  }
+  return kTRUE;
+}
+
 //______________________________________________________________________________
 //
 void DSetup::nextItem(Char_t delimiter)
 {
   // Move the file parsing pointer to the character "delimiter"
 
-  Char_t c;
+  Char_t c = '\0';
   do {
-    fConfigFileStream >> c;
+    if( !getChar(c) ) break;
     if (DSetupDebug>1)  cout << c;
   } while (c != delimiter);
 }
@@ -3082,9 +3280,9 @@ void DSetup::nextField()
 
   Char_t delimiter = ':';
   Int_t k = 0;
-  Char_t c, previousC;
+  Char_t c = '\0', previousC = '\0';
   do {
-    fConfigFileStream >> c;
+    getChar(c);
     //cout << "|" << c << "|";
     if( c != '\n' && c != ' ' && c != delimiter && c != '.') {
       fFieldName[k] = c;
@@ -3102,7 +3300,7 @@ void DSetup::nextField()
       k = 0;
     }
     //cout << "k=" << k ;
-  } while (c != delimiter && !fConfigFileStream.eof() );
+  } while (c != delimiter && !configEof() );
   fFieldName[k]='\0';
   if (DSetupDebug>1)  cout << "field = " << fFieldName << endl;
 }
@@ -3114,9 +3312,10 @@ void DSetup::read_r3(DR3 &arg)
   // Modified BH 2013/08/21 memory leak removed
 
   Double_t co[3] = {0., 0., 0.}; // BH 2013/08/21
+  Char_t token[64];
   for (Int_t k = 0; k < 3; k++) {
     if( k>0 ) nextItem(':'); // already positionned for 1st value
-    fConfigFileStream >> co[k];
+    if( getNumberToken( token, 64, kTRUE) ) co[k] = atof(token);
     if (DSetupDebug>1) cout << co[k] << endl;
     arg.SetValue(co);
   }
@@ -3127,7 +3326,8 @@ void DSetup::read_r3(DR3 &arg)
 void DSetup::read_item(Int_t &arg)
 {
   //nextItem(':');
-  fConfigFileStream >> arg;
+  Char_t token[64];
+  arg = getNumberToken( token, 64, kFALSE) ? (Int_t)strtol( token, 0, 10) : 0;
   if (DSetupDebug>1){
     cout << "value = " << arg << endl;
   }
@@ -3138,7 +3338,8 @@ void DSetup::read_item(Int_t &arg)
 void DSetup::read_item(UInt_t &arg)
 {
   //nextItem(':');
-  fConfigFileStream >> arg;
+  Char_t token[64];
+  arg = getNumberToken( token, 64, kFALSE) ? (UInt_t)strtoul( token, 0, 10) : 0;
   if (DSetupDebug>1){
     printf("value =%d/%x\n",arg,arg);
    }
@@ -3152,7 +3353,8 @@ void DSetup::read_item(Float_t &arg)
   // reads values from configuration file
 
   //nextItem(':');
-  fConfigFileStream >> arg;
+  Char_t token[64];
+  arg = getNumberToken( token, 64, kTRUE) ? (Float_t)atof(token) : 0.;
   if (DSetupDebug>1) cout << "value = " << arg << endl;
 }
 
@@ -3166,16 +3368,16 @@ void DSetup::read_strings(Char_t *aString, Int_t aLength)
   // JB 2009/05/25
 
   Int_t k = 0;
-  Char_t c;
+  Char_t c = '\0';
   // First, go to the " delimiter
   //nextItem('"');
   do {
-    fConfigFileStream >> c;
+    if( !getChar(c) ) break;
     //cout << c;
   } while (c != '"');
   // Now, read the value up to the next " delimiter
   do {
-    fConfigFileStream >> c;
+    if( !getChar(c) ) break;
     //cout << c;
     if ((c != '"') && (k < aLength)) {
       aString[k] = c;
@@ -3197,16 +3399,16 @@ void DSetup::read_TStrings(TString& TheString, Int_t aLength)
   // JB 2009/05/25
 
   Int_t k = 0;
-  Char_t c;
+  Char_t c = '\0';
   // First, go to the " delimiter
   //nextItem('"');
   do {
-    fConfigFileStream >> c;
+    if( !getChar(c) ) break;
     //cout << c;
   } while (c != '"');
   // Now, read the value up to the next " delimiter
   do {
-    fConfigFileStream >> c;
+    if( !getChar(c) ) break;
     //cout << c;
     if ((c != '"') && (k < aLength)) {
       aString[k] = c;
@@ -3224,13 +3426,13 @@ void DSetup::read_TStrings(TString& TheString, Int_t aLength)
 void DSetup::getRidOfLine()
 {
 
-  // Simply get rid of all character till the line ends,
-  // line is not expected to exceeds 200 charaters.
+  // Simply get rid of all character till the line ends.
   //
   // JB, 2013/01/16
 
-  Char_t line[250];
-  fConfigFileStream.getline( line, 250);
+  while( fConfigPos<fConfigBuffer.size() && fConfigBuffer[fConfigPos]!='\n' ) fConfigPos++;
+  if( fConfigPos<fConfigBuffer.size() ) fConfigPos++; // skip the end of line
+  else fConfigEof = kTRUE;
 
 }
 //______________________________________________________________________________
@@ -4240,6 +4442,97 @@ void DSetup::PrintListOfHotPixelsToMask(int aPlaneNumber)
   return;
 
 }
+//______________________________________________________________________________
+//
+TString DSetup::hotPixelCacheFileName(int aPlaneNumber, TString HotPixelMapFile)
+{
+  // Build the name of the cache file for the hot pixel lists of a plane.
+  // The name encodes the hash of the config file (which contains the
+  //  FakeRateCut or FractionToMask values), the plane number,
+  //  and the size and modification time of the hot pixel map file,
+  //  so that any change of the inputs leads to a new computation.
+  // Return an empty string if the cache is not enabled.
+
+  if( fCacheDir.IsNull() ) return TString("");
+
+  FileStat_t mapStat;
+  Long64_t mapSize = 0;
+  Long_t   mapTime = 0;
+  if( !gSystem->GetPathInfo( HotPixelMapFile.Data(), mapStat) ) {
+    mapSize = mapStat.fSize;
+    mapTime = mapStat.fMtime;
+  }
+
+  return TString::Format( "%s/hotpixels_%016llx_pl%d_%llx_%lx.bin", fCacheDir.Data(), fConfigHash, aPlaneNumber+1, (ULong64_t)mapSize, (ULong_t)mapTime);
+}
+
+//______________________________________________________________________________
+//
+Bool_t DSetup::readHotPixelCache(int aPlaneNumber, TString HotPixelMapFile)
+{
+  // Fill the hot pixel lists of the plane from the cache file.
+  // Return kFALSE if the cache is disabled, the file is missing or corrupted,
+  //  the lists are then left empty.
+  // A list cannot hold more entries than the plane has pixels.
+
+  TString fileName = hotPixelCacheFileName( aPlaneNumber, HotPixelMapFile);
+  if( fileName.IsNull() ) return kFALSE;
+
+  ifstream cacheFile( fileName.Data(), ios::in | ios::binary);
+  if( cacheFile.fail() ) return kFALSE;
+
+  std::vector<Int_t> *lists[3] = { &pPlaneParameter[aPlaneNumber].HotPixelList_lin,
+                                   &pPlaneParameter[aPlaneNumber].HotPixelList_col,
+                                   &pPlaneParameter[aPlaneNumber].HotPixelList_index };
+  Double_t pixelsN = pPlaneParameter[aPlaneNumber].Strips(0)*pPlaneParameter[aPlaneNumber].Strips(1);
+  for( Int_t iList=0; iList<3; iList++) {
+    Int_t size = 0;
+    cacheFile.read( (char*)&size, sizeof(Int_t));
+    Bool_t ok = cacheFile.good() && size>=0 && size<=pixelsN;
+    if( ok ) {
+      lists[iList]->resize(size);
+      if( size>0 ) cacheFile.read( (char*)&(*lists[iList])[0], size*sizeof(Int_t));
+      ok = cacheFile.good();
+    }
+    if( !ok ) {
+      printf("WARNING in DSetup: corrupted hot pixel cache %s, the lists are recomputed\n", fileName.Data());
+      for( Int_t jList=0; jList<3; jList++) lists[jList]->clear();
+      return kFALSE;
+    }
+  }
+
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+void DSetup::writeHotPixelCache(int aPlaneNumber, TString HotPixelMapFile)
+{
+  // Store the hot pixel lists of the plane in the cache file,
+  // nothing is done if the cache is disabled.
+
+  TString fileName = hotPixelCacheFileName( aPlaneNumber, HotPixelMapFile);
+  if( fileName.IsNull() ) return;
+
+  gSystem->mkdir( fCacheDir.Data(), kTRUE);
+  ofstream cacheFile( fileName.Data(), ios::out | ios::binary);
+  if( cacheFile.fail() ) {
+    printf("WARNING in DSetup: cannot write cache file %s\n", fileName.Data());
+    return;
+  }
+
+  std::vector<Int_t> *lists[3] = { &pPlaneParameter[aPlaneNumber].HotPixelList_lin,
+                                   &pPlaneParameter[aPlaneNumber].HotPixelList_col,
+                                   &pPlaneParameter[aPlaneNumber].HotPixelList_index };
+  for( Int_t iList=0; iList<3; iList++) {
+    Int_t size = (Int_t)lists[iList]->size();
+    cacheFile.write( (const char*)&size, sizeof(Int_t));
+    if( size>0 ) cacheFile.write( (const char*)&(*lists[iList])[0], size*sizeof(Int_t));
+  }
+  cacheFile.close();
+
+}
+
 //______________________________________________________________________________
 //
 DSetup::~DSetup()
@@ -52,6 +52,7 @@
 //*KEND.
 #include "DTrackFitter.h"
 #include "MKalmanFilter.h"
+#include "DProfiler.h"
 
 ClassImp(DTrack) // Description of a Track
 
@@ -243,6 +244,9 @@ Bool_t DTrack::Analyze( Int_t aNumber, DHit** aHitList, Int_t nHits, Float_t res
   // Last Modified JB, 2012/05/07 Fix bug on fHitList which was properly stored
   // Last Modified JB, 2012/08/28 Allow strip-telescope track fitting again
 
+  TAF_PROFILE_SCOPE( DProfiler::kTrackFitting, 0);
+  TAF_PROFILE_COUNT( DProfiler::kTrackFitting, 0, 1);
+
   fTrackNumber = aNumber; // JB 2009/07/17
   fHits    = nHits;
   fValid   = kFALSE;
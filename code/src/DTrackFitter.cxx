@@ -17,6 +17,8 @@ DTrackFitter::DTrackFitter(Int_t trackParamNumber, Int_t hitNumber, Int_t localA
   _localAxisNumber       = localAxisNumber;
   _trackParametersNumber = trackParamNumber;
   _multipleScatteringFit = ifMultipleScattering;
+  _fitMethod             = kFitRecursive;
+  _pathSign              = 1.;
 
   _fHitList               = hitList;
   _initialTrackParameters = initialTrackParameters;
@@ -26,9 +28,9 @@ DTrackFitter::DTrackFitter(Int_t trackParamNumber, Int_t hitNumber, Int_t localA
 
   // Define Matrices :
   _derivativeTrackMatrix   = new TMatrixD(_dimResiduals, _trackParametersNumber);
-  _covarianceMatrix        = new TMatrixD(_dimResiduals, _dimResiduals);
-  _covarianceMatrixMS      = new TMatrixD(_dimResiduals, _dimResiduals);
-  _inverseCovarianceMatrix = new TMatrixD(_dimResiduals, _dimResiduals);
+  _covarianceMatrix        = 0; // see AllocateCovarianceMatrices
+  _covarianceMatrixMS      = 0;
+  _inverseCovarianceMatrix = 0;
   _finalMatrix             = new TMatrixD(_trackParametersNumber, _trackParametersNumber);
   _inverseFinalMatrix      = new TMatrixD(_trackParametersNumber, _trackParametersNumber);
 
@@ -53,9 +55,6 @@ DTrackFitter::DTrackFitter(Int_t trackParamNumber, Int_t hitNumber, Int_t localA
 DTrackFitter::~DTrackFitter()
 {
   _derivativeTrackMatrix->Zero();
-  _covarianceMatrix->Zero();
-  _covarianceMatrixMS->Zero();
-  _inverseCovarianceMatrix->Zero();
   _finalMatrix->Zero();
   _inverseFinalMatrix->Zero();
 
@@ -317,6 +316,67 @@ void DTrackFitter::ComputeResidualsMS()
   *_residualsVector += *_residualsVectorMS;
 }
 
+void DTrackFitter::AllocateCovarianceMatrices()
+{
+  // Dense covariance matrices of the kFitDense fit, set to zero.
+
+  Int_t dimResiduals = _hitNumber*_localAxisNumber;
+
+  if( _covarianceMatrix==0 ) {
+    _covarianceMatrix        = new TMatrixD(dimResiduals, dimResiduals);
+    _covarianceMatrixMS      = new TMatrixD(dimResiduals, dimResiduals);
+    _inverseCovarianceMatrix = new TMatrixD(dimResiduals, dimResiduals);
+  }
+  _covarianceMatrix->Zero();
+  _covarianceMatrixMS->Zero();
+
+  for(Int_t i=0 ; i<dimResiduals ; ++i) (*_covarianceMatrix)[i][i] = _hitVariances[i];
+
+}
+
+Bool_t DTrackFitter::ComputePathLengths()
+{
+  // Position of the track extrapolations along the initial track, from the first hit.
+  // The distances between hits used by the dense fit are the differences of these
+  //  positions, provided the hits are ordered along the track (either way).
+
+  DR3 direction( _initialTrackParameters(0), _initialTrackParameters(1), 1.);
+  direction = direction * (1./sqrt( direction.InnerProduct(direction) ));
+
+  _pathLengths.assign(_hitNumber, 0.);
+  Int_t nIncreasing = 0, nDecreasing = 0;
+
+  for(Int_t i=1 ; i<_hitNumber ; ++i) {
+    _pathLengths[i] = (_trackExtrapolation[i] - _trackExtrapolation[0]).InnerProduct(direction);
+    if( _pathLengths[i]>_pathLengths[i-1] ) nIncreasing++;
+    if( _pathLengths[i]<_pathLengths[i-1] ) nDecreasing++;
+  }
+
+  _pathSign = nDecreasing>0 ? -1. : 1.;
+  return nIncreasing==0 || nDecreasing==0;
+
+}
+
+void DTrackFitter::ComputeResidualsMSRecursive()
+{
+  // Same as ComputeResidualsMS with running sums:
+  //  Sum{ |s_i-s_k| theta_k } on k<i = sign * ( s_i Sum{theta_k} - Sum{s_k theta_k} )
+
+  Double_t sumTheta = 0., sumPathTheta = 0.;
+
+  for(Int_t i=0 ; i<_hitNumber ; ++i) {
+
+    Double_t resValue = _pathSign * ( _pathLengths[i]*sumTheta - sumPathTheta );
+    (*_residualsVectorMS)[2*i]   = resValue;
+    (*_residualsVectorMS)[2*i+1] = resValue;
+
+    sumTheta     += _thetaMS[i];
+    sumPathTheta += _pathLengths[i]*_thetaMS[i];
+  }
+
+  *_residualsVector += *_residualsVectorMS;
+}
+
 Double_t DTrackFitter::ComputeDistance(DR3 firstPlane, DR3 lastPlane)
 {
  
@@ -340,8 +400,6 @@ void DTrackFitter::ProcessHits()
 {
 
   // Set Matrices And Vectors to Zero() :
-  _covarianceMatrix->Zero();
-  _covarianceMatrixMS->Zero();
   _residualsVector->Zero();
   _residualsVectorMS->Zero();
   _derivativeTrackMatrix->Zero();
@@ -350,6 +408,7 @@ void DTrackFitter::ProcessHits()
   _trackParametersCorrections->Zero();
   _trackExtrapolation.clear();
   _thetaMS.clear();
+  _hitVariances.assign(_hitNumber*_localAxisNumber, 0.);
   _map_DPrecAlign.clear();
   _map_Planes.clear();
 
@@ -402,8 +461,8 @@ void DTrackFitter::ProcessHits()
     (*_residualsVector)[2*iterHit]   = Intersection(0)-hitPosition(0);
     (*_residualsVector)[2*iterHit+1] = Intersection(1)-hitPosition(1);
 
-    (*_covarianceMatrix)[iterHit*2][iterHit*2]     = resolutionU*resolutionU;
-    (*_covarianceMatrix)[iterHit*2+1][iterHit*2+1] = resolutionV*resolutionV;
+    _hitVariances[iterHit*2]   = resolutionU*resolutionU;
+    _hitVariances[iterHit*2+1] = resolutionV*resolutionV;
 
     (*_derivativeTrackMatrix)[2*iterHit][0] = ComputeResidualDerivative_U_AboutTrackDirectionX( iterHit, _initialTrackParameters(0), _initialTrackParameters(1), _initialTrackOrigin);
     (*_derivativeTrackMatrix)[2*iterHit][1] = ComputeResidualDerivative_U_AboutTrackDirectionY( iterHit, _initialTrackParameters(0), _initialTrackParameters(1), _initialTrackOrigin);
@@ -422,14 +481,22 @@ void DTrackFitter::ProcessHits()
 
   } // End loop on hits 
  
+  // The recursive fit needs the hits ordered along the track when there is multiple scattering,
+  //  the dense fit is used otherwise or if the recursive one fails.
+  Bool_t recursiveFit = _fitMethod==kFitRecursive && (_multipleScatteringFit==false || ComputePathLengths());
+
   if(_multipleScatteringFit==true) {
-    SetCovarianceMatrixMS(); 
-    ComputeResidualsMS();
+    if(recursiveFit) ComputeResidualsMSRecursive();
+    else ComputeResidualsMS();
   }
   
 //  _trackParameters->Print(); // Track parameters before fit  
 
-  ComputeTrackParameters();
+  if( !recursiveFit || !ComputeTrackParametersRecursive() ) {
+    AllocateCovarianceMatrices();
+    if(_multipleScatteringFit==true) SetCovarianceMatrixMS();
+    ComputeTrackParameters();
+  }
 /*
   _trackParametersCorrections->Print(); // Coorection to track parameters after track fitting
   _trackParameters->Print();            // New track parameters
@@ -467,6 +534,87 @@ void DTrackFitter::ComputeTrackParameters() //FillFinalMatrix()
   *_trackParameters += *_trackParametersCorrections;
 }
 
+Bool_t DTrackFitter::ComputeTrackParametersRecursive()
+{
+  // Same least square as ComputeTrackParameters, without the covariance matrix of the hits.
+  //
+  // For each axis (U, V), the covariance V = D + MS of the residuals along the hits is the one
+  //  of the measurements of a random walk: the state (offset, slope) starts at zero, the slope
+  //  receives a kick of variance theta_k^2 after hit k and the offset moves by slope*(s_i-s_k).
+  // A filter along the hits gives the innovations nu = L^{-1} x of any vector x and their
+  //  variances S, with V = L S L^T, so that x^T V^{-1} y = Sum{ nu_x nu_y / S }.
+  // It is run on the columns of H and on the residuals, which gives H^T V^{-1} H and
+  //  H^T V^{-1} R with a cost linear with the number of hits.
+  //
+  // Returns kFALSE if a variance S is not positive (the dense fit is then used).
+
+  const Int_t nColumns = _trackParametersNumber+1; // H columns and residuals
+  TMatrixD finalMatrix(_trackParametersNumber, _trackParametersNumber);
+  TVectorD finalVector(_trackParametersNumber);
+  std::vector<Double_t> stateOffset(nColumns), stateSlope(nColumns), innovation(nColumns);
+
+  for(Int_t axis=0 ; axis<_localAxisNumber ; ++axis) {
+
+    Double_t p00 = 0., p01 = 0., p11 = 0.; // covariance of the state
+    stateOffset.assign(nColumns, 0.);
+    stateSlope.assign(nColumns, 0.);
+
+    for(Int_t iterHit=0 ; iterHit<_hitNumber ; ++iterHit) {
+
+      Int_t row = iterHit*_localAxisNumber+axis;
+
+      // propagation from the previous hit
+      if(_multipleScatteringFit==true && iterHit>0) {
+        Double_t step = _pathLengths[iterHit]-_pathLengths[iterHit-1];
+        p00 += step*(2.*p01 + step*p11);
+        p01 += step*p11;
+        for(Int_t c=0 ; c<nColumns ; ++c) stateOffset[c] += step*stateSlope[c];
+      }
+
+      // measurement
+      Double_t variance = p00 + _hitVariances[row];
+      if( !(variance>0.) ) return kFALSE;
+
+      for(Int_t c=0 ; c<_trackParametersNumber ; ++c) innovation[c] = (*_derivativeTrackMatrix)[row][c] - stateOffset[c];
+      innovation[_trackParametersNumber] = (*_residualsVector)[row] - stateOffset[_trackParametersNumber];
+
+      for(Int_t a=0 ; a<_trackParametersNumber ; ++a) {
+        for(Int_t b=0 ; b<_trackParametersNumber ; ++b) finalMatrix[a][b] += innovation[a]*innovation[b]/variance;
+        finalVector[a] += innovation[a]*innovation[_trackParametersNumber]/variance;
+      }
+
+      Double_t gainOffset = p00/variance;
+      Double_t gainSlope  = p01/variance;
+      for(Int_t c=0 ; c<nColumns ; ++c) {
+        stateOffset[c] += gainOffset*innovation[c];
+        stateSlope[c]  += gainSlope*innovation[c];
+      }
+      p11 -= gainSlope*p01;
+      p01 -= gainOffset*p01;
+      p00 -= gainOffset*p00;
+
+      // scattering in the plane of the hit
+      if(_multipleScatteringFit==true) p11 += _thetaMS[iterHit]*_thetaMS[iterHit];
+
+    } // end loop on hits
+
+  } // end loop on axis
+
+  *_finalMatrix = finalMatrix;
+
+  TDecompLU lu(finalMatrix);
+  lu.SetTol(1e-50);
+  lu.Invert(finalMatrix);
+
+  *_inverseFinalMatrix = finalMatrix;
+
+  *_trackParametersCorrections = *_inverseFinalMatrix * finalVector;
+
+  *_trackParameters += *_trackParametersCorrections;
+
+  return kTRUE;
+}
+
 DR3 DTrackFitter::GetTrackDirections()
 {
   DR3 trackParams( (*_trackParameters)[0], (*_trackParameters)[1], 1.); 
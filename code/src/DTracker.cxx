@@ -53,6 +53,7 @@
 //*KEND.
 
 #include "TApplication.h"
+#include "TROOT.h"
 #include "Riostream.h"
 //*Keep,DTracker.
 #include "DTracker.h"
@@ -68,10 +69,13 @@
 #include "DLine.h"
 //*Keep,DHit.
 #include "DHit.h"
-#include "TMinuit.h"
 #include "DLadder.h"
 //*KEND.
 #include "DBeaster.h"
+#include "DProfiler.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 
 
@@ -86,6 +90,8 @@ DTracker::DTracker()
 // DTracker default constructor
 //  if (fgInstance) Warning("MimosaAlignAnalysis", "object already instantiated");
 //  else fgInstance = this;
+  fPlaneThreads = 0;
+  fPlanePool    = 0;
 }
 
 //______________________________________________________________________________
@@ -377,6 +383,10 @@ DTracker::DTracker(DSetup& c, DAcq& aAcq)
   fSearchHitDistance          = (Double_t)fc->GetTrackerPar().SearchHitDistance; // JB, 2009/05/25
   fSearchMoreHitDistance      = (Double_t)fc->GetTrackerPar().SearchMoreHitDistance; // VR, 2014/06/29
   fKeepUnTrackedHitsBetw2evts = fc->GetTrackerPar().KeepUnTrackedHitsBetw2evts; // VR, 2014/08/26
+  DProfiler::SetSlotsN( fPlanesN+1); // profiling per plane
+  fPlanePool = 0;
+  SetPlaneThreads( fc->GetTrackerPar().PlaneThreads);
+  if( fPlaneThreads>1 ) printf("DTracker, planes updated in parallel with %d threads\n", fPlaneThreads);
   fTrackingPlaneOrderType     = (Int_t)   fc->GetTrackerPar().TrackingPlaneOrderType;// VR, 2014/07/14
 
   if( fTracksMaximum>0 ) { // if tracking required
@@ -550,8 +560,8 @@ DTracker::DTracker(DSetup& c, DAcq& aAcq)
   // Counter of tracks over all event
   // [0]= all tracks, [i>0]=track with i planes
   // JB 2009/09/08
-  fTrackCount = new Int_t[fPlanesN];
-  for( Int_t ip=0; ip<fPlanesN; ip++ ) {
+  fTrackCount = new Int_t[fPlanesN+1]; // a track can have fPlanesN hits
+  for( Int_t ip=0; ip<fPlanesN+1; ip++ ) {
     fTrackCount[ip] = 0;
   }
   // [0]= all tracks, [i>0]= #track with plane i
@@ -622,6 +632,10 @@ DTracker::~DTracker()
   delete [] fSubTrackPlaneIds; // JB 2014/12/15
   delete [] fSubTrack;
 
+#ifdef R__USE_IMT
+  delete fPlanePool;
+#endif
+
   //if(fKalEnabled){ // QL 2016/05/26
   //  delete [] fKalTrack;
   //}
@@ -791,10 +805,12 @@ Int_t DTracker::Update()
   Int_t fOk = 0 ; // should stay at 0 if everything's OK
   Int_t fPlInit = 0 ; // to count how many planes are initialized
 
+  //============
+  UpdatePlanes(); // sequentially or in parallel, see SetPlaneThreads
+  //============
+
   for (Int_t plane = 1; plane <= fPlanesN; plane++) {
-    //============
-    fOk += (Int_t)(GetPlane(plane)->Update()); // fOK incremented if something's wrong
-    //============
+    fOk += fPlaneUpdateStatus[plane-1]; // fOK incremented if something's wrong
     // Check if the plane is initialized or not
     // also set init immediately in analysis mode >=100, JB 2009/10/02
     if( fc->GetPlanePar(plane).AnalysisMode>=100 || fc->GetPlanePar(plane).InitialNoise < fAcq->GetEventNumber()+1 ) fPlInit++; // JB 2009/05/26
@@ -804,36 +820,21 @@ Int_t DTracker::Update()
   if (fKeepUnTrackedHitsBetw2evts)// VR 2014.08.28
   {
     if(fDebugTracker) printf("\n *-*-* Mecanism for adding previous'event'untracked'hits starts *-*-* \n\n");
-    for( Int_t iPlane=0; iPlane < fPlanesN; iPlane++ )
-    {
+    for( Int_t iPlane=0; iPlane < fPlanesN; iPlane++ ) {
       DPlane *aPlane = (DPlane*)fPlaneArray->At(iPlane);
-      if(fDebugTracker) printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
 
-      // Add last'event'unstracked'hits to the current list
-      aPlane->SetHitsNewN(aPlane->GetHitsN());
-      aPlane->SetHitsOldN(aPlane->GetHitsUnTrackedLastEventN());
-      aPlane->SetHitsN   (aPlane->GetHitsNewN() + aPlane->GetHitsOldN());
-      if(fDebugTracker) printf("New hits : %d ; Old hits : %d ; Total hits : %d.\n",aPlane->GetHitsNewN(), aPlane->GetHitsOldN(), aPlane->GetHitsN());
-
-
-      if(fDebugTracker) printf("->Setting new hits as new ones : hits # ");
-      for (Int_t inewHit = 1 ; inewHit <= aPlane->GetHitsNewN() ; inewHit++)
-      {
-        aPlane->GetHit(inewHit)->SetIsFromPreviousEvent(0);
-        if(fDebugTracker) printf("%d [%p]{%.0f;%.0f;%.0f}", aPlane->GetHit(inewHit)->GetNumber(),aPlane->GetHit(inewHit),aPlane->GetHit(inewHit)->GetPositionUhit(),aPlane->GetHit(inewHit)->GetPositionVhit(),aPlane->GetHit(inewHit)->GetPositionWhit() );
-      }
-      if(fDebugTracker) printf("\n");
-
-
-      if(fDebugTracker) printf("->Adding olds hits to current list : hits # (hits memorized #) : ");
-      for (Int_t ioldHit = 1 ; ioldHit <= aPlane->GetHitsOldN() ; ioldHit++)
-      {
-        aPlane->GetHit(aPlane->GetHitsNewN() + ioldHit)->clone(aPlane->GetHitUnTrackedLastEvent(ioldHit),0);
-        //aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->SetNumber((aPlane->GetHitsNewN() + ioldHit));
-        if(fDebugTracker) printf("%d[%p]{%.0f;%.0f;%.0f} (%d[%p]{%.0f;%.0f;%.0f}) ", aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetNumber(),aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit)),aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionUhit(),aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionVhit(),aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionWhit(), aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetNumber(), aPlane->GetHitUnTrackedLastEvent(ioldHit),aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionUhit(),aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionVhit(),aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionWhit());
+      // Add last'event'unstracked'hits to the current list, without copy
+      aPlane->AddUnTrackedHitsOfLastEvent();
+      if(fDebugTracker) {
+        printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
+        printf("New hits : %d ; Old hits : %d ; Total hits : %d.\n",aPlane->GetHitsNewN(), aPlane->GetHitsOldN(), aPlane->GetHitsN());
+        printf("->Hits # (old ones with *) : ");
+        for (Int_t iHit = 1 ; iHit <= aPlane->GetHitsN() ; iHit++) {
+          DHit *aHit = aPlane->GetHit(iHit);
+          printf("%d%s[%p]{%.0f;%.0f;%.0f} ", aHit->GetNumber(), aHit->GetIsFromPreviousEvent()?"*":"", aHit, aHit->GetPositionUhit(), aHit->GetPositionVhit(), aHit->GetPositionWhit());
+        }
+        printf("\n\n");
       }
-      if(fDebugTracker) printf("\n\n");
-
     }
     if(fDebugTracker) printf("\n *-*-* Mecanism for adding previous'event'untracked'hits finished *-*-* \n\n");
   }
@@ -851,6 +852,8 @@ Int_t DTracker::Update()
       // Check if we build tracks with the strip telescope or not
       //============
 
+      { // track finding
+      TAF_PROFILE_SCOPE( DProfiler::kTrackFinding, 0);
       if( GetPlane(1)->GetAnalysisMode()==1 ) { // strip-telescope
         find_tracks_withStrips();
       }
@@ -864,7 +867,10 @@ Int_t DTracker::Update()
            find_tracks_Beast();
          }
       }
+      TAF_PROFILE_COUNT( DProfiler::kTrackFinding, 0, fTracksN);
+      } // end track finding
       if( fVertexMaximum ) { // If vertexing required, JB/LC 2013/06/11
+        TAF_PROFILE_SCOPE( DProfiler::kVertexing, 0);
         find_vertex();
         find_tracks_and_vertex();
       }
@@ -882,24 +888,8 @@ Int_t DTracker::Update()
     if(fDebugTracker) printf("\n *-*-* Mecanism for saving current'event'untracked'hits starts *-*-* \n\n");
     for( Int_t iPlane=0; iPlane < fPlanesN; iPlane++ ) {
       DPlane *aPlane = (DPlane*)fPlaneArray->At(iPlane);
-      if(fDebugTracker) printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
-
-      Int_t UnTracked = 0;
-      if(fDebugTracker) printf("->Copying untracked hits to the untrack hits memory : hits memorized # : ");
-      for (Int_t iHit = 1 ; iHit <= aPlane->GetHitsNewN() ; iHit++)
-      {
-        if (!aPlane->GetHit(iHit)->GetFound() && !aPlane->GetHit(iHit)->GetIsFromPreviousEvent())
-        {
-          aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->clone(aPlane->GetHit(iHit),0);
-          aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->SetIsFromPreviousEvent(1);
-          if(fDebugTracker) printf("%d[%p]{%.0f;%.0f;%.0f} ", aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetNumber(), aPlane->GetHitUnTrackedLastEvent(UnTracked+1),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionUhit(),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionVhit(),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionWhit());
-          UnTracked += 1;
-        }
-      }
-      if(fDebugTracker) printf("\n");
-
-      aPlane->SetHitsUnTrackedLastEventN(UnTracked);
-      if(fDebugTracker) printf("%d untracked hits memorized !\n\n",UnTracked);
+      aPlane->KeepUnTrackedHits(); // only the slots are recorded, the hits are moved when the next event starts
+      if(fDebugTracker) printf(" *** Plane %d : %s ***\n%d untracked hits memorized !\n\n",iPlane+1, aPlane->GetPlanePurpose(), aPlane->GetHitsUnTrackedLastEventN());
     }
     if(fDebugTracker) printf("\n *-*-* Mecanism for saving current'event'untracked'hits finished *-*-* \n\n");
   }
@@ -910,6 +900,74 @@ Int_t DTracker::Update()
   return fOk;
 }
 
+//______________________________________________________________________________
+//
+Int_t DTracker::UpdatePlanes( Int_t nPlanes)
+{
+  // Update (raw data, pedestal and noise, hits) the planes 1 to nPlanes,
+  //  all of them if nPlanes<0, and keep the status returned by DPlane::Update
+  //  of each plane in fPlaneUpdateStatus.
+  // Returns the number of planes with bad raw data.
+  //
+  // With the thread pool of SetPlaneThreads, the planes are updated concurrently
+  //  and all of them are finished on return. Each plane only works on its own
+  //  pixels, hits and noise maps, so the hits do not depend on the number of threads.
+
+  if( nPlanes<0 || nPlanes>fPlanesN ) nPlanes = fPlanesN;
+  fPlaneUpdateStatus.assign( fPlanesN, 0);
+
+#ifdef R__USE_IMT
+  if( fPlanePool && nPlanes>1 ) {
+    fPlanePool->Foreach( [this]( Int_t iPlane) { fPlaneUpdateStatus[iPlane] = (Int_t)GetPlane(iPlane+1)->Update(); }, ROOT::TSeqI( nPlanes));
+  }
+  else
+#endif
+  for( Int_t iPlane=0; iPlane<nPlanes; iPlane++) {
+    fPlaneUpdateStatus[iPlane] = (Int_t)GetPlane(iPlane+1)->Update();
+  }
+
+  Int_t notReady = 0;
+  for( Int_t iPlane=0; iPlane<nPlanes; iPlane++) notReady += fPlaneUpdateStatus[iPlane];
+  return notReady;
+
+}
+
+//______________________________________________________________________________
+//
+void DTracker::SetPlaneThreads( Int_t nThreads)
+{
+  // Number of threads used by UpdatePlanes, 0 or 1 for the sequential loop.
+  //
+  // The hit truth matching of MC data done in DPlane::Update uses a buffer
+  //  common to all planes (DEventMC), the planes are then kept sequential:
+  //  use TruthMatching 2 and DoTruthMatching to update them in parallel.
+  //
+  // DPlane::Update uses ROOT objects (random generators, histograms),
+  //  the ROOT thread safety is enabled before the pool is started.
+
+#ifdef R__USE_IMT
+  delete fPlanePool;
+#endif
+  fPlanePool = 0;
+  fPlaneThreads = nThreads>1 ? nThreads : 0;
+
+  if( fPlaneThreads>1 && MCInfoHolder!=NULL && fc->GetTrackerPar().TruthMatching==1 ) {
+    cout << "WARNING: DTracker, hits truth matched during the plane update (TruthMatching 1), planes updated sequentially." << endl;
+    fPlaneThreads = 0;
+  }
+
+  if( fPlaneThreads>1 ) {
+#ifdef R__USE_IMT
+    ROOT::EnableThreadSafety();
+    fPlanePool = new ROOT::TThreadExecutor( fPlaneThreads);
+#else
+    cout << "WARNING: DTracker, ROOT was built without implicit multi-threading, planes updated sequentially." << endl;
+    fPlaneThreads = 0;
+#endif
+  }
+
+}
+
 //______________________________________________________________________________
 //
 Int_t DTracker::UpdateMC()
@@ -935,47 +993,21 @@ Int_t DTracker::UpdateMC()
 
   if(fKeepUnTrackedHitsBetw2evts){ // VR 2014.08.28
     if(fDebugTracker) printf("\n *-*-* Mecanism for adding previous'event'untracked'hits starts *-*-* \n\n");
-    for(Int_t iPlane=0; iPlane < fPlanesN; iPlane++ ) {
+    for( Int_t iPlane=0; iPlane < fPlanesN; iPlane++ ) {
       DPlane *aPlane = (DPlane*)fPlaneArray->At(iPlane);
-      if(fDebugTracker) printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
-
-      // Add last'event'unstracked'hits to the current list
-      aPlane->SetHitsNewN(aPlane->GetHitsN());
-      aPlane->SetHitsOldN(aPlane->GetHitsUnTrackedLastEventN());
-      aPlane->SetHitsN   (aPlane->GetHitsNewN() + aPlane->GetHitsOldN());
-      if(fDebugTracker) printf("New hits : %d ; Old hits : %d ; Total hits : %d.\n",aPlane->GetHitsNewN(), aPlane->GetHitsOldN(), aPlane->GetHitsN());
-
-
-      if(fDebugTracker) printf("->Setting new hits as new ones : hits # ");
-      for (Int_t inewHit = 1 ; inewHit <= aPlane->GetHitsNewN() ; inewHit++) {
-        aPlane->GetHit(inewHit)->SetIsFromPreviousEvent(0);
-        if(fDebugTracker) printf("%d [%p]{%.0f;%.0f;%.0f}",
-				 aPlane->GetHit(inewHit)->GetNumber(),
-				 aPlane->GetHit(inewHit),
-				 aPlane->GetHit(inewHit)->GetPositionUhit(),
-				 aPlane->GetHit(inewHit)->GetPositionVhit(),
-				 aPlane->GetHit(inewHit)->GetPositionWhit());
-      }
-      if(fDebugTracker) printf("\n");
-
-
-      if(fDebugTracker) printf("->Adding olds hits to current list : hits # (hits memorized #) : ");
-      for (Int_t ioldHit = 1 ; ioldHit <= aPlane->GetHitsOldN() ; ioldHit++) {
-        aPlane->GetHit(aPlane->GetHitsNewN() + ioldHit)->clone(aPlane->GetHitUnTrackedLastEvent(ioldHit),0);
-        if(fDebugTracker) printf("%d[%p]{%.0f;%.0f;%.0f} (%d[%p]{%.0f;%.0f;%.0f}) ",
-				 aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetNumber(),
-				 aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit)),
-				 aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionUhit(),
-				 aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionVhit(),
-				 aPlane->GetHit((aPlane->GetHitsNewN() + ioldHit))->GetPositionWhit(),
-				 aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetNumber(),
-				 aPlane->GetHitUnTrackedLastEvent(ioldHit),
-				 aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionUhit(),
-				 aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionVhit(),
-				 aPlane->GetHitUnTrackedLastEvent(ioldHit)->GetPositionWhit());
-      }
-      if(fDebugTracker) printf("\n\n");
 
+      // Add last'event'unstracked'hits to the current list, without copy
+      aPlane->AddUnTrackedHitsOfLastEvent();
+      if(fDebugTracker) {
+        printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
+        printf("New hits : %d ; Old hits : %d ; Total hits : %d.\n",aPlane->GetHitsNewN(), aPlane->GetHitsOldN(), aPlane->GetHitsN());
+        printf("->Hits # (old ones with *) : ");
+        for (Int_t iHit = 1 ; iHit <= aPlane->GetHitsN() ; iHit++) {
+          DHit *aHit = aPlane->GetHit(iHit);
+          printf("%d%s[%p]{%.0f;%.0f;%.0f} ", aHit->GetNumber(), aHit->GetIsFromPreviousEvent()?"*":"", aHit, aHit->GetPositionUhit(), aHit->GetPositionVhit(), aHit->GetPositionWhit());
+        }
+        printf("\n\n");
+      }
     }
     if(fDebugTracker) printf("\n *-*-* Mecanism for adding previous'event'untracked'hits finished *-*-* \n\n");
   }
@@ -1032,22 +1064,8 @@ Int_t DTracker::UpdateMC()
     if(fDebugTracker) printf("\n *-*-* Mecanism for saving current'event'untracked'hits starts *-*-* \n\n");
     for( Int_t iPlane=0; iPlane < fPlanesN; iPlane++ ) {
       DPlane *aPlane = (DPlane*)fPlaneArray->At(iPlane);
-      if(fDebugTracker) printf(" *** Plane %d : %s ***\n",iPlane+1, aPlane->GetPlanePurpose() );
-
-      Int_t UnTracked = 0;
-      if(fDebugTracker) printf("->Copying untracked hits to the untrack hits memory : hits memorized # : ");
-      for (Int_t iHit = 1 ; iHit <= aPlane->GetHitsNewN() ; iHit++) {
-        if (!aPlane->GetHit(iHit)->GetFound() && !aPlane->GetHit(iHit)->GetIsFromPreviousEvent()) {
-          aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->clone(aPlane->GetHit(iHit),0);
-          aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->SetIsFromPreviousEvent(1);
-          if(fDebugTracker) printf("%d[%p]{%.0f;%.0f;%.0f} ", aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetNumber(), aPlane->GetHitUnTrackedLastEvent(UnTracked+1),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionUhit(),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionVhit(),aPlane->GetHitUnTrackedLastEvent(UnTracked+1)->GetPositionWhit());
-          UnTracked += 1;
-        }
-      }
-      if(fDebugTracker) printf("\n");
-
-      aPlane->SetHitsUnTrackedLastEventN(UnTracked);
-      if(fDebugTracker) printf("%d untracked hits memorized !\n\n",UnTracked);
+      aPlane->KeepUnTrackedHits(); // only the slots are recorded, the hits are moved when the next event starts
+      if(fDebugTracker) printf(" *** Plane %d : %s ***\n%d untracked hits memorized !\n\n",iPlane+1, aPlane->GetPlanePurpose(), aPlane->GetHitsUnTrackedLastEventN());
     }
     if(fDebugTracker) printf("\n *-*-* Mecanism for saving current'event'untracked'hits finished *-*-* \n\n");
   }
@@ -2711,6 +2729,9 @@ void DTracker::MakeKalTrack( DTrack *aTrack, DHit** aHitList, Int_t nHits) {
   //
   // Created QL 2016/05/26
 
+  TAF_PROFILE_SCOPE( DProfiler::kTrackFitting, 0);
+  TAF_PROFILE_COUNT( DProfiler::kTrackFitting, 0, 1);
+
   if( fDebugTracker) printf("DTracker::MakeKalTrack for track %d from %d hits.\n", aTrack->GetNumber(), nHits);
 
   string particle       = fc->GetTrackerPar().BeamType.Data();
@@ -3064,6 +3085,9 @@ void DTracker::MakeLeastChi2Track( DTrack *aTrack, DHit** aHitList, Int_t nHits)
   //
   // Created QL 2016/06/08
 
+  TAF_PROFILE_SCOPE( DProfiler::kTrackFitting, 0);
+  TAF_PROFILE_COUNT( DProfiler::kTrackFitting, 0, 1);
+
   if( fDebugTracker) printf("DTracker::MakeLeastChi2Track for track %d from %d hits.\n", aTrack->GetNumber(), nHits);
 
   string particle       = fc->GetTrackerPar().BeamType.Data();
@@ -3311,6 +3335,18 @@ DTrack* DTracker::nearest_track( DHit *aHit){
 }
 //_____________________________________________________________________________
 //
+void DTracker::ResetStatistics() {
+  // Reset the track counters printed by PrintStatistics
+
+  for( Int_t ip=0; ip<fPlanesN+1; ip++ ) {
+    fTrackCount[ip] = 0;
+    fTrackCountPerPlane[ip] = 0;
+  }
+
+}
+
+//______________________________________________________________________________
+//
 void DTracker::PrintStatistics(ostream &stream) {
   // SS 2011/12/14 - Save statistics to the chosen output stream
   // Modified JB 2014/08/29
@@ -3345,120 +3381,41 @@ void DTracker::PrintStatistics(ostream &stream) {
 }
 //_____________________________________________________________________________
 //
-void FCNAlignVertex(Int_t &n, Double_t *gin, Double_t &f, Double_t *par , Int_t iflag)
+void DTracker::find_vertex()
 {
-  // static fcn wrapper for Minuit
 
-  DTracker::Instance()->fcn(n,gin,f,par,iflag);
-  //fgInstance->fcn(n,gin,f,par,iflag);
+  // Common vertex of the tracks of the event, set to each track.
+  // The fit is done by fVertexFitter (closed-form least squares on the
+  //  distances to the tracks, see DVertexFitter for why it replaced the
+  //  former Minuit function), the fit method and settings can be changed
+  //  through GetVertexFitter().
+  // With a single track, the vertex is a point of the track.
 
-}
-//_____________________________________________________________________________
-//
-void DTracker::fcn(Int_t &npar, Double_t *gin, Double_t &fValue, Double_t *x, Int_t iflag)
-{
+  fVertexFitter.Clear();
+  fVertexFitter.SetResolution( fc->GetTrackerPar().Resolution);
 
   DTrack* aTrack;
-  fValue = 0;
-  Double_t chi2 = 0.0;
-
-  //std::cout<<"fcn function 0"<<endl;
 
   for (Int_t tr = 0; tr<fTracksN; tr++) {
-
-    //std::cout<<"fTracksN = "<<fTracksN<<endl;
-
     aTrack =  fTrack[tr];
-
-    Double_t xp = aTrack->GetLinearFit().GetOrigin()(0);
-    Double_t yp = aTrack->GetLinearFit().GetOrigin()(1);
-    Double_t zp = aTrack->GetLinearFit().GetOrigin()(2);
-
-    Double_t xi = x[0];
-    Double_t yi = x[1];
-    Double_t zi = x[2];
-
-    Double_t ux = aTrack->GetLinearFit().GetSlopeZ()(0);
-    Double_t uy = aTrack->GetLinearFit().GetSlopeZ()(1);
-    Double_t uz = aTrack->GetLinearFit().GetSlopeZ()(2);
-
-    Double_t sigmaXi = 3.5;  // Resolution for X axis.
-    Double_t sigmaYi = 3.5;  // Resolution for Y axis.
-    Double_t sigmaZi = 50.0;  // Resolution for Z axis.
-
-    Double_t sigmaUx = 0.05;
-    Double_t sigmaUy = 0.05;
-    Double_t sigmaUz = 0.05;
-
-    Double_t di2 = (xi-xp)*(xi-xp) + (yi-yp)*(yi-yp) + (zi-zp)*(zi-zp) - ( ((xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz) * ((xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz) );
-
-    Double_t incertXi = ( (1-ux*ux)*(xi-xp) - (yi-yp)*uy*ux - (zi-zp)*uz*ux ) * ( (1-ux*ux)*(xi-xp) - (yi-yp)*uy*ux - (zi-zp)*uz*ux ) * sigmaXi * sigmaXi / (4.0*di2);
-    Double_t incertYi = ( (1-uy*uy)*(yi-yp) - (xi-xp)*uy*ux - (zi-zp)*uy*ux ) * ( (1-uy*uy)*(yi-yp) - (xi-xp)*uy*ux - (zi-zp)*uz*uy ) * sigmaYi * sigmaYi / (4.0*di2);
-    Double_t incertZi = ( (1-uz*uz)*(zi-zp) - (xi-xp)*uz*ux - (yi-yp)*uy*uz ) * ( (1-uz*uz)*(zi-zp) - (xi-xp)*ux*uz - (yi-yp)*uz*uy ) * sigmaZi * sigmaZi / (4.0*di2);
-
-    Double_t incertUx = ( (xi-xp)*( 2*(xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz ) ) * ( (xi-xp)*( 2*(xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz ) ) * sigmaUx * sigmaUx / (4.0*di2);
-    Double_t incertUy = ( (yi-yp)*( 2*(yi-yp)*uy + (xi-xp)*ux + (zi-zp)*uz ) ) * ( (yi-yp)*( 2*(yi-yp)*uy + (xi-xp)*ux + (zi-zp)*uz ) ) * sigmaUy * sigmaUy / (4.0*di2);
-    Double_t incertUz = ( (zi-zp)*( 2*(zi-zp)*uz + (xi-xp)*ux + (yi-yp)*uy ) ) * ( (zi-zp)*( 2*(zi-zp)*uz + (xi-xp)*ux + (yi-yp)*uy ) ) * sigmaUz * sigmaUz / (4.0*di2);
-
-    if( (incertXi + incertYi + incertZi + incertUx + incertUy + incertUz) != 0) chi2 += di2/( incertXi + incertYi + incertZi + incertUx + incertUy + incertUz );
-    else chi2 = di2;
-    //std::cout<<"chi2 = "<<chi2<<std::endl;
-
+    DR3 &origin = aTrack->GetLinearFit().GetOrigin();
+    DR3 &slope  = aTrack->GetLinearFit().GetSlopeZ();
+    fVertexFitter.AddTrack( origin(0), origin(1), origin(2), slope(0), slope(1));
   }
 
-  fValue = chi2;
-  //std::cout<<" chi2 = "<< chi2 <<std::endl;
-}
-//_____________________________________________________________________________
-//
-void DTracker::find_vertex()
-{
-
-  TMinuit* fit = new TMinuit(3);
-  fit->SetPrintLevel(-1);
-  fit->SetFCN(FCNAlignVertex);
-
-  Double_t arglist[3];
-  Int_t ierflg = 0;
-  //fit->mnhelp();
-
-  arglist[0] = 1;
-  fit->mnexcm("SET ERR", arglist , 1, ierflg);
-  arglist[0] = 2;
-  fit->mnexcm("SET STRATEGY ", arglist, 1, ierflg); // JB 2012/09/05
-
-  Double_t vstart[3] = {0.0, 0.0, 0.0};
-
-  static Double_t step[3] = {0.01, 0.01, 0.01};
-  fit->mnparm(0, "x", vstart[0], step[0], 0,0,ierflg);
-  fit->mnparm(1, "y", vstart[1], step[1], 0,0,ierflg);
-  fit->mnparm(2, "z", vstart[2], step[2], 0,0,ierflg);
-
-  // Now ready for minimization step
-  arglist[0] = 500;
-  arglist[1] = 1.;
-  gMinuit->mnexcm("MIGRAD", arglist, 2, ierflg);
-
-  Double_t outPar[3];
-  Double_t err[3];
-
-  for (Int_t i=0; i<3; ++i) {
-    fit->GetParameter(i,outPar[i],err[i]);
-
-  }
-
-  DTrack* aTrack;
+  fVertexFitter.Fit();
 
   for (Int_t tr = 0; tr<fTracksN; tr++) {
     aTrack =  fTrack[tr];
-    aTrack->SetVertex(outPar[0], outPar[1], outPar[2]);
+    aTrack->SetVertex( fVertexFitter.GetX(), fVertexFitter.GetY(), fVertexFitter.GetZ());
   }
 
   if( fDebugTracker) {
     std::cout<<"//--- Vertex coordinate -------------------------//"<<std::endl;
-    std::cout<<" x = "<<outPar[0]<<std::endl;
-    std::cout<<" y = "<<outPar[1]<<std::endl;
-    std::cout<<" z = "<<outPar[2]<<std::endl;
+    std::cout<<" x = "<<fVertexFitter.GetX()<<" +/- "<<sqrt(fVertexFitter.GetCovariance(0,0))<<std::endl;
+    std::cout<<" y = "<<fVertexFitter.GetY()<<" +/- "<<sqrt(fVertexFitter.GetCovariance(1,1))<<std::endl;
+    std::cout<<" z = "<<fVertexFitter.GetZ()<<" +/- "<<sqrt(fVertexFitter.GetCovariance(2,2))<<std::endl;
+    std::cout<<" from "<<fTracksN<<" tracks, chi2 = "<<fVertexFitter.GetChi2()<<", "<<fVertexFitter.GetIterations()<<" iterations, valid = "<<fVertexFitter.IsValid()<<std::endl;
     std::cout<<"//-----------------------------------------------//"<<std::endl;
   }
 
@@ -3469,16 +3426,33 @@ void   DTracker::MCTracksTruthMatching(void)
 {
   //AP 2016/08/08: Function to perform the truth matching of the reconstructed tracks
 
-  for(int itrk=0;itrk<fTracksN;itrk++) {
-    int MCPartID, NHitsMCPartID;
-    MCInfoHolder->DoTrackTruthMatching(fTrack[itrk],MCPartID,NHitsMCPartID);
-
-    fTrack[itrk]->SetMCPartID(MCPartID);
-    fTrack[itrk]->SetHitsFromMCPartID(NHitsMCPartID);
-  }
+  MCInfoHolder->DoTracksTruthMatching(fTracksN, fTrack);
 
   return;
 
+}
+//_____________________________________________________________________________
+//
+void   DTracker::DoTruthMatching(void)
+{
+  // Truth matching of the hits of all the planes and of the tracks
+  // of the current event.
+  //
+  // When TruthMatching is set to 2 in the config file, the matching is not done
+  // during the reconstruction (DPlane::Update), so that the reconstruction
+  // throughput is not affected. Then call this method after the event is
+  // reconstructed when truth information is required, for instance:
+  //   gTAF->GetSession()->NextRawEvent();
+  //   gTAF->GetSession()->GetTracker()->DoTruthMatching();
+
+  if( MCInfoHolder==NULL ) return;
+
+  for( Int_t iPlane=1; iPlane<=fPlanesN; iPlane++) {
+    if( GetPlane(iPlane)->GetReadout()<=0 ) continue;
+    GetPlane(iPlane)->MCHitsTruthMatching();
+  }
+  MCTracksTruthMatching();
+
 }
 //_____________________________________________________________________________
 //
@@ -0,0 +1,365 @@
+// @(#)maf/dtools:$Name:  $:$Id: DVertexFitter.cxx  v.1 $
+
+  ////////////////////////////////////////////////////////////
+  // Class Description of DVertexFitter                     //
+  //                                                        //
+  // Finds the point closest to a set of straight tracks.   //
+  //                                                        //
+  // The default method (kVertexFitAnalytic) is a weighted //
+  //  linear least squares on the perpendicular distances   //
+  //  of the vertex to the tracks, solved in closed form    //
+  //  (3x3), iterated to down-weight the outlier tracks.    //
+  //  It needs no static state and fits can run in          //
+  //  parallel, one DVertexFitter per thread.               //
+  //                                                        //
+  // The former Minuit minimisation of                      //
+  //  DTracker::find_vertex (kVertexFitMinuit) is kept for  //
+  //  comparison only, see macros/VertexFitBenchmark.C.     //
+  //  Its function is not a distance: with the slopes       //
+  //  (sx,sy,1) instead of a unit vector, d^2 = |D|^2 -     //
+  //  (D.u)^2 is negative on the track itself, and its      //
+  //  error terms grow like d^2 so that the chi2 decreases  //
+  //  towards zero far from the tracks. It has no minimum   //
+  //  at the vertex and its result depends on where MIGRAD  //
+  //  stops; the analytic fit does not reproduce it.        //
+  //  It goes through a static instance and is not thread  //
+  //  safe.                                                 //
+  //                                                        //
+  // Nothing is allocated per fit: the track list keeps     //
+  //  its capacity and the TMinuit object is reused.        //
+  //                                                        //
+  ////////////////////////////////////////////////////////////
+
+#include "DVertexFitter.h"
+#include "TMinuit.h"
+#include <math.h>
+
+ClassImp(DVertexFitter)
+
+DVertexFitter* DVertexFitter::fgInstance = 0;
+
+//_____________________________________________________________________________
+//
+static void FCNVertexFitter(Int_t &n, Double_t *gin, Double_t &f, Double_t *par, Int_t iflag)
+{
+  // static fcn wrapper for Minuit
+
+  DVertexFitter::Instance()->MinuitFcn( n, gin, f, par, iflag);
+
+}
+
+//_____________________________________________________________________________
+//
+DVertexFitter::DVertexFitter()
+{
+
+  fFitMethod          = kVertexFitAnalytic;
+  fPositionResolution = 3.5;
+  fSlopeResolution    = 0.;
+  fOutlierCut         = 3.;
+  fMaxIterations      = 10;
+  fMinuit             = 0;
+  fTracks.reserve( 32);
+  Clear();
+
+}
+
+//_____________________________________________________________________________
+//
+DVertexFitter::~DVertexFitter()
+{
+
+  delete fMinuit;
+  if( fgInstance==this ) fgInstance = 0;
+
+}
+
+//_____________________________________________________________________________
+//
+void DVertexFitter::Clear( Option_t *)
+{
+
+  // Remove the tracks and reset the results.
+
+  fTracks.clear();
+  fValid      = kFALSE;
+  fChi2       = 0.;
+  fIterations = 0;
+  for( Int_t i=0; i<3; i++) {
+    fVertex[i] = 0.;
+    for( Int_t j=0; j<3; j++) fCovariance[i][j] = 0.;
+  }
+
+}
+
+//_____________________________________________________________________________
+//
+void DVertexFitter::AddTrack( Double_t x0, Double_t y0, Double_t z0, Double_t slopeX, Double_t slopeY)
+{
+
+  Track_t aTrack;
+  aTrack.origin[0] = x0;
+  aTrack.origin[1] = y0;
+  aTrack.origin[2] = z0;
+  aTrack.slope[0]  = slopeX;
+  aTrack.slope[1]  = slopeY;
+  aTrack.slope[2]  = 1.;
+  Double_t norm = sqrt( 1. + slopeX*slopeX + slopeY*slopeY);
+  for( Int_t i=0; i<3; i++) aTrack.direction[i] = aTrack.slope[i]/norm;
+  aTrack.weight = 1.;
+  fTracks.push_back( aTrack);
+
+}
+
+//_____________________________________________________________________________
+//
+Double_t DVertexFitter::Distance2( const Track_t &aTrack, const Double_t *aPoint, Double_t &along) const
+{
+
+  // Square of the distance from aPoint to the track,
+  //  along is the position of the closest point on the track from its origin.
+
+  Double_t d[3];
+  for( Int_t i=0; i<3; i++) d[i] = aPoint[i] - aTrack.origin[i];
+  along = d[0]*aTrack.direction[0] + d[1]*aTrack.direction[1] + d[2]*aTrack.direction[2];
+  Double_t distance2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2] - along*along;
+  return distance2>0. ? distance2 : 0.;
+
+}
+
+//_____________________________________________________________________________
+//
+Double_t DVertexFitter::GetTrackDistance( Int_t iTrack) const
+{
+
+  Double_t along;
+  return sqrt( Distance2( fTracks[iTrack], fVertex, along));
+
+}
+
+//_____________________________________________________________________________
+//
+Bool_t DVertexFitter::Fit()
+{
+
+  if( fFitMethod==kVertexFitMinuit ) return FitMinuit();
+  return FitAnalytic();
+
+}
+
+//_____________________________________________________________________________
+//
+Bool_t DVertexFitter::FitAnalytic()
+{
+
+  // The vertex V minimises
+  //   chi2 = sum_i w_i |M_i (V - A_i)|^2 / s_i^2,   M_i = 1 - n_i n_i^T,
+  //  with A_i and n_i the origin and unit direction of track i,
+  //  M_i projects on the plane transverse to the track.
+  // Thus (sum_i w_i M_i / s_i^2) V = sum_i w_i M_i A_i / s_i^2,
+  //  solved with the inverse of the 3x3 symmetric matrix, which is also
+  //  the covariance matrix of V.
+  //
+  // The resolution s_i^2 = fPositionResolution^2 + (fSlopeResolution*L_i)^2,
+  //  L_i the distance from A_i to the vertex along the track,
+  //  and the down-weighting w_i = min( 1, (fOutlierCut*s_i/d_i)^2 ), d_i the distance to the vertex,
+  //  depend on V: the system is solved again until V moves by less than 1.e-3,
+  //  at most fMaxIterations times.
+  //
+  // The covariance is exact for gaussian track errors given by s_i: the pulls
+  //  of the vertex are compatible with 1 in macros/VertexFitBenchmark.C.
+  //
+  // Returns false if there are less than 2 tracks or if they are parallel.
+  // With a single track, the vertex is the point of the track closest to (0,0,0),
+  //  as found by the former Minuit fit which starts there.
+
+  fValid      = kFALSE;
+  fChi2       = 0.;
+  fIterations = 0;
+  Int_t nTracks = (Int_t)fTracks.size();
+  if( nTracks==1 ) {
+    Double_t along;
+    Double_t start[3] = { 0., 0., 0. };
+    Distance2( fTracks[0], start, along);
+    for( Int_t i=0; i<3; i++) fVertex[i] = fTracks[0].origin[i] + along*fTracks[0].direction[i];
+  }
+  if( nTracks<2 ) return kFALSE;
+
+  for( Int_t iTrack=0; iTrack<nTracks; iTrack++) fTracks[iTrack].weight = 1.;
+  Double_t sigma2Position = fPositionResolution>0. ? fPositionResolution*fPositionResolution : 1.;
+  Double_t sigma2Slope    = fSlopeResolution*fSlopeResolution;
+  Bool_t   iterate        = fOutlierCut>0. || sigma2Slope>0.;
+
+  Double_t along;
+  while( fIterations<fMaxIterations ) {
+
+    // normal equations, symmetric matrix stored as xx, xy, xz, yy, yz, zz
+    Double_t a[6] = { 0., 0., 0., 0., 0., 0. };
+    Double_t b[3] = { 0., 0., 0. };
+    for( Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+      const Track_t &aTrack = fTracks[iTrack];
+      Double_t sigma2 = sigma2Position;
+      if( fIterations>0 && sigma2Slope>0. ) {
+        Distance2( aTrack, fVertex, along);
+        sigma2 += sigma2Slope*along*along;
+      }
+      Double_t w = aTrack.weight/sigma2;
+      const Double_t *n = aTrack.direction;
+      Double_t mxx = 1.-n[0]*n[0], mxy = -n[0]*n[1], mxz = -n[0]*n[2];
+      Double_t myy = 1.-n[1]*n[1], myz = -n[1]*n[2], mzz = 1.-n[2]*n[2];
+      const Double_t *o = aTrack.origin;
+      a[0] += w*mxx; a[1] += w*mxy; a[2] += w*mxz;
+      a[3] += w*myy; a[4] += w*myz; a[5] += w*mzz;
+      b[0] += w*( mxx*o[0] + mxy*o[1] + mxz*o[2] );
+      b[1] += w*( mxy*o[0] + myy*o[1] + myz*o[2] );
+      b[2] += w*( mxz*o[0] + myz*o[1] + mzz*o[2] );
+    }
+
+    // inverse by cofactors
+    Double_t cxx = a[3]*a[5] - a[4]*a[4];
+    Double_t cxy = a[2]*a[4] - a[1]*a[5];
+    Double_t cxz = a[1]*a[4] - a[2]*a[3];
+    Double_t cyy = a[0]*a[5] - a[2]*a[2];
+    Double_t cyz = a[1]*a[2] - a[0]*a[4];
+    Double_t czz = a[0]*a[3] - a[1]*a[1];
+    Double_t det   = a[0]*cxx + a[1]*cxy + a[2]*cxz;
+    Double_t scale = ( a[0] + a[3] + a[5] )/3.;
+    if( !(fabs(det) > 1.e-9*scale*scale*scale) ) return kFALSE; // parallel tracks
+
+    fCovariance[0][0] = cxx/det; fCovariance[0][1] = cxy/det; fCovariance[0][2] = cxz/det;
+    fCovariance[1][1] = cyy/det; fCovariance[1][2] = cyz/det; fCovariance[2][2] = czz/det;
+    fCovariance[1][0] = fCovariance[0][1];
+    fCovariance[2][0] = fCovariance[0][2];
+    fCovariance[2][1] = fCovariance[1][2];
+
+    Double_t shift2 = 0.;
+    for( Int_t i=0; i<3; i++) {
+      Double_t v = fCovariance[i][0]*b[0] + fCovariance[i][1]*b[1] + fCovariance[i][2]*b[2];
+      shift2 += (v-fVertex[i])*(v-fVertex[i]);
+      fVertex[i] = v;
+    }
+    fIterations++;
+
+    // chi2 with the weights used, then new weights
+    fChi2 = 0.;
+    for( Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+      Track_t &aTrack = fTracks[iTrack];
+      Double_t distance2 = Distance2( aTrack, fVertex, along);
+      Double_t sigma2 = sigma2Position + sigma2Slope*along*along;
+      fChi2 += aTrack.weight*distance2/sigma2;
+      if( fOutlierCut>0. ) {
+        Double_t r = sqrt( distance2/sigma2);
+        aTrack.weight = r>fOutlierCut ? fOutlierCut*fOutlierCut/(r*r) : 1.;
+      }
+    }
+
+    if( !iterate || (fIterations>1 && shift2<1.e-6) ) break;
+  }
+
+  fValid = kTRUE;
+  return kTRUE;
+
+}
+
+//_____________________________________________________________________________
+//
+Bool_t DVertexFitter::FitMinuit()
+{
+
+  // Minimisation by Minuit of the function formerly used by DTracker::find_vertex,
+  //  kept for comparison (see the class description), not thread safe.
+
+  fValid      = kFALSE;
+  fChi2       = 0.;
+  fIterations = 0;
+  if( fTracks.empty() ) return kFALSE;
+
+  Double_t arglist[3];
+  Int_t ierflg = 0;
+
+  if( fMinuit==0 ) {
+    fMinuit = new TMinuit(3);
+    fMinuit->SetPrintLevel(-1);
+    fMinuit->SetFCN(FCNVertexFitter);
+    arglist[0] = 1;
+    fMinuit->mnexcm("SET ERR", arglist , 1, ierflg);
+    arglist[0] = 2;
+    fMinuit->mnexcm("SET STRATEGY ", arglist, 1, ierflg);
+  }
+  fgInstance = this;
+
+  Double_t step = 0.01;
+  fMinuit->mnparm(0, "x", 0., step, 0,0,ierflg);
+  fMinuit->mnparm(1, "y", 0., step, 0,0,ierflg);
+  fMinuit->mnparm(2, "z", 0., step, 0,0,ierflg);
+
+  arglist[0] = 500;
+  arglist[1] = 1.;
+  fMinuit->mnexcm("MIGRAD", arglist, 2, ierflg);
+
+  Double_t err;
+  for( Int_t i=0; i<3; i++) fMinuit->GetParameter( i, fVertex[i], err);
+  Double_t matrix[3][3];
+  fMinuit->mnemat( &matrix[0][0], 3);
+  for( Int_t i=0; i<3; i++) for( Int_t j=0; j<3; j++) fCovariance[i][j] = matrix[i][j];
+
+  Double_t edm, errdef;
+  Int_t nvpar, nparx, icstat;
+  fMinuit->mnstat( fChi2, edm, errdef, nvpar, nparx, icstat);
+  fIterations = fMinuit->fNfcn;
+
+  fValid = ierflg==0;
+  return fValid;
+
+}
+
+//_____________________________________________________________________________
+//
+void DVertexFitter::MinuitFcn(Int_t &npar, Double_t *gin, Double_t &fValue, Double_t *x, Int_t iflag)
+{
+
+  // Function minimised by FitMinuit, formerly DTracker::fcn (LC 2012/12/13).
+
+  fValue = 0;
+  Double_t chi2 = 0.0;
+
+  Double_t sigmaXi = 3.5;  // Resolution for X axis.
+  Double_t sigmaYi = 3.5;  // Resolution for Y axis.
+  Double_t sigmaZi = 50.0;  // Resolution for Z axis.
+
+  Double_t sigmaUx = 0.05;
+  Double_t sigmaUy = 0.05;
+  Double_t sigmaUz = 0.05;
+
+  for (Int_t tr = 0; tr<(Int_t)fTracks.size(); tr++) {
+
+    Double_t xp = fTracks[tr].origin[0];
+    Double_t yp = fTracks[tr].origin[1];
+    Double_t zp = fTracks[tr].origin[2];
+
+    Double_t xi = x[0];
+    Double_t yi = x[1];
+    Double_t zi = x[2];
+
+    Double_t ux = fTracks[tr].slope[0];
+    Double_t uy = fTracks[tr].slope[1];
+    Double_t uz = fTracks[tr].slope[2];
+
+    Double_t di2 = (xi-xp)*(xi-xp) + (yi-yp)*(yi-yp) + (zi-zp)*(zi-zp) - ( ((xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz) * ((xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz) );
+
+    Double_t incertXi = ( (1-ux*ux)*(xi-xp) - (yi-yp)*uy*ux - (zi-zp)*uz*ux ) * ( (1-ux*ux)*(xi-xp) - (yi-yp)*uy*ux - (zi-zp)*uz*ux ) * sigmaXi * sigmaXi / (4.0*di2);
+    Double_t incertYi = ( (1-uy*uy)*(yi-yp) - (xi-xp)*uy*ux - (zi-zp)*uy*ux ) * ( (1-uy*uy)*(yi-yp) - (xi-xp)*uy*ux - (zi-zp)*uz*uy ) * sigmaYi * sigmaYi / (4.0*di2);
+    Double_t incertZi = ( (1-uz*uz)*(zi-zp) - (xi-xp)*uz*ux - (yi-yp)*uy*uz ) * ( (1-uz*uz)*(zi-zp) - (xi-xp)*ux*uz - (yi-yp)*uz*uy ) * sigmaZi * sigmaZi / (4.0*di2);
+
+    Double_t incertUx = ( (xi-xp)*( 2*(xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz ) ) * ( (xi-xp)*( 2*(xi-xp)*ux + (yi-yp)*uy + (zi-zp)*uz ) ) * sigmaUx * sigmaUx / (4.0*di2);
+    Double_t incertUy = ( (yi-yp)*( 2*(yi-yp)*uy + (xi-xp)*ux + (zi-zp)*uz ) ) * ( (yi-yp)*( 2*(yi-yp)*uy + (xi-xp)*ux + (zi-zp)*uz ) ) * sigmaUy * sigmaUy / (4.0*di2);
+    Double_t incertUz = ( (zi-zp)*( 2*(zi-zp)*uz + (xi-xp)*ux + (yi-yp)*uy ) ) * ( (zi-zp)*( 2*(zi-zp)*uz + (xi-xp)*ux + (yi-yp)*uy ) ) * sigmaUz * sigmaUz / (4.0*di2);
+
+    if( (incertXi + incertYi + incertZi + incertUx + incertUy + incertUz) != 0) chi2 += di2/( incertXi + incertYi + incertZi + incertUx + incertUy + incertUz );
+    else chi2 = di2;
+
+  }
+
+  fValue = chi2;
+
+}
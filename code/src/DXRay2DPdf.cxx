@@ -4,7 +4,14 @@
  * This code was autogenerated by RooClassFactory                            * 
  *****************************************************************************/ 
 
-// Your description goes here... 
+// 2D pdf of the X-ray pattern (bands of width W_i separated by S_i, rotated
+//  by phi, with a linear slope beta along alpha), see MPost.
+//
+// The geometry (band edges, rotation, normalisation) depends only on the
+//  parameters: UpdateGeometry computes it once per parameter set and
+//  EvaluatePoint only does the point dependent part, with the same
+//  operations as before so the values are identical.
+// EvaluateBatch evaluates a whole dataset for one parameter set.
 
 #include "Riostream.h" 
 
@@ -19,6 +26,7 @@ ClassImp(DXRay2DPdf)
 //===============================================================================
 DXRay2DPdf::DXRay2DPdf()
 {
+  fGeometryValid = kFALSE;
 }
 //===============================================================================  
 DXRay2DPdf::DXRay2DPdf(const char *name, const char *title, 
@@ -56,6 +64,7 @@ DXRay2DPdf::DXRay2DPdf(const char *name, const char *title,
   S4   ("S4",   "S_{4}", this,_S4),
   S5   ("S5",   "S_{5}", this,_S5)
 {
+  fGeometryValid = kFALSE;
 } 
 //===============================================================================
 DXRay2DPdf::DXRay2DPdf(const DXRay2DPdf& other, const char* name) :  
@@ -77,6 +86,7 @@ DXRay2DPdf::DXRay2DPdf(const DXRay2DPdf& other, const char* name) :
   S4("S4",this,other.S4),
   S5("S5",this,other.S5)
 { 
+  fGeometryValid = kFALSE;
 }
 //===============================================================================
 TObject* DXRay2DPdf::clone(const char* newname) const
@@ -90,33 +100,48 @@ DXRay2DPdf::~DXRay2DPdf()
 {
 }
 //===============================================================================
-double DXRay2DPdf::evaluate() const 
-{ 
+Bool_t DXRay2DPdf::UpdateGeometry() const
+{
+  // Compute the quantities depending only on the parameters,
+  //  unless they did not change since the last call.
+  // Returns kTRUE if they were recomputed.
+
+  Double_t parameters[kCacheParametersN] = { X0, sigma, beta, alpha, phi,
+                                             W1, W2, W3, W4, W5, S2, S3, S4, S5,
+                                             y.min(), y.max() };
+  if(fGeometryValid) {
+    Int_t ip = 0;
+    while(ip<kCacheParametersN && parameters[ip]==fGeometryParameters[ip]) ip++;
+    if(ip==kCacheParametersN) return kFALSE;
+  }
+  for(Int_t ip=0; ip<kCacheParametersN; ip++) fGeometryParameters[ip] = parameters[ip];
+  fGeometryValid = kTRUE;
 
-   const int Npeak(5);
+  const int Npeak(kNpeak);
 
-   double W[Npeak];
-   W[0] = W1;
-   W[1] = W2;
-   W[2] = W3;
-   W[3] = W4;
-   W[4] = W5;
+  double W[Npeak];
+  W[0] = W1;
+  W[1] = W2;
+  W[2] = W3;
+  W[3] = W4;
+  W[4] = W5;
 
-   double S[Npeak];
-   S[0] = 0.0;
-   S[1] = S2;
-   S[2] = S3;
-   S[3] = S4;
-   S[4] = S5;
+  double S[Npeak];
+  S[0] = 0.0;
+  S[1] = S2;
+  S[2] = S3;
+  S[3] = S4;
+  S[4] = S5;
 
-  double ST = 0.0;
   double WT = 0.0;
-  for(int i=0;i<Npeak;i++) {
-    ST += S[i];
-    WT += W[i];
-  }
+  for(int i=0;i<Npeak;i++) WT += W[i];
+
+  fCosPhi   = cos(phi*TMath::Pi()/180.0);
+  fSinPhi   = sin(phi*TMath::Pi()/180.0);
+  fCosAlpha = cos(alpha*TMath::Pi()/180.0);
+  fSinAlpha = sin(alpha*TMath::Pi()/180.0);
 
-  double DeltaY  = (y.max() - y.min())/cos(phi*TMath::Pi()/180.0);
+  double DeltaY  = (y.max() - y.min())/fCosPhi;
   DeltaY        += W[0]*tan(phi*TMath::Pi()/180.0);
   double AveY    = 0.5*(y.max() + y.min());
 
@@ -128,14 +153,13 @@ double DXRay2DPdf::evaluate() const
     }
   }
 
-  double Gamma = 0.0;
+  fGamma = 0.0;
   if(Npeak > 1) {
     for(int j=0;j<Npeak;j++) {
-      Gamma += W[j]*Sadd[j]/WT;
+      fGamma += W[j]*Sadd[j]/WT;
     }
   }
 
-
   double radius = 1.0e+20;
   double SaddTot = 0.0;
   for(int i=0;i<Npeak;i++) {
@@ -143,49 +167,64 @@ double DXRay2DPdf::evaluate() const
   }
   SaddTot += 0.5*W[Npeak-1];
 
-  double alphaAbs = TMath::Abs(alpha);
-  
   if(alpha >= -180.0 && alpha < -90.0) {
-    radius = (SaddTot - Gamma)*(-cos(alpha*TMath::Pi()/180.0)) - 0.5*DeltaY*sin(alpha*TMath::Pi()/180.0);
+    radius = (SaddTot - fGamma)*(-fCosAlpha) - 0.5*DeltaY*fSinAlpha;
   }
   else if(alpha >= -90.0 && alpha < 0.0) {
-    radius = (0.5*W[0] + Gamma)*cos(alpha*TMath::Pi()/180.0) - 0.5*DeltaY*sin(alpha*TMath::Pi()/180.0);
+    radius = (0.5*W[0] + fGamma)*fCosAlpha - 0.5*DeltaY*fSinAlpha;
   }
   else if(alpha >= 0.0 && alpha < 90.0) {
-    radius = (0.5*W[0] + Gamma)*cos(alpha*TMath::Pi()/180.0) + 0.5*DeltaY*sin(alpha*TMath::Pi()/180.0);
+    radius = (0.5*W[0] + fGamma)*fCosAlpha + 0.5*DeltaY*fSinAlpha;
   }
   else if(alpha >= 90.0 && alpha < 180.0) {
-    radius = (SaddTot - Gamma)*(-cos(alpha*TMath::Pi()/180.0)) + 0.5*DeltaY*sin(alpha*TMath::Pi()/180.0);
+    radius = (SaddTot - fGamma)*(-fCosAlpha) + 0.5*DeltaY*fSinAlpha;
   }
 
-  double X0t   =  X0*cos(phi*TMath::Pi()/180.0) + AveY*sin(phi*TMath::Pi()/180.0);
-  double AveYt = -X0*sin(phi*TMath::Pi()/180.0) + AveY*cos(phi*TMath::Pi()/180.0);
+  fX0t   =  X0*fCosPhi + AveY*fSinPhi;
+  fAveYt = -X0*fSinPhi + AveY*fCosPhi;
+
+  fBetaOverRadius = beta/radius;
+  fFactor2        = fBetaOverRadius*sigma*sqrt(2.0/TMath::Pi())*fCosAlpha;
+  fSqrt2Sigma     = sqrt(2.0)*sigma;
+  fNormalisation  = 2.0*WT*DeltaY;
 
-  double Xvalt =  x*cos(phi*TMath::Pi()/180.0) + y*sin(phi*TMath::Pi()/180.0);
-  double Yvalt = -x*sin(phi*TMath::Pi()/180.0) + y*cos(phi*TMath::Pi()/180.0);
+  // the bands of zero width (the unused ones) add exactly 0
+  fBandsN = 0;
+  for(int i=0;i<Npeak;i++) {
+    if(W[i] == 0.0) continue;
+    fXhigh[fBandsN] = fX0t + Sadd[i] + 0.5*W[i];
+    fXlow[fBandsN]  = fX0t + Sadd[i] - 0.5*W[i];
+    fBandsN++;
+  }
 
-  double Factor1  = cos(alpha*TMath::Pi()/180.0)*(Xvalt - X0t - Gamma) + sin(alpha*TMath::Pi()/180.0)*(Yvalt - AveYt);
-  Factor1        *= (beta/radius);
+  return kTRUE;
+}
+//===============================================================================
+inline Double_t DXRay2DPdf::EvaluatePoint(Double_t xVal, Double_t yVal) const
+{
+  // Pdf value at (xVal,yVal), the geometry being up to date.
+
+  double Xvalt =  xVal*fCosPhi + yVal*fSinPhi;
+  double Yvalt = -xVal*fSinPhi + yVal*fCosPhi;
+
+  double Factor1  = fCosAlpha*(Xvalt - fX0t - fGamma) + fSinAlpha*(Yvalt - fAveYt);
+  Factor1        *= fBetaOverRadius;
   Factor1        += 1.0;
 
-  double Factor2 = (beta/radius)*sigma*sqrt(2.0/TMath::Pi())*cos(alpha*TMath::Pi()/180.0);
-  
   double val1 = 0.0;
   double val2 = 0.0;
-  for(int i=0;i<Npeak;i++) {
-    double Xhi  = X0t + Sadd[i] + 0.5*W[i] - Xvalt;
-    Xhi        /= sqrt(2.0)*sigma;
-    double Xli  = X0t + Sadd[i] - 0.5*W[i] - Xvalt;
-    Xli        /= sqrt(2.0)*sigma;
-    
+  for(int i=0;i<fBandsN;i++) {
+    double Xhi  = (fXhigh[i] - Xvalt)/fSqrt2Sigma;
+    double Xli  = (fXlow[i]  - Xvalt)/fSqrt2Sigma;
+
     val1 += TMath::Erfc(Xli) - TMath::Erfc(Xhi);
-    val2 += TMath::Exp(-pow(Xli,2)) - TMath::Exp(-pow(Xhi,2));
+    val2 += TMath::Exp(-Xli*Xli) - TMath::Exp(-Xhi*Xhi);
   }
   val1 *= Factor1;
-  val2 *= Factor2;
-  
+  val2 *= fFactor2;
+
   double val = val1 + val2;
-  val /= (2.0*WT*DeltaY);
+  val /= fNormalisation;
 
   double limit = 1.0e-20;
 
@@ -197,8 +236,24 @@ double DXRay2DPdf::evaluate() const
   if(val < 0.0) cout << "val = " << val << endl;
 
   return val;
+}
+//===============================================================================
+double DXRay2DPdf::evaluate() const 
+{ 
+
+  UpdateGeometry();
+  return EvaluatePoint(x, y);
 
 } 
 //===============================================================================
+void DXRay2DPdf::EvaluateBatch(Int_t n, const Double_t *xValues, const Double_t *yValues, Double_t *values) const
+{
+  // Pdf values (not normalised, as evaluate) at the n points (xValues[i],yValues[i])
+  //  for the current parameters.
+
+  UpdateGeometry();
+  for(Int_t i=0; i<n; i++) values[i] = EvaluatePoint(xValues[i], yValues[i]);
+}
+//===============================================================================
 
 
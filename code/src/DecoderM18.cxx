@@ -9,6 +9,7 @@
 
 #include "DecoderM18.h"
 #include "TMath.h"
+#include "TString.h"
 
 ClassImp(DecoderM18)
 
@@ -24,7 +25,6 @@ DecoderM18::DecoderM18( Int_t aBoardNumber, Int_t aRunNumber, Int_t aSensorNumbe
   kStopPointerTransitionRead(0),
   kStopPointerTransitionSet(0),
   fNEvent(0),
-  fFileInput(0x0),
   fDataChar(0),
   fcountEv(-1),
   fEvCounterCDH(-1),
@@ -39,6 +39,8 @@ DecoderM18::DecoderM18( Int_t aBoardNumber, Int_t aRunNumber, Int_t aSensorNumbe
   fBoardNumber = aBoardNumber;
   fRunNumber = aRunNumber;
   fSensorNumber = aSensorNumber;
+  fFileInput.SetLabel( Form( "DecoderM18 [%d]", fBoardNumber));
+  fFileInput.SetVerbose( false);
  
 }
 // #############################################################################
@@ -54,7 +56,6 @@ TObject(rstream),
   kStopPointerTransitionRead(0),
   kStopPointerTransitionSet(0),
   fNEvent(0),
-  fFileInput(0x0),
   fDataChar(0),
   fcountEv(-1),
   fEvCounterCDH(-1),
@@ -114,11 +115,12 @@ void DecoderM18::SetTrailer( UInt_t aTrailer){
 // #############################################################################
 Bool_t DecoderM18::ReadNextInt() {
 
-  if(!fFileInput){ printf("DecoderM18 [%d]: Error No Input File\n", fBoardNumber); return 0; }
+  // The words are copied from the block of the file loaded in memory,
+  //  see BoardReaderBuffer.
+
+  if(!fFileInput.IsOpen()){ printf("DecoderM18 [%d]: Error No Input File\n", fBoardNumber); return 0; }
   
-  fread(&fDataChar,1,4,fFileInput);
-   
-  if( feof(fFileInput) ) {
+  if( !fFileInput.Read(&fDataChar,4) ) {
     printf("DecoderM18 [%d]: No more data in file! -> STOPPING\n", fBoardNumber);
     return kFALSE;
   }
@@ -130,25 +132,34 @@ Bool_t DecoderM18::ReadNextInt() {
 // #############################################################################
 Int_t DecoderM18::Get_Nevent() {
   
-  if(!fFileInput){ printf("DecoderM18 [%d]: Error No Input File\n", fBoardNumber); return -1; }
+  if(!fFileInput.IsOpen()){ printf("DecoderM18 [%d]: Error No Input File\n", fBoardNumber); return -1; }
 
-  Long_t position;
-  position = ftell(fFileInput); //save current position 
+  fFileInput.Clear();
+  Long64_t position = fFileInput.Tell(); //save current position 
 
-  fseek(fFileInput,0,SEEK_SET); // go to beginning of the file
+  fFileInput.Seek(0); // go to beginning of the file
 
+  // count the trailers directly in memory, one block at a time
   fNEvent=0;
-  while(!feof(fFileInput))
-    {
-      if(!ReadNextInt()){
-	cout << "No 32 bit words to read!" << endl;
-	return -1;
-      }
-      if(fDataChar == kTrailer){fNEvent++;}
+  const Int_t wordsPerPeek = 65536;
+  Long64_t wordsLeft = fFileInput.GetFileSize()/4;
+  while( wordsLeft>0 ) {
+    Int_t nWords = wordsLeft<wordsPerPeek ? (Int_t)wordsLeft : wordsPerPeek;
+    const char *words = fFileInput.Peek( 4*nWords);
+    if( !words ) {
+      cout << "No 32 bit words to read!" << endl;
+      return -1;
     }
+    UInt_t word;
+    for( Int_t iWord=0; iWord<nWords; iWord++) {
+      memcpy( &word, words+4*iWord, 4);
+      if(word == kTrailer){fNEvent++;}
+    }
+    fFileInput.Skip( 4*nWords);
+    wordsLeft -= nWords;
+  }
 
-
-  fseek(fFileInput,position,SEEK_SET); //go back to initial position
+  fFileInput.Seek(position); //go back to initial position
 
   return fNEvent;
 
@@ -242,7 +253,7 @@ Bool_t DecoderM18::ReadData( ) {
       //cout << " Pixel[" << fIndex.size() << "]: initial hex= " << fDataChar << ", final amp= ", << Amp << ", at index " << Index << endl;
     } 
     else {
-      fseek(fFileInput,-4,SEEK_CUR);
+      fFileInput.Skip(-4);
       return kTRUE;
     }
   }
@@ -0,0 +1,165 @@
+// --------------------------------------------------------------------------------------
+//
+// Decoder of the zero-suppressed data of a Mimosa26/28 frame,
+//  see DecoderMi26.h
+//
+// The decoding loop has no per-pixel test when no pixel of the line is vetoed:
+//  the 4 possible pixels of a state are written unconditionally
+//  and the output pointer is moved by the real number of pixels.
+// The window on lines is tested once per line,
+//  the statistics are computed only if required, once per line.
+//
+// --------------------------------------------------------------------------------------
+
+#include "DecoderMi26.h"
+#include <cstring>
+
+// --------------------------------------------------------------------------------------
+
+DecoderMi26::DecoderMi26( int nLines, int nColumns) {
+
+  fLines        = nLines>0 ? nLines : 1;
+  fColumns      = nColumns>0 ? nColumns : 1;
+  // one additional word per line, a state can start at the last column
+  fWordsPerLine = (fColumns+63)/64 + 1;
+  fVetoMask.assign( (size_t)fLines*fWordsPerLine, 0ULL);
+  fLineVetoed.assign( fLines, 0);
+  fVetoedN      = 0;
+
+  fStatistics   = false;
+  ResetStatistics();
+
+  fHits.reserve( 4096);
+  fOverflowLines.reserve( 64);
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DecoderMi26::SetVeto( int aLine, int aColumn) {
+
+  // Veto the pixel (aLine, aColumn), lines and columns start at 0.
+
+  if( aLine<0 || aLine>=fLines || aColumn<0 || aColumn>=fColumns ) return;
+  unsigned long long bit = 1ULL << (aColumn%64);
+  unsigned long long &word = fVetoMask[(size_t)aLine*fWordsPerLine + aColumn/64];
+  if( !(word & bit) ) {
+    word |= bit;
+    fLineVetoed[aLine] = 1;
+    fVetoedN++;
+  }
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DecoderMi26::ClearVeto() {
+
+  fVetoMask.assign( fVetoMask.size(), 0ULL);
+  fLineVetoed.assign( fLineVetoed.size(), 0);
+  fVetoedN = 0;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool DecoderMi26::IsVetoed( int aLine, int aColumn) const {
+
+  if( aLine<0 || aLine>=fLines || aColumn<0 || aColumn>=fWordsPerLine*64 ) return false;
+  return (fVetoMask[(size_t)aLine*fWordsPerLine + aColumn/64] >> (aColumn%64)) & 1ULL;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+void DecoderMi26::ResetStatistics() {
+
+  memset( fLineOccupancy, 0, sizeof(fLineOccupancy));
+  memset( fBlockOccupancy, 0, sizeof(fBlockOccupancy));
+
+}
+
+// --------------------------------------------------------------------------------------
+
+int DecoderMi26::Decode( const unsigned short *words, int nWords, int firstLine, int lastLine) {
+
+  // Decode the nWords words of one sensor in one frame
+  //  and append the fired pixels to the list of hits.
+  // Lines outside [firstLine, lastLine] are skipped but still counted
+  //  in the overflow list and the statistics.
+  // Returns the number of hits added, -1 if a line announces more states
+  //  than there are words left (the available states are decoded).
+
+  size_t hitsBefore = fHits.size();
+  bool truncated = false;
+  bool wrapped = firstLine>lastLine;
+  int iWord = 0;
+  int lastWord = nWords-1; // the last word is a dummy
+
+  while( iWord<lastWord ) { // loop over lines
+
+    unsigned int lineWord = words[iWord++];
+    int nStates = lineWord & 0xF;
+    int line    = (lineWord>>4) & 0x7FF;
+    if( lineWord & 0x8000 ) fOverflowLines.push_back( line);
+    if( iWord+nStates>nWords ) {
+      nStates = nWords-iWord;
+      truncated = true;
+    }
+    const unsigned short *states = words+iWord;
+    iWord += nStates;
+
+    if( fStatistics ) {
+      fLineOccupancy[nStates]++;
+      // only the blocks with states are visited, the others count as empty
+      int statesInBlock[kStatBlocks] = {0};
+      int filledBlocks = 0;
+      for( int iState=0; iState<nStates; iState++) {
+        int block = (states[iState]>>2) & 0x3F;
+        if( block<kStatBlocks ) statesInBlock[block]++;
+      }
+      for( int iState=0; iState<nStates; iState++) {
+        int block = (states[iState]>>2) & 0x3F;
+        if( block<kStatBlocks && statesInBlock[block] ) {
+          fBlockOccupancy[statesInBlock[block]]++;
+          statesInBlock[block] = 0;
+          filledBlocks++;
+        }
+      }
+      fBlockOccupancy[0] += kStatBlocks-filledBlocks;
+    }
+
+    bool kept = wrapped ? (line>=firstLine || line<=lastLine) : (line>=firstLine && line<=lastLine);
+    if( !kept || nStates==0 ) continue;
+
+    if( fVetoedN && line<fLines && fLineVetoed[line] ) { // slow path, test each pixel
+      for( int iState=0; iState<nStates; iState++) {
+        int column = (states[iState]>>2) & 0x7FF;
+        int nPixels = (states[iState] & 0x3) + 1;
+        for( int iPixel=0; iPixel<nPixels; iPixel++) {
+          if( IsVetoed( line, column+iPixel) ) continue;
+          Hit_t hit = { (unsigned short)line, (unsigned short)(column+iPixel) };
+          fHits.push_back( hit);
+        }
+      }
+    }
+    else { // fast path, no test per pixel
+      size_t nHits = fHits.size();
+      fHits.resize( nHits + 4*nStates);
+      Hit_t *out = &fHits[nHits];
+      for( int iState=0; iState<nStates; iState++) {
+        unsigned short column = (states[iState]>>2) & 0x7FF;
+        out[0].line = line; out[0].column = column;
+        out[1].line = line; out[1].column = column+1;
+        out[2].line = line; out[2].column = column+2;
+        out[3].line = line; out[3].column = column+3;
+        out += (states[iState] & 0x3) + 1;
+      }
+      fHits.resize( out-&fHits[0]);
+    }
+
+  } // end loop over lines
+
+  return truncated ? -1 : (int)(fHits.size()-hitsBefore);
+
+}
@@ -42,17 +42,23 @@
 //    To be called for each event, get and decode the data
 //    corresponding to next event. Update the IMGEvent object.
 //  - SkipNextEvent = jump an event, ignoring its data.
+//  - GoToEvent = position the reading on a given event of the run,
+//    using the event index when available (see InitEventIndex).
 //  - AddFile/AddFileList =
 //    Add file names to the list of binary files to be considered for the readout
 //
 // Methods internal to the class
 //  - IMGBoardReader = constructor, sets almost all control variables
 //  - LookUpRawFile, OpenRawFile, CloseRawFile = raw data file management
+//  - InitEventIndex, SeekPosition = event index management
 //  - GetNextBuffer = load a full event in the memory (= Data buffer)
 //  - SetBufferPointers = set the pointers to the different part of
 //      the Data buffer (Header, inpu0, input1, ..., Trailer) for an event
 //  - BuildValue( anAddress, wordSize) = return the content of the Data buffer
 //      at anAddress and with length wordSize.
+//  - UnpackValues = same as BuildValue for a whole block of values,
+//      with the mask and the CDS subtraction applied,
+//      used by GetInputData when the values of an input are contiguous.
 //  - GetInputData = extract the rawdata value(s) for each channel (=pixel or strip)
 //    of each inputs and call the AddPixel method for it.
 //  - AddPixel = build the channel signal associated with the given rawdata value.
@@ -77,6 +83,7 @@
 // Last modified: JB 2020/11/25 IMGBoardReader, GetInputData for daqmode=5 (blocReading)
 
 #include "IMGBoardReader.h"
+#include <cstring>
 
 ClassImp(IMGBoardReader)
 ClassImp(IMGEvent)
@@ -291,6 +298,13 @@ IMGBoardReader::IMGBoardReader( int boardNumber, int nInputs, int *nChannels, in
   NumberOfFiles      = 0;
   CurrentFileNumber  = 0;
   NoMoreFile         = false;
+  ListOfInputFileNames = 0;
+  PixelSink          = 0;
+  BulkUnpack         = true;
+  BulkUnpackChecked  = false;
+  IndexFileName      = 0;
+  IndexLoaded        = false;
+  NextEventPosition  = 0;
 
   ReadingEvent       = false;
   CurrentEvent       = 0; // Allow to know wether data are correct, JB 2009/05/26
@@ -315,6 +329,7 @@ IMGBoardReader::~IMGBoardReader() {
   delete CurrentEvent;
   delete InputFileName;
   delete Data;
+  delete[] IndexFileName;
   ListOfTriggers.clear();
   ListOfTimestamps.clear();
   ListOfFrames.clear();
@@ -396,7 +411,7 @@ bool IMGBoardReader::AddFileList(const char *prefixFileName, int startIndex, int
   CurrentFileNumber = 0;
   SuffixFileName = new char[10];
   PrefixFileName = new char[300];
-  ListOfInputFileNames = new char*[endIndex-startIndex+1];
+  ListOfInputFileNames = new char*[endIndex-startIndex+1]();
   sprintf( PrefixFileName, "%s", prefixFileName);
   sprintf( SuffixFileName, "%s", suffixFileName);
   /*if(DebugLevel>0)*/ cout << "IMGBoardReader " << BoardNumber << " adding " << NumberOfFiles << " files like " << prefixFileName << "*" << SuffixFileName << endl;
@@ -450,7 +465,10 @@ bool IMGBoardReader::AddFileList(const char *prefixFileName, int startIndex, int
     rc = true;
   }
 
-  if( rc)  OpenRawFile(ListOfInputFileNames[0]); //reopens the very first file
+  if( rc) {
+    OpenRawFile(ListOfInputFileNames[0]); //reopens the very first file
+    InitEventIndex();
+  }
 //   RawFileStream.clear();
   return rc;
 }
@@ -501,6 +519,14 @@ bool IMGBoardReader::LookUpRawFile() {
     cout << "  --> IMGBoardReader " << BoardNumber << ": No more files to read " << CurrentFileNumber+1 << " >= " << NumberOfFiles << " closing!" << endl;
     CloseRawFile();
     NoMoreFile = true;
+
+    // The whole run has been read, the index can be saved for the next time
+    if( !IndexLoaded && IndexFileName!=0 && EventIndex.GetEntriesN()>0 && EventIndex.GetEntriesN()==NextEventPosition ) {
+      EventIndex.SetComplete();
+      if( EventIndex.WriteToFile( IndexFileName) ) {
+        cout << "  --> IMGBoardReader " << BoardNumber << ": index of " << EventIndex.GetEntriesN() << " events saved in " << IndexFileName << endl;
+      }
+    }
     return false;
   }
 
@@ -564,10 +590,25 @@ bool IMGBoardReader::GetNextBuffer( ) {
   if ( !( BuffersRead>=EventsInFile || RawFileStream.eof() ) || LookUpRawFile() ) {
 
     // Now we can get the next data buffer
+    Long64_t offset = (Long64_t)BuffersRead*SizeOfEvent;
     RawFileStream.read(reinterpret_cast<char *> ( &Data[0] ), sizeof(char) * SizeOfEvent);
     if(DebugLevel>2) cout << "  IMGBoardReader " << BoardNumber << ": Got new data buffer " << BuffersRead << " with gcount=" << RawFileStream.gcount() << " bytes, SizeOfEvent=" << SizeOfEvent << endl;
     readSuccess = ( (size_t)RawFileStream.gcount() == SizeOfEvent );
     BuffersRead++;
+
+    if( readSuccess ) {
+      // First sequential pass: record where this event lies
+      if( !EventIndex.IsComplete() && NextEventPosition==EventIndex.GetEntriesN() ) {
+        if( SizeOfHeader>=(int)sizeof(TEventHeader) ) {
+          TEventHeader *header = (TEventHeader*)Data;
+          EventIndex.Add( CurrentFileNumber, offset, header->EvNo, header->VFasCnt[1], header->TrigCnt);
+        }
+        else {
+          EventIndex.Add( CurrentFileNumber, offset);
+        }
+      }
+      NextEventPosition++;
+    }
   }
   return readSuccess;
 
@@ -575,6 +616,128 @@ bool IMGBoardReader::GetNextBuffer( ) {
 
 // --------------------------------------------------------------------------------------
 
+void IMGBoardReader::InitEventIndex( ) {
+
+  // Prepare the index of the events (file number, byte offset,
+  //  event number, trigger frame and trigger counter from the header).
+  //
+  // The index is stored in a sidecar file named after the first raw file
+  //  with the extension ".tafidx".
+  // If this file exists and matches the raw files (same sizes)
+  //  and the event size, it is loaded and GoToEvent can seek directly.
+  // Otherwise the index is built while reading the run sequentially
+  //  and saved once the last file is done (see LookUpRawFile).
+
+  EventIndex.Reset();
+  IndexLoaded = false;
+  NextEventPosition = 0;
+  delete[] IndexFileName;
+  IndexFileName = 0;
+
+  std::vector<Long64_t> fileSizes( NumberOfFiles, -1);
+  for( int iFile=0; iFile<NumberOfFiles; iFile++ ) {
+    if( ListOfInputFileNames[iFile]==0 ) continue;
+    ifstream rawFile( ListOfInputFileNames[iFile], ios::in | ios::binary | ios::ate);
+    if( rawFile.good() ) fileSizes[iFile] = (Long64_t)rawFile.tellg();
+    if( IndexFileName==0 ) {
+      IndexFileName = new char[strlen(ListOfInputFileNames[iFile])+8];
+      sprintf( IndexFileName, "%s.tafidx", ListOfInputFileNames[iFile]);
+    }
+  }
+  if( IndexFileName==0 ) return;
+  EventIndex.SetFileSizes( fileSizes);
+
+  if( !EventIndex.ReadFromFile( IndexFileName) ) return;
+
+  // The offsets must still correspond to the event size and to the nb of events per file
+  for( int iEvent=0; iEvent<EventIndex.GetEntriesN(); iEvent++ ) {
+    const DEventIndex::Entry_t *entry = EventIndex.GetEntry( iEvent);
+    if( entry->fileNumber<0 || entry->fileNumber>=NumberOfFiles || entry->offset%SizeOfEvent!=0 || entry->offset/SizeOfEvent>=EventsInFile ) {
+      cout << "  --> IMGBoardReader " << BoardNumber << ": index " << IndexFileName << " does not match the event size or the events per file, ignored." << endl;
+      EventIndex.Reset();
+      return;
+    }
+  }
+
+  IndexLoaded = true;
+  cout << "  --> IMGBoardReader " << BoardNumber << ": index of " << EventIndex.GetEntriesN() << " events loaded from " << IndexFileName << endl;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool IMGBoardReader::SeekPosition( int fileNumber, Long64_t offset, int eventPosition) {
+
+  // Move the reading to the given byte offset of the given file,
+  //  eventPosition is the rank in the run of the event found there.
+
+  if( fileNumber<0 || fileNumber>=NumberOfFiles || ListOfInputFileNames[fileNumber]==0 ) return false;
+
+  if( fileNumber!=CurrentFileNumber || !RawFileStream.is_open() ) {
+    if( RawFileStream.is_open() ) CloseRawFile();
+    CurrentFileNumber = fileNumber;
+    InputFileName = ListOfInputFileNames[CurrentFileNumber];
+    if( !OpenRawFile( InputFileName) ) return false;
+  }
+
+  RawFileStream.clear();
+  RawFileStream.seekg( offset);
+  BuffersRead = (int)(offset/SizeOfEvent);
+  NextEventPosition = eventPosition;
+  NoMoreFile = false;
+  ReadingEvent = false;
+
+  return !RawFileStream.fail();
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool IMGBoardReader::GoToEvent( int anEvent) {
+
+  // Position the reading so that the next call to HasData()
+  //  returns the event anEvent, counted from 0 since the start of the run.
+  //
+  // If the event is in the index, seek directly to it.
+  // Otherwise read the buffers (without decoding them) from the closest
+  //  known position, which extends the index on the way.
+  //
+  // Return false if the event cannot be reached.
+
+  if( anEvent<0 ) return false;
+  if( anEvent==NextEventPosition ) return true;
+
+  int nIndexed = EventIndex.GetEntriesN();
+  int target = -1; // indexed event to seek to, -1 to go on from the current position
+  if( anEvent<nIndexed ) {
+    target = anEvent;
+  }
+  else if( nIndexed>0 && ( anEvent<NextEventPosition || nIndexed-1>NextEventPosition ) ) {
+    target = nIndexed-1;
+  }
+
+  if( target>=0 ) {
+    const DEventIndex::Entry_t *entry = EventIndex.GetEntry( target);
+    if( !SeekPosition( entry->fileNumber, entry->offset, target) ) return false;
+  }
+  else if( anEvent<NextEventPosition ) { // no index yet, restart from the first file
+    if( !SeekPosition( 0, 0, 0) ) return false;
+  }
+
+  if(DebugLevel) cout << "  IMGBoardReader " << BoardNumber << ": going to event " << anEvent << " from " << NextEventPosition << endl;
+  while( NextEventPosition<anEvent ) {
+    if( !GetNextBuffer() ) {
+      cout << "  --> IMGBoardReader " << BoardNumber << ": cannot reach event " << anEvent << ", run ends at " << NextEventPosition << endl;
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+// --------------------------------------------------------------------------------------
+
 bool IMGBoardReader::SetBufferPointers( ) {
 
   // Set the pointers to the differrent buffers,
@@ -697,6 +860,9 @@ void IMGBoardReader::GetInputData( int mode) {
   // Modified: JB 2016/08/17 correction for multiframe mode (compatible with run 34939)
   // Modified: JB 2016/09/20 upgrade of multiframe mode to handle both CDS and non-CDS case
   // Modified: JB 2020/11/25 blocReading handling
+  //
+  // Inputs with contiguous values holding one channel each
+  //  are unpacked by blocks, see GetInputDataBulk.
 
   if( Data==NULL) {
     cout << "WARNING in IMGBoardReader board " << BoardNumber << ", event pointer is null!" << endl;
@@ -712,6 +878,8 @@ void IMGBoardReader::GetInputData( int mode) {
 
   for( int iInput=0; iInput<NbOfInputs; iInput++ ) { // loop on inputs
 
+    if( IsBulkUnpackInput( iInput, mode) && GetInputDataBulk( iInput) ) continue;
+
     unsigned int value = 0;
     unsigned int second_value = 0;
     unsigned int rawdata = 0;
@@ -849,6 +1017,8 @@ void IMGBoardReader::GetInputData( int mode) {
     delete[] rawdatas; // reduce memory leak, BH 2013/08/21
   } // end loop on inputs
 
+  if( mode==0 ) BulkUnpackChecked = true;
+
 }
 
 // --------------------------------------------------------------------------------------
@@ -1041,7 +1211,7 @@ void IMGBoardReader::AddPixel( int input, unsigned int rawdata, int index) {
   //   test if zero suppression is required
   if ( abs(SignificantBits[input])!=1 || value!=0 ) {
     if( IfZeroSupress == 0 || value > ZeroThreshold ) {
-      ListOfPixels.push_back( IMGPixel( trueInput, value, trueIndex));
+      StorePixel( trueInput, value, trueIndex);
     }
   }
 
@@ -1133,7 +1303,7 @@ void IMGBoardReader::AddPixel( int input, unsigned int *rawdatas, int nFrames, i
       //printf( "     (value!=0):%d (sigBit(%d)!=1):%d -> new pixel = %d\n", value!=0, SignificantBits[input], abs(SignificantBits[input])!=1, abs(SignificantBits[input])!=1 || value!=0);
       if ( abs(SignificantBits[input])!=1 || value!=0 ) {
         if( IfZeroSupress == 0 || value > ZeroThreshold ) {
-          ListOfPixels.push_back( IMGPixel( trueInput, value, trueIndex));
+          StorePixel( trueInput, value, trueIndex);
         }
         if( DebugLevel>2 ) {
           printf( "      input %d(true %d), channel %d(true %d): raw = 0x%8x, value = 0x%8x or %d for frame %d\n", input, trueInput, index, trueIndex, rawdatas[iFrame], value, value, iFrame);
@@ -1185,7 +1355,7 @@ void IMGBoardReader::AddPixel( int input, unsigned int *rawdatas, int nFrames, i
       /*if( iFrame==4)*/
       /*if( 2<iFrame && iFrame<7)*/
       if( IfZeroSupress == 0 || value > ZeroThreshold ) {
-        ListOfPixels.push_back( IMGPixel( trueInput, value, trueIndex, iFrame));
+        StorePixel( trueInput, value, trueIndex, iFrame);
       }
 
     } // end loop on physical frames
@@ -1260,6 +1430,172 @@ unsigned int IMGBoardReader::BuildValue( int anAddress, int wordSize) {
 
 // --------------------------------------------------------------------------------------
 
+bool IMGBoardReader::IsBulkUnpackInput( int input, int mode) {
+
+  // Tell whether the values of an input can be unpacked by blocks:
+  //  pixels are built (mode 0), the values are not spread over several frames,
+  //  one value holds one channel, and no detailed printout is required.
+
+  return BulkUnpack && mode==0 && !ifMultiFrame && NChannelsPerValue[input]==1 && DebugLevel<3;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool IMGBoardReader::GetInputDataBulk( int input) {
+
+  // Same as GetInputData for mode 0, for an input accepted by IsBulkUnpackInput.
+  // Channel i is the value i of the input, with the following layout:
+  //  - standard: the values follow each other,
+  //  - ifSplitFrames: all the values of frame 2 follow all the values of frame 1,
+  //  - ifBlocReading: blocs of ifBlocReading values of frame 1 and frame 2 alternate.
+  // For the last two layouts the CDS (frame1-frame2) is computed while unpacking.
+  //
+  // On the first event the unpacking is compared to BuildValue,
+  //  if they differ bulk unpacking is switched off and false is returned
+  //  before any pixel is added, so that the input can be read value by value.
+
+  int nValues = NValuesToRead[input];
+  int wordSize = (int)SizeOfValue[input];
+  unsigned int mask = (unsigned int)pow(2.,SignificantBits[input])-1;
+  if( (int)UnpackedValues.size()<nValues ) UnpackedValues.resize( nValues);
+  unsigned int *values = &UnpackedValues[0];
+
+  // list the blocs of contiguous values: first address, second address for CDS, size
+  int nBlocs = 1;
+  int blocSize = nValues;
+  if( ifBlocReading ) {
+    blocSize = ifBlocReading;
+    nBlocs = (nValues+blocSize-1)/blocSize;
+  }
+
+  if( !BulkUnpackChecked ) {
+    for( int iBloc=0; iBloc<nBlocs && BulkUnpack; iBloc++ ) {
+      int address = InputDataAdress[input] + (ifBlocReading ? 2*iBloc*blocSize*wordSize : 0);
+      int secondAddress = ifSplitFrames ? address+nValues*wordSize : ( ifBlocReading ? address+blocSize*wordSize : -1 );
+      int size = iBloc<nBlocs-1 ? blocSize : nValues-iBloc*blocSize;
+      BulkUnpack = CheckUnpackValues( address, secondAddress, wordSize, size, mask);
+    }
+    if( !BulkUnpack ) {
+      cout << "WARNING in IMGBoardReader board " << BoardNumber << ", bulk unpacking differs from BuildValue for input " << input << ", switched off!" << endl;
+      return false;
+    }
+  }
+
+  for( int iBloc=0; iBloc<nBlocs; iBloc++ ) {
+    int address = InputDataAdress[input] + (ifBlocReading ? 2*iBloc*blocSize*wordSize : 0);
+    int secondAddress = ifSplitFrames ? address+nValues*wordSize : ( ifBlocReading ? address+blocSize*wordSize : -1 );
+    int size = iBloc<nBlocs-1 ? blocSize : nValues-iBloc*blocSize;
+    UnpackValues( address, secondAddress, wordSize, size, mask, values+iBloc*blocSize);
+  }
+
+  for( int iChannel=0; iChannel<nValues; iChannel++ ) { // loop on channels
+    if( FirstTriggerChannel[input]<=iChannel && iChannel<=LastTriggerChannel[input] ) continue;
+    if( FirstExcludedChannel[input]<=iChannel && iChannel<=LastExcludedChannel[input] ) continue;
+    AddPixel( input, values+iChannel, 1, iChannel);
+  }
+
+  return true;
+
+}
+
+// --------------------------------------------------------------------------------------
+
+// Value of wordSize bytes built as in BuildValue, for the layouts handled by blocks:
+//  little endian 1 Byte (read two at a time), 2 and 4 Bytes, big endian 2 Bytes.
+// The bytes are assembled with shifts, so the result does not depend on the host.
+template< int wordSize, int endian > static inline unsigned int LoadValue( const unsigned char *p) {
+  if( endian==1 ) return ((unsigned int)p[0]<<8) | p[1];
+  if( wordSize==4 ) return p[0] | ((unsigned int)p[1]<<8) | ((unsigned int)p[2]<<16) | ((unsigned int)p[3]<<24);
+  return p[0] | ((unsigned int)p[1]<<8);
+}
+
+// Unpack nValues values, minus the values at second if withCDS.
+// The values are processed by groups of kUnpackGroup with a fixed trip count,
+//  built in a local array (no aliasing with the input),
+//  which the compiler turns into SIMD instructions.
+static const int kUnpackGroup = 16;
+template< int wordSize, int endian, bool withCDS > static void UnpackBlock( const unsigned char *first, const unsigned char *second, int nValues, unsigned int mask, unsigned int *values) {
+  int iValue = 0;
+  for( ; iValue+kUnpackGroup<=nValues; iValue+=kUnpackGroup ) {
+    const unsigned char *p1 = first + iValue*wordSize;
+    const unsigned char *p2 = withCDS ? second + iValue*wordSize : 0;
+    unsigned int group[kUnpackGroup];
+    for( int k=0; k<kUnpackGroup; k++ ) {
+      group[k] = LoadValue<wordSize,endian>( p1+k*wordSize) & mask;
+      if( withCDS ) group[k] -= LoadValue<wordSize,endian>( p2+k*wordSize) & mask;
+    }
+    memcpy( values+iValue, group, sizeof(group));
+  }
+  for( ; iValue<nValues; iValue++ ) {
+    unsigned int value = LoadValue<wordSize,endian>( first+iValue*wordSize) & mask;
+    if( withCDS ) value -= LoadValue<wordSize,endian>( second+iValue*wordSize) & mask;
+    values[iValue] = value;
+  }
+}
+
+template< int wordSize, int endian > static void UnpackBlock( const unsigned char *first, const unsigned char *second, int nValues, unsigned int mask, unsigned int *values) {
+  if( second ) UnpackBlock<wordSize,endian,true>( first, second, nValues, mask, values);
+  else UnpackBlock<wordSize,endian,false>( first, second, nValues, mask, values);
+}
+
+// --------------------------------------------------------------------------------------
+
+void IMGBoardReader::UnpackValues( int anAddress, int secondAddress, int wordSize, int nValues, unsigned int mask, unsigned int *values) {
+
+  // Fill values with the nValues consecutive values of wordSize bytes
+  //  starting at anAddress in the Data buffer, masked with mask.
+  // If secondAddress>=0, the values starting there are subtracted (CDS).
+  // The result is the same as BuildValue( anAddress+i*wordSize, wordSize) & mask
+  //  (minus the second one), see CheckUnpackValues.
+  // Layouts other than 8/16/32 bits little endian and 16 bits big endian
+  //  are built value by value with BuildValue.
+
+  const unsigned char *first = (const unsigned char*)Data + anAddress;
+  const unsigned char *second = secondAddress>=0 ? (const unsigned char*)Data + secondAddress : 0;
+
+  if( Endianness==0 && wordSize==1 ) UnpackBlock<1,0>( first, second, nValues, mask, values);
+  else if( Endianness==0 && wordSize==2 ) UnpackBlock<2,0>( first, second, nValues, mask, values);
+  else if( Endianness==0 && wordSize==4 ) UnpackBlock<4,0>( first, second, nValues, mask, values);
+  else if( Endianness==1 && wordSize==2 ) UnpackBlock<2,1>( first, second, nValues, mask, values);
+  else {
+    for( int iValue=0; iValue<nValues; iValue++ ) {
+      values[iValue] = BuildValue( anAddress+iValue*wordSize, wordSize) & mask;
+      if( secondAddress>=0 ) values[iValue] -= BuildValue( secondAddress+iValue*wordSize, wordSize) & mask;
+    }
+  }
+
+}
+
+// --------------------------------------------------------------------------------------
+
+bool IMGBoardReader::CheckUnpackValues( int anAddress, int secondAddress, int wordSize, int nValues, unsigned int mask) {
+
+  // Compare, bit by bit, the values from UnpackValues
+  //  with the ones built value by value with BuildValue,
+  //  for the current content of the Data buffer.
+  // Return true if all values are identical.
+
+  std::vector<unsigned int> values( nValues>0 ? nValues : 1);
+  UnpackValues( anAddress, secondAddress, wordSize, nValues, mask, &values[0]);
+
+  int nDifferences = 0;
+  for( int iValue=0; iValue<nValues; iValue++ ) {
+    unsigned int expected = BuildValue( anAddress+iValue*wordSize, wordSize) & mask;
+    if( secondAddress>=0 ) expected -= BuildValue( secondAddress+iValue*wordSize, wordSize) & mask;
+    if( values[iValue]!=expected ) {
+      if( nDifferences<10 ) printf( "  IMGBoardReader::CheckUnpackValues value %d at address %d: unpacked 0x%x, built 0x%x\n", iValue, anAddress+iValue*wordSize, values[iValue], expected);
+      nDifferences++;
+    }
+  }
+  if( nDifferences ) printf( "  IMGBoardReader::CheckUnpackValues %d values out of %d differ (word size %d, endianness %d)\n", nDifferences, nValues, wordSize, Endianness);
+
+  return nDifferences==0;
+
+}
+
+// --------------------------------------------------------------------------------------
+
 void IMGBoardReader::SkipNextEvent() {
 
   // This method is used to ignore the next event
@@ -49,6 +49,8 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <math.h>
 
 #include "TROOT.h"
 #include "MAlign.h"
@@ -1794,6 +1796,18 @@ if(printResidues==1) {
 
 }
 
+static Long64_t MiniVectorCell( Double_t position, Double_t cellSize)
+{
+  // Index of the cell of size cellSize containing position, used by AssociateMiniVectors.
+  // Everything is in one cell for a null size, the index is bounded for huge positions.
+
+  if( !(cellSize>0.) ) return 0;
+  Double_t cell = floor( position/cellSize );
+  if( !(cell>-1.e15) ) return -1000000000000000LL; // includes NaN
+  if( cell>1.e15 ) return 1000000000000000LL;
+  return (Long64_t)cell;
+}
+
 void MimosaAlignAnalysis::AssociateMiniVectors( Double_t boundDistance, Double_t boundSlopes, Int_t mode)
 {
 
@@ -1839,49 +1853,84 @@ void MimosaAlignAnalysis::AssociateMiniVectors( Double_t boundDistance, Double_t
     DPrecAlign* DPrecAlignLadder0 = ladder0->GetPrecAlign();                   //laddersDPrecAlign[0];
     DPrecAlign* DPrecAlignLadder1 = ladder1->GetPrecAlign();                   //laddersDPrecAlign[1];
 
+    // The position projected on ladder 0 and the direction of the ladder 1 mini-vectors
+    //  do not depend on the ladder 0 mini-vector: they are computed once, and the
+    //  mini-vectors are sorted by cells of boundDistance x boundDistance of this position,
+    //  so that each ladder 0 mini-vector is only compared to those of the neighbouring cells.
+    // The candidates are examined in their original order, so the pair chosen is the one
+    //  of the full double loop: smallest distance2D*tiltIndicator, the last one if equal.
+    Int_t nMiniVectorsLadder1 = (Int_t)miniVectorsLadder1.size();
+    std::vector<DR3> centersMV_Ladder1( nMiniVectorsLadder1);
+    std::vector<DR3> tiltsMV_Ladder1( nMiniVectorsLadder1);
+    std::vector< std::pair< std::pair<Long64_t,Long64_t>, Int_t> > cellsLadder1( nMiniVectorsLadder1);
+    for( Int_t iMV1=0; iMV1<nMiniVectorsLadder1; iMV1++ ) {
+      centersMV_Ladder1[iMV1] = miniVectorsLadder1[iMV1]->CalculateMiniVectorIntersectionLadder(DPrecAlignLadder0);
+      tiltsMV_Ladder1[iMV1]   = miniVectorsLadder1[iMV1]->GetMiniVectorDirection();
+      cellsLadder1[iMV1] = std::make_pair( std::make_pair( MiniVectorCell( centersMV_Ladder1[iMV1](0), boundDistance), MiniVectorCell( centersMV_Ladder1[iMV1](1), boundDistance)), iMV1);
+    }
+    std::sort( cellsLadder1.begin(), cellsLadder1.end());
+
+    std::vector<Int_t> candidates;
+    candidates.reserve( nMiniVectorsLadder1);
+
     std::vector<MiniVector*>::iterator itMiniVectorLadder0 = miniVectorsLadder0.begin();
     for( ; itMiniVectorLadder0!=miniVectorsLadder0.end() ; ++itMiniVectorLadder0 ) {
 
       DR3 currentCenterMV_Ladder0 = (*itMiniVectorLadder0)->GetMiniVectorLadderCenter(); // Coord of current MV in ladder1 frame
       DR3 currentTiltsLadder0     = (*itMiniVectorLadder0)->GetMiniVectorDirection();
-      
-      std::map<Double_t, MiniVector*> candidateMiniVectors;
-
-      std::vector<MiniVector*>::iterator itMiniVectorLadder1 = miniVectorsLadder1.begin();  
-      for( ; itMiniVectorLadder1!=miniVectorsLadder1.end() ; ++itMiniVectorLadder1 ) {
 
-        DR3 currentCenterMV_Ladder1 = (*itMiniVectorLadder1)->CalculateMiniVectorIntersectionLadder(DPrecAlignLadder0);
-        DR3 currentTiltsLadder1     = (*itMiniVectorLadder1)->GetMiniVectorDirection();
-
-        DR3 diffPos = currentCenterMV_Ladder1 - currentCenterMV_Ladder0;
-        DR3 diffSlopes = (currentTiltsLadder1 - currentTiltsLadder0)*1000.;
-
-        currentCenterMV_Ladder0.Print();
-        currentCenterMV_Ladder1.Print();
-        diffPos.Print();
-        currentTiltsLadder0.Print();
-        currentTiltsLadder1.Print();
-        diffSlopes.Print();
+      // ladder 1 mini-vectors in the cells overlapping the search window,
+      //  one more cell on each side absorbs the rounding at the cell edges
+      candidates.clear();
+      Long64_t cellXLow  = MiniVectorCell( currentCenterMV_Ladder0(0)-boundDistance, boundDistance) - 1;
+      Long64_t cellXHigh = MiniVectorCell( currentCenterMV_Ladder0(0)+boundDistance, boundDistance) + 1;
+      Long64_t cellYLow  = MiniVectorCell( currentCenterMV_Ladder0(1)-boundDistance, boundDistance) - 1;
+      Long64_t cellYHigh = MiniVectorCell( currentCenterMV_Ladder0(1)+boundDistance, boundDistance) + 1;
+      for( Long64_t cellX=cellXLow; cellX<=cellXHigh; cellX++ ) {
+        std::vector< std::pair< std::pair<Long64_t,Long64_t>, Int_t> >::iterator itCell = std::lower_bound( cellsLadder1.begin(), cellsLadder1.end(), std::make_pair( std::make_pair( cellX, cellYLow), -1));
+        for( ; itCell!=cellsLadder1.end() && itCell->first.first==cellX && itCell->first.second<=cellYHigh ; ++itCell ) candidates.push_back( itCell->second);
+      }
+      std::sort( candidates.begin(), candidates.end());
+
+      Int_t    bestCandidate = -1;
+      Double_t bestKey       = 0.;
+      for( Int_t iCandidate=0; iCandidate<(Int_t)candidates.size(); iCandidate++ ) {
+        Int_t iMV1 = candidates[iCandidate];
+
+        DR3 diffPos = centersMV_Ladder1[iMV1] - currentCenterMV_Ladder0;
+        DR3 diffSlopes = (tiltsMV_Ladder1[iMV1] - currentTiltsLadder0)*1000.;
+
+        if( AlignDebug>1 ) {
+          currentCenterMV_Ladder0.Print();
+          centersMV_Ladder1[iMV1].Print();
+          diffPos.Print();
+          currentTiltsLadder0.Print();
+          tiltsMV_Ladder1[iMV1].Print();
+          diffSlopes.Print();
+        }
 
         if( fabs(diffPos(0))<=boundDistance && fabs(diffPos(1))<=boundDistance && fabs(diffSlopes(0))<=boundSlopes && fabs(diffSlopes(1))<=boundSlopes ) {
           
           Double_t distance2D = diffPos(0)*diffPos(0) + diffPos(1)*diffPos(1);
           Double_t tiltIndicator = (diffSlopes(0)+diffSlopes(1))*1000;
+          Double_t key = distance2D*tiltIndicator;
           
-          candidateMiniVectors[distance2D*tiltIndicator] = *itMiniVectorLadder1;   
+          if( bestCandidate<0 || !(bestKey<key) ) { // as a std::map keyed on key, a later equal key replaces the previous one
+            bestCandidate = iMV1;
+            bestKey       = key;
+          }
         } // end if
  
-      } // end for Ladder0
+      } // end for Ladder1 candidates
       
       // Filling _associatedMiniVectors :
-      if(candidateMiniVectors.size() != 0) {
+      if(bestCandidate>=0) {
         
-        ladder1->AddAssociatedMiniVector( candidateMiniVectors.begin()->second );
+        ladder1->AddAssociatedMiniVector( miniVectorsLadder1[bestCandidate] );
         ladder0->AddAssociatedMiniVector( *itMiniVectorLadder0 );
-        candidateMiniVectors.clear();
       } // end if
 
-    } // end for Ladder1
+    } // end for Ladder0
     
     std::cout<<"     --> "<<ladder0->GetAssociatedMiniVectorsSize()<<" mini-vector pairs associated"<<std::endl;
     std::cout<<"################################################"<<std::endl;
@@ -56,6 +56,11 @@
 #include "MAnalysis.h"
 #endif
 #include "DSetup.h"
+#include "TArrayI.h"
+
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
 
 ClassImp(MimosaAnalysis)
 
@@ -147,6 +152,23 @@ MimosaAnalysis::MimosaAnalysis()
   CUT_MaxHitRatePerPixel = 0.; //cdritsa: set to 5; if the pixel is a seed too many times in the run, remove the hit.
   CUT_MinHitRatePerPixel = 0.; // you can also remove pixels with low occupancy for testing
 
+  // Eta corrections tabulated within 0.01 um, see SetEtaTableTolerance()
+  fEtaTableTolerance = 0.01;
+
+  // Event loops are sequential unless SetNWorkers() is called
+  fNWorkers = 1;
+  fWorkerIndex = 0;
+  fWorkersN = 0;
+  fParallelCountersN = 0;
+  fParallelStreamsN = 0;
+  fParallelCarriedN = 0;
+  NeventRangeForEfficiency = 0;
+  temp_maxarray = 0;
+  ievt_array = 0;
+  temp_Efficiency_array = NULL;
+  temp_NofClMatchTrack = NULL;
+  temp_NtrkInMimo = NULL;
+
   if (fgInstance)
 	  Warning("MimosaAnalysis", "object already instantiated");
   else {
@@ -1445,6 +1467,12 @@ void MimosaAnalysis::GetMiEta()
      READListe_CoGU_eta5x5.AddAt(n_Eta5x5U,i);
      READListe_CoGV_eta5x5.AddAt(n_Eta5x5V,i);
    }
+
+   // tabulated corrections, taken from the CorPar file when stored there
+   const Float_t *lists[kEtaTablesN] = { READListe_CoGU.GetArray(), READListe_CoGV.GetArray(),
+                                         READListe_CoGU_eta2x2.GetArray(), READListe_CoGV_eta2x2.GetArray(),
+                                         READListe_CoGU_eta5x5.GetArray(), READListe_CoGV_eta5x5.GetArray() };
+   BuildEtaTables( fEtaTables, lists, READnListe_CoG, kTRUE);
    //---etaab fin GetMiEta()
    /*   cout<<"READListe"<<endl;
 	for(Int_t i=0 ; i< READnListe_CoG ; i++){
@@ -1462,6 +1490,37 @@ void MimosaAnalysis::GetMiEta()
  MainCanvas->Update();
 }
 
+//______________________________________________________________________________
+//
+static const char *kEtaTableNames[] = { "EtaTable3x3U", "EtaTable3x3V", "EtaTable2x2U", "EtaTable2x2V", "EtaTable5x5U", "EtaTable5x5V" };
+
+void MimosaAnalysis::BuildEtaTables( DEtaTable *tables, const Float_t **lists, Int_t listN, Bool_t readCorPar)
+{
+  // Tabulate the eta corrections of the 3x3, 2x2 and 5x5 CoG lists (U and V),
+  //  within fEtaTableTolerance (um).
+  // With readCorPar, the tables stored in the CorPar file by CreateNewEta
+  //  are used when they still match the lists.
+  // A list which cannot be tabulated (or fEtaTableTolerance<=0) keeps
+  //  the exact correction, see DEtaTable.
+
+  for( Int_t k=0; k<kEtaTablesN; k++) {
+    tables[k].SetList( lists[k], listN, (k%2==0) ? PixelSizeU : PixelSizeV);
+
+    DEtaTable *stored = (readCorPar && theCorFile) ? (DEtaTable*)theCorFile->Get( kEtaTableNames[k]) : 0;
+    Bool_t fromCorPar = stored!=0 && tables[k].UseCellsOf( *stored, fEtaTableTolerance);
+    if( !fromCorPar ) tables[k].Tabulate( fEtaTableTolerance);
+    delete stored;
+
+    if( tables[k].IsTabulated() ) {
+      Info("BuildEtaTables","%s: %d cells of %.4f um%s, max deviation %.4f um", kEtaTableNames[k], tables[k].GetCellsN(), tables[k].GetStep(), fromCorPar?" (CorPar)":"", tables[k].GetMaxDeviation());
+    }
+    else if( listN>0 ) {
+      Info("BuildEtaTables","%s: exact correction from the %d CoG (max deviation %.4f um for tolerance %.4f um)", kEtaTableNames[k], listN, tables[k].GetMaxDeviation(), fEtaTableTolerance);
+    }
+  }
+
+}
+
 //_____________________________________________________________
 //
 void MimosaAnalysis::CreateNewEta()
@@ -1788,6 +1847,13 @@ void MimosaAnalysis::CreateNewEta()
     n_Eta5x5V = Liste_CoGV_eta5x5[ii];
     TreeEta->Fill();
   }
+
+  // tabulated corrections of the new lists, stored next to the TreeEta
+  DEtaTable etaTables[kEtaTablesN];
+  const Float_t *lists[kEtaTablesN] = { Liste_CoGU.GetArray(), Liste_CoGV.GetArray(),
+                                        Liste_CoGU_eta2x2.GetArray(), Liste_CoGV_eta2x2.GetArray(),
+                                        Liste_CoGU_eta5x5.GetArray(), Liste_CoGV_eta5x5.GetArray() };
+  BuildEtaTables( etaTables, lists, n_Entries, kFALSE);
   //---etaab fin CreateNewEta()
   //T->Print();
 
@@ -1826,6 +1892,10 @@ void MimosaAnalysis::CreateNewEta()
   theCorFile->cd();
 
   TreeEta->Write("TreeEta",kOverwrite);
+  for( Int_t k=0; k<kEtaTablesN; k++) {
+    if( etaTables[k].IsTabulated() ) etaTables[k].Write( kEtaTableNames[k], kOverwrite);
+    else theCorFile->Delete( Form( "%s;*", kEtaTableNames[k]));
+  }
 
   ProfACGn->Write("ProfACG",kOverwrite);
   ProfUCG->Write("ProfUCG",kOverwrite);
@@ -1874,6 +1944,18 @@ void MimosaAnalysis::HotPixel_init( Int_t useMap)
   if( TheUsePixelMap  && Option_read_Pixel_map==1 ){
     HotPixelFile = new TFile(HotPixelFileName,"READ");
     h2HotPixelMap = (TH2F*)HotPixelFile->Get("h2HotPixelMap");
+
+    // Translate the rate cuts into a bit mask, once for all
+    fHotPixelMask.Reset();
+    for( Int_t iCol=1; iCol<=h2HotPixelMap->GetNbinsY(); iCol++) {
+      for( Int_t iRow=1; iRow<=h2HotPixelMap->GetNbinsX() && iRow<=NofPixelInRaw; iRow++) {
+        if(    h2HotPixelMap->GetBinContent( iRow, iCol) > CUT_MaxHitRatePerPixel
+            || h2HotPixelMap->GetBinContent( iRow, iCol) < CUT_MinHitRatePerPixel ) {
+          fHotPixelMask.SetHotIndex( (iCol-1)*NofPixelInRaw + iRow-1);
+        }
+      }
+    }
+    Info("HotPixel_init","%d pixels out of the rate range [%g, %g].", fHotPixelMask.GetNHotIndex(), CUT_MinHitRatePerPixel, CUT_MaxHitRatePerPixel);
   }
 
   Info("HotPixel_init","End hot pixel map preparation, usage = %d and %d.", TheUsePixelMap, Option_read_Pixel_map);
@@ -1889,12 +1971,10 @@ Int_t MimosaAnalysis::HotPixel_test( Int_t aPixelIndex)
   //
   // JB 2011/11/23 imported from A. Besson june 2004
 
-  Int_t iRow = aPixelIndex%NofPixelInRaw +1;
-  Int_t iCol = aPixelIndex/NofPixelInRaw +1;
-  if(    TheUsePixelMap ==  1 && Option_read_Pixel_map == 1
-      && (   h2HotPixelMap->GetBinContent( iRow, iCol) > CUT_MaxHitRatePerPixel
-	  || h2HotPixelMap->GetBinContent( iRow, iCol) < CUT_MinHitRatePerPixel)
-     ){
+  // The rate cuts have been applied once in HotPixel_init,
+  //  the test is now a bit lookup.
+
+  if( TheUsePixelMap ==  1 && Option_read_Pixel_map == 1 && fHotPixelMask.IsHotIndex( aPixelIndex) ){
 	return 1;
   }
 
@@ -1935,6 +2015,458 @@ void MimosaAnalysis::HotPixel_end( Int_t eventsRead)
 
 }
 
+//______________________________________________________________________________
+//
+void MimosaAnalysis::ParallelLoop_addCounter( Int_t *aCounter, Int_t aSize)
+{
+  // Declare a counter (or an array of aSize counters), local to the
+  //  analysis method, which has to be summed over the workers.
+  // To be called before ParallelLoop_init.
+
+  if( fParallelCountersN>=kMaxParallelCounters ) {
+    Warning("ParallelLoop_addCounter","Too many counters (max %d), this one will not be merged!", kMaxParallelCounters);
+    return;
+  }
+  fParallelCounter[fParallelCountersN] = aCounter;
+  fParallelCounterSize[fParallelCountersN] = aSize;
+  fParallelCountersN++;
+
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::ParallelLoop_addStream( ofstream *aStream)
+{
+  // Declare a text output written during the event loop.
+  // Each worker writes in its own temporary file, which is appended
+  //  to the stream at the end, so that the lines stay in event order.
+  // Streams not opened are ignored.
+  // To be called before ParallelLoop_init.
+
+  if( !aStream->is_open() ) return;
+  if( fParallelStreamsN>=kMaxParallelStreams ) {
+    Warning("ParallelLoop_addStream","Too many streams (max %d), this one will not be merged!", kMaxParallelStreams);
+    return;
+  }
+  fParallelStream[fParallelStreamsN] = aStream;
+  fParallelStreamsN++;
+
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::ParallelLoop_addCarried( Int_t *aValue)
+{
+  // Declare a value carried from one event to the next, local to the
+  //  analysis method (e.g. the last event with some property), which is
+  //  written in the declared streams.
+  // A worker cannot know its value at the start of its range: it starts
+  //  with the tag ParallelLoop_carriedTag(i) instead. When the streams
+  //  are appended, the tags written are replaced by the value at the end
+  //  of the previous range, and the value itself ends as after a single
+  //  process loop. Only the streams are corrected, not the console output.
+  // To be called before ParallelLoop_init.
+
+  if( fParallelCarriedN>=kMaxParallelCarried ) {
+    Warning("ParallelLoop_addCarried","Too many carried values (max %d), this one will not be corrected!", kMaxParallelCarried);
+    return;
+  }
+  fParallelCarried[fParallelCarriedN] = aValue;
+  fParallelCarriedN++;
+
+}
+
+//______________________________________________________________________________
+//
+Int_t MimosaAnalysis::ParallelLoop_init( Int_t &firstEvent, Int_t &lastEvent)
+{
+  // Share the events [firstEvent, lastEvent] between fNWorkers processes.
+  //
+  // The main process keeps the first range of events.
+  // The other processes (workers) are forked from it, so they start with
+  //  a copy of the whole analysis (cuts, alignment, eta parameters, booked
+  //  histograms), re-open the input file to get their own TTree and DEvent,
+  //  and reset their histograms and counters so that they only accumulate
+  //  the contribution of their range.
+  // The results are merged back by ParallelLoop_end, in event order.
+  //
+  // On return, [firstEvent, lastEvent] is the range of the current process,
+  //  the returned value is the worker index (0 for the main process).
+  //
+  // Ranges are kept above minEventsPerWorker events,
+  //  a single process is used for short loops.
+  // Only the histograms (TH1) of the "histograms" directory can be merged,
+  //  a single process is also used if it contains other objects (trees, graphs...).
+
+  const Int_t minEventsPerWorker = 1000;
+
+  fWorkerIndex = 0;
+  fWorkersN = 0;
+
+  Int_t nEvents = lastEvent-firstEvent+1;
+  Int_t nWorkers = TMath::Min( fNWorkers, nEvents/minEventsPerWorker);
+  if( nWorkers<=1 ) return 0;
+
+  if( dir ) {
+    TIter next( dir->GetList());
+    TObject *obj;
+    while( (obj=next()) ) {
+      if( !obj->InheritsFrom( TH1::Class()) ) {
+        Warning("ParallelLoop_init","%s (%s) cannot be merged between processes, the loop will run in a single process.", obj->GetName(), obj->ClassName());
+        return 0;
+      }
+    }
+  }
+
+  for( Int_t iWorker=0; iWorker<nWorkers; iWorker++) {
+    fWorkerFirstEvent[iWorker] = firstEvent + (Int_t)((Long64_t)nEvents*iWorker/nWorkers);
+    fWorkerLastEvent[iWorker] = firstEvent + (Int_t)((Long64_t)nEvents*(iWorker+1)/nWorkers) - 1;
+  }
+  fWorkerFilePrefix = Form( "%s/taf_%d_run%d_pl%d", gSystem->TempDirectory(), gSystem->GetPid(), RunNumber, ThePlaneNumber);
+
+  // Nothing buffered must be written twice
+  for( Int_t iStream=0; iStream<fParallelStreamsN; iStream++) fParallelStream[iStream]->flush();
+  cout.flush();
+  fflush( stdout);
+
+  for( Int_t iWorker=1; iWorker<nWorkers; iWorker++) {
+
+    pid_t pid = fork();
+
+    if( pid==0 ) { // in the worker
+      fWorkerIndex = iWorker;
+      fWorkersN = nWorkers;
+
+      // Counter of event bunches for the efficiency vs time,
+      //  as if the previous events were read by this process
+      if( NeventRangeForEfficiency>0 && fWorkerFirstEvent[iWorker]>firstEvent ) {
+        ievt_array += (fWorkerFirstEvent[iWorker]-1)/NeventRangeForEfficiency - (firstEvent+NeventRangeForEfficiency-1)/NeventRangeForEfficiency + 1;
+      }
+      firstEvent = fWorkerFirstEvent[iWorker];
+      lastEvent = fWorkerLastEvent[iWorker];
+
+      // The input file descriptor is shared with the main process,
+      //  the worker needs its own
+      OpenInputFile();
+
+      // Start from empty histograms and counters
+      if( dir ) {
+        TIter next( dir->GetList());
+        TObject *obj;
+        while( (obj=next()) ) {
+          if( obj->InheritsFrom( TH1::Class()) ) ((TH1*)obj)->Reset();
+        }
+      }
+      for( Int_t iCounter=0; iCounter<fParallelCountersN; iCounter++) {
+        for( Int_t i=0; i<fParallelCounterSize[iCounter]; i++) fParallelCounter[iCounter][i] = 0;
+      }
+      for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) *fParallelCarried[iCarried] = ParallelLoop_carriedTag( iCarried);
+      NtrkInMimo = 0;
+      NofClMatchTrack = 0;
+      hitCounter = 0;
+      hitCounterPos = 0;
+      for( Int_t i=0; i<10; i++) clusterMultiplicity[i] = 0;
+      if( temp_NtrkInMimo && temp_NofClMatchTrack ) {
+        for( Int_t i=0; i<temp_maxarray; i++) {
+          temp_NtrkInMimo[i] = 0.;
+          temp_NofClMatchTrack[i] = 0.;
+        }
+      }
+      nListe_CoG = 0;
+      nListe_CoG_eta2x2 = 0;
+      nListe_CoG_eta5x5 = 0;
+      Liste_CoGU.Set(0);
+      Liste_CoGV.Set(0);
+      Liste_CoGU_eta2x2.Set(0);
+      Liste_CoGV_eta2x2.Set(0);
+      Liste_CoGU_eta5x5.Set(0);
+      Liste_CoGV_eta5x5.Set(0);
+      if( alignement ) alignement->ResetDataPoints();
+
+      // Text outputs go to temporary files
+      for( Int_t iStream=0; iStream<fParallelStreamsN; iStream++) {
+        fParallelStream[iStream]->close();
+        fParallelStream[iStream]->open( Form( "%s_w%d_s%d.txt", fWorkerFilePrefix.Data(), iWorker, iStream));
+      }
+
+      return iWorker;
+    } // end in the worker
+
+    else if( pid<0 ) { // fork failed, stop the workers already started and go on alone
+      Error("ParallelLoop_init","Cannot start worker %d, the loop will run in a single process.", iWorker);
+      for( Int_t jWorker=1; jWorker<iWorker; jWorker++) {
+        kill( fWorkerPid[jWorker], SIGKILL);
+        waitpid( fWorkerPid[jWorker], NULL, 0);
+      }
+      return 0;
+    }
+
+    fWorkerPid[iWorker] = pid;
+
+  } // end loop on workers
+
+  fWorkersN = nWorkers;
+  firstEvent = fWorkerFirstEvent[0];
+  lastEvent = fWorkerLastEvent[0];
+  Info("ParallelLoop_init","Events shared between %d processes, main process reads events %d to %d.", fWorkersN, firstEvent, lastEvent);
+
+  return 0;
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::ParallelLoop_end()
+{
+  // To be called right after the event loop.
+  //
+  // In a worker: write the histograms of the "histograms" directory and all
+  //  the counters in a temporary file, then terminate the process.
+  // In the main process: wait for each worker, in the order of the event
+  //  ranges, and add its results to the current ones:
+  //  - histograms are added (TH1::Add), other objects of the directory
+  //    are not merged (warning),
+  //  - the counters declared with ParallelLoop_addCounter, the efficiency
+  //    counters (global and per bunch of events), the cluster counters
+  //    are summed,
+  //  - the CoG lists for the eta correction and the alignment data points
+  //    are appended,
+  //  - the temporary text outputs are appended to their stream, with the
+  //    tags of the carried values replaced (see ParallelLoop_addCarried).
+  // The declared counters, carried values and streams are forgotten afterwards.
+
+  const Int_t nMemberCounters = 15; // see the list below
+
+  // ---------------
+  // In a worker
+  // ---------------
+  if( fWorkerIndex>0 ) {
+
+    TString fileName = Form( "%s_w%d.root", fWorkerFilePrefix.Data(), fWorkerIndex);
+    TFile workerFile( fileName+".tmp", "RECREATE");
+    if( workerFile.IsZombie() ) _exit( 1);
+
+    // histograms, identified by their rank in the directory
+    if( dir ) {
+      Int_t rank = 0;
+      TIter next( dir->GetList());
+      TObject *obj;
+      while( (obj=next()) ) {
+        if( obj->InheritsFrom( TH1::Class()) ) obj->Write( Form( "h%d", rank));
+        rank++;
+      }
+    }
+
+    // counters
+    Int_t nCounters = nMemberCounters;
+    for( Int_t iCounter=0; iCounter<fParallelCountersN; iCounter++) nCounters += fParallelCounterSize[iCounter];
+    TArrayI counters( nCounters);
+    counters[0] = NtrkInMimo;
+    counters[1] = NofClMatchTrack;
+    counters[2] = hitCounter;
+    counters[3] = hitCounterPos;
+    counters[4] = ievt_array;
+    for( Int_t i=0; i<10; i++) counters[5+i] = clusterMultiplicity[i];
+    Int_t index = nMemberCounters;
+    for( Int_t iCounter=0; iCounter<fParallelCountersN; iCounter++) {
+      for( Int_t i=0; i<fParallelCounterSize[iCounter]; i++) counters[index++] = fParallelCounter[iCounter][i];
+    }
+    workerFile.WriteObjectAny( &counters, "TArrayI", "counters");
+    TArrayI carried( fParallelCarriedN);
+    for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) carried[iCarried] = *fParallelCarried[iCarried];
+    workerFile.WriteObjectAny( &carried, "TArrayI", "carried");
+    if( temp_NtrkInMimo && temp_NofClMatchTrack ) {
+      TArrayF bunchCounters( 2*temp_maxarray);
+      for( Int_t i=0; i<temp_maxarray; i++) {
+        bunchCounters[i] = temp_NtrkInMimo[i];
+        bunchCounters[temp_maxarray+i] = temp_NofClMatchTrack[i];
+      }
+      workerFile.WriteObjectAny( &bunchCounters, "TArrayF", "bunchCounters");
+    }
+
+    // lists
+    workerFile.WriteObjectAny( &Liste_CoGU, "TArrayF", "Liste_CoGU");
+    workerFile.WriteObjectAny( &Liste_CoGV, "TArrayF", "Liste_CoGV");
+    workerFile.WriteObjectAny( &Liste_CoGU_eta2x2, "TArrayF", "Liste_CoGU_eta2x2");
+    workerFile.WriteObjectAny( &Liste_CoGV_eta2x2, "TArrayF", "Liste_CoGV_eta2x2");
+    workerFile.WriteObjectAny( &Liste_CoGU_eta5x5, "TArrayF", "Liste_CoGU_eta5x5");
+    workerFile.WriteObjectAny( &Liste_CoGV_eta5x5, "TArrayF", "Liste_CoGV_eta5x5");
+    if( alignement ) alignement->GetDataPoints()->Write( "alignData", TObject::kSingleKey);
+
+    workerFile.Close();
+    for( Int_t iStream=0; iStream<fParallelStreamsN; iStream++) fParallelStream[iStream]->close();
+
+    // the file only appears once complete
+    Int_t status = gSystem->Rename( fileName+".tmp", fileName) ? 1 : 0;
+    cout.flush();
+    fflush( stdout);
+    _exit( status); // no cleanup, everything belongs to the main process
+  }
+
+  // ---------------
+  // In the main process
+  // ---------------
+  TDirectory *savedDirectory = gDirectory;
+
+  // carried values at the end of the previous range, the main process range first
+  Int_t previousCarried[kMaxParallelCarried];
+  for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) previousCarried[iCarried] = *fParallelCarried[iCarried];
+
+  for( Int_t iWorker=1; iWorker<fWorkersN; iWorker++) {
+
+    // The worker may have been collected already by the ROOT signal handler,
+    //  only a complete file tells the worker succeeded.
+    Int_t status = 0;
+    Bool_t failed = kFALSE;
+    if( waitpid( fWorkerPid[iWorker], &status, 0)==fWorkerPid[iWorker] ) {
+      failed = !WIFEXITED(status) || WEXITSTATUS(status)!=0;
+    }
+    TString fileName = Form( "%s_w%d.root", fWorkerFilePrefix.Data(), iWorker);
+    if( failed || gSystem->AccessPathName( fileName) ) {
+      Error("ParallelLoop_end","Worker %d failed, events %d to %d are MISSING from the results!", iWorker, fWorkerFirstEvent[iWorker], fWorkerLastEvent[iWorker]);
+      gSystem->Unlink( fileName+".tmp");
+      for( Int_t iStream=0; iStream<fParallelStreamsN; iStream++) gSystem->Unlink( Form( "%s_w%d_s%d.txt", fWorkerFilePrefix.Data(), iWorker, iStream));
+      continue;
+    }
+
+    TFile workerFile( fileName, "READ");
+
+    // histograms
+    if( dir ) {
+      Int_t rank = 0;
+      TIter next( dir->GetList());
+      TObject *obj;
+      while( (obj=next()) ) {
+        if( obj->InheritsFrom( TH1::Class()) ) {
+          TH1 *hWorker = (TH1*)workerFile.Get( Form( "h%d", rank));
+          if( hWorker && !strcmp( hWorker->GetName(), obj->GetName()) ) {
+            ((TH1*)obj)->Add( hWorker);
+          }
+          else {
+            Warning("ParallelLoop_end","Histogram %s not found for worker %d.", obj->GetName(), iWorker);
+          }
+        }
+        else if( iWorker==1 ) { // created during the loop, ParallelLoop_init refuses the others
+          Warning("ParallelLoop_end","%s (%s) is not merged, it only contains events %d to %d.", obj->GetName(), obj->ClassName(), fWorkerFirstEvent[0], fWorkerLastEvent[0]);
+        }
+        rank++;
+      }
+    }
+
+    // counters
+    TArrayI *counters = (TArrayI*)workerFile.GetObjectChecked( "counters", "TArrayI");
+    if( counters ) {
+      NtrkInMimo += (*counters)[0];
+      NofClMatchTrack += (*counters)[1];
+      hitCounter += (*counters)[2];
+      hitCounterPos += (*counters)[3];
+      if( (*counters)[4]>ievt_array ) ievt_array = (*counters)[4];
+      for( Int_t i=0; i<10; i++) clusterMultiplicity[i] += (*counters)[5+i];
+      Int_t index = nMemberCounters;
+      for( Int_t iCounter=0; iCounter<fParallelCountersN; iCounter++) {
+        for( Int_t i=0; i<fParallelCounterSize[iCounter] && index<counters->GetSize(); i++) fParallelCounter[iCounter][i] += (*counters)[index++];
+      }
+      delete counters;
+    }
+    TArrayF *bunchCounters = (TArrayF*)workerFile.GetObjectChecked( "bunchCounters", "TArrayF");
+    if( bunchCounters ) {
+      if( temp_NtrkInMimo && temp_NofClMatchTrack && bunchCounters->GetSize()==2*temp_maxarray ) {
+        for( Int_t i=0; i<temp_maxarray; i++) {
+          temp_NtrkInMimo[i] += (*bunchCounters)[i];
+          temp_NofClMatchTrack[i] += (*bunchCounters)[temp_maxarray+i];
+        }
+      }
+      delete bunchCounters;
+    }
+
+    // lists, same size limit as in ClusterPosition_compute
+    TArrayF *lists[6];
+    const char *listNames[6] = { "Liste_CoGU", "Liste_CoGV", "Liste_CoGU_eta2x2", "Liste_CoGV_eta2x2", "Liste_CoGU_eta5x5", "Liste_CoGV_eta5x5" };
+    for( Int_t iList=0; iList<6; iList++) lists[iList] = (TArrayF*)workerFile.GetObjectChecked( listNames[iList], "TArrayF");
+    if( lists[0] && lists[1] && lists[2] && lists[3] && lists[4] && lists[5] ) {
+      for( Int_t i=0; i<lists[0]->GetSize() && nListe_CoG<7500; i++) {
+        Liste_CoGU.Set(nListe_CoG+1);
+        Liste_CoGV.Set(nListe_CoG+1);
+        Liste_CoGU.AddAt( (*lists[0])[i], nListe_CoG);
+        Liste_CoGV.AddAt( (*lists[1])[i], nListe_CoG);
+        nListe_CoG++;
+        Liste_CoGU_eta2x2.Set(nListe_CoG_eta2x2+1);
+        Liste_CoGV_eta2x2.Set(nListe_CoG_eta2x2+1);
+        Liste_CoGU_eta2x2.AddAt( (*lists[2])[i], nListe_CoG_eta2x2);
+        Liste_CoGV_eta2x2.AddAt( (*lists[3])[i], nListe_CoG_eta2x2);
+        nListe_CoG_eta2x2++;
+        Liste_CoGU_eta5x5.Set(nListe_CoG_eta5x5+1);
+        Liste_CoGV_eta5x5.Set(nListe_CoG_eta5x5+1);
+        Liste_CoGU_eta5x5.AddAt( (*lists[4])[i], nListe_CoG_eta5x5);
+        Liste_CoGV_eta5x5.AddAt( (*lists[5])[i], nListe_CoG_eta5x5);
+        nListe_CoG_eta5x5++;
+      }
+    }
+    for( Int_t iList=0; iList<6; iList++) delete lists[iList];
+
+    TList *alignData = (TList*)workerFile.Get( "alignData");
+    if( alignData ) {
+      if( alignement ) {
+        TIter nextPoint( alignData);
+        TObject *point;
+        while( (point=nextPoint()) ) alignement->NewData( (DataPoints*)point);
+        alignData->Clear( "nodelete"); // points now belong to the alignment
+      }
+      delete alignData;
+    }
+
+    // carried values at the end of this range, a tag means unchanged since its start
+    Int_t workerCarried[kMaxParallelCarried];
+    for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) workerCarried[iCarried] = previousCarried[iCarried];
+    TArrayI *carried = (TArrayI*)workerFile.GetObjectChecked( "carried", "TArrayI");
+    if( carried && carried->GetSize()==fParallelCarriedN ) {
+      for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) {
+        workerCarried[iCarried] = (*carried)[iCarried];
+        for( Int_t jCarried=0; jCarried<fParallelCarriedN; jCarried++) {
+          if( workerCarried[iCarried]==ParallelLoop_carriedTag( jCarried) ) { workerCarried[iCarried] = previousCarried[jCarried]; break; }
+        }
+      }
+    }
+    delete carried;
+
+    workerFile.Close();
+    gSystem->Unlink( fileName);
+
+    // text outputs
+    for( Int_t iStream=0; iStream<fParallelStreamsN; iStream++) {
+      TString textName = Form( "%s_w%d_s%d.txt", fWorkerFilePrefix.Data(), iWorker, iStream);
+      ifstream workerText( textName.Data());
+      if( fParallelCarriedN==0 ) {
+        if( workerText.good() && workerText.peek()!=EOF ) (*fParallelStream[iStream]) << workerText.rdbuf();
+      }
+      else {
+        TString line;
+        while( line.ReadLine( workerText, kFALSE) ) {
+          for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) {
+            line.ReplaceAll( Form( "%d", ParallelLoop_carriedTag( iCarried)), Form( "%d", previousCarried[iCarried]));
+          }
+          (*fParallelStream[iStream]) << line << endl;
+        }
+      }
+      workerText.close();
+      gSystem->Unlink( textName);
+    }
+
+    for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) previousCarried[iCarried] = workerCarried[iCarried];
+
+  } // end loop on workers
+
+  for( Int_t iCarried=0; iCarried<fParallelCarriedN; iCarried++) *fParallelCarried[iCarried] = previousCarried[iCarried];
+
+  if( savedDirectory ) savedDirectory->cd();
+  if( fWorkersN>1 ) Info("ParallelLoop_end","Results of %d processes merged.", fWorkersN);
+
+  fWorkersN = 0;
+  fParallelCountersN = 0;
+  fParallelStreamsN = 0;
+  fParallelCarriedN = 0;
+
+}
+
 //_____________________________________________________________________________
 //
 DPrecAlign*  MimosaAnalysis::AlignMimosa(Int_t aDistance)
@@ -3592,145 +4124,48 @@ void MimosaAnalysis::ClusterPosition_init()
    Float_t xxx_eta5x5 = UofHitEta5x5_new-hUdigital;
    Float_t yxx_eta5x5 = VofHitEta5x5_new-hVdigital;
    //----etaab fin
-   Int_t iBin(0);
-   // cout << "xxx= " << xxx << endl;
-   //		  while(xxx > hEta3Int->GetBinLowEdge(iBin++));
-   while(xxx > Edges3x3[iBin] && iBin<NBins3x3-1){
-     // cout << xxx << hEta3Int->GetBinLowEdge(iBin) << endl;
-     //  cout << "iBin = " << iBin << endl;
-     iBin++;
-   }
-   //		  		  cout << "iBin = " << iBin << endl;
-   UofHitEta3=Contents3x3U[iBin]+hUdigital;
-   //    cout << "U = " << UofHitEta3 << endl;
-   iBin=0;
-   while(yxx > Edges3x3[iBin] && iBin<NBins3x3-1){
-     iBin++;
-   }
-   VofHitEta3 = Contents3x3V[iBin]+hVdigital;
-   // JB, Don't get the use of the following lines ?!?
+   // The pol6 parametrisation of the 3x3 correction is only kept when
+   //  the list correction below is not available (the binned 3x3
+   //  correction formerly computed here was always overwritten).
+   Bool_t etaListFilled = CorStatus!=2 && READnListe_CoG>0;
    UofHitEta3 = hUdigital;
    VofHitEta3 = hVdigital;
-
-
-   for(Int_t i=0; i<7; i++)
-     {
-       UofHitEta3 += FitParEta3U[i]*TMath::Power(xxx,i);
-       VofHitEta3 += FitParEta3V[i]*TMath::Power(yxx,i);
-       /*		//------------------ETASTUDIES
-	 if((ievt==14404)||(ievt==10937)){
-	 cout<<i <<"  -------------- UofHitEta3 VofHitEta3 "<<UofHitEta3<<" "<<VofHitEta3<<endl;
-	 cout<<" hUdigital hVdigital "<<hUdigital<<" "<<hVdigital<<endl;
-	 cout<<" UofHitCG VofHitCG "<<UofHitCG<<" "<<VofHitCG<<endl;
-	 cout<<" xxx yxx "<<xxx <<" "<<yxx<<endl;
-	 cout<<"FitParEta3U[i] FitParEta3V[i] "<<FitParEta3U[i] <<" "<<FitParEta3V[i] <<endl;
-	 cout<<"TMath::Power(xxx,i) TMath::Power(yxx,i)"<< TMath::Power(xxx,i) <<" "<<TMath::Power(yxx,i)<<endl;
-	 cout<<"  -------------- "<<endl;
-
-	 }
-	 //--------------------- */
-     }
-   if( MimoDebug>1) printf("ClusterPosition_eta: Eta3 = %.1f, %.1f\n", UofHitEta3, VofHitEta3);
+   if( !etaListFilled || MimoDebug>1 ) {
+     for(Int_t i=0; i<7; i++)
+       {
+         UofHitEta3 += FitParEta3U[i]*TMath::Power(xxx,i);
+         VofHitEta3 += FitParEta3V[i]*TMath::Power(yxx,i);
+       }
+     if( MimoDebug>1) printf("ClusterPosition_eta: Eta3 = %.1f, %.1f\n", UofHitEta3, VofHitEta3);
+   }
 
 
    // ---------------------------
    //------------------------------------------------New ETA METHOD WITHOUT FIT BIAS
-   if(CorStatus!=2 && READnListe_CoG>0){ // if corPar OK and EtaList filled
+   // The correction pitch*(number of list CoG <= CoG)/N - pitch/2 is tabulated
+   //  by GetMiEta, see DEtaTable.
+   if(etaListFilled){ // if corPar OK and EtaList filled
+     //---eta 3x3
      UofHitEta3 = hUdigital;
      VofHitEta3 = hVdigital;
-     //---U eta 3x3
-     Int_t etacounter = 0;
-     Int_t etastop = 1;
-     while(etastop ==1){
-       if(READListe_CoGU[etacounter] > xxx){
-	 etastop=0;
-       }else{
-	 //cout<<"etacounter etastop READnListe_CoG  READListe_CoGU[etacounter] xxx "
-	 //  <<etacounter<<" "<<etastop <<" "<<READnListe_CoG <<" "<<READListe_CoGU[etacounter]<<" "<<xxx<<endl;
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG){etastop=0;}
-       }
-
-     }
-
-     UofHitEta3+= PixelSizeU* (float(etacounter)/float(READnListe_CoG)) - PixelSizeU/2.;
-     //---V eta 3x3
-     etacounter = 0;
-     etastop = 1;
-     while(etastop ==1){
-       if(READListe_CoGV[etacounter] > yxx){
-	 etastop=0;
-       }else{
-	 //cout<<"etacounter etastop READnListe_CoG  READListe_CoGV[etacounter] yxx "
-	 //  <<etacounter<<" "<<etastop <<" "<<READnListe_CoG <<" "<<READListe_CoGV[etacounter]<<" "<<yxx<<endl;
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG){etastop=0;}
-       }
-
-     }
-     VofHitEta3+= PixelSizeV* (float(etacounter)/float(READnListe_CoG)) - PixelSizeV/2.;
+     UofHitEta3 += fEtaTables[kEta3x3U].Eval( xxx);
+     VofHitEta3 += fEtaTables[kEta3x3V].Eval( yxx);
 
      if( MimoDebug>1) printf("ClusterPosition_eta: Eta3(bis) = %.1f, %.1f\n", UofHitEta3, VofHitEta3);
 
-
-     //---etaab debut Look eta list
-     //---U eta 2x2
-     etacounter = 0;
-     etastop = 1;
+     //---eta 2x2
      UofHitEta2x2_newR = hUdigital;
-     while(etastop ==1){
-       if(READListe_CoGU_eta2x2[etacounter] > xxx_eta2x2){
-	 etastop=0;
-       }else{
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG_eta2x2){etastop=0;}
-       }
-     }
-     UofHitEta2x2_newR += PixelSizeU* (float(etacounter)/float(READnListe_CoG_eta2x2)) - PixelSizeU/2.;
-     //---V eta 2x2
-     etacounter = 0;
-     etastop = 1;
      VofHitEta2x2_newR = hVdigital;
-     while(etastop ==1){
-       if(READListe_CoGV_eta2x2[etacounter] > yxx_eta2x2){
-	 etastop=0;
-       }else{
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG_eta2x2){etastop=0;}
-       }
-     }
-     VofHitEta2x2_newR += PixelSizeV* (float(etacounter)/float(READnListe_CoG_eta2x2)) - PixelSizeV/2.;
+     UofHitEta2x2_newR += fEtaTables[kEta2x2U].Eval( xxx_eta2x2);
+     VofHitEta2x2_newR += fEtaTables[kEta2x2V].Eval( yxx_eta2x2);
 
      if( MimoDebug>1) printf("ClusterPosition_eta: Eta2x2_newR = %.1f, %.1f\n", UofHitEta2x2_newR, VofHitEta2x2_newR);
 
-
-     //---U eta 5x5
-     etacounter = 0;
-     etastop = 1;
+     //---eta 5x5
      UofHitEta5x5_newR = hUdigital;
-     while(etastop ==1){
-       if(READListe_CoGU_eta5x5[etacounter] > xxx_eta5x5){
-	 etastop=0;
-       }else{
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG_eta5x5){etastop=0;}
-       }
-     }
-     UofHitEta5x5_newR += PixelSizeU* (float(etacounter)/float(READnListe_CoG_eta5x5)) - PixelSizeU/2.;
-
-     //---V eta 5x5
-     etacounter = 0;
-     etastop = 1;
      VofHitEta5x5_newR = hVdigital;
-     while(etastop ==1){
-       if(READListe_CoGV_eta5x5[etacounter] > yxx_eta5x5){
-	 etastop=0;
-       }else{
-	 etacounter++;
-	 if(etacounter>=READnListe_CoG_eta5x5){etastop=0;}
-       }
-     }
-     VofHitEta5x5_newR += PixelSizeV* (float(etacounter)/float(READnListe_CoG_eta5x5)) - PixelSizeV/2.;
+     UofHitEta5x5_newR += fEtaTables[kEta5x5U].Eval( xxx_eta5x5);
+     VofHitEta5x5_newR += fEtaTables[kEta5x5V].Eval( yxx_eta5x5);
 
      if( MimoDebug>1) printf("ClusterPosition_eta: Eta2x2_newR = %.1f, %.1f\n", UofHitEta5x5_newR, VofHitEta5x5_newR);
 
@@ -16,6 +16,9 @@
 #include "TFile.h"
 #include "TSystem.h"
 #include "TCanvas.h"
+#include "TROOT.h"
+#include "TChainElement.h"
+#include "TLeaf.h"
 
 #include <assert.h>
 #include <stdio.h>
@@ -27,6 +30,9 @@
 #include <string>
 #include <math.h>
 #include <iomanip>
+#include <set>
+#include <fcntl.h>
+#include <unistd.h>
 
 ClassImp(MCBoardReader);
 
@@ -92,6 +98,11 @@ MCBoardReader::MCBoardReader(int boardNumber, int Runnumber, TString pathName, T
   fFramesReadFromFile = 0;
   fCurrentEvent       = NULL;
   MCInfoHolder        = NULL;
+  fClusterBytes       = 0;
+  fCacheSize          = 0;
+  fReadAheadFiles     = 0;
+  fReadAheadDone      = 0;
+  fImplicitMTStarted  = false;
   
   if(!Open()) {
     if(fFileName.EndsWith(".root")) {
@@ -144,6 +155,10 @@ MCBoardReader::~MCBoardReader()
   ListOfNoisePixels.clear();
   TheListOfMCNonSensitiveParticles.clear();
   
+#ifdef R__USE_IMT
+  if(fImplicitMTStarted) ROOT::DisableImplicitMT();
+#endif
+  
 }
 //------------------------------------------+-----------------------------------
 bool MCBoardReader::Open()
@@ -164,6 +179,15 @@ bool MCBoardReader::Open()
     tree = (TTree*)file_in.Get(fTreeName.Data());
     
     if(tree != NULL) {
+      // size of a cluster (baskets compressed together), to size the TTreeCache
+      Long64_t entries = tree->GetEntries();
+      if(entries > 0) {
+        Long64_t autoFlush    = tree->GetAutoFlush();
+        Long64_t clusterBytes = tree->GetZipBytes();
+        if(autoFlush > 0 && autoFlush < entries) clusterBytes = (Long64_t)((double)tree->GetZipBytes()/entries*autoFlush);
+        if(clusterBytes > fClusterBytes) fClusterBytes = clusterBytes;
+      }
+      
       bool ParatialTest = CheckIfNonSensitiveVariables(tree);
       if(GotNonSensitiveInfo && !ParatialTest) {
 	GotNonSensitiveInfo = false;
@@ -329,9 +353,126 @@ Long64_t  MCBoardReader::LoadTree(Long64_t entry)
   TChain *chain = (TChain*)fChain;
   if (chain->GetTreeNumber() != fCurrent) {
     fCurrent = chain->GetTreeNumber();
+    PrepareTree();
   }
   return centry;
   
+}
+//------------------------------------------+-----------------------------------
+void MCBoardReader::SetPrefetch(int cacheSizeMB, int nThreads, int readAheadFiles)
+{
+  
+  // Configure the prefetching of the input trees, the frames being read in sequence:
+  //  - the TTreeCache reads the baskets of the needed branches for a whole cluster
+  //    in one request, its default size (cacheSizeMB=0) is twice the largest cluster
+  //    within [10,256] MB, cacheSizeMB<0 switches the cache off,
+  //  - with nThreads>0 the baskets of the branches of an entry are decompressed
+  //    in parallel on the ROOT implicit multi-threading pool,
+  //  - the readAheadFiles files following the current one in the list
+  //    are loaded in the background while the current one is decoded.
+  
+  const Long64_t MB = 1024*1024;
+  if(cacheSizeMB > 0) fCacheSize = cacheSizeMB*MB;
+  else if(cacheSizeMB == 0) {
+    fCacheSize = 2*fClusterBytes;
+    if(fCacheSize <  10*MB) fCacheSize =  10*MB;
+    if(fCacheSize > 256*MB) fCacheSize = 256*MB;
+  }
+  else fCacheSize = 0;
+  fChain->SetCacheSize(fCacheSize);
+  
+  if(nThreads > 0) {
+#ifdef R__USE_IMT
+    if(!ROOT::IsImplicitMTEnabled()) {
+      ROOT::EnableImplicitMT(nThreads);
+      fImplicitMTStarted = true;
+    }
+    fChain->SetImplicitMT(true);
+#else
+    cout << "WARNING: MCBoardReader, ROOT was built without implicit multi-threading, baskets decompressed sequentially." << endl;
+#endif
+  }
+  
+  fReadAheadFiles = readAheadFiles>0 ? readAheadFiles : 0;
+  ReadAheadFiles(1);
+  
+  cout << "MCBoardReader:: prefetching with " << fCacheSize/MB << " MB cache (largest cluster " << fClusterBytes/1024 << " kB), "
+       << nThreads << " decompression thread(s), " << fReadAheadFiles << " file(s) read ahead" << endl;
+  
+  // the cache and branch status are set up when the first tree is loaded
+  fCurrent = -1;
+  
+}
+//------------------------------------------+-----------------------------------
+void MCBoardReader::PrepareTree()
+{
+  
+  // Called when the chain moves to a new tree:
+  //  - the branches without address are disabled, so that GetEntry reads only
+  //    the needed ones (the counters of the variable size arrays are kept),
+  //  - the needed branches are all given to the TTreeCache, without learning phase,
+  //  - the next files of the list are read ahead.
+  
+  TTree* tree = fChain->GetTree();
+  if(tree == NULL) return;
+  
+  std::set<std::string> needed;
+  TIter nextElement(fChain->GetStatus());
+  TChainElement* element;
+  while((element = (TChainElement*)nextElement())) {
+    if(element->GetBaddress() == NULL) continue;
+    needed.insert(element->GetName());
+    TBranch* branch = tree->GetBranch(element->GetName());
+    if(branch == NULL) continue;
+    TLeaf* leaf = (TLeaf*)branch->GetListOfLeaves()->At(0);
+    if(leaf != NULL && leaf->GetLeafCount() != NULL) needed.insert(leaf->GetLeafCount()->GetBranch()->GetName());
+  }
+  
+  int nDisabled = 0;
+  TIter nextBranch(tree->GetListOfBranches());
+  TBranch* branch;
+  while((branch = (TBranch*)nextBranch())) {
+    if(needed.count(branch->GetName())) continue;
+    fChain->SetBranchStatus(branch->GetName(), 0);
+    nDisabled++;
+  }
+  
+  if(fCacheSize > 0) {
+    for(std::set<std::string>::const_iterator it=needed.begin(); it!=needed.end(); ++it) {
+      fChain->AddBranchToCache(it->c_str(), kFALSE);
+    }
+    fChain->StopCacheLearningPhase();
+  }
+  
+  if(fDebugLevel) cout << "MCBoardReader:: tree " << fCurrent << ", " << needed.size() << " branches read, " << nDisabled << " disabled" << endl;
+  
+  ReadAheadFiles(fCurrent+1);
+  
+}
+//------------------------------------------+-----------------------------------
+void MCBoardReader::ReadAheadFiles(int firstFile)
+{
+  
+  // Ask the system to load the files [firstFile, firstFile+fReadAheadFiles[ of the list
+  //  into the page cache, the reading goes on in the background.
+  // Remote files (URL) are left to the TChain.
+  
+  int lastFile = firstFile + fReadAheadFiles;
+  if(lastFile > int(ListOfInputROOTFiles.size())) lastFile = int(ListOfInputROOTFiles.size());
+  
+  for(int ifile=(firstFile>fReadAheadDone ? firstFile : fReadAheadDone); ifile<lastFile; ifile++) {
+    const char* name = ListOfInputROOTFiles[ifile].Data();
+    if(strstr(name, "://") != NULL) continue;
+#ifdef POSIX_FADV_WILLNEED
+    int fd = ::open(name, O_RDONLY);
+    if(fd < 0) continue;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    ::close(fd);
+    if(fDebugLevel) cout << "MCBoardReader:: reading ahead " << name << endl;
+#endif
+  }
+  if(lastFile > fReadAheadDone) fReadAheadDone = lastFile;
+  
 }
 //------------------------------------------+-----------------------------------
 bool MCBoardReader::HasData()
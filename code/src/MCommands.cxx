@@ -274,11 +274,31 @@ void MimosaAnalysis::MimosaPro(Int_t   MaxEvt,
 
   Info("MimosaPro","\nReady to loop over %d events (over %d in the tree)\n", MaxEvent, (int)t->GetEntries());
 
+  // ************************************
+  // Share the events between fNWorkers processes (see SetNWorkers),
+  // the counters and text files below are merged at the end of the loop
+
+  ParallelLoop_addCounter( &ngoodhit);
+  ParallelLoop_addCounter( &NRecHit);
+  ParallelLoop_addCounter( &nmiss);
+  ParallelLoop_addCounter( &nmissh);
+  ParallelLoop_addCounter( &nmissthdist);
+  ParallelLoop_addCounter( NKeepHit, NCut);
+  ParallelLoop_addCounter( NKeepHitOk, NCut);
+  ParallelLoop_addStream( &outFileGoodEvt);
+  ParallelLoop_addStream( &outFileBadEvt);
+  ParallelLoop_addStream( &outFile);
+  ParallelLoop_addCarried( &Previousbadevent);
+  ParallelLoop_addCarried( &Previousbadevent2);
+  Int_t FirstEvent = MinEvent;
+  Int_t LastEvent = MaxEvent;
+  ParallelLoop_init( FirstEvent, LastEvent);
+
   // **********************************************************************************
   // ********* MAIN LOOP ***************
   // **********************************************************************************
 
-  for ( Int_t ievt=MinEvent ; ievt<=MaxEvent ; ievt++ ) { // Main loop over event
+  for ( Int_t ievt=FirstEvent ; ievt<=LastEvent ; ievt++ ) { // Main loop over event
 
     if(MimoDebug) Info("MimosaPro","Reading event %d",ievt);
 
@@ -307,9 +327,11 @@ void MimosaAnalysis::MimosaPro(Int_t   MaxEvt,
     }
 
     if(ievt/NofCycle*NofCycle == ievt || ievt<10){
-      if( selection->GetMaximum()>15*selection->GetBinContent(6)) MainCanvas->SetLogy(); // JB 2010/04/28
-      MainCanvas->Modified();
-      MainCanvas->Update();
+      if( fWorkerIndex==0 ) { // the display belongs to the main process
+        if( selection->GetMaximum()>15*selection->GetBinContent(6)) MainCanvas->SetLogy(); // JB 2010/04/28
+        MainCanvas->Modified();
+        MainCanvas->Update();
+      }
       cout << "MimosaPro Event " << ievt <<endl;
       if (NtrkInMimo>100){
         cout<<"  temporary efficiency = "<<NofClMatchTrack<<" / "<<NtrkInMimo<<" = "<<1.*NofClMatchTrack/NtrkInMimo<<endl;
@@ -1325,6 +1347,8 @@ void MimosaAnalysis::MimosaPro(Int_t   MaxEvt,
 
   } // end of Main loop over event
 
+  ParallelLoop_end();
+
   //**********************************************************************************
   //******************************* END OF MAIN LOOP *********************************
   //**********************************************************************************
@@ -2102,10 +2126,19 @@ void MimosaAnalysis::MimosaCalibration(Int_t MaxEvt , Float_t S2N_seed, Float_t
   Info("MimosaCalibration","\nReady to loop over %d events\n", MaxEvent);
   const Int_t NofCycle=1000;
 
+  // Share the events between fNWorkers processes (see SetNWorkers)
+  ParallelLoop_addCounter( &NgoodEvents);
+  ParallelLoop_addCounter( &Ngoodhits);
+  ParallelLoop_addCounter( &NgoodhitsinPeak);
+  ParallelLoop_addCounter( &totalNOfHits);
+  Int_t FirstEvent = MinEvent;
+  Int_t LastEvent = MaxEvent;
+  ParallelLoop_init( FirstEvent, LastEvent);
+
   // **********************************************************************************
   // ********* MAIN LOOP ***************
   // **********************************************************************************
-  for ( Int_t ievt=MinEvent ; ievt<=MaxEvent ; ievt++ ) { // Main loop over event
+  for ( Int_t ievt=FirstEvent ; ievt<=LastEvent ; ievt++ ) { // Main loop over event
 
     if(MimoDebug) Info("MimosaCalibration","Reading event %d",ievt);
 
@@ -2269,6 +2302,8 @@ void MimosaAnalysis::MimosaCalibration(Int_t MaxEvt , Float_t S2N_seed, Float_t
     if(MimoDebug) Info("MimosaCalibration","End loop on hits, found %d good hits in event %d (total %d good hits)", Ngoodhitsinevent, ievt, Ngoodhits);
 
   } // end of Main loop over event
+
+  ParallelLoop_end();
   //**********************************************************************************
   //******************************* END OF MAIN LOOP *********************************
   //**********************************************************************************
@@ -4541,11 +4576,31 @@ void MimosaAnalysis::MimosaProLadder(Int_t MaxEvt, Int_t TrackHitDist, Float_t S
 
   Info("MimosaPro","\nReady to loop over %d events (over %d in the tree)\n", MaxEvent, (int)t->GetEntries());
 
+  // ************************************
+  // Share the events between fNWorkers processes (see SetNWorkers),
+  // the counters and text files below are merged at the end of the loop
+
+  ParallelLoop_addCounter( &ngoodhit);
+  ParallelLoop_addCounter( &NRecHit);
+  ParallelLoop_addCounter( &nmiss);
+  ParallelLoop_addCounter( &nmissh);
+  ParallelLoop_addCounter( &nmissthdist);
+  ParallelLoop_addCounter( NKeepHit, NCut);
+  ParallelLoop_addCounter( NKeepHitOk, NCut);
+  ParallelLoop_addStream( &outFileGoodEvt);
+  ParallelLoop_addStream( &outFileBadEvt);
+  ParallelLoop_addStream( &outFile);
+  ParallelLoop_addCarried( &Previousbadevent);
+  ParallelLoop_addCarried( &Previousbadevent2);
+  Int_t FirstEvent = MinEvent;
+  Int_t LastEvent = MaxEvent;
+  ParallelLoop_init( FirstEvent, LastEvent);
+
   // **********************************************************************************
   // ********* MAIN LOOP ***************
   // **********************************************************************************
 
-  for ( Int_t ievt=MinEvent ; ievt<=MaxEvent ; ievt++ ) { // Main loop over event
+  for ( Int_t ievt=FirstEvent ; ievt<=LastEvent ; ievt++ ) { // Main loop over event
 
     if(MimoDebug) Info("MimosaPro","Reading event %d",ievt);
 
@@ -4574,9 +4629,11 @@ void MimosaAnalysis::MimosaProLadder(Int_t MaxEvt, Int_t TrackHitDist, Float_t S
     }
 
     if(ievt/NofCycle*NofCycle == ievt || ievt<10){
-      if( selection->GetMaximum()>15*selection->GetBinContent(6)) MainCanvas->SetLogy(); // JB 2010/04/28
-      MainCanvas->Modified();
-      MainCanvas->Update();
+      if( fWorkerIndex==0 ) { // the display belongs to the main process
+        if( selection->GetMaximum()>15*selection->GetBinContent(6)) MainCanvas->SetLogy(); // JB 2010/04/28
+        MainCanvas->Modified();
+        MainCanvas->Update();
+      }
       cout << "MimosaPro Event " << ievt <<endl;
       if (NtrkInMimo>100){
         cout<<"  temporary efficiency = "<<NofClMatchTrack<<" / "<<NtrkInMimo<<" = "<<1.*NofClMatchTrack/NtrkInMimo<<endl;
@@ -5352,6 +5409,8 @@ void MimosaAnalysis::MimosaProLadder(Int_t MaxEvt, Int_t TrackHitDist, Float_t S
 
   } // end of Main loop over event
 
+  ParallelLoop_end();
+
   //**********************************************************************************
   //******************************* END OF MAIN LOOP *********************************
   //**********************************************************************************
@@ -25,6 +25,8 @@
 
 
 #include "MAnalysis.h"
+#include "TFileMerger.h"
+#include "TBufferFile.h"
 
 ClassImp(MimosaAnalysis)
 
@@ -772,21 +774,101 @@ void MimosaAnalysis::AlignTrackerGlobal(const Int_t refPlane, const Int_t nEvent
 
 //______________________________________________________________________________
 //
-void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel)
+void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel, const char *compression, Int_t compressionLevel)
 {
   // Runs the analysis on raw data (hit and track finders) over "NEvt" events
   //  and generates DSF root file with the Ttree containing those hits and tracks.
   // The amount of stored info inside the Ttree depends on "fillLevel":
   //  fillLevel=0, maximum info stored,
   //  fillLevel=1, only info on DUT stored.
+  // "compression" ("ZLIB", "LZ4", "ZSTD", "LZMA") and "compressionLevel"
+  //  overwrite the DSF settings of the config file if given,
+  //  e.g. "LZ4" is much faster for DSF files analysed right away.
   //
   // Modified: JB 2011/07/07 to localize path names
   // Modified: JB 2011/07/21 for level of storage
 
   if(!CheckIfDone("init")) return;
 
-  fSession->MakeTree();
   fSession->SetEvents(NEvt); // to be modified
+  if( compression || compressionLevel>=0 ) fSession->SetDSFCompression( compression, compressionLevel);
+  Char_t New_File_Name[1000];
+  sprintf(New_File_Name,"%srun%d_0%d.root",(const char*)fSession->GetSummaryFilePath(),fSession->GetRunNumber(),GetFileNumber()+1);
+  RunDSFProduction( fillLevel, New_File_Name);
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::DSFProductionRange(Int_t firstEvent, Int_t lastEvent, Int_t fillLevel, Int_t warmUpEvents)
+{
+  // Same as DSFProduction but only for the events firstEvent to lastEvent
+  //  (counted from 0 since the start of the run).
+  // The event numbers stored are the ones of a production of the full run.
+  //
+  // The warmUpEvents events preceding firstEvent are reconstructed
+  //  but not stored, so that analog planes have their pedestal and noise
+  //  initialized; warmUpEvents<0 (default) selects the number of events
+  //  required by the noise initialization of the analog planes (0 if none).
+  //
+  // Reaching firstEvent is direct if the readers keep an event index,
+  //  otherwise the events before are read but not reconstructed.
+
+  if(!CheckIfDone("init")) return;
+
+  if( warmUpEvents<0 ) warmUpEvents = fSession->GetDefaultWarmUpEvents();
+  fSession->SetEventRange( firstEvent, lastEvent, warmUpEvents);
+  Char_t New_File_Name[1000];
+  sprintf(New_File_Name,"%srun%d_0%d_events%d-%d.root",(const char*)fSession->GetSummaryFilePath(),fSession->GetRunNumber(),GetFileNumber()+1, firstEvent, lastEvent);
+  RunDSFProduction( fillLevel, New_File_Name);
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::DSFProductionChunk(Int_t chunkId, Int_t nChunks, Int_t NEvt, Int_t fillLevel, Int_t warmUpEvents)
+{
+  // Produce the part chunkId (0 to nChunks-1) of the DSF which
+  //  DSFProduction(NEvt) would produce, that is of the events 0 to NEvt.
+  // Each chunk can run in a separate job (or node), MergeDSFChunks(nChunks)
+  //  then rebuilds the DSF of the full production.
+  // See DSFProductionRange for warmUpEvents.
+
+  if(!CheckIfDone("init")) return;
+
+  if( nChunks<1 || chunkId<0 || chunkId>=nChunks ) {
+    Error("DSFProductionChunk", "chunk %d does not exist for %d chunks", chunkId, nChunks);
+    return;
+  }
+
+  Long64_t nEvents = (Long64_t)NEvt+1;
+  Int_t firstEvent = (Int_t)( nEvents*chunkId/nChunks );
+  Int_t lastEvent  = (Int_t)( nEvents*(chunkId+1)/nChunks ) - 1;
+  if( warmUpEvents<0 ) warmUpEvents = fSession->GetDefaultWarmUpEvents();
+  Info("DSFProductionChunk", "chunk %d/%d: events %d to %d, %d warm-up events", chunkId, nChunks, firstEvent, lastEvent, warmUpEvents);
+
+  fSession->SetEventRange( firstEvent, lastEvent, warmUpEvents);
+  fSession->SetChunk( chunkId, nChunks);
+  RunDSFProduction( fillLevel, GetDSFChunkFileName( chunkId, nChunks).Data());
+}
+
+//______________________________________________________________________________
+//
+TString MimosaAnalysis::GetDSFChunkFileName(Int_t chunkId, Int_t nChunks)
+{
+  // Name of the DSF file written by DSFProductionChunk
+
+  TString fileName = Form("%srun%d_0%d_chunk%dof%d.root",(const char*)fSession->GetSummaryFilePath(),fSession->GetRunNumber(),GetFileNumber()+1, chunkId, nChunks);
+  fTool.LocalizeDirName( &fileName);
+  return fileName;
+}
+
+//______________________________________________________________________________
+//
+void MimosaAnalysis::RunDSFProduction(Int_t fillLevel, const char *newFileName)
+{
+  // Reconstruct the events selected in the session and write the DSF,
+  //  renamed newFileName at the end.
+
+  fSession->MakeTree();
   fSession->SetFillLevel( fillLevel); // JB 2011/07/21
   //fSession->GetTracker()->SetAlignmentStatus(2);  // 2 = all planes in telescope used for tracking, for NOW JB
   if( fSession->GetTracker()->GetAlignmentStatus()==1 ) {
@@ -802,7 +884,7 @@ void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel)
   Char_t Old_File_Name[1000];
   sprintf(Old_File_Name,"%s/%s",(const char*)fSession->GetSummaryFilePath(),fSession->GetSummaryFileName().Data());
   sprintf(Old_File_Name,"%s", fTool.LocalizeDirName( Old_File_Name)); // JB 2011/07/07
-  sprintf(New_File_Name,"%srun%d_0%d.root",(const char*)fSession->GetSummaryFilePath(),fSession->GetRunNumber(),GetFileNumber()+1);
+  sprintf(New_File_Name,"%s", newFileName);
   sprintf(New_File_Name,"%s", fTool.LocalizeDirName( New_File_Name)); // JB 2011/07/07
 
   gSystem->Rename(Old_File_Name,New_File_Name);
@@ -813,6 +895,194 @@ void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel)
   logfile.close();
 }
 
+//______________________________________________________________________________
+//
+Bool_t MimosaAnalysis::MergeDSFChunks(Int_t nChunks)
+{
+  // Merge the DSF files written by DSFProductionChunk( chunkId, nChunks, ...)
+  //  for chunkId=0 to nChunks-1 into the DSF of the full production
+  //  (same name as with DSFProduction).
+  //
+  // The trees are concatenated in chunk order, hence in event order,
+  //  the statistics (hDSFStatistics) and profiling histograms are summed.
+  // The merge is refused if a chunk is missing or if the event ranges
+  //  of the chunks are not contiguous.
+  //
+  // Replaces the manual merging with macros/MergingTrees.cc for a chunked production.
+
+  if(!CheckIfDone("init")) return kFALSE;
+  if( nChunks<1 ) {
+    Error("MergeDSFChunks", "%d chunks, nothing to merge", nChunks);
+    return kFALSE;
+  }
+
+  TString mergedFileName = Form("%srun%d_0%d.root",(const char*)fSession->GetSummaryFilePath(),fSession->GetRunNumber(),GetFileNumber()+1);
+  fTool.LocalizeDirName( &mergedFileName);
+
+  TDirectory *savedDirectory = gDirectory;
+  TFileMerger merger( kFALSE);
+
+  Int_t compressionSettings = -1; // taken from the first chunk, hence as configured for the production
+  Int_t expectedFirstEvent = 0;
+  Int_t lastEvent = -1;
+  for( Int_t iChunk=0; iChunk<nChunks; iChunk++) {
+    TString chunkFileName = GetDSFChunkFileName( iChunk, nChunks);
+    TFile *chunkFile = TFile::Open( chunkFileName.Data(), "READ");
+    if( !chunkFile || chunkFile->IsZombie() ) {
+      Error("MergeDSFChunks", "cannot open chunk file %s, merge aborted", chunkFileName.Data());
+      delete chunkFile;
+      savedDirectory->cd();
+      return kFALSE;
+    }
+    TH1 *hChunk = (TH1*)chunkFile->Get("hDSFChunk");
+    if( !hChunk || (Int_t)hChunk->GetBinContent(1)!=iChunk || (Int_t)hChunk->GetBinContent(2)!=nChunks ) {
+      Error("MergeDSFChunks", "%s is not the chunk %d of %d, merge aborted", chunkFileName.Data(), iChunk, nChunks);
+      chunkFile->Close();
+      delete chunkFile;
+      savedDirectory->cd();
+      return kFALSE;
+    }
+    Int_t firstEvent = (Int_t)hChunk->GetBinContent(3);
+    if( firstEvent!=expectedFirstEvent ) {
+      Error("MergeDSFChunks", "chunk %d starts at event %d instead of %d, merge aborted", iChunk, firstEvent, expectedFirstEvent);
+      chunkFile->Close();
+      delete chunkFile;
+      savedDirectory->cd();
+      return kFALSE;
+    }
+    lastEvent = (Int_t)hChunk->GetBinContent(4);
+    expectedFirstEvent = lastEvent+1;
+    Info("MergeDSFChunks", "chunk %d: events %d to %d from %s", iChunk, firstEvent, lastEvent, chunkFileName.Data());
+    if( iChunk==0 ) compressionSettings = chunkFile->GetCompressionSettings();
+    chunkFile->Close();
+    delete chunkFile;
+    merger.AddFile( chunkFileName.Data());
+  }
+
+  // The merged trees are re-compressed with the settings of the chunks
+  //  (algorithm*100+level, see DSession::MakeTree)
+  merger.OutputFile( mergedFileName.Data(), "RECREATE", compressionSettings);
+  if( !merger.Merge() ) {
+    Error("MergeDSFChunks", "merge into %s failed", mergedFileName.Data());
+    savedDirectory->cd();
+    return kFALSE;
+  }
+
+  // The range of the merged file is the one of a single production,
+  //  print and log the combined statistics
+  TFile *mergedFile = TFile::Open( mergedFileName.Data(), "UPDATE");
+  if( mergedFile && !mergedFile->IsZombie() ) {
+    TH1 *hChunk = (TH1*)mergedFile->Get("hDSFChunk");
+    if( hChunk ) {
+      hChunk->SetBinContent( 1, 0);
+      hChunk->SetBinContent( 2, 1);
+      hChunk->SetBinContent( 3, 0);
+      hChunk->SetBinContent( 4, lastEvent);
+      hChunk->SetBinContent( 5, 0);
+      hChunk->Write( "", TObject::kOverwrite);
+    }
+    ofstream logfile;
+    logfile.open("DSFProd.log",ios::app);
+    logfile << "============================================" << endl;
+    logfile << nChunks << " chunks merged in " << mergedFileName.Data() << endl;
+    TH1 *hStatistics = (TH1*)mergedFile->Get("hDSFStatistics");
+    if( hStatistics ) {
+      for( Int_t ib=1; ib<=hStatistics->GetNbinsX(); ib++) {
+        cout << "  " << hStatistics->GetXaxis()->GetBinLabel(ib) << ": " << (Long64_t)hStatistics->GetBinContent(ib) << endl;
+        logfile << "  " << hStatistics->GetXaxis()->GetBinLabel(ib) << ": " << (Long64_t)hStatistics->GetBinContent(ib) << endl;
+      }
+    }
+    logfile.close();
+    mergedFile->Close();
+  }
+  delete mergedFile;
+  savedDirectory->cd();
+
+  Info("MergeDSFChunks", "%d chunks (events 0 to %d) merged in %s", nChunks, lastEvent, mergedFileName.Data());
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+//
+Bool_t MimosaAnalysis::CompareDSF(const char *fileName1, const char *fileName2)
+{
+  // Check that two DSF files contain the same events,
+  //  typically a merged chunked production and a single production.
+  // Each event is compared byte per byte once serialized,
+  //  then the statistics histograms (hDSFStatistics) are compared.
+  // Return kTRUE if both files are identical, otherwise
+  //  the first difference is reported.
+  //
+  // Note that analog planes reach the same pedestal and noise only
+  //  after their initialization, events may then differ slightly
+  //  at the beginning of chunks, see DSFProductionRange.
+
+  TDirectory *savedDirectory = gDirectory;
+  TFile *file1 = TFile::Open( fileName1, "READ");
+  TFile *file2 = TFile::Open( fileName2, "READ");
+  if( !file1 || file1->IsZombie() || !file2 || file2->IsZombie() ) {
+    Error("CompareDSF", "cannot open %s or %s", fileName1, fileName2);
+    delete file1;
+    delete file2;
+    savedDirectory->cd();
+    return kFALSE;
+  }
+
+  Bool_t identical = kTRUE;
+  TTree *tree1 = (TTree*)file1->Get("T");
+  TTree *tree2 = (TTree*)file2->Get("T");
+  if( !tree1 || !tree2 ) {
+    Error("CompareDSF", "no tree T in %s or %s", fileName1, fileName2);
+    identical = kFALSE;
+  }
+  else if( tree1->GetEntries()!=tree2->GetEntries() ) {
+    Error("CompareDSF", "%lld events in %s but %lld in %s", tree1->GetEntries(), fileName1, tree2->GetEntries(), fileName2);
+    identical = kFALSE;
+  }
+  else {
+    DEvent *event1 = 0;
+    DEvent *event2 = 0;
+    tree1->SetBranchAddress( "fEvent", &event1);
+    tree2->SetBranchAddress( "fEvent", &event2);
+    for( Long64_t iEntry=0; iEntry<tree1->GetEntries() && identical; iEntry++) {
+      tree1->GetEntry( iEntry);
+      tree2->GetEntry( iEntry);
+      TBufferFile buffer1( TBuffer::kWrite);
+      TBufferFile buffer2( TBuffer::kWrite);
+      event1->Streamer( buffer1);
+      event2->Streamer( buffer2);
+      if( buffer1.Length()!=buffer2.Length() || memcmp( buffer1.Buffer(), buffer2.Buffer(), buffer1.Length()) ) {
+        Error("CompareDSF", "entry %lld differs (events %d and %d)", iEntry, event1->GetHeader().GetEventNumber(), event2->GetHeader().GetEventNumber());
+        identical = kFALSE;
+      }
+    }
+    tree1->ResetBranchAddresses();
+    tree2->ResetBranchAddresses();
+    delete event1;
+    delete event2;
+  }
+
+  TH1 *hStatistics1 = (TH1*)file1->Get("hDSFStatistics");
+  TH1 *hStatistics2 = (TH1*)file2->Get("hDSFStatistics");
+  if( identical && hStatistics1 && hStatistics2 ) {
+    for( Int_t ib=1; ib<=hStatistics1->GetNbinsX(); ib++) {
+      if( hStatistics1->GetBinContent(ib)!=hStatistics2->GetBinContent(ib) ) {
+        Error("CompareDSF", "%s differ: %.0f and %.0f", hStatistics1->GetXaxis()->GetBinLabel(ib), hStatistics1->GetBinContent(ib), hStatistics2->GetBinContent(ib));
+        identical = kFALSE;
+      }
+    }
+  }
+
+  file1->Close();
+  file2->Close();
+  delete file1;
+  delete file2;
+  savedDirectory->cd();
+
+  if( identical ) Info("CompareDSF", "%s and %s contain the same events", fileName1, fileName2);
+  return identical;
+}
+
 //______________________________________________________________________________
   void MimosaAnalysis::Help()
 {
@@ -862,7 +1132,11 @@ void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel)
   cout<<"--->Parametrization of the deviations"<<endl;
   cout<<"gTAF->StudyDeformation(tiniBound, nEvents, fitAuto)"<<endl;
   cout<<"--->Reconstruction"<<endl;
-  cout<<"gTAF->DSFProduction( events, [fillLevel]) "<<endl;
+  cout<<"gTAF->DSFProduction( events, [fillLevel], [compression], [compressionLevel]) "<<endl;
+  cout<<"gTAF->DSFProductionRange( firstEvent, lastEvent, [fillLevel], [warmUpEvents]) "<<endl;
+  cout<<"gTAF->DSFProductionChunk( chunk, nChunks, events, [fillLevel], [warmUpEvents]) "<<endl;
+  cout<<"gTAF->MergeDSFChunks( nChunks) "<<endl;
+  cout<<"gTAF->CompareDSF( fileName1, fileName2) "<<endl;
   cout<<"                              "<<endl;
   cout<<"----------------------------- "<<endl;
   cout<<"------------3/ ANALYSIS       "<<endl;
@@ -873,6 +1147,7 @@ void MimosaAnalysis::DSFProduction(Int_t NEvt, Int_t fillLevel)
   cout<<"gTAF->SetDSFFile(aFileName)"<<endl;
   cout<<"---> Analyse hit - track association"<<endl;
   cout<<"gTAF->SetCUT_MaxHitRatePerPixel( aRate)"<<endl;
+  cout<<"gTAF->SetNWorkers( n)  : share the events of MimosaPro/MimosaCalibration between n processes"<<endl;
   cout<<"gTAF->MimosaPro( events, TrackHitDist,S2N_seed,S2N_neighbour,submatrix,  GeoMatrix, SaveAlign (yes/no) , hitmap (0/1))"<<endl;
   cout<<"---> Analyse fake hit rate"<<endl;
   cout<<"gTAF->MimosaFakerate( events, S2N_seed, S2N_neighbour, submatrix, GeoMatrix)"<<endl;
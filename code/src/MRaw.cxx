@@ -5884,9 +5884,7 @@ void MRaw::SkipEvent( Int_t nEventsToSkip)
   if(fDebugRaw) printf( "MRaw::SkipEvent start to skip %d events.\n", nEventsToSkip);
 
   fSession->SetEvents(nEventsToSkip);
-  for( Int_t iEvent=0; iEvent<nEventsToSkip; iEvent++ ) {
-    if( !(fSession->NextRawEvent()) ) break; // JB 2009/06/26
-  }
+  fSession->SkipRawEvents( nEventsToSkip); // seeks directly if the readers keep an event index
 
 }
 
@@ -100,10 +100,7 @@ PXIBoardReader::PXIBoardReader( int boardNumber, const char *configFileName, int
   EventsOverflow     = 0;
   EventsAborted      = 0; // JB 2009/09/16
   FramesReadTwice    = 0;
-  for( int ib=0; ib<100; ib++) {
-    NStatesInBlock[ib] = 0;
-  }
-  NStatesInLine = 0;
+  Mi26Decoder.SetStatistics( true);
   h1BlockOccupancy = new TH1S("h1BlockOccupancy","Block state occupancy",11,-1,10);
   h1LineOccupancy = new TH1S("h1LineOccupancy","Line state occupancy",11,-1,10);
 
@@ -494,80 +491,52 @@ bool PXIBoardReader::DecodeFrame( int iSensor) {
   }
 
 
-  // -+-+- Pointers AND LOOP to usefull data, i.e. line and states
-  MI26__TStatesLine *lineStatus;
-  MI26__TState *state;
-
-  // ====================
-  while( (long int)frameData < endAddress) { // Loop over usefull data
-
-    // first 16 bits word is the Status/Line
-    lineStatus = (MI26__TStatesLine*)frameData;
-    frameData += 1; // goto next word
-
-    if( lineStatus->F.Ovf > 0 ) { // Stop when overflow, JB 2009/09/08
-//      if(EventsOverflow%1000==0 && ReadingEvent) printf("WARNING : overflow while reading %d event %d at frame %d and sensor %d, total overflow number is %d\n", ReadingEvent, CurrentEventNumber, frame->FrameCnt, iSensor, EventsOverflow);
-       Overflow = true;
-//     if(iSensor==3 && lineStatus->F.LineAddr ==498) Overflow = false; //MG 2010/06/07 --- chip43
-//     if(iSensor==3 && lineStatus->F.LineAddr ==499) Overflow = false; //MG 2010/06/07 --- chip43
-     if(iSensor==4 && lineStatus->F.LineAddr ==318) Overflow = false; //MG 2010/06/02
-//There are noisy pixels on line 318 of the 4th chip --> overflow disable for this line
-      if(EventsOverflow%1000==0 && ReadingEvent&&Overflow == true) printf("WARNING : overflow while reading %d event %d at frame %d, line %d and sensor %d, total overflow number is %d\n", ReadingEvent, CurrentEventNumber, (unsigned int)frame->FrameCnt,lineStatus->F.LineAddr, iSensor, EventsOverflow);//MG 2010/06/02  // removing warning with cast BH 2013/08/20
-
+  // -+-+- Decode the usefull data, i.e. line and states
+  // Pixels are kept only if we are reading an event
+  // and if the line is in the proper limit:
+  //  from FirstLineToKeep in FirstFrame, up to LastLineToKeep in LastFrame.
+  // The line and state words are decoded by Mi26Decoder,
+  //  which also counts the states per line and per block for the statistics.
+  int firstLine = DecoderMi26::kAllLines; // no line kept
+  int lastLine  = DecoderMi26::kAllLines;
+  if( ReadingEvent ) {
+    bool isFirstFrame = (int)frame->FrameCnt == FirstFrame;
+    bool isLastFrame  = (int)frame->FrameCnt == LastFrame;
+    if( isFirstFrame && isLastFrame ) {
+      firstLine = FirstLineToKeep;
+      lastLine  = LastLineToKeep;
+      if( firstLine<=lastLine ) { // the two conditions together keep all lines
+        firstLine = 0;
+        lastLine  = DecoderMi26::kAllLines;
+      }
     }
-
-    if(DebugLevel>3) printf("                  line %d, #states %d, overflow %d at mem.pos %ld, reading event ? %d\n", lineStatus->F.LineAddr, lineStatus->F.StateNb, lineStatus->F.Ovf, (long int)lineStatus, ReadingEvent); // removing warning specifying type for format BH 2013/08/20
-
-    // Stop there if the state was the last usefull word to read
-    // because it is a dummy 
-    // JB 2009/08/30
-    if( (long int)frameData >= endAddress ) break;
-  
-    // Init some statistics for this line
-    // JB 2009/09/10
-    for( int ib=0; ib<100; ib++) {
-      NStatesInBlock[ib] = 0;
+    else if( isFirstFrame ) {
+      firstLine = FirstLineToKeep;
     }
-    NStatesInLine = 0;
-
-    // Next words are the states if any
-    for( int iState=0; iState<lineStatus->F.StateNb; iState++ ) { // loop over states found on sensor
-      state = (MI26__TState*)frameData;
-      frameData += 1; // goto next word
-
-      //compute some statistics, JB 2009/09/10
-      NStatesInLine++;
-      NStatesInBlock[state->F.ColAddr%64] += 1;
-
-      // A state contains HitNb+1 pixels
-      // the first pixel being on the left at the column ColAddr
-      for( int iPixel=0; iPixel<state->F.HitNb+1; iPixel++) { // loop on pixels in the state
-
-	// create a new pixel only if we are reading an event
-	// and if the line is in the proper limit
-	if( ReadingEvent && (
-	    ((int)frame->FrameCnt == FirstFrame && (int)lineStatus->F.LineAddr >= FirstLineToKeep)
-	    || ((int)frame->FrameCnt == LastFrame && (int)lineStatus->F.LineAddr <= LastLineToKeep)
-	  ) ) {
-	  AddPixel( iSensor+1, 1, lineStatus->F.LineAddr, state->F.ColAddr+iPixel);
-	}
-
-      }
-
-      if(DebugLevel>3) printf("                  state %d, #pixels %d, column %d at mem.pos %ld\n", iState, state->F.HitNb+1, state->F.ColAddr, (long int)state); // removing warning specifying type for format BH 2013/08/20
-    } // end loop over states
-
-    // Fill the statistics histograms, JB 2009/09/10
-    for( int ib=0; ib<18; ib++) {
-      h1BlockOccupancy->Fill( NStatesInBlock[ib]);
+    else if( isLastFrame ) {
+      firstLine = 0;
+      lastLine  = LastLineToKeep;
     }
-    h1LineOccupancy->Fill( NStatesInLine);
- 
+  }
+
+  Mi26Decoder.ClearHits();
+  if( Mi26Decoder.Decode( (UInt16*)frame->ADataW16, dataLength/sizeof(UInt16), firstLine, lastLine) < 0 ) {
+    printf("WARNING PXIBoardReader: data truncated in frame %d for sensor %d\n", (unsigned int)frame->FrameCnt, iSensor);
+  }
 
-    if(DebugLevel>4) printf("               mem.pos %ld <?> %ld\n", (long int)frameData, endAddress); // removing warning specifying type for format BH 2013/08/20
+  std::vector<int> &overflowLines = Mi26Decoder.GetOverflowLines();
+  for( size_t iLine=0; iLine<overflowLines.size(); iLine++ ) { // Stop when overflow, JB 2009/09/08
+    if(iSensor==4 && overflowLines[iLine]==318) continue; //MG 2010/06/02
+//There are noisy pixels on line 318 of the 4th chip --> overflow disable for this line
+    Overflow = true;
+    if(EventsOverflow%1000==0 && ReadingEvent) printf("WARNING : overflow while reading %d event %d at frame %d, line %d and sensor %d, total overflow number is %d\n", ReadingEvent, CurrentEventNumber, (unsigned int)frame->FrameCnt, overflowLines[iLine], iSensor, EventsOverflow);//MG 2010/06/02
+  }
 
-  } // end loop over usefull data
-  // =====================
+  std::vector<DecoderMi26::Hit_t> &hits = Mi26Decoder.GetHits();
+  for( size_t iHit=0; iHit<hits.size(); iHit++ ) {
+    AddPixel( iSensor+1, 1, hits[iHit].line, hits[iHit].column);
+    if(DebugLevel>3) printf("                  pixel line %d, column %d\n", hits[iHit].line, hits[iHit].column);
+  }
 
   if(DebugLevel>2) cout << "                 # pixels so far " << ListOfPixels.size() << endl;
 
@@ -707,6 +676,14 @@ void PXIBoardReader::PrintStatistics(ostream &stream) {
   stream << EventsOverflow << " events with an overflow." << endl;
   stream << FramesReadTwice << " frames read twice." << endl;
   stream << EventsAborted << " events aborted." << endl;
+  // Fill the statistics histograms from the counts of the decoder
+  h1LineOccupancy->Reset();
+  h1BlockOccupancy->Reset();
+  for( int n=0; n<=DecoderMi26::kMaxStatesPerLine; n++ ) {
+    if( Mi26Decoder.GetLinesWithStates(n) ) h1LineOccupancy->Fill( n, Mi26Decoder.GetLinesWithStates(n));
+    if( Mi26Decoder.GetBlocksWithStates(n) ) h1BlockOccupancy->Fill( n, Mi26Decoder.GetBlocksWithStates(n));
+  }
+
   stream << " average #states in line: " << h1LineOccupancy->GetMean() << " with RM: " << h1LineOccupancy->GetRMS() << endl;
   stream << " average #states in block: " << h1BlockOccupancy->GetMean() << " with RM: " << h1BlockOccupancy->GetRMS() << endl;
   stream << "***********************************************" << endl;
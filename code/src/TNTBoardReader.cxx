@@ -21,6 +21,7 @@
 // Last modified JB, 2011/07/07 to localize path names
 
 #include "TNTBoardReader.h"
+#include "TString.h"
 
 ClassImp(TNTBoardReader)
 ClassImp(TNTEvent)
@@ -43,6 +44,7 @@ ClassImp(TNTEvent)
   CurrentWordIndex   = 0;
   SizeOfDataBuffer   = 0;
   Data               = new unsigned int[SizeOfWord];
+  RawFileStream.SetLabel( Form( "TNTBoardReader %d", BoardNumber));
   Endianness         = endian;
   NumberOfBitsValue  = (Int_t)TMath::Abs(numberOfBits); // # bits used to code the pixel value, JB 2009/09/28
   SignedValues       = (numberOfBits/(Int_t)TMath::Abs(numberOfBits)<0); // if negative, we have signed values
@@ -107,14 +109,7 @@ bool TNTBoardReader::AddFile(char *fileName) {
   CurrentFileNumber = 1;
   InputFileName = fileName;
   sprintf(InputFileName,"%s", fTool.LocalizeDirName( InputFileName)); // JB 2011/07/07
-  RawFileStream.open( InputFileName);
-  if( RawFileStream.fail() ) {
-    cout << endl << "ERROR TNTBoardReader " << BoardNumber << " file " << InputFileName << " does not exist!" << endl;
-    return false;
-  }
-  cout << endl << "  --> TNTBoardReader " << BoardNumber << " New file " << InputFileName << endl;  
-
-  return true;
+  return RawFileStream.Open( InputFileName);
 }
 
 // --------------------------------------------------------------------------------------
@@ -123,6 +118,9 @@ bool TNTBoardReader::AddFileList(const char *prefixFileName, int startIndex, int
   // Store the inputs to be able to read several files one after the other
   // JB, 2008/10/8
   // Modified: JB 2010/10/05 to allow a first index file not 1 and read file#>10
+  //
+  // All the file names are given to the input buffer,
+  //  which goes from one file to the next by itself.
 
   NumberOfFiles = endIndex;
   CurrentFileNumber = startIndex; // JB 2010/10/05
@@ -134,26 +132,13 @@ bool TNTBoardReader::AddFileList(const char *prefixFileName, int startIndex, int
   sprintf( SuffixFileName, "%s", suffixFileName);//RDM310509
   if(DebugLevel>0) cout << "TNTBoardReader " << BoardNumber << " adding " << NumberOfFiles << " files like " << prefixFileName << "*" << SuffixFileName << endl;
   InputFileName = new char[300];
-  if( CurrentFileNumber<10 ) {
-    sprintf( InputFileName, "%s000%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
+  for( int iFile=startIndex; iFile<=endIndex; iFile++ ) {
+    sprintf( InputFileName, "%s%04d%s", PrefixFileName, iFile, SuffixFileName);
+    sprintf(InputFileName,"%s", fTool.LocalizeDirName( InputFileName)); // JB 2011/07/07
+    if(DebugLevel>0) cout << "  adding file " << InputFileName << endl;
+    RawFileStream.AddFile( InputFileName);
   }
-  else if( CurrentFileNumber<100 ) {
-    sprintf( InputFileName, "%s00%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-  }
-  else if( CurrentFileNumber<1000 ) {
-    sprintf( InputFileName, "%s0%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-  }
-  else {
-    sprintf( InputFileName, "%s%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-  } 
-  sprintf(InputFileName,"%s", fTool.LocalizeDirName( InputFileName)); // JB 2011/07/07
-  if(DebugLevel>0) cout << "  trying file " << InputFileName << endl;
-  RawFileStream.open( InputFileName);
-  if( RawFileStream.fail() ) {
-    cout << endl << "ERROR TNTBoardReader " << BoardNumber << " file " << InputFileName << " does not exist!!" << endl;
-    return false;
-  }
-  cout << endl << "  --> TNTBoardReader " << BoardNumber << " New file " << InputFileName << endl;  
+  if( !RawFileStream.IsOpen() ) return false; // first file missing
 
   return true;
 }
@@ -165,7 +150,7 @@ void TNTBoardReader::Close() {
   // Closes everything needed to be
   // Close()2008/09/27
   cout << "eventnumber=" << eventnumber << endl ;
-  RawFileStream.close();
+  RawFileStream.Close();
 }
 
 // --------------------------------------------------------------------------------------
@@ -199,75 +184,29 @@ bool TNTBoardReader::GetNextWord( ) {
   if( SizeOfDataBuffer && (size_t)CurrentWordIndex < SizeOfDataBuffer-1 ) 
   {
     CurrentWordIndex++;
+    return true;
+  }
+
+  // If we have read the full current Data buffer already,
+  // get the next SizeOfWord words, the input buffer reads the disk by large blocks
+  // and opens the next file of the list when needed
+  SizeOfDataBuffer = RawFileStream.ReadSome( Data, sizeof(unsigned int) * SizeOfWord) / sizeof(unsigned int); // number of available words for this buffer
+  CurrentWordIndex = 0; //re-init the reading position in Data
+  if(DebugLevel>7) cout << "  TNTBoardReader " << BoardNumber << ": Got new data buffer with " << SizeOfDataBuffer << " (1st word at " << CurrentWordIndex << ")." << " SizeOfWord=" << SizeOfWord << endl;
+
+  if( SizeOfDataBuffer==0 ) { // no more file, end the reading
+    cout << "  --> TNTBoardReader " << BoardNumber << ": No more files to read " << RawFileStream.GetFileIndex()+1 << " >= " << RawFileStream.GetFilesN() << " closing!" << endl;   //YV 23/06/09 to speed up DSF production
+    RawFileStream.Close();
+    NoMoreFile = true; // JB 2010/10/13
+    return false;
+  }
+
+  // change the endian of the 32 bts binary words
+  // moved from HasData, JB 2009/05/21, now done for the whole buffer
+  if(Endianness==1) {
+    for( size_t iWord=0; iWord<SizeOfDataBuffer; iWord++ ) Data[iWord] = SwapEndian(Data[iWord]);
   }
 
-  // If we have read the full current Data buffer alreay,
-  // try to get a new Data buffer
-  else 
-  {    	// If end of file but still a file to read, open it
-    	if( RawFileStream.eof() ) 
-    	{
-
-      		if( CurrentFileNumber < NumberOfFiles) 
-		{
-		  if(DebugLevel>1) cout << "  --> TNTBoardReader " << BoardNumber << " New file to read " << CurrentFileNumber << " <= " << NumberOfFiles << " closing and opening." << endl;
-		  RawFileStream.close();
-                  CurrentFileNumber++;
-		  if( CurrentFileNumber<10 ) {
-		    sprintf( InputFileName, "%s000%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-		  }
-		  else if( CurrentFileNumber<100 ) {
-		    sprintf( InputFileName, "%s00%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-		  }
-		  else if( CurrentFileNumber<1000 ) {
-		    sprintf( InputFileName, "%s0%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-		  }
-		  else {
-		    sprintf( InputFileName, "%s%d%s", PrefixFileName, CurrentFileNumber, SuffixFileName);
-		  }
-		  sprintf(InputFileName,"%s", fTool.LocalizeDirName( InputFileName)); // JB 2011/07/07
-		  RawFileStream.open( InputFileName);
-		  if( RawFileStream.fail() ) 
-		  { // end the reading if file opening failed
-		    cout << endl << "ERROR TNTBoardReader " << BoardNumber << " file " << InputFileName << " does not exist!!!" << endl;
-		    return false;
-		  }
-		  else {
-		    cout << endl << "  --> TNTBoardReader " << BoardNumber << " New file " << InputFileName << endl;  
-		  }
-      		} // end if( CurrentFileNumber < NumberOfFiles)
-      		else // Otherwise no more file, end the reading
-		{
-		  cout << "  --> TNTBoardReader " << BoardNumber << ": No more files to read " << CurrentFileNumber << " > " << NumberOfFiles << " closing!" << endl;   //YV 23/06/09 to speed up DSF production
-
-			RawFileStream.close();
-			NoMoreFile = true; // JB 2010/10/13
-			return false;
-      		}
-    	}//end if eof
-
-    // Now we can get the next data buffer
-    RawFileStream.read(reinterpret_cast<char *> ( &Data[0] ), sizeof(int) * SizeOfWord);
-    SizeOfDataBuffer = RawFileStream.gcount() / sizeof ( size_t ); // number of available words for this buffer
-    CurrentWordIndex = 0; //re-init the reading position in Data    
-    if(DebugLevel>7) cout << "  TNTBoardReader " << BoardNumber << ": Got new data buffer with " << SizeOfDataBuffer << " (1st word at " << CurrentWordIndex << ")." << " gcount=" << RawFileStream.gcount() << " sizeof=" << sizeof ( size_t ) << " SizeOfWord=" << SizeOfWord << endl;
-    
-  }// fin else du if ( SizeOfDataBuffer && (size_t)CurrentWordIndex < SizeOfDataBuffer-1 ) {CurrentWordIndex++;}
-
-
-  //if(DebugLevel>5) 
-  //{
-  //   cout << "TNTBoardReader (Before SwapEndian)" << BoardNumber << ": Getting new word at CurrentWordIndex=" <<CurrentWordIndex << endl ;
-  //   cout << "Data["<< CurrentWordIndex<<"]= "<< Data[ CurrentWordIndex] << " and = " << hex << Data[ CurrentWordIndex]<< dec << endl;
-  //}
-  // change the endian of the 32 bts binary word
-  // moved from HasData, JB 2009/05/21
-  if(Endianness==1) Data[CurrentWordIndex] = SwapEndian(Data[CurrentWordIndex]); // we should check wether or not to do it (how ?)
-  //if(DebugLevel>5) 
-  //{ 
-  //  cout << "TNTBoardReader (After SwapEndian)" << BoardNumber << ": CurrentWordIndex= " << CurrentWordIndex <<  endl;
-  //  cout << "Data["<< CurrentWordIndex<<"]= "<< Data[ CurrentWordIndex] << " and = " << hex << Data[ CurrentWordIndex]<< dec << endl;
-  //}
   return true;
 
 }